@@ -46,6 +46,56 @@
  * Types and classes
  *****************************************************************************/
 
+/**
+ * The system clock, based on the processor time of the program.
+ */
+class SystemClock : public IClock
+{
+public:
+
+    /**
+     * Constructs the system clock.
+     */
+    SystemClock() :
+        IClock()
+    {
+    }
+
+    /**
+     * Destroys the system clock.
+     */
+    ~SystemClock()
+    {
+    }
+
+    /**
+     * Get timestamp in ms since the program is running.
+     *
+     * @return Timestamp in ms
+     */
+    unsigned long getMillis() final
+    {
+        clock_t now = clock();
+
+        return (now * 1000UL) / CLOCKS_PER_SEC;
+    }
+
+    /**
+     * Wait for the given duration by busy waiting.
+     *
+     * @param[in] ms    Duration in ms
+     */
+    void delay(unsigned long ms) final
+    {
+        unsigned long start = getMillis();
+
+        while(ms > (getMillis() - start))
+        {
+            ;
+        }
+    }
+};
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -54,10 +104,33 @@
  * Local Variables
  *****************************************************************************/
 
+/** The system clock is used, as long as no other clock source is set. */
+static SystemClock  gSystemClock;
+
+/** Current clock source */
+static IClock*      gClock          = &gSystemClock;
+
+/** Default seed of the pseudo random number generator, it must not be 0. */
+static const uint32_t   RANDOM_SEED_DEFAULT = 0x2545F491U;
+
+/** State of the pseudo random number generator (xorshift32). */
+static uint32_t     gRandomState    = RANDOM_SEED_DEFAULT;
+
+/** Number of CPU cycles per ms, like a ESP32 with 240 MHz. */
+static const uint32_t   CYCLES_PER_MS   = 240000U;
+
+/** ESP system functions */
+EspClass ESP;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
+uint32_t EspClass::getCycleCount()
+{
+    return static_cast<uint32_t>(millis()) * CYCLES_PER_MS;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -72,9 +145,29 @@
 
 extern unsigned long millis()
 {
-    clock_t now = clock();
+    return gClock->getMillis();
+}
 
-    return (now * 1000UL) / CLOCKS_PER_SEC;
+extern void delay(unsigned long ms)
+{
+    gClock->delay(ms);
+}
+
+extern void setClock(IClock* clock)
+{
+    if (nullptr == clock)
+    {
+        gClock = &gSystemClock;
+    }
+    else
+    {
+        gClock = clock;
+    }
+}
+
+extern IClock& getClock()
+{
+    return *gClock;
 }
 
 extern uint32_t esp_log_timestamp(void)
@@ -82,6 +175,47 @@ extern uint32_t esp_log_timestamp(void)
     return millis();
 }
 
+extern void randomSeed(unsigned long seed)
+{
+    /* The xorshift generator would stuck with a state of 0. */
+    if (0U == static_cast<uint32_t>(seed))
+    {
+        gRandomState = RANDOM_SEED_DEFAULT;
+    }
+    else
+    {
+        gRandomState = static_cast<uint32_t>(seed);
+    }
+}
+
+extern long random(long howBig)
+{
+    long value = 0;
+
+    if (0 < howBig)
+    {
+        gRandomState ^= gRandomState << 13U;
+        gRandomState ^= gRandomState >> 17U;
+        gRandomState ^= gRandomState << 5U;
+
+        value = static_cast<long>(gRandomState % static_cast<uint32_t>(howBig));
+    }
+
+    return value;
+}
+
+extern long random(long howSmall, long howBig)
+{
+    long value = howSmall;
+
+    if (howSmall < howBig)
+    {
+        value = howSmall + random(howBig - howSmall);
+    }
+
+    return value;
+}
+
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
\ No newline at end of file
@@ -55,6 +55,7 @@
 
 #include "WString.h"
 #include "Print.h"
+#include "IClock.hpp"
 
 /******************************************************************************
  * Macros
@@ -67,6 +68,26 @@
 /** Arduino boolean */
 typedef bool boolean;
 
+/**
+ * ESP system functions, as far as they are used by the application.
+ */
+class EspClass
+{
+public:
+
+    /**
+     * Get the number of CPU cycles since start.
+     * It is derived from the clock source, which keeps it reproducible
+     * with a virtual clock.
+     *
+     * @return Number of CPU cycles
+     */
+    uint32_t getCycleCount();
+};
+
+/** ESP system functions */
+extern EspClass ESP;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
@@ -78,6 +99,55 @@ typedef bool boolean;
  */
 extern unsigned long millis();
 
+/**
+ * Wait for the given duration.
+ * 
+ * @param[in] ms    Duration in ms
+ */
+extern void delay(unsigned long ms);
+
+/**
+ * Set the clock source, which is used by millis() and delay().
+ * 
+ * @param[in] clock Clock source or nullptr to use the system clock.
+ */
+extern void setClock(IClock* clock);
+
+/**
+ * Get the clock source, which is used by millis() and delay().
+ * 
+ * @return Clock source
+ */
+extern IClock& getClock();
+
+/**
+ * Initialize the pseudo random number generator.
+ * The sequence of random numbers is deterministic for a given seed, which
+ * makes native test runs reproducible.
+ * 
+ * @param[in] seed  Seed
+ */
+extern void randomSeed(unsigned long seed);
+
+/**
+ * Get a pseudo random number in the range [0; howBig[.
+ * 
+ * @param[in] howBig    Upper bound (exclusive)
+ * 
+ * @return Random number
+ */
+extern long random(long howBig);
+
+/**
+ * Get a pseudo random number in the range [howSmall; howBig[.
+ * 
+ * @param[in] howSmall  Lower bound (inclusive)
+ * @param[in] howBig    Upper bound (exclusive)
+ * 
+ * @return Random number
+ */
+extern long random(long howSmall, long howBig);
+
 /**
  * Get timestamp for log output in ms.
  * 
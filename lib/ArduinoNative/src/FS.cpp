@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "FS.h"
 
+#include <sys/stat.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -58,6 +60,51 @@
  * Public Methods
  *****************************************************************************/
 
+size_t File::position() const
+{
+    size_t  pos = 0U;
+
+    if (nullptr != m_fd)
+    {
+        long filePos = ftell(m_fd);
+
+        if (0 <= filePos)
+        {
+            pos = static_cast<size_t>(filePos);
+        }
+    }
+
+    return pos;
+}
+
+size_t File::size() const
+{
+    size_t      fileSize    = 0U;
+    struct stat fileStat;
+
+    if ((nullptr != m_fd) &&
+        (0 == fstat(fileno(m_fd), &fileStat)))
+    {
+        fileSize = static_cast<size_t>(fileStat.st_size);
+    }
+
+    return fileSize;
+}
+
+time_t File::getLastWrite()
+{
+    time_t      lastWrite   = 0;
+    struct stat fileStat;
+
+    if ((nullptr != m_fd) &&
+        (0 == fstat(fileno(m_fd), &fileStat)))
+    {
+        lastWrite = fileStat.st_mtime;
+    }
+
+    return lastWrite;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
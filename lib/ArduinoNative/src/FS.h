@@ -70,6 +70,11 @@ enum SeekMode {
 class File
 {
 public:
+    File() :
+        m_fd(nullptr)
+    {
+    }
+
     File(FILE* fd) :
         m_fd(fd)
     {
@@ -79,21 +84,36 @@ public:
     {
     }
 
-    size_t write(uint8_t data);
-    size_t write(const uint8_t *buf, size_t size);
+    size_t write(uint8_t data)
+    {
+        return write(&data, 1U);
+    }
+
+    size_t write(const uint8_t *buf, size_t size)
+    {
+        size_t written = 0U;
+
+        if (nullptr != m_fd)
+        {
+            written = fwrite(buf, 1, size, m_fd);
+        }
+
+        return written;
+    }
+
     int available();
-    
+
     int read()
     {
         int data = -1;
 
         if (nullptr != m_fd)
         {
-            int8_t byte = 0;
+            uint8_t byte = 0U;
 
-            if (1 != fread(&byte, 1, 1, m_fd))
+            if (1 == fread(&byte, 1, 1, m_fd))
             {
-                data = -1;
+                data = byte;
             }
         }
 
@@ -128,8 +148,11 @@ public:
 
     void close()
     {
-        fclose(m_fd);
-        m_fd = nullptr;
+        if (nullptr != m_fd)
+        {
+            fclose(m_fd);
+            m_fd = nullptr;
+        }
     }
 
     operator bool() const
@@ -147,8 +170,6 @@ public:
 private:
 
     FILE*   m_fd;
-
-    File();
 };
 
 class FS
@@ -177,7 +198,7 @@ public:
     bool exists(const char* path)
     {
         bool    itExists    = false;
-        FILE*   fd          = fopen("path", "r");
+        FILE*   fd          = fopen(path, "r");
 
         if (nullptr != fd)
         {
@@ -193,11 +214,25 @@ public:
         return exists(path.c_str());
     }
 
-    bool remove(const char* path);
-    bool remove(const String& path);
+    bool remove(const char* path)
+    {
+        return (0 == ::remove(path));
+    }
 
-    bool rename(const char* pathFrom, const char* pathTo);
-    bool rename(const String& pathFrom, const String& pathTo);
+    bool remove(const String& path)
+    {
+        return remove(path.c_str());
+    }
+
+    bool rename(const char* pathFrom, const char* pathTo)
+    {
+        return (0 == ::rename(pathFrom, pathTo));
+    }
+
+    bool rename(const String& pathFrom, const String& pathTo)
+    {
+        return rename(pathFrom.c_str(), pathTo.c_str());
+    }
 
     bool mkdir(const char *path);
     bool mkdir(const String &path);
@@ -0,0 +1,140 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Virtual clock for test
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup test
+ *
+ * @{
+ */
+
+#ifndef VIRTUAL_CLOCK_HPP
+#define VIRTUAL_CLOCK_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IClock.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A deterministic clock, which only advances if it is stepped. A delay() is
+ * handled by stepping the clock immediately, without waiting.
+ *
+ * Inject it with setClock() to let millis(), delay() and everything based on
+ * them, e.g. the SimpleTimer, run on virtual time. This way long running
+ * behaviour can be simulated much faster than real time.
+ */
+class VirtualClock : public IClock
+{
+public:
+
+    /**
+     * Constructs the virtual clock.
+     *
+     * @param[in] startMs   Start timestamp in ms
+     */
+    VirtualClock(unsigned long startMs = 0UL) :
+        IClock(),
+        m_millis(startMs)
+    {
+    }
+
+    /**
+     * Destroys the virtual clock.
+     */
+    ~VirtualClock()
+    {
+    }
+
+    /**
+     * Get timestamp in ms.
+     *
+     * @return Timestamp in ms
+     */
+    unsigned long getMillis() final
+    {
+        return m_millis;
+    }
+
+    /**
+     * Wait for the given duration by stepping the clock.
+     *
+     * @param[in] ms    Duration in ms
+     */
+    void delay(unsigned long ms) final
+    {
+        step(ms);
+    }
+
+    /**
+     * Step the clock forward.
+     *
+     * @param[in] ms    Duration in ms
+     */
+    void step(unsigned long ms)
+    {
+        m_millis += ms;
+    }
+
+    /**
+     * Set the clock to the given timestamp.
+     *
+     * @param[in] ms    Timestamp in ms
+     */
+    void set(unsigned long ms)
+    {
+        m_millis = ms;
+    }
+
+private:
+
+    unsigned long   m_millis;   /**< Current timestamp in ms */
+
+    VirtualClock(const VirtualClock& clock);
+    VirtualClock& operator=(const VirtualClock& clock);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* VIRTUAL_CLOCK_HPP */
+
+/** @} */
@@ -0,0 +1,126 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fast decibel conversion
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef DECIBEL_HPP
+#define DECIBEL_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fast decibel conversion for audio rate processing, which avoids the
+ * log10f() call of the C library.
+ */
+namespace Decibel
+{
+
+/** The dB value, which represents an amplitude of 0. */
+static constexpr float  MIN_DECIBEL         = -200.0F;
+
+/** Conversion factor from log2() to dB, which is 20 * log10(2). */
+static constexpr float  DECIBEL_PER_LOG2    = 6.0205999F;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Fast approximation of the binary logarithm, with an absolute error
+ * less than 0.01, which is less than 0.06 dB.
+ *
+ * @param[in] value Value, shall be greater than 0.
+ *
+ * @return Binary logarithm
+ */
+inline float fastLog2(float value)
+{
+    uint32_t    bits        = 0U;
+    int32_t     exponent    = 0;
+    float       mantissa    = 0.0F;
+
+    (void)memcpy(&bits, &value, sizeof(bits));
+
+    /* The exponent bias is reduced by one, because the approximation
+     * results in [1; 2) for the mantissa in [1; 2).
+     */
+    exponent    = static_cast<int32_t>((bits >> 23U) & 0xFFU) - 128;
+    bits        = (bits & 0x007FFFFFU) | 0x3F800000U;
+
+    (void)memcpy(&mantissa, &bits, sizeof(mantissa));
+
+    /* Second order approximation of log2() + 1 in [1; 2). */
+    return static_cast<float>(exponent) + ((-0.34484843F * mantissa + 2.02466578F) * mantissa - 0.67487759F);
+}
+
+/**
+ * Convert a linear amplitude to dB (20 * log10(amplitude)), by using the
+ * fast binary logarithm approximation.
+ *
+ * @param[in] amplitude Linear amplitude
+ *
+ * @return Amplitude in dB. If the amplitude is not greater than 0, MIN_DECIBEL will be returned.
+ */
+inline float fromAmplitude(float amplitude)
+{
+    float decibel = MIN_DECIBEL;
+
+    if (0.0F < amplitude)
+    {
+        decibel = DECIBEL_PER_LOG2 * fastLog2(amplitude);
+    }
+
+    return decibel;
+}
+
+}
+
+#endif  /* DECIBEL_HPP */
+
+/** @} */
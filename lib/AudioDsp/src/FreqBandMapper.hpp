@@ -0,0 +1,441 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frequency band mapper
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef FREQ_BAND_MAPPER_HPP
+#define FREQ_BAND_MAPPER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Supported frequency band scales.
+ */
+enum FreqBandScale
+{
+    FREQ_BAND_SCALE_LOG = 0,    /**< Logarithmic spaced bands, e.g. 8 bands are octaves and 24 bands are 1/3 octaves. */
+    FREQ_BAND_SCALE_MEL         /**< Mel spaced bands with triangular overlapping filters. */
+};
+
+/**
+ * Maps the frequency bins of a spectrum to perceptual frequency bands.
+ *
+ * The weight of every frequency bin to its (at most two) bands is calculated
+ * once by configure(). Every weight is already normalized by the sum of the
+ * band weights, therefore a band is the weighted average of its frequency
+ * bins and the mapping itself needs only multiply-add operations.
+ * See Decibel.hpp for a fast conversion of the bands to dB.
+ *
+ * @tparam TBins        Number of frequency bins, including the DC bin.
+ * @tparam TMaxBands    Max. number of frequency bands.
+ */
+template < uint32_t TBins, uint8_t TMaxBands >
+class FreqBandMapper
+{
+public:
+
+    /** Max. number of frequency bands. */
+    static const uint8_t    MAX_BANDS           = TMaxBands;
+
+    /** Frequency bin of the low edge of the first logarithmic band. */
+    static constexpr float  LOG_LOW_EDGE_BIN    = 3.0F;
+
+    /**
+     * Constructs the mapper without any frequency band.
+     */
+    FreqBandMapper() :
+        m_bandsLen(0U),
+        m_firstBand(),
+        m_weights()
+    {
+    }
+
+    /**
+     * Destroys the mapper.
+     */
+    ~FreqBandMapper()
+    {
+    }
+
+    /**
+     * Calculate the weights of the frequency bins for the frequency bands.
+     * The DC bin is never used.
+     *
+     * The logarithmic scale starts with the first band at LOG_LOW_EDGE_BIN,
+     * because the lower frequency bins can not be resolved further. Every
+     * band contains at least one frequency bin.
+     *
+     * @param[in] scale         Frequency band scale
+     * @param[in] bandsLen      Number of frequency bands [1; MAX_BANDS]
+     * @param[in] sampleRate    Sample rate in Hz
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool configure(FreqBandScale scale, uint8_t bandsLen, uint32_t sampleRate)
+    {
+        bool isSuccessful = false;
+
+        if ((0U < bandsLen) &&
+            (TMaxBands >= bandsLen) &&
+            (TBins > bandsLen) &&
+            (0U < sampleRate))
+        {
+            (void)memset(m_firstBand, 0, sizeof(m_firstBand));
+            (void)memset(m_weights, 0, sizeof(m_weights));
+
+            m_bandsLen = bandsLen;
+
+            if (FREQ_BAND_SCALE_MEL == scale)
+            {
+                calculateMelWeights(sampleRate);
+            }
+            else
+            {
+                calculateLogWeights();
+            }
+
+            normalizeWeights();
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Get the number of frequency bands.
+     *
+     * @return Number of frequency bands
+     */
+    uint8_t getBandsLen() const
+    {
+        return m_bandsLen;
+    }
+
+    /**
+     * Map the frequency bins to the frequency bands.
+     *
+     * @param[in]   bins    Frequency bins, TBins values.
+     * @param[out]  bands   Frequency bands, getBandsLen() values.
+     */
+    void map(const float* bins, float* bands) const
+    {
+        uint32_t    binIdx  = 0U;
+        uint8_t     bandIdx = 0U;
+
+        if ((nullptr == bins) ||
+            (nullptr == bands))
+        {
+            return;
+        }
+
+        for(bandIdx = 0U; bandIdx < m_bandsLen; ++bandIdx)
+        {
+            bands[bandIdx] = 0.0F;
+        }
+
+        /* The weight of the second band is 0 for the last band, therefore
+         * the band after it is never written.
+         */
+        for(binIdx = 1U; binIdx < TBins; ++binIdx)
+        {
+            uint8_t band = m_firstBand[binIdx];
+
+            bands[band] += bins[binIdx] * m_weights[binIdx][0U];
+
+            if (0.0F < m_weights[binIdx][1U])
+            {
+                bands[band + 1U] += bins[binIdx] * m_weights[binIdx][1U];
+            }
+        }
+    }
+
+private:
+
+    uint8_t m_bandsLen;             /**< Number of frequency bands */
+    uint8_t m_firstBand[TBins];     /**< First frequency band of every frequency bin. */
+    float   m_weights[TBins][2U];   /**< Weight of every frequency bin for its first and the following band. */
+
+    /**
+     * Calculate the weights of logarithmic spaced, rectangular bands.
+     */
+    void calculateLogWeights()
+    {
+        const float HIGH_EDGE_BIN   = static_cast<float>(TBins - 1U);
+        uint32_t    binIdx          = 1U;
+        uint8_t     bandIdx         = 0U;
+
+        for(bandIdx = 0U; bandIdx < m_bandsLen; ++bandIdx)
+        {
+            float       exponent    = static_cast<float>(bandIdx + 1U) / static_cast<float>(m_bandsLen);
+            uint32_t    highEdgeBin = static_cast<uint32_t>(lroundf(LOG_LOW_EDGE_BIN * powf(HIGH_EDGE_BIN / LOG_LOW_EDGE_BIN, exponent)));
+            uint32_t    maxEdgeBin  = (TBins - 1U) - (m_bandsLen - 1U - bandIdx);
+
+            /* Every band shall have one frequency bin at least and the
+             * following bands too.
+             */
+            if (binIdx > highEdgeBin)
+            {
+                highEdgeBin = binIdx;
+            }
+
+            if (maxEdgeBin < highEdgeBin)
+            {
+                highEdgeBin = maxEdgeBin;
+            }
+
+            while(binIdx <= highEdgeBin)
+            {
+                m_firstBand[binIdx]     = bandIdx;
+                m_weights[binIdx][0U]   = 1.0F;
+
+                ++binIdx;
+            }
+        }
+    }
+
+    /**
+     * Calculate the weights of mel spaced, triangular bands.
+     *
+     * @param[in] sampleRate    Sample rate in Hz
+     */
+    void calculateMelWeights(uint32_t sampleRate)
+    {
+        const float BIN_WIDTH   = static_cast<float>(sampleRate) / static_cast<float>(2U * TBins);
+        const float MEL_LOW     = toMel(BIN_WIDTH);
+        const float MEL_HIGH    = toMel(BIN_WIDTH * static_cast<float>(TBins - 1U));
+        const float MEL_STEP    = (MEL_HIGH - MEL_LOW) / static_cast<float>(m_bandsLen + 1U);
+        uint32_t    binIdx      = 0U;
+
+        for(binIdx = 1U; binIdx < TBins; ++binIdx)
+        {
+            /* Position in units of the band center distance. Band n has its
+             * center at position n + 1 and reaches to its neighbour centers.
+             */
+            float       position    = (toMel(BIN_WIDTH * static_cast<float>(binIdx)) - MEL_LOW) / MEL_STEP;
+            uint32_t    segment     = static_cast<uint32_t>(position);
+            float       fraction    = position - static_cast<float>(segment);
+
+            if (m_bandsLen < segment)
+            {
+                segment     = m_bandsLen;
+                fraction    = 0.0F;
+            }
+
+            if (0U == segment)
+            {
+                /* Rising edge of the first band only. */
+                m_firstBand[binIdx]     = 0U;
+                m_weights[binIdx][0U]   = fraction;
+            }
+            else if (m_bandsLen == segment)
+            {
+                /* Falling edge of the last band only. */
+                m_firstBand[binIdx]     = m_bandsLen - 1U;
+                m_weights[binIdx][0U]   = 1.0F - fraction;
+            }
+            else
+            {
+                /* Falling edge of the lower band and rising edge of the upper band. */
+                m_firstBand[binIdx]     = segment - 1U;
+                m_weights[binIdx][0U]   = 1.0F - fraction;
+                m_weights[binIdx][1U]   = fraction;
+            }
+        }
+
+        /* Narrow bands may not hit any frequency bin, which is fixed by using
+         * the nearest frequency bin.
+         */
+        fixEmptyMelBands(MEL_LOW, MEL_STEP, BIN_WIDTH);
+    }
+
+    /**
+     * Assign the nearest frequency bin to every mel band without any weight.
+     * Only the second weight of a frequency bin can be free, therefore it
+     * is used for bands, which follow the first band of the frequency bin.
+     *
+     * @param[in] melLow    Mel value of the first frequency bin
+     * @param[in] melStep   Distance of the band centers in mel
+     * @param[in] binWidth  Width of a frequency bin in Hz
+     */
+    void fixEmptyMelBands(float melLow, float melStep, float binWidth)
+    {
+        float   bandWeights[TMaxBands];
+        uint8_t bandIdx     = 0U;
+
+        calculateBandWeights(bandWeights);
+
+        for(bandIdx = 0U; bandIdx < m_bandsLen; ++bandIdx)
+        {
+            if (0.0F >= bandWeights[bandIdx])
+            {
+                float       centerFreq  = fromMel(melLow + melStep * static_cast<float>(bandIdx + 1U));
+                uint32_t    binIdx      = static_cast<uint32_t>(lroundf(centerFreq / binWidth));
+
+                if (1U > binIdx)
+                {
+                    binIdx = 1U;
+                }
+                else if ((TBins - 1U) < binIdx)
+                {
+                    binIdx = TBins - 1U;
+                }
+
+                if (bandIdx == m_firstBand[binIdx])
+                {
+                    m_weights[binIdx][0U] = 1.0F;
+                }
+                else if (bandIdx == (m_firstBand[binIdx] + 1U))
+                {
+                    m_weights[binIdx][1U] = 1.0F;
+                }
+                else
+                {
+                    /* Not possible, the frequency bin is at the band center. */
+                    ;
+                }
+            }
+        }
+    }
+
+    /**
+     * Normalize the weights by the sum of the band weights.
+     */
+    void normalizeWeights()
+    {
+        float       bandWeights[TMaxBands];
+        uint32_t    binIdx      = 0U;
+
+        calculateBandWeights(bandWeights);
+
+        for(binIdx = 1U; binIdx < TBins; ++binIdx)
+        {
+            uint8_t band = m_firstBand[binIdx];
+
+            if (0.0F < bandWeights[band])
+            {
+                m_weights[binIdx][0U] /= bandWeights[band];
+            }
+
+            if ((m_bandsLen > (band + 1U)) &&
+                (0.0F < bandWeights[band + 1U]))
+            {
+                m_weights[binIdx][1U] /= bandWeights[band + 1U];
+            }
+            else
+            {
+                m_weights[binIdx][1U] = 0.0F;
+            }
+        }
+    }
+
+    /**
+     * Calculate the sum of the weights of every band.
+     *
+     * @param[out] bandWeights  Sum of the weights of every band.
+     */
+    void calculateBandWeights(float* bandWeights) const
+    {
+        uint32_t    binIdx  = 0U;
+        uint8_t     bandIdx = 0U;
+
+        for(bandIdx = 0U; bandIdx < TMaxBands; ++bandIdx)
+        {
+            bandWeights[bandIdx] = 0.0F;
+        }
+
+        for(binIdx = 1U; binIdx < TBins; ++binIdx)
+        {
+            uint8_t band = m_firstBand[binIdx];
+
+            bandWeights[band] += m_weights[binIdx][0U];
+
+            if (m_bandsLen > (band + 1U))
+            {
+                bandWeights[band + 1U] += m_weights[binIdx][1U];
+            }
+        }
+    }
+
+    /**
+     * Convert a frequency to mel.
+     *
+     * @param[in] freq  Frequency in Hz
+     *
+     * @return Mel
+     */
+    static float toMel(float freq)
+    {
+        return 2595.0F * log10f(1.0F + freq / 700.0F);
+    }
+
+    /**
+     * Convert mel to a frequency.
+     *
+     * @param[in] mel   Mel
+     *
+     * @return Frequency in Hz
+     */
+    static float fromMel(float mel)
+    {
+        return 700.0F * (powf(10.0F, mel / 2595.0F) - 1.0F);
+    }
+
+    FreqBandMapper(const FreqBandMapper& mapper);
+    FreqBandMapper& operator=(const FreqBandMapper& mapper);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* FREQ_BAND_MAPPER_HPP */
+
+/** @} */
@@ -0,0 +1,316 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Goertzel filter bank
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef GOERTZEL_BANK_HPP
+#define GOERTZEL_BANK_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <math.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Goertzel filter bank, which calculates the amplitude of several target
+ * frequencies in a single pass over the sample block.
+ *
+ * Every sample is windowed only once and then fed into the filter of every
+ * enabled tone. The hamming window is calculated once during construction,
+ * because the block size is fixed. A target frequency is rounded to the
+ * nearest frequency bin of the block.
+ *
+ * https://en.wikipedia.org/wiki/Goertzel_algorithm
+ *
+ * @tparam TSamples Number of samples per block, shall be even.
+ * @tparam TTones   Max. number of tones.
+ */
+template < uint32_t TSamples, uint8_t TTones >
+class GoertzelBank
+{
+public:
+
+    /** Max. number of tones. */
+    static const uint8_t    MAX_TONES   = TTones;
+
+    /**
+     * Constructs the filter bank with all tones disabled.
+     */
+    GoertzelBank() :
+        m_window(),
+        m_coeff(),
+        m_cosValue(),
+        m_sinValue(),
+        m_activeTones(),
+        m_activeTonesCnt(0U)
+    {
+        uint32_t idx = 0U;
+
+        for(idx = 0U; idx < WINDOW_SIZE; ++idx)
+        {
+            m_window[idx] = 0.54F - 0.46F * cosf((2.0F * static_cast<float>(M_PI) * idx) / static_cast<float>(TSamples));
+        }
+
+        for(idx = 0U; idx < TTones; ++idx)
+        {
+            m_coeff[idx]    = 0.0F;
+            m_cosValue[idx] = 0.0F;
+            m_sinValue[idx] = 0.0F;
+        }
+    }
+
+    /**
+     * Destroys the filter bank.
+     */
+    ~GoertzelBank()
+    {
+    }
+
+    /**
+     * Set the target frequency of a tone. A frequency, which is rounded to
+     * the frequency bin 0, disables the tone.
+     *
+     * @param[in] toneId        Tone id [0; MAX_TONES - 1]
+     * @param[in] freq          Target frequency in Hz
+     * @param[in] sampleRate    Sample rate in Hz
+     */
+    void setTargetFreq(uint8_t toneId, float freq, uint32_t sampleRate)
+    {
+        if ((TTones > toneId) &&
+            (0U < sampleRate))
+        {
+            float       fIndex  = 0.5F + ((TSamples * freq) / sampleRate);
+            uint32_t    bin     = 0U;
+
+            if (0.0F < fIndex)
+            {
+                bin = static_cast<uint32_t>(fIndex);
+            }
+
+            if (TSamples / 2U < bin)
+            {
+                bin = TSamples / 2U;
+            }
+
+            if (0U == bin)
+            {
+                m_coeff[toneId]     = 0.0F;
+                m_cosValue[toneId]  = 0.0F;
+                m_sinValue[toneId]  = 0.0F;
+            }
+            else
+            {
+                float omega = (2.0F * static_cast<float>(M_PI) * bin) / TSamples;
+
+                m_cosValue[toneId]  = cosf(omega);
+                m_sinValue[toneId]  = sinf(omega);
+                m_coeff[toneId]     = 2.0F * m_cosValue[toneId];
+            }
+
+            updateActiveTones(toneId, 0U != bin);
+        }
+    }
+
+    /**
+     * Is the tone enabled?
+     *
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     *
+     * @return If the tone is enabled, it will return true otherwise false.
+     */
+    bool isEnabled(uint8_t toneId) const
+    {
+        bool    isEnabled   = false;
+        uint8_t idx         = 0U;
+
+        while((m_activeTonesCnt > idx) && (false == isEnabled))
+        {
+            if (toneId == m_activeTones[idx])
+            {
+                isEnabled = true;
+            }
+
+            ++idx;
+        }
+
+        return isEnabled;
+    }
+
+    /**
+     * Calculate the amplitude of every tone.
+     * The amplitude of a disabled tone is 0.
+     *
+     * @param[in]   samples     Sample block, TSamples values.
+     * @param[out]  magnitudes  Amplitude of every tone, MAX_TONES values.
+     */
+    void calculate(const int32_t* samples, float* magnitudes) const
+    {
+        float   q1[TTones];
+        float   q2[TTones];
+        uint8_t idx             = 0U;
+        uint8_t toneId          = 0U;
+
+        if ((nullptr == samples) ||
+            (nullptr == magnitudes))
+        {
+            return;
+        }
+
+        for(idx = 0U; idx < TTones; ++idx)
+        {
+            q1[idx]         = 0.0F;
+            q2[idx]         = 0.0F;
+            magnitudes[idx] = 0.0F;
+        }
+
+        /* The window is symmetric, therefore the second half of the block
+         * walks the table backwards.
+         */
+        feed(&samples[0], WINDOW_SIZE, 0, 1, q1, q2);
+        feed(&samples[WINDOW_SIZE], TSamples - WINDOW_SIZE, static_cast<int32_t>(WINDOW_SIZE) - 2, -1, q1, q2);
+
+        for(idx = 0U; idx < m_activeTonesCnt; ++idx)
+        {
+            float realValue = 0.0F;
+            float imagValue = 0.0F;
+
+            toneId      = m_activeTones[idx];
+            realValue   = (q1[toneId] - q2[toneId] * m_cosValue[toneId]) / SCALING_FACTOR;
+            imagValue   = (q2[toneId] * m_sinValue[toneId]) / SCALING_FACTOR;
+
+            /* Correct the amplitude loss of the window. */
+            magnitudes[toneId] = 2.0F * sqrtf(realValue * realValue + imagValue * imagValue);
+        }
+    }
+
+private:
+
+    /** Number of window values, the window is symmetric to the block center. */
+    static const uint32_t   WINDOW_SIZE     = TSamples / 2U + 1U;
+
+    /** Scales the result to the single-sided amplitude. */
+    static constexpr float  SCALING_FACTOR  = static_cast<float>(TSamples) / 2.0F;
+
+    float   m_window[WINDOW_SIZE];      /**< Precomputed window */
+    float   m_coeff[TTones];            /**< Precomputed coefficient of every tone */
+    float   m_cosValue[TTones];         /**< Precomputed cosinus value of every tone */
+    float   m_sinValue[TTones];         /**< Precomputed sinus value of every tone */
+    uint8_t m_activeTones[TTones];      /**< Ids of the enabled tones */
+    uint8_t m_activeTonesCnt;           /**< Number of enabled tones */
+
+    /**
+     * Feed samples into the filters of all enabled tones.
+     *
+     * @param[in]       samples     Samples
+     * @param[in]       count       Number of samples
+     * @param[in]       windowIdx   Window index of the first sample
+     * @param[in]       windowStep  Window index step per sample
+     * @param[in,out]   q1          Filter state of every tone
+     * @param[in,out]   q2          Filter state of every tone
+     */
+    void feed(const int32_t* samples, uint32_t count, int32_t windowIdx, int32_t windowStep, float* q1, float* q2) const
+    {
+        uint32_t idx = 0U;
+
+        for(idx = 0U; idx < count; ++idx)
+        {
+            float   value   = static_cast<float>(samples[idx]) * m_window[windowIdx];
+            uint8_t tone    = 0U;
+
+            for(tone = 0U; tone < m_activeTonesCnt; ++tone)
+            {
+                uint8_t toneId  = m_activeTones[tone];
+                float   q0      = m_coeff[toneId] * q1[toneId] - q2[toneId] + value;
+
+                q2[toneId] = q1[toneId];
+                q1[toneId] = q0;
+            }
+
+            windowIdx += windowStep;
+        }
+    }
+
+    /**
+     * Update the list of enabled tones.
+     *
+     * @param[in] toneId    Tone id
+     * @param[in] isEnabled Is tone enabled?
+     */
+    void updateActiveTones(uint8_t toneId, bool isEnabled)
+    {
+        uint8_t idx     = 0U;
+        uint8_t dstIdx  = 0U;
+
+        /* Remove it first, to avoid duplicates. */
+        for(idx = 0U; idx < m_activeTonesCnt; ++idx)
+        {
+            if (toneId != m_activeTones[idx])
+            {
+                m_activeTones[dstIdx] = m_activeTones[idx];
+                ++dstIdx;
+            }
+        }
+
+        m_activeTonesCnt = dstIdx;
+
+        if (true == isEnabled)
+        {
+            m_activeTones[m_activeTonesCnt] = toneId;
+            ++m_activeTonesCnt;
+        }
+    }
+
+    GoertzelBank(const GoertzelBank& bank);
+    GoertzelBank& operator=(const GoertzelBank& bank);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* GOERTZEL_BANK_HPP */
+
+/** @} */
@@ -0,0 +1,434 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Onset detector
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef ONSET_DETECTOR_HPP
+#define ONSET_DETECTOR_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <math.h>
+#include <Decibel.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Detects onsets (e.g. beats) in a stream of spectra and estimates the tempo.
+ *
+ * The onset detection function is the spectral flux: the average increase of
+ * the log. magnitude of all frequency bins, compared to the previous
+ * spectrum. An onset is detected immediately, if the flux exceeds an
+ * adaptive threshold, which follows the mean and the mean deviation of the
+ * flux. There is no look-ahead, therefore the latency is a single spectrum.
+ *
+ * The tempo is estimated by a histogram of the intervals between the last
+ * onsets. It decays with every onset, so the tempo follows the music.
+ *
+ * @tparam TBins    Number of frequency bins, including the DC bin.
+ */
+template < uint32_t TBins >
+class OnsetDetector
+{
+public:
+
+    /** Default sensitivity, which is the factor of the mean deviation above the mean flux. */
+    static constexpr float  SENSITIVITY_DEFAULT = 1.5F;
+
+    /** Min. beat interval in ms, which corresponds to 200 BPM. */
+    static const uint32_t   MIN_BEAT_INTERVAL   = 300U;
+
+    /** Max. beat interval in ms, which corresponds to 60 BPM. */
+    static const uint32_t   MAX_BEAT_INTERVAL   = 1000U;
+
+    /**
+     * Constructs the onset detector.
+     */
+    OnsetDetector() :
+        m_sensitivity(SENSITIVITY_DEFAULT),
+        m_prevLogMagnitudes(),
+        m_frames(0U),
+        m_flux(0.0F),
+        m_meanFlux(0.0F),
+        m_meanDeviation(0.0F),
+        m_threshold(0.0F),
+        m_onsetTimestamps(),
+        m_onsets(0U),
+        m_intervalHistogram(),
+        m_tempo(0.0F)
+    {
+    }
+
+    /**
+     * Destroys the onset detector.
+     */
+    ~OnsetDetector()
+    {
+    }
+
+    /**
+     * Get the sensitivity.
+     *
+     * @return Sensitivity
+     */
+    float getSensitivity() const
+    {
+        return m_sensitivity;
+    }
+
+    /**
+     * Set the sensitivity, which is the factor of the mean deviation above
+     * the mean flux. The lower the value, the more onsets are detected.
+     *
+     * @param[in] sensitivity   Sensitivity, shall be greater than 0.
+     */
+    void setSensitivity(float sensitivity)
+    {
+        if (0.0F < sensitivity)
+        {
+            m_sensitivity = sensitivity;
+        }
+    }
+
+    /**
+     * Reset the detector, e.g. after a gap in the stream of spectra.
+     */
+    void reset()
+    {
+        uint32_t idx = 0U;
+
+        m_frames        = 0U;
+        m_flux          = 0.0F;
+        m_meanFlux      = 0.0F;
+        m_meanDeviation = 0.0F;
+        m_threshold     = 0.0F;
+        m_onsets        = 0U;
+        m_tempo         = 0.0F;
+
+        for(idx = 0U; idx < HISTOGRAM_SIZE; ++idx)
+        {
+            m_intervalHistogram[idx] = 0.0F;
+        }
+    }
+
+    /**
+     * Process the next spectrum.
+     *
+     * @param[in] bins      Frequency bins with linear magnitude, TBins values.
+     * @param[in] timestamp Timestamp of the spectrum in ms.
+     *
+     * @return If an onset is detected, it will return true otherwise false.
+     */
+    bool process(const float* bins, uint32_t timestamp)
+    {
+        bool    isOnset = false;
+        float   flux    = 0.0F;
+
+        if (nullptr == bins)
+        {
+            return false;
+        }
+
+        flux = calculateFlux(bins);
+
+        /* The first spectrum has no predecessor, so its flux is not
+         * considered at all. The threshold needs some history, before
+         * onsets are detected.
+         */
+        if (0U == m_frames)
+        {
+            ++m_frames;
+            flux = 0.0F;
+        }
+        else if (WARM_UP_FRAMES > m_frames)
+        {
+            ++m_frames;
+            m_flux = 0.0F;
+        }
+        else
+        {
+            m_flux      = flux;
+            m_threshold = m_meanFlux + m_sensitivity * m_meanDeviation;
+
+            if (MIN_FLUX > m_threshold)
+            {
+                m_threshold = MIN_FLUX;
+            }
+
+            if ((m_threshold < flux) &&
+                ((0U == m_onsets) || (MIN_ONSET_INTERVAL <= (timestamp - getLastOnsetTimestamp()))))
+            {
+                addOnset(timestamp);
+                isOnset = true;
+            }
+        }
+
+        /* The onset itself raises the threshold, which suppresses multiple
+         * detections of a single onset.
+         */
+        m_meanDeviation += WEIGHT_NEW_VALUE * (fabsf(flux - m_meanFlux) - m_meanDeviation);
+        m_meanFlux      += WEIGHT_NEW_VALUE * (flux - m_meanFlux);
+
+        return isOnset;
+    }
+
+    /**
+     * Get the spectral flux of the last spectrum.
+     *
+     * @return Spectral flux in log2 units per frequency bin
+     */
+    float getFlux() const
+    {
+        return m_flux;
+    }
+
+    /**
+     * Get the threshold, which the spectral flux of the last spectrum was
+     * compared with.
+     *
+     * @return Threshold in log2 units per frequency bin
+     */
+    float getThreshold() const
+    {
+        return m_threshold;
+    }
+
+    /**
+     * Get the strength of the last spectrum, which is the ratio of the
+     * spectral flux to the threshold. An onset has a strength greater than 1.
+     *
+     * @return Strength
+     */
+    float getStrength() const
+    {
+        float strength = 0.0F;
+
+        if (0.0F < m_threshold)
+        {
+            strength = m_flux / m_threshold;
+        }
+
+        return strength;
+    }
+
+    /**
+     * Get the estimated tempo.
+     *
+     * @return Tempo in BPM or 0, if it is unknown.
+     */
+    float getTempo() const
+    {
+        return m_tempo;
+    }
+
+private:
+
+    /** Number of spectra, before onsets are detected. */
+    static const uint32_t   WARM_UP_FRAMES          = 8U;
+
+    /** Weight of the new flux value for the mean and mean deviation. */
+    static constexpr float  WEIGHT_NEW_VALUE        = 0.05F;
+
+    /** Min. flux threshold, which avoids detections in silence. */
+    static constexpr float  MIN_FLUX                = 0.1F;
+
+    /** Min. interval between two onsets in ms. */
+    static const uint32_t   MIN_ONSET_INTERVAL      = 100U;
+
+    /** Number of last onsets, whose intervals are considered for the tempo. */
+    static const uint8_t    ONSET_HISTORY           = 4U;
+
+    /** Resolution of the interval histogram in ms. */
+    static const uint32_t   HISTOGRAM_RESOLUTION    = 10U;
+
+    /** Number of interval histogram bins. */
+    static const uint32_t   HISTOGRAM_SIZE          = (MAX_BEAT_INTERVAL - MIN_BEAT_INTERVAL) / HISTOGRAM_RESOLUTION + 1U;
+
+    /** The weight of the interval histogram is kept with every onset. */
+    static constexpr float  HISTOGRAM_DECAY         = 0.9F;
+
+    /** Min. weight of the interval histogram maximum for a tempo estimation. */
+    static constexpr float  MIN_TEMPO_WEIGHT        = 2.0F;
+
+    float       m_sensitivity;                          /**< Factor of the mean deviation above the mean flux. */
+    float       m_prevLogMagnitudes[TBins];             /**< Log. magnitudes of the previous spectrum. */
+    uint32_t    m_frames;                               /**< Number of processed spectra during warm up. */
+    float       m_flux;                                 /**< Spectral flux of the last spectrum. */
+    float       m_meanFlux;                             /**< Mean spectral flux. */
+    float       m_meanDeviation;                        /**< Mean deviation of the spectral flux. */
+    float       m_threshold;                            /**< Threshold of the last spectrum. */
+    uint32_t    m_onsetTimestamps[ONSET_HISTORY];       /**< Timestamps of the last onsets in ms, as ring buffer. */
+    uint32_t    m_onsets;                               /**< Number of detected onsets. */
+    float       m_intervalHistogram[HISTOGRAM_SIZE];    /**< Weighted histogram of the onset intervals. */
+    float       m_tempo;                                /**< Estimated tempo in BPM. */
+
+    /**
+     * Calculate the spectral flux and remember the log. magnitudes.
+     * The DC bin is never used.
+     *
+     * @param[in] bins  Frequency bins with linear magnitude, TBins values.
+     *
+     * @return Spectral flux
+     */
+    float calculateFlux(const float* bins)
+    {
+        float       flux    = 0.0F;
+        uint32_t    idx     = 0U;
+
+        for(idx = 1U; idx < TBins; ++idx)
+        {
+            /* Only the increase is of interest, because an onset is a
+             * sudden rise of energy.
+             */
+            float logMagnitude  = Decibel::fastLog2(1.0F + bins[idx]);
+            float diff          = logMagnitude - m_prevLogMagnitudes[idx];
+
+            if (0.0F < diff)
+            {
+                flux += diff;
+            }
+
+            m_prevLogMagnitudes[idx] = logMagnitude;
+        }
+
+        return flux / static_cast<float>(TBins - 1U);
+    }
+
+    /**
+     * Get the timestamp of the last onset.
+     *
+     * @return Timestamp in ms
+     */
+    uint32_t getLastOnsetTimestamp() const
+    {
+        return m_onsetTimestamps[(m_onsets - 1U) % ONSET_HISTORY];
+    }
+
+    /**
+     * Add an onset and update the tempo estimation.
+     *
+     * @param[in] timestamp Timestamp of the onset in ms.
+     */
+    void addOnset(uint32_t timestamp)
+    {
+        uint32_t    idx         = 0U;
+        uint32_t    history     = (ONSET_HISTORY < m_onsets) ? ONSET_HISTORY : m_onsets;
+        uint32_t    maxIdx      = 0U;
+
+        for(idx = 0U; idx < HISTOGRAM_SIZE; ++idx)
+        {
+            m_intervalHistogram[idx] *= HISTOGRAM_DECAY;
+        }
+
+        /* Not only the interval to the last onset is considered, because
+         * there may be onsets between the beats.
+         */
+        for(idx = 0U; idx < history; ++idx)
+        {
+            uint32_t interval = timestamp - m_onsetTimestamps[(m_onsets - 1U - idx) % ONSET_HISTORY];
+
+            if ((MIN_BEAT_INTERVAL <= interval) &&
+                (MAX_BEAT_INTERVAL >= interval))
+            {
+                m_intervalHistogram[(interval - MIN_BEAT_INTERVAL) / HISTOGRAM_RESOLUTION] += 1.0F;
+            }
+        }
+
+        m_onsetTimestamps[m_onsets % ONSET_HISTORY] = timestamp;
+        ++m_onsets;
+
+        for(idx = 1U; idx < HISTOGRAM_SIZE; ++idx)
+        {
+            if (m_intervalHistogram[maxIdx] < m_intervalHistogram[idx])
+            {
+                maxIdx = idx;
+            }
+        }
+
+        if (MIN_TEMPO_WEIGHT <= m_intervalHistogram[maxIdx])
+        {
+            m_tempo = 60000.0F / calculateInterval(maxIdx);
+        }
+    }
+
+    /**
+     * Calculate the beat interval as weighted average around the interval
+     * histogram maximum, which is more precise than the histogram resolution.
+     *
+     * @param[in] maxIdx    Index of the interval histogram maximum
+     *
+     * @return Beat interval in ms
+     */
+    float calculateInterval(uint32_t maxIdx) const
+    {
+        float       sum         = 0.0F;
+        float       weights     = 0.0F;
+        uint32_t    idx         = (0U < maxIdx) ? (maxIdx - 1U) : 0U;
+        uint32_t    lastIdx     = ((HISTOGRAM_SIZE - 1U) > maxIdx) ? (maxIdx + 1U) : maxIdx;
+
+        while(lastIdx >= idx)
+        {
+            float center = static_cast<float>(MIN_BEAT_INTERVAL + idx * HISTOGRAM_RESOLUTION) + (static_cast<float>(HISTOGRAM_RESOLUTION) / 2.0F);
+
+            sum     += m_intervalHistogram[idx] * center;
+            weights += m_intervalHistogram[idx];
+
+            ++idx;
+        }
+
+        return sum / weights;
+    }
+
+    OnsetDetector(const OnsetDetector& detector);
+    OnsetDetector& operator=(const OnsetDetector& detector);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* ONSET_DETECTOR_HPP */
+
+/** @} */
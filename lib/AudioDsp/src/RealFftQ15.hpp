@@ -0,0 +1,344 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed-point real FFT
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef REAL_FFT_Q15_HPP
+#define REAL_FFT_Q15_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <math.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fixed-point FFT for real samples, which calculates the single-sided
+ * amplitude spectrum with a hamming window.
+ *
+ * The samples are normalized by the block peak to 14 bit (block floating
+ * point) and transformed in Q15. The real samples are packed into a complex
+ * FFT of half the size, which is split into the real spectrum afterwards.
+ * Every butterfly stage halves the values, therefore no overflow can happen
+ * and the result is already divided by the FFT size.
+ *
+ * The window, twiddle factors and the bit reversal order are calculated once
+ * during construction.
+ *
+ * The result is compatible to the arduinoFFT float calculation with the same
+ * window and the amplitude correction, except that the DC part is corrected
+ * too. The fixed-point resolution limits the dynamic range in a single block
+ * to about 70 dB, which is sufficient for the visualization.
+ *
+ * @tparam TSamples Number of samples, shall be a power of 2 and at least 4.
+ */
+template < uint32_t TSamples >
+class RealFftQ15
+{
+public:
+
+    /** Number of frequency bins, which is half of the samples. */
+    static const uint32_t   BINS    = TSamples / 2U;
+
+    /**
+     * Constructs the FFT and calculates all tables.
+     */
+    RealFftQ15() :
+        m_window(),
+        m_twiddles(),
+        m_bitReversal(),
+        m_data()
+    {
+        initTables();
+    }
+
+    /**
+     * Destroys the FFT.
+     */
+    ~RealFftQ15()
+    {
+    }
+
+    /**
+     * Calculate the single-sided amplitude spectrum.
+     *
+     * @param[in]   samples     Audio samples, TSamples values.
+     * @param[out]  magnitudes  Linear amplitude of every frequency bin, BINS values.
+     */
+    void calculate(const int32_t* samples, float* magnitudes)
+    {
+        int32_t shift = 0;
+
+        if ((nullptr == samples) ||
+            (nullptr == magnitudes))
+        {
+            return;
+        }
+
+        shift = getNormalizationShift(samples);
+
+        load(samples, shift);
+        transform();
+        calculateMagnitudes(magnitudes, shift);
+    }
+
+private:
+
+    /** Size of the complex FFT, which the real samples are packed into. */
+    static const uint32_t   HALF            = TSamples / 2U;
+
+    /** One in Q15 format. */
+    static const int32_t    Q15_ONE         = 32767;
+
+    /** Rounding offset for the Q15 multiplication. */
+    static const int32_t    Q15_ROUND       = 1 << 14;
+
+    /** Q15 fraction bits */
+    static const uint32_t   Q15_SHIFT       = 15U;
+
+    /**
+     * Number of bits the block peak is normalized to. This leaves one bit
+     * headroom for the complex butterflies.
+     */
+    static const int32_t    SAMPLE_BITS     = 14;
+
+    /** Amplitude correction factor of the hamming window. */
+    static constexpr float  WINDOW_FACTOR   = 0.54F;
+
+    /**
+     * A complex value in Q15 format.
+     */
+    struct Complex
+    {
+        int16_t re; /**< Real part */
+        int16_t im; /**< Imaginary part */
+    };
+
+    int16_t     m_window[TSamples / 2U];        /**< First half of the symmetric hamming window in Q15 */
+    Complex     m_twiddles[TSamples / 2U];      /**< Twiddle factors e^(-2 pi i k / TSamples) in Q15 */
+    uint16_t    m_bitReversal[TSamples / 2U];   /**< Bit reversed index of the complex FFT */
+    Complex     m_data[TSamples / 2U];          /**< Complex FFT data */
+
+    RealFftQ15(const RealFftQ15& fft);
+    RealFftQ15& operator=(const RealFftQ15& fft);
+
+    /**
+     * Calculate the window, twiddle factor and bit reversal tables.
+     */
+    void initTables()
+    {
+        const double    FULL_TURN   = 2.0 * M_PI;   /* Not TWO_PI, because Arduino defines it as macro. */
+        uint32_t        idx         = 0U;
+        uint32_t        bits        = 0U;
+
+        while((1U << bits) < HALF)
+        {
+            ++bits;
+        }
+
+        for(idx = 0U; idx < HALF; ++idx)
+        {
+            uint32_t reversed   = 0U;
+            uint32_t bit        = 0U;
+
+            /* Same hamming window as arduinoFFT, which is symmetric to (TSamples - 1) / 2. */
+            m_window[idx]       = static_cast<int16_t>(lround((0.54 - 0.46 * cos(FULL_TURN * idx / (TSamples - 1U))) * Q15_ONE));
+
+            m_twiddles[idx].re  = static_cast<int16_t>(lround(cos(FULL_TURN * idx / TSamples) * Q15_ONE));
+            m_twiddles[idx].im  = static_cast<int16_t>(lround(-sin(FULL_TURN * idx / TSamples) * Q15_ONE));
+
+            for(bit = 0U; bit < bits; ++bit)
+            {
+                reversed |= ((idx >> bit) & 1U) << (bits - 1U - bit);
+            }
+
+            m_bitReversal[idx]  = static_cast<uint16_t>(reversed);
+        }
+    }
+
+    /**
+     * Determine the shift, which normalizes the block peak to SAMPLE_BITS.
+     *
+     * @param[in] samples   Audio samples
+     *
+     * @return Number of bits to shift right. If negative, it shall be shifted left.
+     */
+    int32_t getNormalizationShift(const int32_t* samples) const
+    {
+        uint32_t    peak    = 0U;
+        int32_t     bits    = 0;
+        uint32_t    idx     = 0U;
+
+        for(idx = 0U; idx < TSamples; ++idx)
+        {
+            uint32_t magnitude = (0 > samples[idx]) ? (0U - static_cast<uint32_t>(samples[idx])) : static_cast<uint32_t>(samples[idx]);
+
+            if (peak < magnitude)
+            {
+                peak = magnitude;
+            }
+        }
+
+        while(0U != peak)
+        {
+            ++bits;
+            peak >>= 1U;
+        }
+
+        /* A silent block needs no normalization. */
+        return (0 == bits) ? 0 : (bits - SAMPLE_BITS);
+    }
+
+    /**
+     * Normalize and window the samples and pack them in bit reversed order
+     * into the complex FFT data. Even samples are the real part and odd
+     * samples the imaginary part.
+     *
+     * @param[in] samples   Audio samples
+     * @param[in] shift     Normalization shift, see getNormalizationShift().
+     */
+    void load(const int32_t* samples, int32_t shift)
+    {
+        uint32_t idx = 0U;
+
+        for(idx = 0U; idx < TSamples; ++idx)
+        {
+            int32_t     value   = (0 <= shift) ? (samples[idx] >> shift) : (samples[idx] * (1 << -shift));
+            int32_t     weight  = m_window[(HALF > idx) ? idx : (TSamples - 1U - idx)];
+            Complex&    dst     = m_data[m_bitReversal[idx >> 1U]];
+
+            value = (value * weight + Q15_ROUND) >> Q15_SHIFT;
+
+            if (0U == (idx & 1U))
+            {
+                dst.re = static_cast<int16_t>(value);
+            }
+            else
+            {
+                dst.im = static_cast<int16_t>(value);
+            }
+        }
+    }
+
+    /**
+     * Radix-2 decimation in time FFT over the complex data, which is expected
+     * in bit reversed order. Every stage halves the values.
+     */
+    void transform()
+    {
+        uint32_t half = 0U;
+
+        for(half = 1U; half < HALF; half <<= 1U)
+        {
+            uint32_t    stride  = HALF / half;
+            uint32_t    base    = 0U;
+
+            for(base = 0U; base < HALF; base += 2U * half)
+            {
+                uint32_t idx = 0U;
+
+                for(idx = 0U; idx < half; ++idx)
+                {
+                    const Complex&  twiddle = m_twiddles[idx * stride];
+                    Complex&        even    = m_data[base + idx];
+                    Complex&        odd     = m_data[base + idx + half];
+                    int32_t         tRe     = (odd.re * twiddle.re - odd.im * twiddle.im + Q15_ROUND) >> Q15_SHIFT;
+                    int32_t         tIm     = (odd.re * twiddle.im + odd.im * twiddle.re + Q15_ROUND) >> Q15_SHIFT;
+                    int32_t         eRe     = even.re;
+                    int32_t         eIm     = even.im;
+
+                    even.re = static_cast<int16_t>((eRe + tRe) >> 1);
+                    even.im = static_cast<int16_t>((eIm + tIm) >> 1);
+                    odd.re  = static_cast<int16_t>((eRe - tRe) >> 1);
+                    odd.im  = static_cast<int16_t>((eIm - tIm) >> 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * Split the complex FFT result into the spectrum of the real samples and
+     * calculate the corrected amplitude of every frequency bin.
+     *
+     * @param[out]  magnitudes  Linear amplitude of every frequency bin
+     * @param[in]   shift       Normalization shift, see getNormalizationShift().
+     */
+    void calculateMagnitudes(float* magnitudes, int32_t shift) const
+    {
+        /* The even and odd spectrum are calculated doubled and the FFT is
+         * already divided by HALF. Together with the single-sided spectrum
+         * correction, only the window correction and the normalization
+         * remain.
+         */
+        const float scale   = ldexpf(1.0F / (2.0F * WINDOW_FACTOR), shift);
+        uint32_t    idx     = 0U;
+
+        for(idx = 0U; idx < HALF; ++idx)
+        {
+            const Complex&  z       = m_data[idx];
+            const Complex&  zMirror = m_data[(HALF - idx) & (HALF - 1U)];
+            const Complex&  twiddle = m_twiddles[idx];
+            int32_t         evenRe  = z.re + zMirror.re;
+            int32_t         evenIm  = z.im - zMirror.im;
+            int32_t         oddRe   = z.im + zMirror.im;
+            int32_t         oddIm   = zMirror.re - z.re;
+            float           re      = static_cast<float>(evenRe + ((twiddle.re * oddRe - twiddle.im * oddIm + Q15_ROUND) >> Q15_SHIFT));
+            float           im      = static_cast<float>(evenIm + ((twiddle.re * oddIm + twiddle.im * oddRe + Q15_ROUND) >> Q15_SHIFT));
+
+            magnitudes[idx] = sqrtf(re * re + im * im) * scale;
+        }
+
+        /* The DC part exists only once in the two-sided spectrum. */
+        magnitudes[0] *= 0.5F;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* REAL_FFT_Q15_HPP */
+
+/** @} */
@@ -0,0 +1,263 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free sample ring buffer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef SAMPLE_RING_BUFFER_HPP
+#define SAMPLE_RING_BUFFER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lock-free ring buffer for audio samples with a single producer and a
+ * single consumer.
+ *
+ * The producer only changes the write index and the consumer only the read
+ * index. Both indices run free and are wrapped by the buffer size on access,
+ * therefore the whole buffer can be used. If the buffer is full, the producer
+ * drops the new samples and counts them, which never blocks the producer.
+ * The consumer detects it with resync(), before it reads the next window.
+ *
+ * The consumer can read a window without removing it and afterwards remove
+ * only a part of it, which results in overlapping windows.
+ *
+ * @tparam TSize    Buffer size in number of samples, shall be a power of 2.
+ */
+template < uint32_t TSize >
+class SampleRingBuffer
+{
+public:
+
+    /** Buffer size in number of samples. */
+    static const uint32_t   SIZE    = TSize;
+
+    /**
+     * Constructs an empty ring buffer.
+     */
+    SampleRingBuffer() :
+        m_buffer(),
+        m_writeIdx(0U),
+        m_readIdx(0U),
+        m_droppedSamples(0U)
+    {
+        static_assert(0U == (TSize & (TSize - 1U)), "The size must be a power of 2.");
+    }
+
+    /**
+     * Destroys the ring buffer.
+     */
+    ~SampleRingBuffer()
+    {
+    }
+
+    /**
+     * Write samples. Only the producer shall call it.
+     * If there is not enough space, the remaining samples are dropped.
+     *
+     * @param[in] samples   Samples
+     * @param[in] count     Number of samples
+     *
+     * @return Number of written samples.
+     */
+    uint32_t write(const int32_t* samples, uint32_t count)
+    {
+        uint32_t writeIdx   = m_writeIdx.load(std::memory_order_relaxed);
+        uint32_t readIdx    = m_readIdx.load(std::memory_order_acquire);
+        uint32_t space      = TSize - (writeIdx - readIdx);
+        uint32_t idx        = 0U;
+
+        if (nullptr == samples)
+        {
+            return 0U;
+        }
+
+        if (space < count)
+        {
+            m_droppedSamples.fetch_add(count - space, std::memory_order_relaxed);
+            count = space;
+        }
+
+        for(idx = 0U; idx < count; ++idx)
+        {
+            m_buffer[(writeIdx + idx) & MASK] = samples[idx];
+        }
+
+        /* Publish the samples after they are written. */
+        m_writeIdx.store(writeIdx + count, std::memory_order_release);
+
+        return count;
+    }
+
+    /**
+     * Get the number of samples, which are available for reading.
+     * Only the consumer shall rely on it.
+     *
+     * @return Number of available samples.
+     */
+    uint32_t available() const
+    {
+        return m_writeIdx.load(std::memory_order_acquire) - m_readIdx.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Read samples without removing them. Only the consumer shall call it.
+     *
+     * @param[out]  samples Sample buffer
+     * @param[in]   count   Number of samples, which to read.
+     *
+     * @return If the number of samples is available, it will return true otherwise false.
+     */
+    bool peek(int32_t* samples, uint32_t count) const
+    {
+        bool isSuccessful = false;
+
+        if ((nullptr != samples) &&
+            (count <= available()))
+        {
+            uint32_t readIdx    = m_readIdx.load(std::memory_order_relaxed);
+            uint32_t idx        = 0U;
+
+            for(idx = 0U; idx < count; ++idx)
+            {
+                samples[idx] = m_buffer[(readIdx + idx) & MASK];
+            }
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Remove samples. Only the consumer shall call it.
+     *
+     * @param[in] count Number of samples, which to remove.
+     *
+     * @return Number of removed samples.
+     */
+    uint32_t skip(uint32_t count)
+    {
+        uint32_t availableSamples = available();
+
+        if (availableSamples < count)
+        {
+            count = availableSamples;
+        }
+
+        /* Release the space after the samples are read. */
+        m_readIdx.store(m_readIdx.load(std::memory_order_relaxed) + count, std::memory_order_release);
+
+        return count;
+    }
+
+    /**
+     * Get the number of samples, which were dropped because of a full
+     * buffer and reset it.
+     *
+     * @return Number of dropped samples.
+     */
+    uint32_t getDroppedSamples()
+    {
+        return m_droppedSamples.exchange(0U, std::memory_order_relaxed);
+    }
+
+    /**
+     * Resynchronize the consumer after the producer dropped samples.
+     * The buffered samples are removed, because the samples, which the
+     * producer writes after the drop, are not continuous to them.
+     * Only the consumer shall call it.
+     *
+     * @param[out] removedSamples   Number of removed samples.
+     *
+     * @return Number of dropped samples. If 0, nothing was dropped and removed.
+     */
+    uint32_t resync(uint32_t& removedSamples)
+    {
+        uint32_t droppedSamples = getDroppedSamples();
+
+        removedSamples = 0U;
+
+        if (0U < droppedSamples)
+        {
+            removedSamples = skip(available());
+        }
+
+        return droppedSamples;
+    }
+
+    /**
+     * Remove all samples. The producer must not write at the same time.
+     */
+    void clear()
+    {
+        m_readIdx.store(m_writeIdx.load(std::memory_order_acquire), std::memory_order_release);
+        m_droppedSamples.store(0U, std::memory_order_relaxed);
+    }
+
+private:
+
+    /** Mask to wrap the free running indices. */
+    static const uint32_t   MASK    = TSize - 1U;
+
+    int32_t                 m_buffer[TSize];    /**< Sample buffer */
+    std::atomic<uint32_t>   m_writeIdx;         /**< Free running write index, only changed by the producer. */
+    std::atomic<uint32_t>   m_readIdx;          /**< Free running read index, only changed by the consumer. */
+    std::atomic<uint32_t>   m_droppedSamples;   /**< Number of dropped samples since last request. */
+
+    SampleRingBuffer(const SampleRingBuffer& buffer);
+    SampleRingBuffer& operator=(const SampleRingBuffer& buffer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* SAMPLE_RING_BUFFER_HPP */
+
+/** @} */
@@ -0,0 +1,243 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free double buffer with sequence counter
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef SEQ_LOCK_BUFFER_HPP
+#define SEQ_LOCK_BUFFER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lock-free publication of data from a single writer to several readers,
+ * seqlock style with two buffers.
+ *
+ * The writer fills always the buffer, which is not published and publishes
+ * it afterwards by incrementing the sequence counter. The readers access the
+ * published buffer directly, without locking and without copying. A reader
+ * can afterwards check whether the writer started to overwrite the buffer
+ * in the meantime, which happens only if the reader is slower than two
+ * publications.
+ *
+ * @tparam TData    Data type, which to publish.
+ */
+template < typename TData >
+class SeqLockBuffer
+{
+public:
+
+    /**
+     * Constructs the buffer without any published data.
+     */
+    SeqLockBuffer() :
+        m_buffers(),
+        m_published(0U),
+        m_writeStarted(0U)
+    {
+    }
+
+    /**
+     * Destroys the buffer.
+     */
+    ~SeqLockBuffer()
+    {
+    }
+
+    /**
+     * Get the buffer, which to fill with the next data.
+     * Only the writer shall call it and call publish() afterwards.
+     *
+     * @return Write buffer
+     */
+    TData& beginWrite()
+    {
+        uint32_t next = m_published.load(std::memory_order_relaxed) + 1U;
+
+        /* Announce the write before the buffer is changed. */
+        m_writeStarted.store(next, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        return m_buffers[next & 1U];
+    }
+
+    /**
+     * Publish the buffer, which was filled after beginWrite().
+     */
+    void publish()
+    {
+        m_published.store(m_writeStarted.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    /**
+     * Get the sequence number of the published data. It is incremented by
+     * every publication and 0 as long as nothing is published.
+     *
+     * @return Sequence number
+     */
+    uint32_t getSequence() const
+    {
+        return m_published.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get direct access to the latest published data.
+     * After the data is used, endRead() shall be called to check whether
+     * the data was consistent.
+     *
+     * @param[out] sequence Sequence number of the data.
+     *
+     * @return Published data or nullptr if nothing is published yet.
+     */
+    const TData* beginRead(uint32_t& sequence) const
+    {
+        const TData* data = nullptr;
+
+        sequence = m_published.load(std::memory_order_acquire);
+
+        if (0U < sequence)
+        {
+            data = &m_buffers[sequence & 1U];
+        }
+
+        return data;
+    }
+
+    /**
+     * Check whether the data, which was accessed by beginRead() was not
+     * changed by the writer in the meantime.
+     *
+     * @param[in] sequence  Sequence number of the data, see beginRead().
+     *
+     * @return If the data is consistent, it will return true otherwise false.
+     */
+    bool endRead(uint32_t sequence) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        /* The buffer is overwritten by the second write after it. */
+        return (m_writeStarted.load(std::memory_order_relaxed) - sequence) < 2U;
+    }
+
+    /**
+     * Read a consistent copy of the latest published data.
+     *
+     * @param[out]  data        Data
+     * @param[out]  sequence    Sequence number of the data.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool read(TData& data, uint32_t& sequence) const
+    {
+        return read(
+            [&data](const TData& published) -> bool
+            {
+                data = published;
+
+                return true;
+            },
+            sequence);
+    }
+
+    /**
+     * Read the latest published data with a reader, which copies only the
+     * parts it needs. The reader is called again, if the writer changed
+     * the data in the meantime.
+     *
+     * @tparam TReader Function object with the signature bool(const TData&).
+     *                 It returns false, if the data can not be used.
+     *
+     * @param[in]   reader      Reader
+     * @param[out]  sequence    Sequence number of the data.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    template < typename TReader >
+    bool read(TReader reader, uint32_t& sequence) const
+    {
+        bool        isSuccessful    = false;
+        uint8_t     retries         = MAX_RETRIES;
+
+        while((false == isSuccessful) && (0U < retries))
+        {
+            const TData* published = beginRead(sequence);
+
+            if ((nullptr == published) ||
+                (false == reader(*published)))
+            {
+                break;
+            }
+
+            isSuccessful = endRead(sequence);
+
+            --retries;
+        }
+
+        return isSuccessful;
+    }
+
+private:
+
+    /** Max. number of read retries, if the writer overwrites the data. */
+    static const uint8_t    MAX_RETRIES = 3U;
+
+    TData                   m_buffers[2U];  /**< The published and the write buffer. */
+    std::atomic<uint32_t>   m_published;    /**< Number of publications, selects the published buffer. */
+    std::atomic<uint32_t>   m_writeStarted; /**< Number of started writes, selects the write buffer. */
+
+    SeqLockBuffer(const SeqLockBuffer& buffer);
+    SeqLockBuffer& operator=(const SeqLockBuffer& buffer);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* SEQ_LOCK_BUFFER_HPP */
+
+/** @} */
@@ -90,16 +90,21 @@ bool AudioDrv::start()
         }
         else
         {
-            /* Clear sample write index before the task will start.
-             * Otherwise it may happen that the first buffer of the
-             * observers will be filled partly.
+            /* Clear the ring buffer before the tasks will start.
+             * Otherwise it may happen that the first window of the
+             * observers contains old samples.
              */
-            m_sampleWriteIndex = 0U;
+            m_ringBuffer.clear();
 
-            /* Create binary semaphore to signal task exit. */
-            m_xSemaphore = xSemaphoreCreateBinary();
+            m_windowInfo.samplePos      = 0U;
+            m_windowInfo.isContinuous   = false;
 
-            if (nullptr == m_xSemaphore)
+            /* Create binary semaphores to signal task exit. */
+            m_xSemaphore        = xSemaphoreCreateBinary();
+            m_observerSemaphore = xSemaphoreCreateBinary();
+
+            if ((nullptr == m_xSemaphore) ||
+                (nullptr == m_observerSemaphore))
             {
                 isSuccessful = false;
             }
@@ -110,19 +115,51 @@ bool AudioDrv::start()
                 /* Task shall run */
                 m_taskExit = false;
 
-                osRet = xTaskCreateUniversal(   processTask,
-                                                "audioDrvTask",
-                                                TASK_STACK_SIZE,
+                /* The observer task must be up, before the driver task
+                 * notifies it.
+                 */
+                osRet = xTaskCreateUniversal(   observerTask,
+                                                "audioObsTask",
+                                                OBSERVER_TASK_STACK_SIZE,
                                                 this,
-                                                TASK_PRIORITY,
-                                                &m_taskHandle,
-                                                TASK_RUN_CORE);
+                                                OBSERVER_TASK_PRIORITY,
+                                                &m_observerTaskHandle,
+                                                OBSERVER_TASK_RUN_CORE);
 
                 /* Task successful created? */
-                if (pdPASS == osRet)
+                if (pdPASS != osRet)
                 {
-                    (void)xSemaphoreGive(m_xSemaphore);
-                    isSuccessful = true;
+                    m_observerTaskHandle = nullptr;
+                    isSuccessful = false;
+                }
+                else
+                {
+                    (void)xSemaphoreGive(m_observerSemaphore);
+
+                    osRet = xTaskCreateUniversal(   processTask,
+                                                    "audioDrvTask",
+                                                    TASK_STACK_SIZE,
+                                                    this,
+                                                    TASK_PRIORITY,
+                                                    &m_taskHandle,
+                                                    TASK_RUN_CORE);
+
+                    /* Task successful created? */
+                    if (pdPASS == osRet)
+                    {
+                        (void)xSemaphoreGive(m_xSemaphore);
+                        isSuccessful = true;
+                    }
+                    else
+                    {
+                        m_taskHandle = nullptr;
+                        isSuccessful = false;
+
+                        /* Join observer task */
+                        m_taskExit = true;
+                        (void)xSemaphoreTake(m_observerSemaphore, portMAX_DELAY);
+                        m_observerTaskHandle = nullptr;
+                    }
                 }
             }
         }
@@ -136,6 +173,12 @@ bool AudioDrv::start()
                 m_xSemaphore = nullptr;
             }
 
+            if (nullptr != m_observerSemaphore)
+            {
+                vSemaphoreDelete(m_observerSemaphore);
+                m_observerSemaphore = nullptr;
+            }
+
             m_mutex.destroy();
         }
         else
@@ -155,15 +198,20 @@ void AudioDrv::stop()
 
         /* Join */
         (void)xSemaphoreTake(m_xSemaphore, portMAX_DELAY);
+        (void)xSemaphoreTake(m_observerSemaphore, portMAX_DELAY);
 
         LOG_INFO("Audio driver task is down.");
 
         vSemaphoreDelete(m_xSemaphore);
         m_xSemaphore = nullptr;
 
+        vSemaphoreDelete(m_observerSemaphore);
+        m_observerSemaphore = nullptr;
+
         m_mutex.destroy();
 
-        m_taskHandle = nullptr;
+        m_taskHandle            = nullptr;
+        m_observerTaskHandle    = nullptr;
     }
 }
 
@@ -219,54 +267,40 @@ void AudioDrv::process()
         /* One DMA block finished? */
         else if (I2S_EVENT_RX_DONE == i2sEvt.type)
         {
-            uint16_t            sampleIdx       = 0U;
-            MutexGuard<Mutex>   guard(m_mutex);
+            int32_t samples[SAMPLES_PER_DMA_BLOCK];    /* Attention, this datatype must correlate to the configuration, see bits per sample! */
+            size_t  bytesRead   = 0;
+            size_t  count       = 0U;
+            size_t  sampleIdx   = 0U;
 
             /* Read the whole DMA block. */
-            for(sampleIdx = 0U; sampleIdx < SAMPLES_PER_DMA_BLOCK; ++sampleIdx)
-            {
-                int32_t sample      = 0U;   /* Attention, this datatype must correlate to the configuration, see bits per sample! */
-                size_t  bytesRead   = 0;
+            (void)i2s_read(I2S_PORT, samples, sizeof(samples), &bytesRead, portMAX_DELAY);
 
-                (void)i2s_read(I2S_PORT, &sample, sizeof(sample), &bytesRead, portMAX_DELAY);
+            count = bytesRead / sizeof(samples[0]);
 
-                if (sizeof(sample) == bytesRead)
-                {
-                    /* Down shift to get the real value. */
-                    sample >>= I2S_SAMPLE_SHIFT;
-
-                    m_sampleBuffer[m_sampleWriteIndex] = sample;
-                    ++m_sampleWriteIndex;
+            for(sampleIdx = 0U; sampleIdx < count; ++sampleIdx)
+            {
+                /* Down shift to get the real value. */
+                samples[sampleIdx] >>= I2S_SAMPLE_SHIFT;
 
-                    /* Check for ext. microphone */
-                    if (false == m_isMicAvailable)
+                /* Check for ext. microphone */
+                if (false == m_isMicAvailable)
+                {
+                    if (0 != samples[sampleIdx])
                     {
-                        if (0 != sample)
-                        {
-                            m_isMicAvailable = true;
-                        }
+                        m_isMicAvailable = true;
                     }
+                }
+            }
 
-                    /* All samples read? */
-                    if (SAMPLES <= m_sampleWriteIndex)
-                    {
-                        uint32_t observerIndex = 0U;
-
-                        m_sampleWriteIndex = 0U;
-
-                        while(observerIndex < MAX_OBSERVERS)
-                        {
-                            IAudioObserver* observer = m_observers[observerIndex];
-
-                            if (nullptr != observer)
-                            {
-                                observer->notify(m_sampleBuffer, SAMPLES);
-                            }
+            /* The ring buffer never blocks. If the observers are too slow,
+             * the samples are dropped.
+             */
+            (void)m_ringBuffer.write(samples, count);
 
-                            ++observerIndex;
-                        }
-                    }
-                }
+            /* A complete window is available? */
+            if (SAMPLES <= m_ringBuffer.available())
+            {
+                (void)xTaskNotifyGive(m_observerTaskHandle);
             }
         }
         else
@@ -277,6 +311,77 @@ void AudioDrv::process()
     }
 }
 
+void AudioDrv::observerTask(void* parameters)
+{
+    AudioDrv* tthis = reinterpret_cast<AudioDrv*>(parameters);
+
+    if ((nullptr != tthis) &&
+        (nullptr != tthis->m_observerSemaphore))
+    {
+        (void)xSemaphoreTake(tthis->m_observerSemaphore, portMAX_DELAY);
+
+        while(false == tthis->m_taskExit)
+        {
+            tthis->processObservers();
+        }
+
+        (void)xSemaphoreGive(tthis->m_observerSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void AudioDrv::processObservers()
+{
+    /* Wait until the driver task signals a complete window. */
+    if (0U < ulTaskNotifyTake(pdTRUE, OBSERVER_TASK_TIMEOUT * portTICK_PERIOD_MS))
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+
+        /* Provide every available window, each shifted by the hop size.
+         * Before every window, it is checked whether samples were dropped.
+         */
+        resync();
+
+        while(true == m_ringBuffer.peek(m_sampleBuffer, SAMPLES))
+        {
+            uint32_t observerIndex = 0U;
+
+            while(observerIndex < MAX_OBSERVERS)
+            {
+                IAudioObserver* observer = m_observers[observerIndex];
+
+                if (nullptr != observer)
+                {
+                    observer->notify(m_sampleBuffer, SAMPLES, m_windowInfo);
+                }
+
+                ++observerIndex;
+            }
+
+            m_windowInfo.samplePos      += m_ringBuffer.skip(m_hopSize);
+            m_windowInfo.isContinuous   = true;
+
+            resync();
+        }
+    }
+}
+
+void AudioDrv::resync()
+{
+    uint32_t removedSamples = 0U;
+    uint32_t droppedSamples = m_ringBuffer.resync(removedSamples);
+
+    if (0U < droppedSamples)
+    {
+        /* The position keeps track of the real time, therefore the dropped samples count too. */
+        m_windowInfo.samplePos      += static_cast<uint64_t>(removedSamples) + droppedSamples;
+        m_windowInfo.isContinuous   = false;
+
+        LOG_WARNING("%u audio samples dropped, %u discarded.", droppedSamples, removedSamples);
+    }
+}
+
 bool AudioDrv::initI2S()
 {
     bool                isSuccessful    = false;
@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <driver/i2s.h>
 #include <Mutex.hpp>
+#include <SampleRingBuffer.hpp>
 
 /******************************************************************************
  * Compiler Switches
@@ -55,6 +56,15 @@
  * Types and Classes
  *****************************************************************************/
 
+/**
+ * Information about a sample window, which is provided to the audio observers.
+ */
+struct AudioWindowInfo
+{
+    uint64_t    samplePos;      /**< Position of the first window sample since the driver start, including the dropped samples. */
+    bool        isContinuous;   /**< Are the samples continuous to the previous window? It is false after samples were dropped. */
+};
+
 /**
  * The audio observer will be notified for every complete number of available
  * samples.
@@ -76,8 +86,9 @@ public:
      * 
      * @param[in]   data    Audio sample data buffer
      * @param[in]   size    Number of audio samples
+     * @param[in]   info    Information about the sample window
      */
-    virtual void notify(int32_t* data, size_t size) = 0;
+    virtual void notify(int32_t* data, size_t size, const AudioWindowInfo& info) = 0;
 
 protected:
 
@@ -93,6 +104,15 @@ protected:
 /**
  * The audio driver supports the I2S interface. It will configure the DMA
  * for receicing samples and provides them.
+ * 
+ * The driver task only drains the DMA blocks into a lock-free ring buffer.
+ * The observers are notified by a separate task with overlapping windows of
+ * SAMPLES samples, which are shifted by the hop size. This way a slow
+ * observer doesn't delay the DMA handling.
+ * 
+ * If the observers are too slow, samples are dropped. The buffered samples
+ * are discarded then too and the next window is marked as not continuous,
+ * so no window spans the gap.
  */
 class AudioDrv
 {
@@ -173,6 +193,44 @@ public:
         }
     }
 
+    /**
+     * Get the hop size, which is the number of samples the window is shifted
+     * between two observer notifications.
+     * 
+     * @return Hop size in number of samples
+     */
+    uint32_t getHopSize() const
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        return m_hopSize;
+    }
+
+    /**
+     * Set the hop size, which is the number of samples the window is shifted
+     * between two observer notifications. A hop size of SAMPLES / 2 results
+     * in 50% overlap, a hop size of SAMPLES / 4 in 75% overlap.
+     * 
+     * @param[in] hopSize   Hop size in number of samples [1; SAMPLES]
+     * 
+     * @return If successful set, it will return true otherwise false.
+     */
+    bool setHopSize(uint32_t hopSize)
+    {
+        bool isSuccessful = false;
+
+        if ((0U < hopSize) &&
+            (SAMPLES >= hopSize))
+        {
+            MutexGuard<Mutex> guard(m_mutex);
+
+            m_hopSize       = hopSize;
+            isSuccessful    = true;
+        }
+
+        return isSuccessful;
+    }
+
     /**
      * The sample rate in Hz. According to the Nyquist theorem, it shall be
      * twice as the max. audio frequency, which to support.
@@ -184,6 +242,11 @@ public:
      */
     static const uint32_t               SAMPLES                 = 512U;
 
+    /**
+     * The default hop size in number of samples, which results in 50% overlap.
+     */
+    static const uint32_t               HOP_SIZE_DEFAULT        = SAMPLES / 2U;
+
 private:
 
     /** Task stack size in bytes */
@@ -192,8 +255,26 @@ private:
     /** MCU core where the task shall run */
     static const BaseType_t             TASK_RUN_CORE           = PRO_CPU_NUM;
 
-    /** Task priority. */
-    static const UBaseType_t            TASK_PRIORITY           = 1U;
+    /** Task priority. It is higher than the observer task, to drain the DMA in time. */
+    static const UBaseType_t            TASK_PRIORITY           = 2U;
+
+    /** Observer task stack size in bytes */
+    static const uint32_t               OBSERVER_TASK_STACK_SIZE = 8096U;
+
+    /** MCU core where the observer task shall run */
+    static const BaseType_t             OBSERVER_TASK_RUN_CORE  = PRO_CPU_NUM;
+
+    /** Observer task priority. */
+    static const UBaseType_t            OBSERVER_TASK_PRIORITY  = 1U;
+
+    /** Max. time in ms the observer task waits for samples, before it checks for exit. */
+    static const uint32_t               OBSERVER_TASK_TIMEOUT   = 100U;
+
+    /**
+     * Ring buffer size in number of samples. It buffers one window and the
+     * samples, which are received while the observers are processing.
+     */
+    static const uint32_t               RING_BUFFER_SIZE        = 2U * SAMPLES;
 
     /**
      * The I2S port, which to use for the audio input.
@@ -248,14 +329,23 @@ private:
      */
     static const uint32_t               MAX_OBSERVERS           = 3U;
 
+    /**
+     * Ring buffer type between the driver task and the observer task.
+     */
+    typedef SampleRingBuffer<RING_BUFFER_SIZE> RingBuffer;
+
     mutable Mutex       m_mutex;                    /**< Mutex used for concurrent access protection. */
     TaskHandle_t        m_taskHandle;               /**< Task handle */
-    bool                m_taskExit;                 /**< Flag to signal the task to exit. */
+    volatile bool       m_taskExit;                 /**< Flag to signal the tasks to exit. */
     SemaphoreHandle_t   m_xSemaphore;               /**< Binary semaphore used to signal the task exit. */
+    TaskHandle_t        m_observerTaskHandle;       /**< Observer task handle */
+    SemaphoreHandle_t   m_observerSemaphore;        /**< Binary semaphore used to signal the observer task exit. */
     QueueHandle_t       m_i2sEventQueueHandle;      /**< The I2S event queue handle, used for rx done notification. Note, the queue is created by I2S driver. */
     bool                m_isMicAvailable;           /**< Is a microphone as input device available? */
-    int32_t             m_sampleBuffer[SAMPLES];    /**< Sample buffer */
-    uint16_t            m_sampleWriteIndex;         /**< The current sample write index to the input buffer. */
+    RingBuffer          m_ringBuffer;               /**< Lock-free ring buffer from the driver task to the observer task. */
+    int32_t             m_sampleBuffer[SAMPLES];    /**< Sample window, which is provided to the observers. */
+    uint32_t            m_hopSize;                  /**< Number of samples the window is shifted per notification. */
+    AudioWindowInfo     m_windowInfo;               /**< Information about the next sample window. */
     IAudioObserver*     m_observers[MAX_OBSERVERS]; /**< A list of registered audio observers. */
 
     /**
@@ -266,10 +356,14 @@ private:
         m_taskHandle(nullptr),
         m_taskExit(false),
         m_xSemaphore(nullptr),
+        m_observerTaskHandle(nullptr),
+        m_observerSemaphore(nullptr),
         m_i2sEventQueueHandle(nullptr),
         m_isMicAvailable(false),
+        m_ringBuffer(),
         m_sampleBuffer(),
-        m_sampleWriteIndex(0U),
+        m_hopSize(HOP_SIZE_DEFAULT),
+        m_windowInfo(),
         m_observers()
     {
     }
@@ -297,6 +391,24 @@ private:
      */
     void process();
 
+    /**
+     * Observer task, which notifies the observers.
+     *
+     * @param[in]   parameters  Task pParameters
+     */
+    static void observerTask(void* parameters);
+
+    /**
+     * Notify the observers about all available sample windows.
+     */
+    void processObservers();
+
+    /**
+     * Resynchronize to the newest samples, if samples were dropped.
+     * The next window is marked as not continuous then.
+     */
+    void resync();
+
     /**
      * Setup the I2S driver.
      * 
@@ -73,25 +73,23 @@ bool AudioService::start()
     }
     else
     {
+        /* The beat detection shall not consider the spectra before the restart. */
+        m_beatDetector.reset();
+        m_spectrumAnalyzer.setObserver(&m_beatDetector);
+
         if (false == audioDrv.registerObserver(m_spectrumAnalyzer))
         {
             LOG_ERROR("Couldn't register spectrum analyzer.");
             isSuccessful = false;
         }
+        else if (false == audioDrv.registerObserver(m_audioToneDetector))
+        {
+            LOG_ERROR("Couldn't register audio tone detector.");
+            isSuccessful = false;
+        }
         else
         {
-            uint8_t idx = 0U;
-            
-            while(MAX_TONE_DETECTORS > idx)
-            {
-                if (false == audioDrv.registerObserver(m_audioToneDetector[idx]))
-                {
-                    LOG_ERROR("Couldn't register audio tone detector (%u).", idx);
-                    isSuccessful = false;
-                }
-
-                ++idx;
-            }
+            ;
         }
 
         if (false == isSuccessful)
@@ -110,16 +108,10 @@ bool AudioService::start()
 void AudioService::stop()
 {
     AudioDrv&   audioDrv    = AudioDrv::getInstance();
-    uint8_t     idx         = 0U;
 
     audioDrv.unregisterObserver(m_spectrumAnalyzer);
-
-    while(MAX_TONE_DETECTORS > idx)
-    {
-        audioDrv.unregisterObserver(m_audioToneDetector[idx]);
-
-        ++idx;
-    }
+    audioDrv.unregisterObserver(m_audioToneDetector);
+    m_spectrumAnalyzer.setObserver(nullptr);
 
     AudioDrv::getInstance().stop();
 
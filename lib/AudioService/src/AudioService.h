@@ -44,6 +44,7 @@
 #include "AudioDrv.h"
 #include "SpectrumAnalyzer.h"
 #include "AudioToneDetector.h"
+#include "BeatDetector.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -102,34 +103,32 @@ public:
     }
 
     /**
-     * Get the audio tone detector.
-     * 
-     * @param[in] id    Tone detector id
+     * Get the audio tone detector. It detects up to
+     * AudioToneDetector::MAX_TONES tones at once.
      * 
      * @return Tone detector instance otherwise nullptr
      */
-    AudioToneDetector* getAudioToneDetector(uint8_t id)
+    AudioToneDetector* getAudioToneDetector()
     {
-        AudioToneDetector* instance = nullptr;
-
-        if (MAX_TONE_DETECTORS > id)
-        {
-            instance = &m_audioToneDetector[id];
-        }
-
-        return instance;
+        return &m_audioToneDetector;
     }
 
     /**
-     * The max. number of tone detectors, which the service
-     * can provide.
+     * Get the beat detector. It works on the spectrum of the spectrum
+     * analyzer.
+     * 
+     * @return Beat detector instance otherwise nullptr
      */
-    static const uint8_t    MAX_TONE_DETECTORS  = 2U;
+    BeatDetector* getBeatDetector()
+    {
+        return &m_beatDetector;
+    }
 
 private:
 
     SpectrumAnalyzer    m_spectrumAnalyzer;
-    AudioToneDetector   m_audioToneDetector[MAX_TONE_DETECTORS];
+    AudioToneDetector   m_audioToneDetector;
+    BeatDetector        m_beatDetector;
 
     AudioService(const AudioService& drv);
     AudioService& operator=(const AudioService& drv);
@@ -140,7 +139,8 @@ private:
     AudioService() :
         IService(),
         m_spectrumAnalyzer(),
-        m_audioToneDetector()
+        m_audioToneDetector(),
+        m_beatDetector()
     {
     }
 
@@ -33,7 +33,6 @@
  * Includes
  *****************************************************************************/
 #include "AudioToneDetector.h"
-#include <math.h>
 #include <Logging.h>
 
 /******************************************************************************
@@ -60,104 +59,200 @@
  * Public Methods
  *****************************************************************************/
 
-void AudioToneDetector::notify(int32_t* data, size_t size)
+float AudioToneDetector::getTargetFreq(uint8_t toneId) const
 {
-    /* If the target frequency is around 0 Hz, no calculation takes place. */
-    if (((EPSILON < m_targetFreq) || (-EPSILON > m_targetFreq)) &&
-        (nullptr != data))
-    {
-        size_t  index           = 0U;
-        float   q0              = 0.0F;
-        float   q1              = 0.0F;
-        float   q2              = 0.0F;
-        float   realValue       = 0.0F;
-        float   imagValue       = 0.0F;
-        float   magnitude       = 0.0F;
-        float   scalingFactor   = static_cast<float>(size) / 2.0F;
-
-        while(size > index)
-        {
-            float fData = static_cast<float>(data[index]);
+    float targetFreq = 0.0f;
 
-            q0  = m_coeff * q1 - q2 + applyHanningWindow(fData, index, AudioDrv::SAMPLES);
-            q2  = q1;
-            q1  = q0;
-
-            ++index;
-        }
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
 
-        realValue = q1 - q2 * m_cosValue;
-        realValue /= scalingFactor;
+        targetFreq = m_tones[toneId].targetFreq;
+    }
 
-        imagValue = q2 * m_sinValue;
-        imagValue /= scalingFactor;
+    return targetFreq;
+}
 
-        magnitude = sqrtf(realValue * realValue + imagValue * imagValue);
-        magnitude = applyHanningMagnitudeCorrection(magnitude);
+void AudioToneDetector::setTargetFreq(uint8_t toneId, float freq)
+{
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        Tone&               tone    = m_tones[toneId];
 
-        if (m_threshold < magnitude)
+        if (tone.targetFreq != freq)
         {
-            /* Still detected? */
-            if (true == m_isDetected)
-            {
-                /* Wait until the application has read it. */
-                ;
-            }
-            /* The target frequency must be detected over a specific duration. */
-            else if (false == m_timer.isTimerRunning())
-            {
-                m_timer.start(m_minDuration);
-            }
-            else if (true == m_timer.isTimeout())
+            tone.targetFreq = freq;
+            tone.isDetected = false;
+            tone.timer.stop();
+
+            /* If the target frequency is around 0 Hz, the tone is disabled. */
+            if ((EPSILON < freq) || (-EPSILON > freq))
             {
-                m_isDetected = true;
+                m_bank.setTargetFreq(toneId, freq, AudioDrv::SAMPLE_RATE);
             }
             else
             {
-                ;
+                m_bank.setTargetFreq(toneId, 0.0f, AudioDrv::SAMPLE_RATE);
             }
-
-            m_lastMagntiude = magnitude;
-        }
-        else
-        {
-            m_timer.stop();
         }
     }
 }
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
+uint32_t AudioToneDetector::getMinDuration(uint8_t toneId) const
+{
+    uint32_t minDuration = 0U;
 
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        minDuration = m_tones[toneId].minDuration;
+    }
+
+    return minDuration;
+}
+
+void AudioToneDetector::setMinDuration(uint8_t toneId, uint32_t duration)
+{
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        m_tones[toneId].minDuration = duration;
+    }
+}
 
-void AudioToneDetector::preCompute()
+float AudioToneDetector::getThreshold(uint8_t toneId) const
 {
-    float       fIndex  = 0.5F + ((AudioDrv::SAMPLES * m_targetFreq) / AudioDrv::SAMPLE_RATE);
-    uint32_t    index   = static_cast<uint32_t>(fIndex);
+    float threshold = 0.0f;
+
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        threshold = m_tones[toneId].threshold;
+    }
 
-    m_omega = (2.0F * M_PI) / AudioDrv::SAMPLES;
-    m_omega *= index;
+    return threshold;
+}
 
-    m_cosValue = cos(m_omega);
-    m_sinValue = sin(m_omega);
+void AudioToneDetector::setThreshold(uint8_t toneId, float threshold)
+{
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
 
-    m_coeff = 2.0F * m_cosValue;
+        m_tones[toneId].threshold = threshold;
+    }
 }
 
-float AudioToneDetector::applyHanningWindow(float data, uint32_t sampleIndex, uint32_t samples)
+bool AudioToneDetector::isEnabled(uint8_t toneId) const
 {
-    float fSamples = static_cast<float>(samples);
+    MutexGuard<Mutex> guard(m_mutex);
 
-    return data * (0.54F - 0.46F * cos( 2.0F * M_PI * sampleIndex / fSamples));
+    return m_bank.isEnabled(toneId);
 }
 
-float AudioToneDetector::applyHanningMagnitudeCorrection(float data)
+bool AudioToneDetector::isTargetFreqDetected(uint8_t toneId)
 {
-    return data * 2.0F;
+    bool isDetected = false;
+
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        isDetected = m_tones[toneId].isDetected;
+
+        /* Reset detection flag.
+         * This is done here to ensure the application doesn't miss it.
+         */
+        m_tones[toneId].isDetected = false;
+    }
+
+    return isDetected;
+}
+
+float AudioToneDetector::getLastMagnitude(uint8_t toneId) const
+{
+    float lastMagnitude = 0.0f;
+
+    if (MAX_TONES > toneId)
+    {
+        MutexGuard<Mutex> guard(m_mutex);
+
+        lastMagnitude = m_tones[toneId].lastMagnitude;
+    }
+
+    return lastMagnitude;
+}
+
+void AudioToneDetector::notify(int32_t* data, size_t size, const AudioWindowInfo& info)
+{
+    /* The filter bank requires a complete block of samples. */
+    if ((nullptr != data) &&
+        (AudioDrv::SAMPLES == size))
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        uint8_t             toneId  = 0U;
+
+        /* All enabled tones are calculated in a single pass. */
+        m_bank.calculate(data, m_magnitudes);
+
+        for(toneId = 0U; toneId < MAX_TONES; ++toneId)
+        {
+            /* The min. duration of a tone must be observed without any gap. */
+            if (false == info.isContinuous)
+            {
+                m_tones[toneId].timer.stop();
+            }
+
+            if (true == m_bank.isEnabled(toneId))
+            {
+                updateDetection(m_tones[toneId], m_magnitudes[toneId]);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void AudioToneDetector::updateDetection(Tone& tone, float magnitude)
+{
+    if (tone.threshold < magnitude)
+    {
+        /* Still detected? */
+        if (true == tone.isDetected)
+        {
+            /* Wait until the application has read it. */
+            ;
+        }
+        /* The target frequency must be detected over a specific duration. */
+        else if (false == tone.timer.isTimerRunning())
+        {
+            tone.timer.start(tone.minDuration);
+        }
+        else if (true == tone.timer.isTimeout())
+        {
+            tone.isDetected = true;
+        }
+        else
+        {
+            ;
+        }
+
+        tone.lastMagnitude = magnitude;
+    }
+    else
+    {
+        tone.timer.stop();
+    }
 }
 
 /******************************************************************************
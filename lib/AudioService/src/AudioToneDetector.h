@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <Mutex.hpp>
 #include <SimpleTimer.hpp>
+#include <GoertzelBank.hpp>
 
 #include "AudioDrv.h"
 
@@ -58,7 +59,10 @@
  *****************************************************************************/
 
 /**
- * Audio tone detection by using the Goertzel algorithm.
+ * Audio tone detection of several tones by using a Goertzel filter bank.
+ * Every tone has its own target frequency, threshold, min. duration and
+ * detection state, but all tones are calculated in a single pass over the
+ * audio samples.
  * 
  * https://en.wikipedia.org/wiki/Goertzel_algorithm
  */
@@ -66,22 +70,21 @@ class AudioToneDetector : public IAudioObserver
 {
 public:
 
+    /**
+     * The max. number of tones, which can be detected.
+     */
+    static const uint8_t    MAX_TONES   = 4U;
+
     /**
      * Constructs the audio tone detector instance.
      */
     AudioToneDetector() :
         m_mutex(),
-        m_targetFreq(0.0f),
-        m_omega(0.0f),
-        m_cosValue(0.0f),
-        m_sinValue(0.0f),
-        m_coeff(0.0f),
-        m_minDuration(0U),
-        m_threshold(0.0f),
-        m_isDetected(false),
-        m_timer(),
-        m_lastMagntiude(0.0f)
+        m_bank(),
+        m_tones(),
+        m_magnitudes()
     {
+        (void)m_mutex.create();
     }
 
     /**
@@ -95,94 +98,81 @@ public:
     /**
      * Get the target frequency.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
      * @return Target frequency in Hz
      */
-    float getTargetFreq() const
-    {
-        return m_targetFreq;
-    }
+    float getTargetFreq(uint8_t toneId) const;
 
     /**
-     * Set the target frequency.
+     * Set the target frequency. A target frequency of 0 Hz disables the tone.
      * 
-     * @param[in] freq  Target frequency in Hz
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * @param[in] freq      Target frequency in Hz
      */
-    void setTargetFreq(float freq)
-    {
-        if (m_targetFreq != freq)
-        {
-            m_targetFreq = freq;
-            preCompute();
-        }
-    }
+    void setTargetFreq(uint8_t toneId, float freq);
 
     /**
      * Get the min. duration which the target frequency must be present.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
      * @return Min. duration in ms
      */
-    uint32_t getMinDuration() const
-    {
-        return m_minDuration;
-    }
+    uint32_t getMinDuration(uint8_t toneId) const;
 
     /**
      * Set the min. duration which the target frequency must be present.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
      * @param[in] duration  Min. duration in ms
      */
-    void setMinDuration(uint32_t duration)
-    {
-        m_minDuration = duration;
-    }
+    void setMinDuration(uint8_t toneId, uint32_t duration);
 
     /**
      * Get the magntiude threshold.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
      * @return Magnitude threshold
      */
-    float getThreshold() const
-    {
-        return m_threshold;
-    }
+    float getThreshold(uint8_t toneId) const;
 
     /**
      * Set the magnitude threshold. The audio signal must be greater than the
      * threshold to be recognized.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
      * @param[in] threshold Magnitude threshold
      */
-    void setThreshold(float threshold)
-    {
-        m_threshold = threshold;
-    }
+    void setThreshold(uint8_t toneId, float threshold);
+
+    /**
+     * Is the tone enabled?
+     * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
+     * @return If the tone is enabled, it will return true otherwise false.
+     */
+    bool isEnabled(uint8_t toneId) const;
 
     /**
      * Is the target frequency detected?
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
      * @return If audio signal is detected, it will return true otherwise false.
      */
-    bool isTargetFreqDetected()
-    {
-        bool isDetected = m_isDetected;
-
-        /* Reset detection flag.
-         * This is done here to ensure the application doesn't miss it.
-         */
-        m_isDetected = false;
-
-        return isDetected;
-    }
+    bool isTargetFreqDetected(uint8_t toneId);
 
     /**
      * Get the last magnitude which was greater than the threshold.
      * 
+     * @param[in] toneId    Tone id [0; MAX_TONES - 1]
+     * 
      * @return Last magnitude
      */
-    float getLastMagnitude() const
-    {
-        return m_lastMagntiude;
-    }
+    float getLastMagnitude(uint8_t toneId) const;
 
     /**
      * The audio driver will call this method to notify about a complete available
@@ -190,8 +180,9 @@ public:
      * 
      * @param[in]   data    Audio sample data buffer
      * @param[in]   size    Number of audio samples
+     * @param[in]   info    Information about the sample window
      */
-    void notify(int32_t* data, size_t size) final;
+    void notify(int32_t* data, size_t size, const AudioWindowInfo& info) final;
 
     /**
      * The epsilon is used to determine a 0 floating value.
@@ -200,45 +191,53 @@ public:
 
 private:
 
-    mutable Mutex   m_mutex;            /**< Mutex used for concurrent access protection. */
-    float           m_targetFreq;       /**< Target frequency in Hz */
-    float           m_omega;            /**< Precomputed angle velocity */
-    float           m_cosValue;         /**< Precomputed cosinus value */
-    float           m_sinValue;         /**< Precomputed sinus value */
-    float           m_coeff;            /**< Precomputed coefficient */
-    float           m_threshold;        /**< Threshold for target frequency detection. */
-    uint32_t        m_minDuration;      /**< The min. duration the target frequency must be active in ms.*/
-    bool            m_isDetected;       /**< Is target frequency detected? */
-    SimpleTimer     m_timer;            /**< Timer used for target frequency detection. */
-    float           m_lastMagntiude;    /**< Last magnitude which was greater than the threshold. */
-
-    AudioToneDetector(const AudioToneDetector& drv);
-    AudioToneDetector& operator=(const AudioToneDetector& drv);
-
     /**
-     * Precompute some values for faster recognization phase.
+     * The detection configuration and state of a single tone.
      */
-    void preCompute();
+    struct Tone
+    {
+        float       targetFreq;     /**< Target frequency in Hz */
+        float       threshold;      /**< Threshold for target frequency detection. */
+        uint32_t    minDuration;    /**< The min. duration the target frequency must be active in ms.*/
+        bool        isDetected;     /**< Is target frequency detected? */
+        SimpleTimer timer;          /**< Timer used for target frequency detection. */
+        float       lastMagnitude;  /**< Last magnitude which was greater than the threshold. */
+
+        /**
+         * Constructs a disabled tone.
+         */
+        Tone() :
+            targetFreq(0.0f),
+            threshold(0.0f),
+            minDuration(0U),
+            isDetected(false),
+            timer(),
+            lastMagnitude(0.0f)
+        {
+        }
+    };
 
     /**
-     * Apply Hanning windowing to sample data.
-     * 
-     * @param[in] data          Sample data
-     * @param[in] sampleIndex   Sample index
-     * @param[in] samples       Number of samples
-     * 
-     * @return Sample data after windowing
+     * Goertzel filter bank with the block size of the audio driver.
      */
-    float applyHanningWindow(float data, uint32_t sampleIndex, uint32_t samples);
+    typedef GoertzelBank<AudioDrv::SAMPLES, MAX_TONES> ToneFilterBank;
+
+    mutable Mutex   m_mutex;                    /**< Mutex used for concurrent access protection. */
+    ToneFilterBank  m_bank;                     /**< Filter bank, which calculates the magnitude of all tones at once. */
+    Tone            m_tones[MAX_TONES];         /**< Configuration and state of every tone. */
+    float           m_magnitudes[MAX_TONES];    /**< Magnitudes of the last sample block. */
+
+    AudioToneDetector(const AudioToneDetector& drv);
+    AudioToneDetector& operator=(const AudioToneDetector& drv);
 
     /**
-     * Apply Hanning windowing correction factor for the magnitude.
-     * 
-     * @param[in] data Sample data
+     * Update the detection state of a tone with the magnitude of the
+     * current sample block.
      * 
-     * @return Sample data after correction
+     * @param[in] tone      Tone
+     * @param[in] magnitude Magnitude of the tone in the current sample block
      */
-    float applyHanningMagnitudeCorrection(float data);
+    void updateDetection(Tone& tone, float magnitude);
 };
 
 /******************************************************************************
@@ -0,0 +1,174 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Beat detector
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BeatDetector.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool BeatDetector::registerObserver(IBeatObserver& observer)
+{
+    uint8_t             index           = 0U;
+    bool                isSuccessful    = false;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    while((index < MAX_OBSERVERS) && (false == isSuccessful))
+    {
+        if (nullptr == m_observers[index])
+        {
+            m_observers[index] = &observer;
+
+            isSuccessful = true;
+        }
+        else
+        {
+            ++index;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void BeatDetector::unregisterObserver(IBeatObserver& observer)
+{
+    uint8_t             index   = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    while(index < MAX_OBSERVERS)
+    {
+        if (m_observers[index] == (&observer))
+        {
+            m_observers[index] = nullptr;
+        }
+
+        ++index;
+    }
+}
+
+float BeatDetector::getSensitivity() const
+{
+    MutexGuard<Mutex> guard(m_mutex);
+
+    return m_detector.getSensitivity();
+}
+
+void BeatDetector::setSensitivity(float sensitivity)
+{
+    MutexGuard<Mutex> guard(m_mutex);
+
+    m_detector.setSensitivity(sensitivity);
+}
+
+void BeatDetector::reset()
+{
+    MutexGuard<Mutex> guard(m_mutex);
+
+    m_detector.reset();
+    m_tempo = 0.0F;
+}
+
+void BeatDetector::notifySpectrum(const float* freqBins, size_t len, const AudioWindowInfo& info)
+{
+    if ((nullptr != freqBins) &&
+        (SpectrumAnalyzer::FREQ_BINS == len))
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        uint64_t            samplePos   = info.samplePos + AudioDrv::SAMPLES;   /* Newest sample of the window */
+        uint32_t            timestamp   = static_cast<uint32_t>((samplePos * 1000U) / AudioDrv::SAMPLE_RATE);
+
+        /* The spectral flux across a gap is no onset. */
+        if (false == info.isContinuous)
+        {
+            m_detector.reset();
+        }
+
+        if (true == m_detector.process(freqBins, timestamp))
+        {
+            BeatEvent   event;
+            uint8_t     index   = 0U;
+
+            event.timestamp = timestamp;
+            event.strength  = m_detector.getStrength();
+            event.tempo     = m_detector.getTempo();
+
+            m_tempo = event.tempo;
+            ++m_beatCount;
+
+            for(index = 0U; index < MAX_OBSERVERS; ++index)
+            {
+                if (nullptr != m_observers[index])
+                {
+                    m_observers[index]->notifyBeat(event);
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
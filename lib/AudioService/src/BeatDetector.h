@@ -0,0 +1,237 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Beat detector
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup audio_service
+ *
+ * @{
+ */
+
+#ifndef BEAT_DETECTOR_H
+#define BEAT_DETECTOR_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <atomic>
+#include <Mutex.hpp>
+#include <OnsetDetector.hpp>
+
+#include "SpectrumAnalyzer.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A detected beat.
+ */
+struct BeatEvent
+{
+    uint32_t    timestamp;  /**< Capture time in ms since the audio driver start */
+    float       strength;   /**< Strength, which is the ratio of the spectral flux to the threshold. Always greater than 1. */
+    float       tempo;      /**< Estimated tempo in BPM or 0, if it is unknown. */
+};
+
+/**
+ * The beat observer will be notified about every detected beat, in the
+ * context of the audio task.
+ */
+class IBeatObserver
+{
+public:
+
+    /**
+     * Destroy the beat observer interface.
+     */
+    virtual ~IBeatObserver()
+    {
+    }
+
+    /**
+     * The beat detector will call this method to notify about a beat.
+     * It shall return fast, because it delays the audio task.
+     * 
+     * @param[in] event The beat event.
+     */
+    virtual void notifyBeat(const BeatEvent& event) = 0;
+
+protected:
+
+    /**
+     * Construct the beat oberserver interface.
+     */
+    IBeatObserver()
+    {
+    }
+
+};
+
+/**
+ * The beat detector detects onsets in the streaming spectrum by spectral
+ * flux with an adaptive threshold and estimates the tempo.
+ * 
+ * A beat is detected with the spectrum it appears in, so the latency is
+ * less than a single hop of the audio driver. The beats can be observed
+ * or polled by the beat counter.
+ * 
+ * The onsets are timestamped by the sample position of the spectrum, not by
+ * the time of processing. Otherwise a backlog of windows, which is processed
+ * at once, would get nearly equal timestamps.
+ */
+class BeatDetector : public ISpectrumObserver
+{
+public:
+
+    /**
+     * The max. number of beat observers.
+     */
+    static const uint8_t    MAX_OBSERVERS   = 4U;
+
+    /**
+     * Constructs the beat detector instance.
+     */
+    BeatDetector() :
+        m_mutex(),
+        m_detector(),
+        m_observers(),
+        m_beatCount(0U),
+        m_tempo(0.0F)
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the beat detector instance.
+     */
+    ~BeatDetector()
+    {
+        /* Never called. */
+    }
+
+    /**
+     * Register a beat observer.
+     * 
+     * @param[in] observer The beat observer which to register.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool registerObserver(IBeatObserver& observer);
+
+    /**
+     * Unregister a beat observer.
+     * 
+     * @param[in] observer The beat observer which to unregister.
+     */
+    void unregisterObserver(IBeatObserver& observer);
+
+    /**
+     * Get the number of detected beats. It can be polled to detect new beats
+     * without registering an observer.
+     * 
+     * @return Number of detected beats
+     */
+    uint32_t getBeatCount() const
+    {
+        return m_beatCount;
+    }
+
+    /**
+     * Get the estimated tempo.
+     * 
+     * @return Tempo in BPM or 0, if it is unknown.
+     */
+    float getTempo() const
+    {
+        return m_tempo;
+    }
+
+    /**
+     * Get the sensitivity.
+     * 
+     * @return Sensitivity
+     */
+    float getSensitivity() const;
+
+    /**
+     * Set the sensitivity, which is the factor of the mean deviation above
+     * the mean spectral flux. The lower the value, the more beats are
+     * detected.
+     * 
+     * @param[in] sensitivity   Sensitivity, shall be greater than 0.
+     */
+    void setSensitivity(float sensitivity);
+
+    /**
+     * Reset the detection, e.g. after the audio driver was restarted.
+     */
+    void reset();
+
+    /**
+     * The spectrum analyzer will call this method to notify about a new
+     * spectrum.
+     * 
+     * @param[in]   freqBins    Frequency bins with linear magnitude
+     * @param[in]   len         Number of frequency bins
+     * @param[in]   info        Information about the sample window of the spectrum
+     */
+    void notifySpectrum(const float* freqBins, size_t len, const AudioWindowInfo& info) final;
+
+private:
+
+    mutable Mutex                               m_mutex;                        /**< Mutex used for concurrent access protection. */
+    OnsetDetector<SpectrumAnalyzer::FREQ_BINS>  m_detector;                     /**< Onset detection and tempo estimation. */
+    IBeatObserver*                              m_observers[MAX_OBSERVERS];     /**< A list of registered beat observers. */
+    std::atomic<uint32_t>                       m_beatCount;                    /**< Number of detected beats. */
+    std::atomic<float>                          m_tempo;                        /**< Estimated tempo in BPM. */
+
+    BeatDetector(const BeatDetector& detector);
+    BeatDetector& operator=(const BeatDetector& detector);
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* BEAT_DETECTOR_H */
+
+/** @} */
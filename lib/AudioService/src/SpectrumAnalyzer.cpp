@@ -51,6 +51,8 @@
  * Types and classes
  *****************************************************************************/
 
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN == 0)
+
 /**
  * Provides the FFT window correction factor.
  * See the National Instruments application note 041:
@@ -109,6 +111,8 @@ struct WindowCorrection<FFTWindow::Flat_top>
     static constexpr const float factor = 0.22F;
 };
 
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN == 0) */
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -121,35 +125,51 @@ struct WindowCorrection<FFTWindow::Flat_top>
  * Public Methods
  *****************************************************************************/
 
-void SpectrumAnalyzer::notify(int32_t* data, size_t size)
+void SpectrumAnalyzer::notify(int32_t* data, size_t size, const AudioWindowInfo& info)
 {
     if (nullptr != data)
     {
-        size_t index = 0U;
-
 #if (SPECTRUM_ANALYZER_SIM_SIN_EN != 0)
 
         /* Simulate the sampling of a sinusoidal 1000 Hz signal
-         * with an amplitude of 94 db SPL, sampled at 40000 Hz.
+         * with an amplitude of 94 db SPL, sampled with the audio driver
+         * sample rate. The samples are replaced before any FFT backend
+         * uses them.
          */
         {
-            float signalFrequency   = 1000.0F;
-            float cycles            = (((AudioDrv::SAMPLES - 1U) * signalFrequency) / AudioDrv::SAMPLE_RATE);   /* Number of signal cycles that the sampling will read. */
-            float amplitude         = 420426.0F; /* 94 db SPL */
+            const float signalFrequency = 1000.0F;
+            const float cycles          = (((AudioDrv::SAMPLES - 1U) * signalFrequency) / AudioDrv::SAMPLE_RATE);  /* Number of signal cycles that the sampling will read. */
+            const float amplitude       = 420426.0F; /* 94 db SPL */
+            size_t      sampleIdx       = 0U;
 
-            for (uint16_t sampleIdx = 0U; sampleIdx < AudioDrv::SAMPLES; ++sampleIdx)
+            for(sampleIdx = 0U; sampleIdx < size; ++sampleIdx)
             {
                 /* Build data with positive and negative values. */
-                m_real[sampleIdx] = (amplitude * (sin((sampleIdx * (twoPi * cycles)) / AudioDrv::SAMPLES))) / 2.0F;
-                
-                /* Imaginary part must be zeroed in case of looping to avoid wrong calculations and overflows. */
-                m_imag[sampleIdx] = 0.0F;
+                data[sampleIdx] = static_cast<int32_t>((amplitude * sinf((sampleIdx * (2.0F * static_cast<float>(M_PI) * cycles)) / AudioDrv::SAMPLES)) / 2.0F);
             }
+        }
+
+#endif  /* (SPECTRUM_ANALYZER_SIM_SIN_EN != 0) */
 
-            m_isMicAvailable = true;
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN != 0)
+
+        /* The fixed-point FFT requires a complete block of samples. It
+         * windows, transforms and corrects them in a single step.
+         */
+        if (AudioDrv::SAMPLES == size)
+        {
+            Spectrum& spectrum = m_spectrum.beginWrite();
+
+            m_fft.calculate(data, spectrum.freqBins);
+            calculateFreqBands(spectrum);
+
+            /* Provide the spectrum to the application. */
+            publish(spectrum, info);
         }
 
-#else /* (SPECTRUM_ANALYZER_SIM_SIN_EN != 0) */
+#else   /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+
+        size_t index = 0U;
 
         while(index < size)
         {
@@ -159,35 +179,98 @@ void SpectrumAnalyzer::notify(int32_t* data, size_t size)
             ++index;
         }
 
-#endif  /* (SPECTRUM_ANALYZER_SIM_SIN_EN == 0) */
-
         /* Transform the time discrete values to the frequency spectrum. */
         calculateFFT();
 
         /* Store the frequency bins and provide it to the application. */
-        copyFreqBins();
+        {
+            Spectrum& spectrum = m_spectrum.beginWrite();
+
+            for(index = 0U; index < FREQ_BINS; ++index)
+            {
+                spectrum.freqBins[index] = m_real[index];
+            }
+
+            calculateFreqBands(spectrum);
+            publish(spectrum, info);
+        }
+
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
     }
 }
 
-bool SpectrumAnalyzer::getFreqBins(float* freqBins, size_t len)
+bool SpectrumAnalyzer::setFreqBands(FreqBandScale scale, uint8_t len)
+{
+    bool isSuccessful = false;
+
+    if ((0U < len) &&
+        (MAX_FREQ_BANDS >= len) &&
+        ((FREQ_BAND_SCALE_LOG == scale) || (FREQ_BAND_SCALE_MEL == scale)))
+    {
+        m_freqBandsCfg = toFreqBandsCfg(scale, len);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool SpectrumAnalyzer::getFreqBins(float* freqBins, size_t len) const
 {
-    bool                isSuccessful    = false;
-    MutexGuard<Mutex>   guard(m_mutex);
+    bool isSuccessful = false;
 
     if ((nullptr != freqBins) &&
         (0U < len) &&
         ((FREQ_BINS >= len)))
     {
-        size_t idx = 0U;
+        uint32_t sequence = 0U;
 
-        for(idx = 0U; idx < len; ++idx)
-        {
-            freqBins[idx] = m_freqBins[idx];
-        }
+        /* Copy only the requested frequency bins, not the whole spectrum. */
+        isSuccessful = m_spectrum.read(
+            [freqBins, len](const Spectrum& spectrum) -> bool
+            {
+                size_t idx = 0U;
 
-        m_freqBinsAreReady = false;
+                for(idx = 0U; idx < len; ++idx)
+                {
+                    freqBins[idx] = spectrum.freqBins[idx];
+                }
 
-        isSuccessful = true;
+                return true;
+            },
+            sequence);
+    }
+
+    return isSuccessful;
+}
+
+bool SpectrumAnalyzer::getFreqBands(float* freqBands, size_t len) const
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != freqBands) &&
+        (0U < len) &&
+        ((MAX_FREQ_BANDS >= len)))
+    {
+        uint32_t sequence = 0U;
+
+        isSuccessful = m_spectrum.read(
+            [freqBands, len](const Spectrum& spectrum) -> bool
+            {
+                size_t  idx             = 0U;
+                bool    isBandsLenEqual = (len == spectrum.freqBandsLen);
+
+                /* The band configuration may have changed in the meantime. */
+                if (true == isBandsLenEqual)
+                {
+                    for(idx = 0U; idx < len; ++idx)
+                    {
+                        freqBands[idx] = spectrum.freqBands[idx];
+                    }
+                }
+
+                return isBandsLenEqual;
+            },
+            sequence);
     }
 
     return isSuccessful;
@@ -201,6 +284,8 @@ bool SpectrumAnalyzer::getFreqBins(float* freqBins, size_t len)
  * Private Methods
  *****************************************************************************/
 
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN == 0)
+
 void SpectrumAnalyzer::calculateFFT()
 {
     static const constexpr  float       HALF_SPECTRUM_ENERGY_CORRECTION_FACTOR  = 2.0F;
@@ -230,17 +315,43 @@ void SpectrumAnalyzer::calculateFFT()
     }
 }
 
-void SpectrumAnalyzer::copyFreqBins()
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN == 0) */
+
+void SpectrumAnalyzer::calculateFreqBands(Spectrum& spectrum)
 {
-    uint16_t            idx             = 0U;
-    MutexGuard<Mutex>   guard(m_mutex);
+    uint16_t freqBandsCfg = m_freqBandsCfg;
 
-    for(idx = 0U; idx < FREQ_BINS; ++idx)
+    /* Recalculate the weights only, if the configuration was changed. */
+    if (m_appliedFreqBandsCfg != freqBandsCfg)
     {
-        m_freqBins[idx] = m_real[idx];
+        FreqBandScale   scale   = static_cast<FreqBandScale>(freqBandsCfg >> FREQ_BANDS_CFG_SCALE_SHIFT);
+        uint8_t         len     = static_cast<uint8_t>(freqBandsCfg & FREQ_BANDS_CFG_LEN_MASK);
+
+        if (false == m_freqBandMapper.configure(scale, len, AudioDrv::SAMPLE_RATE))
+        {
+            LOG_ERROR("Invalid frequency band configuration: 0x%04X", freqBandsCfg);
+        }
+
+        m_appliedFreqBandsCfg = freqBandsCfg;
     }
 
-    m_freqBinsAreReady = true;
+    m_freqBandMapper.map(spectrum.freqBins, spectrum.freqBands);
+    spectrum.freqBandsLen = m_freqBandMapper.getBandsLen();
+}
+
+void SpectrumAnalyzer::publish(const Spectrum& spectrum, const AudioWindowInfo& info)
+{
+    ISpectrumObserver* observer = m_observer;
+
+    m_spectrum.publish();
+
+    /* The written buffer stays valid, because only the audio task writes
+     * the next spectrum.
+     */
+    if (nullptr != observer)
+    {
+        observer->notifySpectrum(spectrum.freqBins, FREQ_BINS, info);
+    }
 }
 
 /******************************************************************************
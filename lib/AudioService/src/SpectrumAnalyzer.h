@@ -40,8 +40,9 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
-#include <arduinoFFT.h>
-#include <Mutex.hpp>
+#include <atomic>
+#include <SeqLockBuffer.hpp>
+#include <FreqBandMapper.hpp>
 
 #include "AudioDrv.h"
 
@@ -49,6 +50,21 @@
  * Compiler Switches
  *****************************************************************************/
 
+/**
+ * Select the FFT backend:
+ * - 0: arduinoFFT in float, kept as reference.
+ * - 1: Fixed-point real FFT with precomputed window and twiddle factors.
+ */
+#ifndef SPECTRUM_ANALYZER_FFT_Q15_EN
+#define SPECTRUM_ANALYZER_FFT_Q15_EN    1
+#endif  /* SPECTRUM_ANALYZER_FFT_Q15_EN */
+
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN != 0)
+#include <RealFftQ15.hpp>
+#else   /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+#include <arduinoFFT.h>
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -57,24 +73,99 @@
  * Types and Classes
  *****************************************************************************/
 
+/**
+ * The spectrum observer will be notified about every new spectrum, in the
+ * context of the audio task.
+ */
+class ISpectrumObserver
+{
+public:
+
+    /**
+     * Destroy the spectrum observer interface.
+     */
+    virtual ~ISpectrumObserver()
+    {
+    }
+
+    /**
+     * The spectrum analyzer will call this method to notify about a new
+     * spectrum. It shall return fast, because it delays the audio task.
+     * 
+     * @param[in]   freqBins    Frequency bins with linear magnitude
+     * @param[in]   len         Number of frequency bins
+     * @param[in]   info        Information about the sample window of the spectrum
+     */
+    virtual void notifySpectrum(const float* freqBins, size_t len, const AudioWindowInfo& info) = 0;
+
+protected:
+
+    /**
+     * Construct the spectrum oberserver interface.
+     */
+    ISpectrumObserver()
+    {
+    }
+
+};
+
 /**
  * A spectrum analyzer, which transforms time discrete samples to
  * frequency spectrum bands.
+ * 
+ * Every spectrum is published lock-free in alternating buffers with a
+ * sequence counter. The readers get a consistent snapshot without blocking
+ * the audio task.
+ * 
+ * The frequency bands are calculated with precomputed weights at audio rate.
+ * Their scale and number is configurable, see setFreqBands().
  */
 class SpectrumAnalyzer : public IAudioObserver
 {
 public:
 
+    /**
+     * The number of frequency bins over the spectrum. Note, this is always
+     * half of the samples, because they are symmetrical around DC.
+     */
+    static const uint32_t   FREQ_BINS   = AudioDrv::SAMPLES / 2U;
+
+    /**
+     * The max. number of frequency bands.
+     */
+    static const uint8_t    MAX_FREQ_BANDS      = 32U;
+
+    /**
+     * The default number of frequency bands, with about half an octave bandwidth.
+     */
+    static const uint8_t    FREQ_BANDS_DEFAULT  = 16U;
+
+    /**
+     * A single spectrum.
+     */
+    struct Spectrum
+    {
+        float   freqBins[FREQ_BINS];            /**< The frequency bins as result of the FFT, with linear magnitude. */
+        uint8_t freqBandsLen;                   /**< The number of frequency bands. */
+        float   freqBands[MAX_FREQ_BANDS];      /**< The frequency bands, as weighted average of its frequency bins. */
+    };
+
     /**
      * Constructs the spectrum analyzer instance.
      */
     SpectrumAnalyzer() :
-        m_mutex(),
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN != 0)
+        m_fft(),
+#else   /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
         m_real{0.0f},
         m_imag{0.0f},
         m_fft(m_real, m_imag, AudioDrv::SAMPLES, AudioDrv::SAMPLE_RATE),
-        m_freqBins{0.0f},
-        m_freqBinsAreReady(false)
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+        m_spectrum(),
+        m_freqBandMapper(),
+        m_freqBandsCfg(toFreqBandsCfg(FREQ_BAND_SCALE_LOG, FREQ_BANDS_DEFAULT)),
+        m_appliedFreqBandsCfg(0U),
+        m_observer(nullptr)
     {
     }
 
@@ -92,8 +183,19 @@ public:
      * 
      * @param[in]   data    Audio sample data buffer
      * @param[in]   size    Number of audio samples
+     * @param[in]   info    Information about the sample window
      */
-    void notify(int32_t* data, size_t size) final;
+    void notify(int32_t* data, size_t size, const AudioWindowInfo& info) final;
+
+    /**
+     * Set the spectrum observer, which is notified about every new spectrum.
+     * 
+     * @param[in] observer  Spectrum observer or nullptr to remove it.
+     */
+    void setObserver(ISpectrumObserver* observer)
+    {
+        m_observer = observer;
+    }
 
     /**
      * Get the number of frequency bins.
@@ -105,6 +207,39 @@ public:
         return FREQ_BINS;
     }
 
+    /**
+     * Get the number of frequency bands, which are requested. A spectrum,
+     * which was published before the request, may have a different number.
+     * 
+     * @return Number of frequency bands
+     */
+    size_t getFreqBandsLen() const
+    {
+        return m_freqBandsCfg & FREQ_BANDS_CFG_LEN_MASK;
+    }
+
+    /**
+     * Request the scale and the number of frequency bands. The audio task
+     * recalculates the frequency band weights before the next spectrum.
+     * 
+     * @param[in] scale Frequency band scale
+     * @param[in] len   Number of frequency bands [1; MAX_FREQ_BANDS]
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool setFreqBands(FreqBandScale scale, uint8_t len);
+
+    /**
+     * Get the sequence number of the latest spectrum. It changes with every
+     * new spectrum and is 0 as long as no spectrum is available.
+     * 
+     * @return Sequence number
+     */
+    uint32_t getSequence() const
+    {
+        return m_spectrum.getSequence();
+    }
+
     /**
      * Get frequency bins by copy.
      * 
@@ -113,49 +248,113 @@ public:
      * 
      * @return If successful, it will return true otherwise false.
      */
-    bool getFreqBins(float* freqBins, size_t len);
+    bool getFreqBins(float* freqBins, size_t len) const;
 
     /**
-     * Are the frequency bins updated and ready?
+     * Get frequency bands by copy.
+     * 
+     * @param[out]  freqBands   Frequency band buffer, where to write.
+     * @param[in]   len         Length of frequency band buffer in elements.
+     *                          It must be equal to the number of frequency
+     *                          bands of the spectrum.
      * 
-     * @return If the frequency bins are ready, it will return true otherwise false.
+     * @return If successful, it will return true otherwise false.
      */
-    bool areFreqBinsReady() const
+    bool getFreqBands(float* freqBands, size_t len) const;
+
+    /**
+     * Get direct access to the latest spectrum, without copying.
+     * The spectrum must be released with endRead(), which tells whether it
+     * was consistent during the access.
+     * 
+     * @param[out] sequence Sequence number of the spectrum
+     * 
+     * @return Spectrum or nullptr, if no spectrum is available yet.
+     */
+    const Spectrum* beginRead(uint32_t& sequence) const
     {
-        MutexGuard<Mutex>   guard(m_mutex);
+        return m_spectrum.beginRead(sequence);
+    }
 
-        return m_freqBinsAreReady;
+    /**
+     * Check whether the spectrum, which was accessed by beginRead() was
+     * consistent during the access.
+     * 
+     * @param[in] sequence  Sequence number of the spectrum, see beginRead().
+     * 
+     * @return If the spectrum was consistent, it will return true otherwise false.
+     */
+    bool endRead(uint32_t sequence) const
+    {
+        return m_spectrum.endRead(sequence);
     }
 
 private:
 
-    /**
-     * The number of frequency bins over the spectrum. Note, this is always
-     * half of the samples, because they are symmetrical around DC.
-     */
-    static const uint32_t   FREQ_BINS   = AudioDrv::SAMPLES / 2U;
+    /** Mask of the number of frequency bands in the frequency band configuration. */
+    static const uint16_t   FREQ_BANDS_CFG_LEN_MASK     = 0x00FFU;
 
-    mutable Mutex       m_mutex;                    /**< Mutex used for concurrent access protection. */
-    float               m_real[AudioDrv::SAMPLES];  /**< The real values. */
-    float               m_imag[AudioDrv::SAMPLES];  /**< The imaginary values. */
-    ArduinoFFT<float>   m_fft;                      /**< The FFT algorithm. */
-    float               m_freqBins[FREQ_BINS];      /**< The frequency bins as result of the FFT, with linear magnitude. */
-    bool                m_freqBinsAreReady;         /**< Are the frequency bins ready for the application? */
+    /** Bit position of the scale in the frequency band configuration. */
+    static const uint8_t    FREQ_BANDS_CFG_SCALE_SHIFT  = 8U;
+
+    /** Frequency band mapper */
+    typedef FreqBandMapper<FREQ_BINS, MAX_FREQ_BANDS> BandMapper;
+
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN != 0)
+    RealFftQ15<AudioDrv::SAMPLES>       m_fft;                      /**< The FFT algorithm. */
+#else   /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+    float                               m_real[AudioDrv::SAMPLES];  /**< The real values. */
+    float                               m_imag[AudioDrv::SAMPLES];  /**< The imaginary values. */
+    ArduinoFFT<float>                   m_fft;                      /**< The FFT algorithm. */
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN != 0) */
+    SeqLockBuffer<Spectrum>             m_spectrum;                 /**< The published spectrum. */
+    BandMapper                          m_freqBandMapper;           /**< Maps the frequency bins to the frequency bands. */
+    std::atomic<uint16_t>               m_freqBandsCfg;             /**< Requested frequency band configuration (scale and number). */
+    uint16_t                            m_appliedFreqBandsCfg;      /**< Frequency band configuration of the mapper, only used by the audio task. */
+    std::atomic<ISpectrumObserver*>     m_observer;                 /**< Spectrum observer, which is notified about every new spectrum. */
 
     SpectrumAnalyzer(const SpectrumAnalyzer& drv);
     SpectrumAnalyzer& operator=(const SpectrumAnalyzer& drv);
 
+#if (SPECTRUM_ANALYZER_FFT_Q15_EN == 0)
+
     /**
      * Transform from discrete time to frequency spectrum.
      * Note, the magnitude will be calculated linear and not in dB.
      */
     void calculateFFT();
 
+#endif  /* (SPECTRUM_ANALYZER_FFT_Q15_EN == 0) */
+
     /**
-     * Copy FFT result to frequency bins.
-     * This function is protected against concurrent access.
+     * Get the frequency band configuration, which contains the scale and
+     * the number of frequency bands.
+     * 
+     * @param[in] scale Frequency band scale
+     * @param[in] len   Number of frequency bands
+     * 
+     * @return Frequency band configuration
+     */
+    static uint16_t toFreqBandsCfg(FreqBandScale scale, uint8_t len)
+    {
+        return (static_cast<uint16_t>(scale) << FREQ_BANDS_CFG_SCALE_SHIFT) | len;
+    }
+
+    /**
+     * Calculate the frequency bands from the frequency bins.
+     * A requested frequency band configuration is applied before.
+     * 
+     * @param[in,out] spectrum  Spectrum with frequency bins, which to complete.
+     */
+    void calculateFreqBands(Spectrum& spectrum);
+
+    /**
+     * Publish the spectrum to the application and notify the observer.
+     * 
+     * @param[in] spectrum  The spectrum, which was written last.
+     * @param[in] info      Information about the sample window of the spectrum
      */
-    void copyFreqBins();
+    void publish(const Spectrum& spectrum, const AudioWindowInfo& info);
 };
 
 /******************************************************************************
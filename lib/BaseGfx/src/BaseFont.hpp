@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include "BaseGfx.hpp"
 #include "gfxfont.h"
+#include "BaseGlyphCache.hpp"
+#include "Utf8.hpp"
 
 /******************************************************************************
  * Macros
@@ -57,6 +59,15 @@
 
 /**
  * A graphical font, providing simple single character drawing functionality.
+ *
+ * Every used glyph is rasterized once into a glyph cache and drawn from there
+ * with horizontal spans. A copy of the font starts with an empty cache.
+ *
+ * The glyphs are addressed by Unicode codepoints. A font may provide a sparse
+ * glyph table, which contains the codepoint of every glyph in ascending order.
+ * Its flash cost is 2 byte per glyph. With it, the font may contain more than
+ * the 256 glyphs of first..last. Without it, the GFXfont glyphs are addressed
+ * by first..last like a single byte character set.
  */
 template < typename TColor >
 class BaseFont
@@ -68,7 +79,10 @@ public:
      * Note, until no GFXfont is assigned, it can not draw any character.
      */
     BaseFont() :
-        m_gfxFont(nullptr)
+        m_gfxFont(nullptr),
+        m_codepoints(nullptr),
+        m_codepointCnt(0U),
+        m_glyphCache()
     {
     }
 
@@ -78,17 +92,27 @@ public:
      * @param[in] font  Font, which to copy.
      */
     BaseFont(const BaseFont& font) :
-        m_gfxFont(font.m_gfxFont)
+        m_gfxFont(font.m_gfxFont),
+        m_codepoints(font.m_codepoints),
+        m_codepointCnt(font.m_codepointCnt),
+        m_glyphCache()
     {
     }
 
     /**
      * Constructs a font with the given GFXfont.
      * 
-     * @param[in] gfxFont   GFXfont
+     * @param[in] gfxFont       GFXfont
+     * @param[in] codepoints    Sparse glyph table with one codepoint per glyph
+     *                          in ascending order (optional).
+     * @param[in] codepointCnt  Number of codepoints in the sparse glyph table.
+     *                          If 0, it is derived from first..last.
      */
-    BaseFont(const GFXfont* gfxFont) :
-        m_gfxFont(gfxFont)
+    BaseFont(const GFXfont* gfxFont, const uint16_t* codepoints = nullptr, uint16_t codepointCnt = 0U) :
+        m_gfxFont(gfxFont),
+        m_codepoints(codepoints),
+        m_codepointCnt(codepointCnt),
+        m_glyphCache()
     {
     }
 
@@ -110,7 +134,7 @@ public:
     {
         if (&font != this)
         {
-            m_gfxFont = font.m_gfxFont;
+            setGfxFont(font.m_gfxFont, font.m_codepoints, font.m_codepointCnt);
         }
 
         return *this;
@@ -126,14 +150,44 @@ public:
         return m_gfxFont;
     }
 
+    /**
+     * Get sparse glyph table.
+     *
+     * @return Codepoint of every glyph or nullptr, if not available.
+     */
+    const uint16_t* getCodepoints() const
+    {
+        return m_codepoints;
+    }
+
     /**
      * Set GFXfont.
      *
-     * @param[in] gfxFont   GFXfont
+     * @param[in] gfxFont       GFXfont
+     * @param[in] codepoints    Sparse glyph table with one codepoint per glyph
+     *                          in ascending order (optional).
+     * @param[in] codepointCnt  Number of codepoints in the sparse glyph table.
+     *                          If 0, it is derived from first..last.
+     */
+    void setGfxFont(const GFXfont* gfxFont, const uint16_t* codepoints = nullptr, uint16_t codepointCnt = 0U)
+    {
+        if (gfxFont != m_gfxFont)
+        {
+            m_gfxFont = gfxFont;
+            m_glyphCache.release();
+        }
+
+        m_codepoints    = codepoints;
+        m_codepointCnt  = codepointCnt;
+    }
+
+    /**
+     * Release the glyph cache memory. The glyphs will be cached again on
+     * their next use.
      */
-    void setGfxFont(const GFXfont* gfxFont)
+    void releaseGlyphCache()
     {
-        m_gfxFont = gfxFont;
+        m_glyphCache.release();
     }
 
     /**
@@ -156,6 +210,7 @@ public:
 
     /**
      * Get a glyph object from the font for the choosen character.
+     * The character addresses the glyph directly by first..last.
      * 
      * @param[in] singleChar    Character for what the glyph is requested.
      * 
@@ -163,18 +218,78 @@ public:
      */
     const GFXglyph* getGlyph(char singleChar) const
     {
-        const GFXglyph* glyph   = nullptr;
-        uint8_t uChar           = static_cast<uint8_t>(singleChar);
+        return getGlyphByIndex(static_cast<uint8_t>(singleChar));
+    }
 
-        if ((nullptr != m_gfxFont) &&
-            (m_gfxFont->first <= uChar) &&
-            (m_gfxFont->last >= uChar) &&
-            ('\n' != singleChar) &&
-            ('\r' != singleChar))
+    /**
+     * Get a glyph object from the font for the choosen codepoint.
+     * A raw byte (see Utf8::decode()) addresses the glyph directly by
+     * first..last, like a single character.
+     * 
+     * @param[in] codepoint Unicode codepoint for what the glyph is requested.
+     * 
+     * @return If glyph is found, it will be returned otherwise nullptr.
+     */
+    const GFXglyph* getGlyphByCodepoint(uint32_t codepoint) const
+    {
+        const GFXglyph* glyph = nullptr;
+
+        if (true == Utf8::isRawByte(codepoint))
         {
-            uint8_t glyphIndex  = uChar - m_gfxFont->first;
+            glyph = getGlyphByIndex(static_cast<uint8_t>(codepoint - Utf8::RAW_BYTE_BASE));
+        }
+        else if (nullptr == m_codepoints)
+        {
+            if (0xFFU >= codepoint)
+            {
+                glyph = getGlyphByIndex(static_cast<uint8_t>(codepoint));
+            }
+        }
+        else if ((nullptr != m_gfxFont) &&
+                 (0xFFFFU >= codepoint) &&
+                 ('\n' != codepoint) &&
+                 ('\r' != codepoint))
+        {
+            uint16_t glyphCnt   = getGlyphCnt();
+            uint32_t offset     = codepoint - m_codepoints[0];
+
+            /* Usually the table starts with a contiguous range, which is
+             * indexed directly. Otherwise the table is binary searched.
+             */
+            if ((glyphCnt > offset) &&
+                (codepoint == m_codepoints[offset]))
+            {
+                glyph = &(m_gfxFont->glyph[offset]);
+            }
+            else
+            {
+                uint16_t left   = 0U;
+                uint16_t right  = glyphCnt;
 
-            glyph = &(m_gfxFont->glyph[glyphIndex]);
+                while(left < right)
+                {
+                    uint16_t middle = left + (right - left) / 2U;
+
+                    if (codepoint > m_codepoints[middle])
+                    {
+                        left = middle + 1U;
+                    }
+                    else
+                    {
+                        right = middle;
+                    }
+                }
+
+                if ((glyphCnt > left) &&
+                    (codepoint == m_codepoints[left]))
+                {
+                    glyph = &(m_gfxFont->glyph[left]);
+                }
+            }
+        }
+        else
+        {
+            ;
         }
 
         return glyph;
@@ -191,17 +306,21 @@ public:
      */
     bool getCharBoundingBox(char singleChar, uint16_t& width, uint16_t& height) const
     {
-        bool            status  = false;
-        const GFXglyph* glyph   = getGlyph(singleChar);
-
-        if (nullptr != glyph)
-        {
-            width   = glyph->xAdvance;
-            height  = m_gfxFont->yAdvance;
-            status  = true;
-        }
+        return getGlyphBoundingBox(getGlyph(singleChar), width, height);
+    }
 
-        return status;
+    /**
+     * Get bounding box of single codepoint.
+     *
+     * @param[in]   codepoint   Unicode codepoint
+     * @param[out]  width       Width in pixel
+     * @param[out]  height      Height in pixel
+     *
+     * @return If codepoint is valid, it will return true otherwise false.
+     */
+    bool getCodepointBoundingBox(uint32_t codepoint, uint16_t& width, uint16_t& height) const
+    {
+        return getGlyphBoundingBox(getGlyphByCodepoint(codepoint), width, height);
     }
 
     /**
@@ -221,15 +340,33 @@ public:
      */
     void drawChar(BaseGfx<TColor>& gfx, int16_t& cursorX, int16_t& cursorY, char singleChar, const TColor& color)
     {
-        uint8_t uChar = static_cast<uint8_t>(singleChar);
+        drawCodepoint(gfx, cursorX, cursorY, Utf8::fromChar(singleChar), color);
+    }
 
+    /**
+     * Draw single codepoint at current cursor position. The cursor is
+     * automatically moved to the new position.
+     * 
+     * A newline will place the cursor on the begin of the next line.
+     * 
+     * If text wrap around handling is necessary, this must be done in a
+     * higher layer.
+     *
+     * @param[in]       gfx         Graphics interface
+     * @param[in,out]   cursorX     The cursor position x-coordinate.
+     * @param[in,out]   cursorY     The cursor position y-coordinate.
+     * @param[in]       codepoint   Unicode codepoint which to draw
+     * @param[in]       color       Text color
+     */
+    void drawCodepoint(BaseGfx<TColor>& gfx, int16_t& cursorX, int16_t& cursorY, uint32_t codepoint, const TColor& color)
+    {
         if (nullptr == m_gfxFont)
         {
             return;
         }
 
         /* Set cursor to next line? */
-        if ('\n' == singleChar)
+        if ('\n' == codepoint)
         {
             /* Move cursor to begin and one row down. */
             cursorX = 0;
@@ -237,40 +374,32 @@ public:
         }
         else
         {
-            const GFXglyph* glyph = getGlyph(singleChar);
+            const GFXglyph* glyph = getGlyphByCodepoint(codepoint);
 
             /* Is character available in the font? Note, carriage return is skipped. */
             if (nullptr != glyph)
             {
-                /* Handle character only, if it is really drawn on the screen. */
-                if (0 <= (cursorX + glyph->xAdvance))
+                int16_t posX    = cursorX + glyph->xOffset;
+                int16_t posY    = cursorY + glyph->yOffset;
+
+                /* Handle character only, if it is really drawn on the screen.
+                 * Glyphs completely outside the canvas are just skipped.
+                 */
+                if ((0 < (posX + glyph->width)) &&
+                    (gfx.getWidth() > posX) &&
+                    (0 < (posY + glyph->height)) &&
+                    (gfx.getHeight() > posY))
                 {
-                    int16_t     x               = 0;
-                    int16_t     y               = 0;
-                    uint16_t    bitmapOffset    = glyph->bitmapOffset;
-                    uint8_t     bitmapRowBits   = 0U;
-                    uint8_t     bitCnt          = 0U;
+                    const uint8_t*  mask    = m_glyphCache.get(*m_gfxFont, getGlyphCnt(), static_cast<uint16_t>(glyph - m_gfxFont->glyph));
 
-                    for(y = 0U; y < glyph->height; ++y)
+                    /* Fonts which can not be cached, are drawn pixel by pixel. */
+                    if (nullptr != mask)
+                    {
+                        drawMask(gfx, posX, posY, *glyph, mask, color);
+                    }
+                    else
                     {
-                        for(x = 0U; x < glyph->width; ++x)
-                        {
-                            /* Every 8 bit, the bitmap offset must be increased. */
-                            if (0U == (bitCnt & 0x07))
-                            {
-                                bitmapRowBits = m_gfxFont->bitmap[bitmapOffset];
-                                ++bitmapOffset;
-                            }
-                            ++bitCnt;
-
-                            /* A 1b in the bitmap row bits must be drawn as single pixel. */
-                            if (0U != (bitmapRowBits & 0x80U))
-                            {
-                                gfx.drawPixel(cursorX + x + glyph->xOffset, cursorY + y + glyph->yOffset, color);
-                            }
-
-                            bitmapRowBits <<= 1U;
-                        }
+                        drawBitmap(gfx, posX, posY, *glyph, color);
                     }
                 }
 
@@ -284,9 +413,211 @@ public:
         }
     }
 
+    /**
+     * Get the rasterized mask of a glyph from the glyph cache. Every mask row
+     * consists of bytesPerRow bytes with the MSB as the left pixel. The mask
+     * is only valid until the next glyph is requested.
+     *
+     * @param[in]   glyph       The glyph, which must belong to this font.
+     * @param[out]  bytesPerRow Number of bytes per mask row
+     *
+     * @return If the font can be cached, it will return the mask otherwise nullptr.
+     */
+    const uint8_t* getGlyphMask(const GFXglyph& glyph, uint8_t& bytesPerRow)
+    {
+        const uint8_t* mask = nullptr;
+
+        if (nullptr != m_gfxFont)
+        {
+            mask        = m_glyphCache.get(*m_gfxFont, getGlyphCnt(), static_cast<uint16_t>(&glyph - m_gfxFont->glyph));
+            bytesPerRow = m_glyphCache.getBytesPerRow();
+        }
+
+        return mask;
+    }
+
 private:
 
-    const GFXfont*  m_gfxFont;  /**< Current selected graphics font, based on Adafruit GFXfont format. */
+    const GFXfont*          m_gfxFont;      /**< Current selected graphics font, based on Adafruit GFXfont format. */
+    const uint16_t*         m_codepoints;   /**< Sparse glyph table with the codepoint of every glyph. */
+    uint16_t                m_codepointCnt; /**< Number of codepoints in the sparse glyph table, 0 if derived from first..last. */
+    BaseGlyphCache<TColor>  m_glyphCache;   /**< Cache of the rasterized glyphs. */
+
+    /**
+     * Get number of glyphs in the GFXfont.
+     * Only a sparse glyph table can address more than first..last glyphs.
+     *
+     * @return Number of glyphs
+     */
+    uint16_t getGlyphCnt() const
+    {
+        uint16_t glyphCnt = static_cast<uint16_t>(m_gfxFont->last) - m_gfxFont->first + 1U;
+
+        if ((nullptr != m_codepoints) &&
+            (0U < m_codepointCnt))
+        {
+            glyphCnt = m_codepointCnt;
+        }
+
+        return glyphCnt;
+    }
+
+    /**
+     * Get a glyph object directly by first..last.
+     *
+     * @param[in] uChar Character for what the glyph is requested.
+     *
+     * @return If glyph is found, it will be returned otherwise nullptr.
+     */
+    const GFXglyph* getGlyphByIndex(uint8_t uChar) const
+    {
+        const GFXglyph* glyph = nullptr;
+
+        if ((nullptr != m_gfxFont) &&
+            (m_gfxFont->first <= uChar) &&
+            (m_gfxFont->last >= uChar) &&
+            ('\n' != uChar) &&
+            ('\r' != uChar))
+        {
+            uint8_t glyphIndex  = uChar - m_gfxFont->first;
+
+            glyph = &(m_gfxFont->glyph[glyphIndex]);
+        }
+
+        return glyph;
+    }
+
+    /**
+     * Get bounding box of a glyph.
+     *
+     * @param[in]   glyph   The glyph
+     * @param[out]  width   Width in pixel
+     * @param[out]  height  Height in pixel
+     *
+     * @return If glyph is valid, it will return true otherwise false.
+     */
+    bool getGlyphBoundingBox(const GFXglyph* glyph, uint16_t& width, uint16_t& height) const
+    {
+        bool status = false;
+
+        if (nullptr != glyph)
+        {
+            width   = glyph->xAdvance;
+            height  = m_gfxFont->yAdvance;
+            status  = true;
+        }
+
+        return status;
+    }
+
+    /**
+     * Draw a glyph pixel by pixel directly from the bit-packed GFXfont bitmap.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] posX  x-coordinate of the upper left glyph corner
+     * @param[in] posY  y-coordinate of the upper left glyph corner
+     * @param[in] glyph The glyph
+     * @param[in] color Text color
+     */
+    void drawBitmap(BaseGfx<TColor>& gfx, int16_t posX, int16_t posY, const GFXglyph& glyph, const TColor& color)
+    {
+        int16_t     x               = 0;
+        int16_t     y               = 0;
+        uint16_t    bitmapOffset    = glyph.bitmapOffset;
+        uint8_t     bitmapRowBits   = 0U;
+        uint8_t     bitCnt          = 0U;
+
+        for(y = 0U; y < glyph.height; ++y)
+        {
+            for(x = 0U; x < glyph.width; ++x)
+            {
+                /* Every 8 bit, the bitmap offset must be increased. */
+                if (0U == (bitCnt & 0x07))
+                {
+                    bitmapRowBits = m_gfxFont->bitmap[bitmapOffset];
+                    ++bitmapOffset;
+                }
+                ++bitCnt;
+
+                /* A 1b in the bitmap row bits must be drawn as single pixel. */
+                if (0U != (bitmapRowBits & 0x80U))
+                {
+                    gfx.drawPixel(posX + x, posY + y, color);
+                }
+
+                bitmapRowBits <<= 1U;
+            }
+        }
+    }
+
+    /**
+     * Draw a rasterized glyph mask. Every sequence of set pixels in a row is
+     * drawn as a single span.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] posX  x-coordinate of the upper left glyph corner
+     * @param[in] posY  y-coordinate of the upper left glyph corner
+     * @param[in] glyph The glyph
+     * @param[in] mask  The rasterized glyph mask
+     * @param[in] color Text color
+     */
+    void drawMask(BaseGfx<TColor>& gfx, int16_t posX, int16_t posY, const GFXglyph& glyph, const uint8_t* mask, const TColor& color)
+    {
+        const TColor*   spanColors      = m_glyphCache.getSpanColors(color, glyph.width);
+        uint8_t         bytesPerRow     = m_glyphCache.getBytesPerRow();
+        int16_t         canvasHeight    = static_cast<int16_t>(gfx.getHeight());
+        uint8_t         idx             = 0U;
+        uint8_t         y               = 0U;
+
+        for(y = 0U; y < glyph.height; ++y)
+        {
+            uint32_t    rowBits = 0U;
+            int16_t     x       = posX;
+            int16_t     rowY    = posY + y;
+
+            /* Left align the row bits, the MSB is the left pixel.
+             * Rows outside the canvas are skipped.
+             */
+            if ((0 <= rowY) &&
+                (canvasHeight > rowY))
+            {
+                for(idx = 0U; idx < bytesPerRow; ++idx)
+                {
+                    rowBits |= static_cast<uint32_t>(mask[idx]) << (24U - (8U * idx));
+                }
+            }
+
+            while(0U != rowBits)
+            {
+                uint16_t spanWidth = 0U;
+
+                while(0U == (rowBits & 0x80000000U))
+                {
+                    rowBits <<= 1U;
+                    ++x;
+                }
+
+                while(0U != (rowBits & 0x80000000U))
+                {
+                    rowBits <<= 1U;
+                    ++spanWidth;
+                }
+
+                /* A single pixel is cheaper drawn directly. */
+                if (1U == spanWidth)
+                {
+                    gfx.drawPixel(x, rowY, color);
+                }
+                else
+                {
+                    gfx.drawSpan(x, rowY, spanColors, spanWidth);
+                }
+                x += spanWidth;
+            }
+
+            mask += bytesPerRow;
+        }
+    }
 
 };
 
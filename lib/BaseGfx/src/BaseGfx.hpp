@@ -121,6 +121,47 @@ public:
      */
     virtual void drawPixel(int16_t x, int16_t y, const TColor& color) = 0;
 
+    /**
+     * Draw a horizontal span of pixels, starting at the given position.
+     * The span is clipped to the canvas.
+     *
+     * Overwrite it if the pixels can be written faster than one by one,
+     * e.g. by copying them directly into a framebuffer row.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors from left to right
+     * @param[in] count     Number of pixels
+     */
+    virtual void drawSpan(int16_t x, int16_t y, const TColor* colors, uint16_t count)
+    {
+        if ((nullptr != colors) &&
+            (0 <= y) &&
+            (getHeight() > y))
+        {
+            int32_t begin   = x;
+            int32_t end     = static_cast<int32_t>(x) + count;
+
+            if (0 > begin)
+            {
+                colors += -begin;
+                begin = 0;
+            }
+
+            if (getWidth() < end)
+            {
+                end = getWidth();
+            }
+
+            while(begin < end)
+            {
+                drawPixel(begin, y, *colors);
+                ++colors;
+                ++begin;
+            }
+        }
+    }
+
     /**
      * Copy framebuffer content.
      *
@@ -248,6 +248,50 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels, starting at the given position.
+     * The visible part is copied directly into the pixel buffer row.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors from left to right
+     * @param[in] count     Number of pixels
+     */
+    void drawSpan(int16_t x, int16_t y, const TColor* colors, uint16_t count) override
+    {
+        if ((nullptr != colors) &&
+            (0 <= y) &&
+            (height > y))
+        {
+            int32_t begin   = x;
+            int32_t end     = static_cast<int32_t>(x) + count;
+
+            if (0 > begin)
+            {
+                colors += -begin;
+                begin = 0;
+            }
+
+            if (width < end)
+            {
+                end = width;
+            }
+
+            if (begin < end)
+            {
+                TColor* pixel = &m_pixels[pixelMap(begin, y)];
+
+                while(begin < end)
+                {
+                    *pixel = *colors;
+                    ++pixel;
+                    ++colors;
+                    ++begin;
+                }
+            }
+        }
+    }
+
 private:
 
     /** Number of pixels in the pixel buffer. */
@@ -326,6 +370,18 @@ public:
             m_width     = 0U;
             m_height    = 0U;
         }
+        else
+        {
+            const size_t    PIXEL_BUFFER_SIZE   = m_width * m_height;
+            size_t          idx                 = 0U;
+
+            while(PIXEL_BUFFER_SIZE > idx)
+            {
+                m_pixels[idx] = bitmap.m_pixels[idx];
+
+                ++idx;
+            }
+        }
     }
 
     /**
@@ -360,9 +416,9 @@ public:
                     releasePixels(m_pixels);
                     m_width     = 0U;
                     m_height    = 0U;
-                }
 
-                m_pixels = allocatePixels(bitmap.m_width, bitmap.m_height);
+                    m_pixels = allocatePixels(bitmap.m_width, bitmap.m_height);
+                }
 
                 if (nullptr != m_pixels)
                 {
@@ -514,6 +570,51 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels, starting at the given position.
+     * The visible part is copied directly into the pixel buffer row.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors from left to right
+     * @param[in] count     Number of pixels
+     */
+    void drawSpan(int16_t x, int16_t y, const TColor* colors, uint16_t count) override
+    {
+        if ((nullptr != m_pixels) &&
+            (nullptr != colors) &&
+            (0 <= y) &&
+            (m_height > y))
+        {
+            int32_t begin   = x;
+            int32_t end     = static_cast<int32_t>(x) + count;
+
+            if (0 > begin)
+            {
+                colors += -begin;
+                begin = 0;
+            }
+
+            if (m_width < end)
+            {
+                end = m_width;
+            }
+
+            if (begin < end)
+            {
+                TColor* pixel = &m_pixels[pixelMap(begin, y)];
+
+                while(begin < end)
+                {
+                    *pixel = *colors;
+                    ++pixel;
+                    ++colors;
+                    ++begin;
+                }
+            }
+        }
+    }
+
     /**
      * Use this function to determine whether a internal bitmap buffer is allocated or not.
      * 
@@ -697,6 +798,19 @@ public:
         m_gfx.drawPixel(x, y, color);
     }
 
+    /**
+     * Draw a horizontal span of pixels, starting at the given position.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors from left to right
+     * @param[in] count     Number of pixels
+     */
+    void drawSpan(int16_t x, int16_t y, const TColor* colors, uint16_t count) override
+    {
+        m_gfx.drawSpan(x, y, colors, count);
+    }
+
 private:
 
     BaseGfx<TColor>&    m_gfx;  /**< Graphic operations, hidden behind bitmap facade. */
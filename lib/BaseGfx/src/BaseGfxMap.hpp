@@ -303,6 +303,43 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels, starting at the given position.
+     * The span is clipped to the map canvas and drawn in the underlying one.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors from left to right
+     * @param[in] count     Number of pixels
+     */
+    void drawSpan(int16_t x, int16_t y, const TColor* colors, uint16_t count) final
+    {
+        if ((nullptr != m_gfx) &&
+            (nullptr != colors) &&
+            (0 <= y) &&
+            (m_height > y))
+        {
+            int32_t begin   = x;
+            int32_t end     = static_cast<int32_t>(x) + count;
+
+            if (0 > begin)
+            {
+                colors += -begin;
+                begin = 0;
+            }
+
+            if (m_width < end)
+            {
+                end = m_width;
+            }
+
+            if (begin < end)
+            {
+                m_gfx->drawSpan(begin + m_offsX, y + m_offsY, colors, end - begin);
+            }
+        }
+    }
+
 private:
 
     BaseGfx<TColor>*    m_gfx;      /**< The underlying graphic operations. */
@@ -62,6 +62,7 @@
  * Features:
  * - Provides a text cursor
  * - Text wrap around
+ * - UTF-8 encoded texts
  */
 template < typename TColor >
 class BaseGfxText
@@ -239,6 +240,16 @@ public:
         return m_font;
     }
 
+    /**
+     * Get font.
+     *
+     * @return font
+     */
+    const BaseFont<TColor>& getFont() const
+    {
+        return m_font;
+    }
+
     /**
      * Set GFXfont.
      *
@@ -281,10 +292,12 @@ public:
 
             while('\0' != text[idx])
             {
-                uint16_t charWidth  = 0U;
-                uint16_t charHeight = 0U;
+                uint16_t    charWidth   = 0U;
+                uint16_t    charHeight  = 0U;
+                bool        isFirst     = (0U == idx);
+                uint32_t    codepoint   = Utf8::decode(text, idx);
 
-                if ('\n' == text[idx])
+                if ('\n' == codepoint)
                 {
                     if (boxWidth < lineWidth)
                     {
@@ -294,9 +307,9 @@ public:
                     lineWidth = 0U;
                     boxHeight += m_font.getHeight();
                 }
-                else if (true == m_font.getCharBoundingBox(text[idx], charWidth, charHeight))
+                else if (true == m_font.getCodepointBoundingBox(codepoint, charWidth, charHeight))
                 {
-                    if (0U == idx)
+                    if (true == isFirst)
                     {
                         boxHeight += charHeight;
                     }
@@ -324,8 +337,6 @@ public:
                 {
                     ;
                 }
-
-                ++idx;
             }
 
             if (boxWidth < lineWidth)
@@ -350,6 +361,21 @@ public:
      * @param[in] singleChar    Single character which to draw
      */
     void drawChar(BaseGfx<TColor>& gfx, char singleChar)
+    {
+        drawCodepoint(gfx, Utf8::fromChar(singleChar));
+    }
+
+    /**
+     * Draw single codepoint at current cursor position. The cursor is
+     * automatically moved to the new position. Wrap around handling is
+     * performed if configured.
+     * 
+     * A newline will place the cursor on the begin of the next line.
+     *
+     * @param[in] gfx       Graphics interface
+     * @param[in] codepoint Unicode codepoint which to draw
+     */
+    void drawCodepoint(BaseGfx<TColor>& gfx, uint32_t codepoint)
     {
         if (nullptr == m_font.getGfxFont())
         {
@@ -364,7 +390,7 @@ public:
             uint16_t charBoxWidth   = 0U;
             uint16_t charBoxHeight  = 0U;
 
-            if (true == m_font.getCharBoundingBox(singleChar, charBoxWidth, charBoxHeight))
+            if (true == m_font.getCodepointBoundingBox(codepoint, charBoxWidth, charBoxHeight))
             {
                 if (gfx.getWidth() < (m_cursorX + charBoxWidth))
                 {
@@ -374,28 +400,54 @@ public:
             }
         }
 
-        m_font.drawChar(gfx, m_cursorX, m_cursorY, singleChar, m_textColor);
+        m_font.drawCodepoint(gfx, m_cursorX, m_cursorY, codepoint, m_textColor);
     }
 
     /**
-     * Draw a text at given cursor position.
+     * Draw a UTF-8 encoded text at given cursor position.
+     *
+     * Without text wrap around, the rest of a line is skipped as soon as the
+     * cursor leaves the canvas on the right side. The cursor x-coordinate
+     * stays there until the next line starts. Drawing stops completely, if
+     * the cursor leaves the canvas at the bottom.
      *
      * @param[in] gfx   Graphics interface
      * @param[in] text  Text which to draw
      */
     void drawText(BaseGfx<TColor>& gfx, const char* text)
     {
-        size_t idx = 0U;
+        size_t          idx             = 0U;
+        const int16_t   canvasWidth     = static_cast<int16_t>(gfx.getWidth());
+        int16_t         canvasBottom    = 0;
 
-        if (nullptr == m_font)
+        if ((nullptr == text) ||
+            (nullptr == m_font.getGfxFont()))
         {
             return;
         }
 
-        while('\0' != text[idx])
+        /* A line is completely below the canvas, if the cursor is one line
+         * height below its bottom. This covers the glyph ascent.
+         */
+        canvasBottom = static_cast<int16_t>(gfx.getHeight()) + m_font.getHeight();
+
+        while(('\0' != text[idx]) &&
+              (canvasBottom > m_cursorY))
         {
-            drawChar(gfx, text[idx]);
-            ++idx;
+            /* Skip the rest of the line, if it can not be shown anymore.
+             * A line break can not be part of a multi-byte sequence, therefore
+             * skipping byte by byte is fine.
+             */
+            if ((false == m_isTextWrapEnabled) &&
+                (canvasWidth <= m_cursorX) &&
+                ('\n' != text[idx]))
+            {
+                ++idx;
+            }
+            else
+            {
+                drawCodepoint(gfx, Utf8::decode(text, idx));
+            }
         }
     }
 
@@ -0,0 +1,438 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Base glyph cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef BASE_GLYPH_CACHE_HPP
+#define BASE_GLYPH_CACHE_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <new>
+#include "gfxfont.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A cache of pre-rasterized glyphs of a single GFXfont.
+ *
+ * The glyph bitmaps of a GFXfont are bit-packed without any row alignment.
+ * The cache rasterizes a glyph on its first use into a byte aligned mask,
+ * one row after the other with the MSB as the left pixel. This allows to
+ * draw every row with horizontal spans instead of pixel by pixel.
+ *
+ * The slot size is derived from the largest glyph of the font. If all slots
+ * are in use, the least recently used glyph is evicted. The whole memory can
+ * be released at any time, it will be allocated again on the next use.
+ *
+ * Additionally the cache provides a buffer for the span colors, which is
+ * sized by the widest glyph.
+ *
+ * @tparam TColor   The color representation.
+ */
+template < typename TColor >
+class BaseGlyphCache
+{
+public:
+
+    /**
+     * Max. number of cached glyphs.
+     */
+    static const uint8_t    MAX_SLOTS       = 32U;
+
+    /**
+     * Max. glyph width in pixel, which can be cached. Fonts with wider glyphs
+     * are not cached at all.
+     */
+    static const uint8_t    MAX_GLYPH_WIDTH = 32U;
+
+    /**
+     * Constructs an empty glyph cache.
+     */
+    BaseGlyphCache() :
+        m_gfxFont(nullptr),
+        m_glyphCnt(0U),
+        m_isCacheable(false),
+        m_bytesPerRow(0U),
+        m_slotSize(0U),
+        m_slotsCnt(0U),
+        m_usedSlots(0U),
+        m_useCnt(0U),
+        m_slotOfGlyph(nullptr),
+        m_slots(nullptr),
+        m_masks(nullptr),
+        m_spanColors(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the glyph cache.
+     */
+    ~BaseGlyphCache()
+    {
+        release();
+    }
+
+    /**
+     * Get the rasterized glyph mask. If the glyph is not cached yet, it will
+     * be rasterized and maybe evicts the least recently used one.
+     *
+     * The mask contains glyph height rows, every row consists of
+     * getBytesPerRow() bytes.
+     *
+     * @param[in] gfxFont       The GFXfont, where the glyph belongs to.
+     * @param[in] glyphCnt      Number of glyphs in the GFXfont.
+     * @param[in] glyphIndex    Index of the glyph in the GFXfont.
+     *
+     * @return If the glyph is available, it will return its mask otherwise nullptr.
+     */
+    const uint8_t* get(const GFXfont& gfxFont, uint16_t glyphCnt, uint16_t glyphIndex)
+    {
+        const uint8_t* mask = nullptr;
+
+        if ((&gfxFont != m_gfxFont) ||
+            (glyphCnt != m_glyphCnt))
+        {
+            allocate(gfxFont, glyphCnt);
+        }
+
+        if ((nullptr != m_masks) &&
+            (glyphIndex < m_glyphCnt))
+        {
+            uint8_t slotIdx = m_slotOfGlyph[glyphIndex];
+
+            if (NO_SLOT == slotIdx)
+            {
+                slotIdx = getFreeSlot();
+
+                m_slotOfGlyph[glyphIndex]   = slotIdx;
+                m_slots[slotIdx].glyphIndex = glyphIndex;
+                rasterize(glyphIndex, &m_masks[slotIdx * m_slotSize]);
+            }
+
+            ++m_useCnt;
+
+            /* On overflow all glyphs become equal old. */
+            if (0U == m_useCnt)
+            {
+                uint8_t idx = 0U;
+
+                for(idx = 0U; idx < m_usedSlots; ++idx)
+                {
+                    m_slots[idx].lastUse = 0U;
+                }
+
+                m_useCnt = 1U;
+            }
+
+            m_slots[slotIdx].lastUse = m_useCnt;
+            mask = &m_masks[slotIdx * m_slotSize];
+        }
+
+        return mask;
+    }
+
+    /**
+     * Get number of bytes per mask row.
+     *
+     * @return Number of bytes per mask row
+     */
+    uint8_t getBytesPerRow() const
+    {
+        return m_bytesPerRow;
+    }
+
+    /**
+     * Get the span color buffer, filled with the given color. Use it only
+     * after a glyph mask was successfully requested.
+     *
+     * @param[in] color Color
+     * @param[in] count Number of span colors, max. the widest glyph.
+     *
+     * @return Span colors
+     */
+    const TColor* getSpanColors(const TColor& color, uint8_t count)
+    {
+        uint8_t idx = 0U;
+
+        for(idx = 0U; idx < count; ++idx)
+        {
+            m_spanColors[idx] = color;
+        }
+
+        return m_spanColors;
+    }
+
+    /**
+     * Get number of cached glyphs.
+     *
+     * @return Number of cached glyphs
+     */
+    uint8_t getCachedGlyphCnt() const
+    {
+        return m_usedSlots;
+    }
+
+    /**
+     * Release all cached glyphs and the memory.
+     */
+    void release()
+    {
+        if (nullptr != m_slotOfGlyph)
+        {
+            delete[] m_slotOfGlyph;
+            m_slotOfGlyph = nullptr;
+        }
+
+        if (nullptr != m_slots)
+        {
+            delete[] m_slots;
+            m_slots = nullptr;
+        }
+
+        if (nullptr != m_masks)
+        {
+            delete[] m_masks;
+            m_masks = nullptr;
+        }
+
+        if (nullptr != m_spanColors)
+        {
+            delete[] m_spanColors;
+            m_spanColors = nullptr;
+        }
+
+        m_gfxFont       = nullptr;
+        m_glyphCnt      = 0U;
+        m_isCacheable   = false;
+        m_bytesPerRow   = 0U;
+        m_slotSize      = 0U;
+        m_slotsCnt      = 0U;
+        m_usedSlots     = 0U;
+        m_useCnt        = 0U;
+    }
+
+private:
+
+    /**
+     * A slot contains a single rasterized glyph.
+     */
+    struct Slot
+    {
+        uint16_t    glyphIndex; /**< Index of the cached glyph in the GFXfont. */
+        uint16_t    lastUse;    /**< Use counter value of the last access. */
+    };
+
+    /** Marks a glyph, which is not cached. */
+    static const uint8_t    NO_SLOT = 0xFFU;
+
+    const GFXfont*  m_gfxFont;      /**< The GFXfont, which glyphs are cached. */
+    uint16_t        m_glyphCnt;     /**< Number of glyphs in the GFXfont. */
+    bool            m_isCacheable;  /**< Is the GFXfont cacheable? */
+    uint8_t         m_bytesPerRow;  /**< Number of bytes per mask row. */
+    uint16_t        m_slotSize;     /**< Size of a single slot mask in bytes. */
+    uint8_t         m_slotsCnt;     /**< Number of available slots. */
+    uint8_t         m_usedSlots;    /**< Number of used slots. */
+    uint16_t        m_useCnt;       /**< Use counter, to determine the least recently used glyph. */
+    uint8_t*        m_slotOfGlyph;  /**< Slot index of every glyph in the GFXfont. */
+    Slot*           m_slots;        /**< Slots */
+    uint8_t*        m_masks;        /**< Glyph masks of all slots. */
+    TColor*         m_spanColors;   /**< Span colors, used to draw a glyph row. */
+
+    BaseGlyphCache(const BaseGlyphCache& cache);
+    BaseGlyphCache& operator=(const BaseGlyphCache& cache);
+
+    /**
+     * Allocate the cache for the given GFXfont. The slot size is determined
+     * by the largest glyph.
+     *
+     * @param[in] gfxFont   GFXfont
+     * @param[in] glyphCnt  Number of glyphs in the GFXfont.
+     */
+    void allocate(const GFXfont& gfxFont, uint16_t glyphCnt)
+    {
+        uint16_t    idx         = 0U;
+        uint8_t     maxWidth    = 0U;
+        uint8_t     maxHeight   = 0U;
+
+        release();
+        m_gfxFont   = &gfxFont;
+        m_glyphCnt  = glyphCnt;
+
+        for(idx = 0U; idx < glyphCnt; ++idx)
+        {
+            const GFXglyph* glyph = &gfxFont.glyph[idx];
+
+            if (maxWidth < glyph->width)
+            {
+                maxWidth = glyph->width;
+            }
+
+            if (maxHeight < glyph->height)
+            {
+                maxHeight = glyph->height;
+            }
+        }
+
+        m_isCacheable = (MAX_GLYPH_WIDTH >= maxWidth) && (0U < maxWidth) && (0U < maxHeight);
+
+        if (true == m_isCacheable)
+        {
+            m_bytesPerRow   = (maxWidth + 7U) / 8U;
+            m_slotSize      = static_cast<uint16_t>(m_bytesPerRow) * maxHeight;
+            m_slotsCnt      = (MAX_SLOTS < glyphCnt) ? MAX_SLOTS : glyphCnt;
+            m_slotOfGlyph   = new(std::nothrow) uint8_t[glyphCnt];
+            m_slots         = new(std::nothrow) Slot[m_slotsCnt];
+            m_masks         = new(std::nothrow) uint8_t[m_slotsCnt * m_slotSize];
+            m_spanColors    = new(std::nothrow) TColor[maxWidth];
+
+            if ((nullptr == m_slotOfGlyph) ||
+                (nullptr == m_slots) ||
+                (nullptr == m_masks) ||
+                (nullptr == m_spanColors))
+            {
+                release();
+
+                /* Remember the GFXfont, to avoid allocation retries for every glyph. */
+                m_gfxFont   = &gfxFont;
+                m_glyphCnt  = glyphCnt;
+            }
+            else
+            {
+                for(idx = 0U; idx < glyphCnt; ++idx)
+                {
+                    m_slotOfGlyph[idx] = NO_SLOT;
+                }
+            }
+        }
+    }
+
+    /**
+     * Get a free slot. If all slots are used, the least recently used glyph
+     * will be evicted.
+     *
+     * @return Slot index
+     */
+    uint8_t getFreeSlot()
+    {
+        uint8_t slotIdx = 0U;
+
+        if (m_slotsCnt > m_usedSlots)
+        {
+            slotIdx = m_usedSlots;
+            ++m_usedSlots;
+        }
+        else
+        {
+            uint8_t idx = 0U;
+
+            for(idx = 1U; idx < m_slotsCnt; ++idx)
+            {
+                if (m_slots[slotIdx].lastUse > m_slots[idx].lastUse)
+                {
+                    slotIdx = idx;
+                }
+            }
+
+            m_slotOfGlyph[m_slots[slotIdx].glyphIndex] = NO_SLOT;
+        }
+
+        return slotIdx;
+    }
+
+    /**
+     * Rasterize a glyph from the bit-packed GFXfont bitmap into a byte
+     * aligned mask.
+     *
+     * @param[in]   glyphIndex  Index of the glyph in the GFXfont.
+     * @param[out]  mask        Mask buffer with the slot size.
+     */
+    void rasterize(uint16_t glyphIndex, uint8_t* mask) const
+    {
+        const GFXglyph* glyph           = &m_gfxFont->glyph[glyphIndex];
+        uint16_t        bitmapOffset    = glyph->bitmapOffset;
+        uint8_t         bitmapRowBits   = 0U;
+        uint8_t         bitCnt          = 0U;
+        uint16_t        idx             = 0U;
+        uint8_t         x               = 0U;
+        uint8_t         y               = 0U;
+
+        for(idx = 0U; idx < m_slotSize; ++idx)
+        {
+            mask[idx] = 0U;
+        }
+
+        for(y = 0U; y < glyph->height; ++y)
+        {
+            uint8_t* row = &mask[y * m_bytesPerRow];
+
+            for(x = 0U; x < glyph->width; ++x)
+            {
+                /* Every 8 bit, the bitmap offset must be increased. */
+                if (0U == (bitCnt & 0x07U))
+                {
+                    bitmapRowBits = m_gfxFont->bitmap[bitmapOffset];
+                    ++bitmapOffset;
+                }
+                ++bitCnt;
+
+                if (0U != (bitmapRowBits & 0x80U))
+                {
+                    row[x / 8U] |= static_cast<uint8_t>(0x80U >> (x % 8U));
+                }
+
+                bitmapRowBits <<= 1U;
+            }
+        }
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* BASE_GLYPH_CACHE_HPP */
+
+/** @} */
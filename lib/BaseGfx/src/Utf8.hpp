@@ -0,0 +1,193 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  UTF-8 decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** UTF-8 functions */
+namespace Utf8
+{
+
+/**
+ * A byte, which is not part of a valid UTF-8 sequence, is decoded to
+ * RAW_BYTE_BASE + byte. The result is a lone low surrogate, which is no valid
+ * codepoint. It keeps texts working, which address the font glyphs directly
+ * with single bytes like "\x8E".
+ */
+static const uint32_t RAW_BYTE_BASE = 0xDC00U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Is the codepoint a raw byte, which was not part of a valid UTF-8 sequence?
+ *
+ * @param[in] codepoint Codepoint
+ *
+ * @return If it is a raw byte, it will return true otherwise false.
+ */
+inline bool isRawByte(uint32_t codepoint)
+{
+    return ((RAW_BYTE_BASE + 0x80U) <= codepoint) &&
+           ((RAW_BYTE_BASE + 0xFFU) >= codepoint);
+}
+
+/**
+ * Get the codepoint of a single character. A character above ASCII can not
+ * be decoded without its sequence, therefore it is handled as raw byte.
+ *
+ * @param[in] singleChar    Single character
+ *
+ * @return Codepoint
+ */
+inline uint32_t fromChar(char singleChar)
+{
+    uint32_t codepoint = static_cast<uint8_t>(singleChar);
+
+    if (0x80U <= codepoint)
+    {
+        codepoint += RAW_BYTE_BASE;
+    }
+
+    return codepoint;
+}
+
+/**
+ * Decode the next codepoint of a null terminated UTF-8 text.
+ * The index is moved to the begin of the following codepoint. The null
+ * terminator is decoded like any other ASCII character, therefore the caller
+ * is responsible to stop at the end of the text.
+ *
+ * @param[in]       text    UTF-8 text
+ * @param[in,out]   idx     Index of the first byte of the codepoint in the text
+ *
+ * @return Codepoint
+ */
+inline uint32_t decode(const char* text, size_t& idx)
+{
+    const uint8_t*  bytes       = reinterpret_cast<const uint8_t*>(&text[idx]);
+    uint32_t        codepoint   = bytes[0];
+    uint8_t         seqLen      = 0U;
+    uint32_t        minValue    = 0U;
+    uint8_t         seqIdx      = 0U;
+
+    if (0x80U > codepoint)
+    {
+        /* ASCII */
+        seqLen = 1U;
+    }
+    else if (0xE0U == (codepoint & 0xE0U))
+    {
+        if (0xE0U == (codepoint & 0xF0U))
+        {
+            seqLen      = 3U;
+            codepoint  &= 0x0FU;
+            minValue    = 0x0800U;
+        }
+        else if (0xF0U == (codepoint & 0xF8U))
+        {
+            seqLen      = 4U;
+            codepoint  &= 0x07U;
+            minValue    = 0x10000U;
+        }
+        else
+        {
+            ;
+        }
+    }
+    else if (0xC0U == (codepoint & 0xE0U))
+    {
+        seqLen      = 2U;
+        codepoint  &= 0x1FU;
+        minValue    = 0x80U;
+    }
+    else
+    {
+        ;
+    }
+
+    /* Collect the continuation bytes. A null terminator stops it too. */
+    for(seqIdx = 1U; seqIdx < seqLen; ++seqIdx)
+    {
+        if (0x80U != (bytes[seqIdx] & 0xC0U))
+        {
+            break;
+        }
+
+        codepoint = (codepoint << 6U) | (bytes[seqIdx] & 0x3FU);
+    }
+
+    /* Invalid, overlong or surrogate sequences are handled byte by byte. */
+    if ((0U == seqLen) ||
+             (seqIdx < seqLen) ||
+             (minValue > codepoint) ||
+             (0x10FFFFU < codepoint) ||
+             ((0xD800U <= codepoint) && (0xDFFFU >= codepoint)))
+    {
+        codepoint = RAW_BYTE_BASE + bytes[0];
+        ++idx;
+    }
+    else
+    {
+        idx += seqLen;
+    }
+
+    return codepoint;
+}
+
+}
+
+#endif  /* UTF8_HPP */
+
+/** @} */
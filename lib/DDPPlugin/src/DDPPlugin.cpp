@@ -147,7 +147,7 @@ void DDPPlugin::onData(DDPServer::Format format, uint32_t offset, uint8_t bitsPe
     }
 
     if ((nullptr != payload) &&
-        (DDPServer::FORMAT_RGB == format) &&
+        ((DDPServer::FORMAT_RGB == format) || (DDPServer::FORMAT_HSL == format)) &&
         (24U == bitsPerPixel))
     {
         uint16_t    srcIdx          = 0U;
@@ -170,7 +170,14 @@ void DDPPlugin::onData(DDPServer::Format format, uint32_t offset, uint8_t bitsPe
                 ++byteIdx;
             }
 
-            color.set(colorCode);
+            if (DDPServer::FORMAT_HSL == format)
+            {
+                color.setHsl(Color::extractRed(colorCode), Color::extractGreen(colorCode), Color::extractBlue(colorCode));
+            }
+            else
+            {
+                color.set(colorCode);
+            }
 
             m_framebuffer.drawPixel(x, y, color);
 
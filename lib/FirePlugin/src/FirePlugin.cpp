@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "FirePlugin.h"
 
+#include <string.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -54,12 +56,30 @@
  * Local Variables
  *****************************************************************************/
 
+/* Heat palette is shared by all fire plugin instances. */
+Color   FirePlugin::m_heatPalette[UINT8_MAX + 1U];
+
+/* Heat palette is calculated by the first started plugin instance. */
+bool    FirePlugin::m_isHeatPaletteReady    = false;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void FirePlugin::start(uint16_t width, uint16_t height)
 {
+    if (false == m_isHeatPaletteReady)
+    {
+        uint16_t temperature = 0U;
+
+        for(temperature = 0U; temperature <= UINT8_MAX; ++temperature)
+        {
+            m_heatPalette[temperature] = heatColor(temperature);
+        }
+
+        m_isHeatPaletteReady = true;
+    }
+
     if (nullptr == m_heat)
     {
         m_heatSize = width * height;
@@ -69,7 +89,23 @@ void FirePlugin::start(uint16_t width, uint16_t height)
         {
             m_heatSize = 0U;
         }
+        else
+        {
+            /* The fire starts cold. */
+            memset(m_heat, 0, m_heatSize);
+        }
     }
+
+    /* Max. cool down temperature per cell (exclusive). */
+    if (0U < height)
+    {
+        m_coolingLimit = ((COOLING * 10U) / height) + 2U;
+    }
+
+    /* Seed the fast PRNG once from the Arduino PRNG. The xorshift
+     * generator must never be 0.
+     */
+    m_rngState = static_cast<uint32_t>(random(1, INT32_MAX));
 }
 
 void FirePlugin::stop()
@@ -78,6 +114,7 @@ void FirePlugin::stop()
     {
         delete[] m_heat;
         m_heat = nullptr;
+        m_heatSize = 0U;
     }
 }
 
@@ -94,76 +131,101 @@ void FirePlugin::inactive()
 
 void FirePlugin::update(YAGfx& gfx)
 {
-    int16_t x       = 0;
-    int16_t y       = 0;
-
-    if (nullptr == m_heat)
+    const uint16_t  WIDTH   = gfx.getWidth();
+    const uint16_t  HEIGHT  = gfx.getHeight();
+    const size_t    SIZE    = static_cast<size_t>(WIDTH) * HEIGHT;
+    size_t          idx     = 0U;
+    int16_t         x       = 0;
+    int16_t         y       = 0;
+
+    if ((nullptr == m_heat) ||
+        (0U == SIZE) ||
+        (m_heatSize < SIZE))
     {
         return;
     }
 
-    for(x = 0; x < gfx.getWidth(); ++x)
+    /* Step 1) Cool down every cell a little bit */
+    for(idx = 0U; idx < SIZE; ++idx)
     {
-        /* Step 1) Cool down every cell a little bit */
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            uint8_t     coolDownTemperature = random(0, ((COOLING * 10U) / gfx.getHeight()) + 2U);
-            uint32_t    heatPos             = x + y * gfx.getWidth();
+        uint16_t coolDownTemperature = randomBelow(m_coolingLimit);
 
-            if (coolDownTemperature >= m_heat[heatPos])
-            {
-                m_heat[heatPos] = 0U;
-            }
-            else
-            {
-                m_heat[heatPos] -= coolDownTemperature;
-            }
+        if (coolDownTemperature >= m_heat[idx])
+        {
+            m_heat[idx] = 0U;
+        }
+        else
+        {
+            m_heat[idx] -= coolDownTemperature;
         }
+    }
 
-        /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit */
-        for(y = 0; y < (gfx.getHeight() - 1U); ++y)
+    /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit.
+     * A row only depends on the rows below it, which are not updated yet,
+     * therefore the buffer is processed row by row from top to bottom.
+     */
+    if (1U < HEIGHT)
+    {
+        uint8_t*    row = m_heat;
+
+        for(y = 0; y < (HEIGHT - 2); ++y)
         {
-            uint16_t    diffusHeat  = 0U;
+            const uint8_t*  below1  = row + WIDTH;
+            const uint8_t*  below2  = below1 + WIDTH;
 
-            if ((gfx.getHeight() - 2U) > y)
+            for(x = 0; x < WIDTH; ++x)
             {
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 2) * gfx.getWidth()];
-                diffusHeat /= 3U;
-            }
-            else
-            {
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat /= 3U;
+                row[x] = (2U * below1[x] + below2[x]) / 3U;
             }
 
-            m_heat[x + y * gfx.getWidth()] = diffusHeat;
+            row += WIDTH;
         }
 
-        /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
-        if (random(0, 255) < SPARKING)
+        /* The row above the bottom row has only one row below it. */
         {
-            uint8_t     randValue   = random(160, 255);
-            uint32_t    heatPos     = x + (gfx.getHeight() - 1U) * gfx.getWidth();
-            uint16_t    heat        = m_heat[heatPos] + randValue;
+            const uint8_t*  below1  = row + WIDTH;
 
-            if (UINT8_MAX < heat)
+            for(x = 0; x < WIDTH; ++x)
             {
-                m_heat[heatPos] = 255U;
+                row[x] = (2U * row[x] + below1[x]) / 3U;
             }
-            else
+        }
+    }
+
+    /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
+    {
+        uint8_t* bottomRow = m_heat + (SIZE - WIDTH);
+
+        for(x = 0; x < WIDTH; ++x)
+        {
+            uint32_t randValue = nextRandom();
+
+            if ((randValue & 0xffU) < SPARKING)
             {
-                m_heat[heatPos] = heat;
+                /* Spark temperature in [160; 255[ */
+                uint8_t     spark   = 160U + (((randValue >> 8U) & 0xffU) * (255U - 160U) >> 8U);
+                uint16_t    heat    = bottomRow[x] + spark;
+
+                if (UINT8_MAX < heat)
+                {
+                    bottomRow[x] = UINT8_MAX;
+                }
+                else
+                {
+                    bottomRow[x] = heat;
+                }
             }
         }
+    }
 
-        /* Step 4) Map from heat cells to LED colors */
-        for(y = 0; y < gfx.getHeight(); ++y)
+    /* Step 4) Map from heat cells to LED colors */
+    idx = 0U;
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
         {
-            gfx.drawPixel(x, y, heatColor(m_heat[x + y * gfx.getWidth()]));
+            gfx.drawPixel(x, y, m_heatPalette[m_heat[idx]]);
+            ++idx;
         }
     }
 }
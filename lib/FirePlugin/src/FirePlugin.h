@@ -67,7 +67,10 @@
  * 3) Sometimes randomly new 'sparks' of heat are added at the bottom
  * 4) The heat from each cell is rendered as a color into the leds array
  *
- * The heat-to-color mapping uses a black-body radiation approximation.
+ * The heat-to-color mapping uses a black-body radiation approximation, which
+ * is precalculated once into a palette with one color per temperature.
+ * The random numbers are provided by a fast xorshift generator and the heat
+ * cells are stored and processed row by row.
  *
  * It was ported from https://github.com/FastLED/FastLED/blob/master/examples/Fire2012/Fire2012.ino
  */
@@ -84,7 +87,9 @@ public:
     FirePlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
         m_heat(nullptr),
-        m_heatSize(0U)
+        m_heatSize(0U),
+        m_coolingLimit(2U),
+        m_rngState(1U)
     {
     }
 
@@ -160,8 +165,16 @@ public:
 
 private:
 
-    uint8_t*    m_heat;     /**< Heat temperature [0; 255] */
-    size_t      m_heatSize; /**< Number of heat temperatures */
+    uint8_t*    m_heat;         /**< Heat temperature [0; 255], row by row */
+    size_t      m_heatSize;     /**< Number of heat temperatures */
+    uint16_t    m_coolingLimit; /**< Max. cool down temperature per cell and update (exclusive) */
+    uint32_t    m_rngState;     /**< State of the xorshift random number generator, never 0. */
+
+    /** Color per heat temperature, shared by all instances. */
+    static Color    m_heatPalette[UINT8_MAX + 1U];
+
+    /** Is the heat palette calculated? */
+    static bool     m_isHeatPaletteReady;
 
     /**
      * Cooling: How much does the air cool as it rises?
@@ -182,8 +195,39 @@ private:
      * Heat is specified as an arbitrary scale from 0 (cool) to 255 (hot).
      * This is NOT a chromatically correct 'black body radiation'
      * spectrum, but it's surprisingly close, and it's fast and small.
+     *
+     * @param[in] temperature   Heat temperature [0; 255]
+     *
+     * @return Color
+     */
+    static Color heatColor(uint8_t temperature);
+
+    /**
+     * Get next pseudo random number by xorshift32.
+     *
+     * @return Pseudo random number
+     */
+    uint32_t nextRandom()
+    {
+        m_rngState ^= m_rngState << 13U;
+        m_rngState ^= m_rngState >> 17U;
+        m_rngState ^= m_rngState << 5U;
+
+        return m_rngState;
+    }
+
+    /**
+     * Get pseudo random number in the range [0; limit[.
+     * It scales the random number by multiplication instead of a division.
+     *
+     * @param[in] limit Upper bound (exclusive)
+     *
+     * @return Pseudo random number
      */
-    Color heatColor(uint8_t temperature);
+    uint16_t randomBelow(uint16_t limit)
+    {
+        return static_cast<uint16_t>(((nextRandom() & 0xffffU) * limit) >> 16U);
+    }
 };
 
 /******************************************************************************
@@ -37,6 +37,7 @@
 #include <Arduino.h>
 #include <muMatrix8ptRegular.h>
 #include <TomThumb.h>
+#include <Util.h>
 #include <string.h>
 
 /******************************************************************************
@@ -62,7 +63,7 @@
 /**
  * 6pt font for YAGfx: TomThumb
  */
-static YAFont   gFont6pt(&TomThumb);
+static YAFont   gFont6pt(&TomThumb, TomThumbCodepoints, UTIL_ARRAY_NUM(TomThumbCodepoints));
 
 /**
  * 8pt font for YAGfx: muHeavy8ptRegular
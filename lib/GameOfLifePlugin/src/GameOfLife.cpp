@@ -0,0 +1,195 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Conways Game of Life world calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GameOfLife.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static inline void halfAdder(uint32_t a, uint32_t b, uint32_t& sum, uint32_t& carry);
+static inline void fullAdder(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** FNV-1a offset basis, used for the generation hash. */
+static const uint32_t   HASH_OFFSET_BASIS   = 2166136261U;
+
+/** FNV-1a prime, used for the generation hash. */
+static const uint32_t   HASH_PRIME          = 16777619U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+uint32_t GameOfLife::calculateNextGeneration(const uint32_t* src, uint32_t* dst, uint16_t wordsPerRow, uint16_t height)
+{
+    uint32_t    hash    = HASH_OFFSET_BASIS;
+    uint16_t    y       = 0U;
+
+    for(y = 0U; y < height; ++y)
+    {
+        uint16_t        yUp     = (0U == y) ? (height - 1U) : (y - 1U);
+        uint16_t        yDown   = ((height - 1U) == y) ? 0U : (y + 1U);
+        const uint32_t* rowUp   = &src[yUp * wordsPerRow];
+        const uint32_t* row     = &src[y * wordsPerRow];
+        const uint32_t* rowDown = &src[yDown * wordsPerRow];
+        uint32_t*       rowDst  = &dst[y * wordsPerRow];
+        uint16_t        word    = 0U;
+
+        for(word = 0U; word < wordsPerRow; ++word)
+        {
+            uint16_t    wordWest    = (0U == word) ? (wordsPerRow - 1U) : (word - 1U);
+            uint16_t    wordEast    = ((wordsPerRow - 1U) == word) ? 0U : (word + 1U);
+
+            /* Bit n is the cell at x = word * BITS + n. Shifting a row by one
+             * bit moves the west or east neighbour of every cell onto its
+             * position. The border bits are taken from the adjacent words.
+             */
+            uint32_t    upWest      = (rowUp[word] << 1U) | (rowUp[wordWest] >> (BITS - 1U));
+            uint32_t    up          = rowUp[word];
+            uint32_t    upEast      = (rowUp[word] >> 1U) | (rowUp[wordEast] << (BITS - 1U));
+            uint32_t    west        = (row[word] << 1U) | (row[wordWest] >> (BITS - 1U));
+            uint32_t    alive       = row[word];
+            uint32_t    east        = (row[word] >> 1U) | (row[wordEast] << (BITS - 1U));
+            uint32_t    downWest    = (rowDown[word] << 1U) | (rowDown[wordWest] >> (BITS - 1U));
+            uint32_t    down        = rowDown[word];
+            uint32_t    downEast    = (rowDown[word] >> 1U) | (rowDown[wordEast] << (BITS - 1U));
+            uint32_t    sumA        = 0U;
+            uint32_t    carryA      = 0U;
+            uint32_t    sumB        = 0U;
+            uint32_t    carryB      = 0U;
+            uint32_t    sumC        = 0U;
+            uint32_t    carryC      = 0U;
+            uint32_t    ones        = 0U;
+            uint32_t    carryOnes   = 0U;
+            uint32_t    sumTwos     = 0U;
+            uint32_t    carryTwosA  = 0U;
+            uint32_t    twos        = 0U;
+            uint32_t    carryTwosB  = 0U;
+            uint32_t    fours       = 0U;
+            uint32_t    next        = 0U;
+
+            /* Sum up the eight neighbours bit-sliced: ones + 2 * twos + 4 * fours */
+            fullAdder(upWest, up, upEast, sumA, carryA);
+            fullAdder(west, east, downWest, sumB, carryB);
+            halfAdder(down, downEast, sumC, carryC);
+            fullAdder(sumA, sumB, sumC, ones, carryOnes);
+            fullAdder(carryA, carryB, carryC, sumTwos, carryTwosA);
+            halfAdder(sumTwos, carryOnes, twos, carryTwosB);
+
+            /* Four or more neighbours are handled all the same. */
+            fours = carryTwosA | carryTwosB;
+
+            /* Rules:
+             * 1. Any live cell with fewer than two live neighbours dies, as if by underpopulation.
+             * 2. Any live cell with two or three live neighbours lives on to the next generation.
+             * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
+             * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
+             *
+             * Which results in: alive next time, if there are exactly three
+             * neighbours or exactly two and the cell is alive.
+             */
+            next = twos & (~fours) & (ones | alive);
+
+            rowDst[word] = next;
+
+            hash ^= next;
+            hash *= HASH_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Half adder of 32 independent bits in parallel.
+ *
+ * @param[in]   a       Summand
+ * @param[in]   b       Summand
+ * @param[out]  sum     Sum
+ * @param[out]  carry   Carry
+ */
+static inline void halfAdder(uint32_t a, uint32_t b, uint32_t& sum, uint32_t& carry)
+{
+    sum     = a ^ b;
+    carry   = a & b;
+}
+
+/**
+ * Full adder of 32 independent bits in parallel.
+ *
+ * @param[in]   a       Summand
+ * @param[in]   b       Summand
+ * @param[in]   c       Summand
+ * @param[out]  sum     Sum
+ * @param[out]  carry   Carry
+ */
+static inline void fullAdder(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry)
+{
+    uint32_t halfSum = a ^ b;
+
+    sum     = halfSum ^ c;
+    carry   = (a & b) | (c & halfSum);
+}
@@ -0,0 +1,90 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Conways Game of Life world calculation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef GAMEOFLIFE_H
+#define GAMEOFLIFE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Calculation of the Game of Life world.
+ *
+ * The cells are stored as bits, row by row. Bit n of a row word is the cell
+ * at x = word * BITS + n. The world wraps around at its borders.
+ */
+namespace GameOfLife
+{
+
+/** Number of cells per row word. */
+static const uint8_t BITS = 32U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Calculate the next generation of the whole world.
+ * Every row word is calculated at once, by summing up the eight
+ * neighbour bit masks with a bit-sliced adder.
+ *
+ * @param[in]   src         World with the current generation
+ * @param[out]  dst         World for the next generation
+ * @param[in]   wordsPerRow Number of row words per world row
+ * @param[in]   height      World height in number of rows
+ *
+ * @return Hash of the next generation
+ */
+extern uint32_t calculateNextGeneration(const uint32_t* src, uint32_t* dst, uint16_t wordsPerRow, uint16_t height);
+
+}
+
+#endif  /* GAMEOFLIFE_H */
+
+/** @} */
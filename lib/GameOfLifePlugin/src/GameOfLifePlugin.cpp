@@ -60,9 +60,16 @@
 
 void GameOfLifePlugin::start(uint16_t width, uint16_t height)
 {
-    m_width     = width;
-    m_height    = height;
-    m_gridSize  = ((m_width * m_height) + (BITS - 1U)) / BITS;
+    m_width         = width;
+    m_height        = height;
+
+    /* The world width is rounded up to whole grid data elements, which
+     * keeps the horizontal wrap around simple.
+     */
+    m_wordsPerRow   = ((m_width * WORLD_SCALE) + (BITS - 1U)) / BITS;
+    m_worldWidth    = m_wordsPerRow * BITS;
+    m_worldHeight   = m_height * WORLD_SCALE;
+    m_gridSize      = m_wordsPerRow * m_worldHeight;
 
     (void)createGrids();
 }
@@ -141,7 +148,7 @@ void GameOfLifePlugin::update(YAGfx& gfx)
         m_forceRestartTimer.restart();
         m_restartTimer.stop();
     }
-    /* If the grid is stable, keep it for a while and then restart. */
+    /* If the grid is stable or oscillates, keep it for a while and then restart. */
     else if ((true == m_restartTimer.isTimerRunning()) &&
              (true == m_restartTimer.isTimeout()))
     {
@@ -154,82 +161,31 @@ void GameOfLifePlugin::update(YAGfx& gfx)
     if ((true == isInit) &&
         (true == m_displayTimer.isTimeout()))
     {
-        int32_t cellX           = 0;
-        int32_t cellY           = 0;
-        uint8_t inactiveGrid    = (m_activeGrid + 1U) % GRIDS;
-        bool    isStable        = true;
+        uint8_t     inactiveGrid    = (m_activeGrid + 1U) % GRIDS;
+        uint32_t    hash            = GameOfLife::calculateNextGeneration(m_grids[m_activeGrid], m_grids[inactiveGrid], m_wordsPerRow, m_worldHeight);
+        bool        isRepeated      = isRepeatedGeneration(hash);
 
         /* Note: The active grid is the one, where we look how the current state of
          * every cell is. This is the grid, which is shown on the display right now.
-         * The next time cycle of the game will be drawn now on the inactive grid,
-         * which will be then shown at the end of this routine.
+         * The next time cycle of the game was calculated on the inactive grid,
+         * which will be shown now.
          *
          * After that the active grid will be inactive and vice versa.
          */
 
-        /* Handle active grid */
-        for(cellY = 0; cellY < m_height; ++cellY)
+        /* Pan the viewport slowly through the world. */
+        ++m_generation;
+
+        if (0U == (m_generation % PAN_GENERATIONS))
         {
-            for(cellX = 0; cellX < m_width; ++cellX)
-            {
-                bool    cellState       = getCellState(m_activeGrid, cellX, cellY);
-                uint8_t neighboursAlive = countAliveNeighbours(m_activeGrid, cellX, cellY);
-                bool    newState        = false;
-
-                /* Rules:
-                 * 1. Any live cell with fewer than two live neighbours dies, as if by underpopulation.
-                 * 2. Any live cell with two or three live neighbours lives on to the next generation.
-                 * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
-                 * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
-                 */
-
-                /* Dead? */
-                if (false == cellState)
-                {
-                    /* Rule 4: Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction. */
-                    if (3U == neighboursAlive)
-                    {
-                        newState = true;
-                    }
-                    /* Cell stays dead. */
-                    else
-                    {
-                        newState = false;
-                    }
-                }
-                /* Alive */
-                else
-                {
-                    /* Rule 1: Any live cell with fewer than two live neighbours dies, as if by underpopulation. */
-                    if (2U > neighboursAlive)
-                    {
-                        newState = false;
-                    }
-                    /* Rule 2: Any live cell with two or three live neighbours lives on to the next generation. */
-                    else if (4U > neighboursAlive)
-                    {
-                        newState = true;
-                    }
-                    /* Rule 3: Any live cell with more than three live neighbours dies, as if by overpopulation. */
-                    else
-                    {
-                        newState = false;
-                    }
-                }
-
-                setCellState(inactiveGrid, cellX, cellY, newState);
-
-                if (cellState != newState)
-                {
-                    isStable = false;
-                }
-            }
+            m_viewX = (m_viewX + 1U) % m_worldWidth;
+            m_viewY = (m_viewY + 1U) % m_worldHeight;
         }
 
         update(gfx, inactiveGrid);
 
-        /* If grid is stable, restart game after a period. */
-        if ((true == isStable) &&
+        /* If grid is stable or oscillates, restart game after a period. */
+        if ((true == isRepeated) &&
             (false == m_restartTimer.isTimerRunning()))
         {
             m_restartTimer.start(RESTART_PERIOD);
@@ -310,147 +266,54 @@ void GameOfLifePlugin::generateInitialPattern(uint8_t gridId)
 
         ++gridDataIndex;
     }
-}
-
-bool GameOfLifePlugin::getCellState(uint8_t gridId, int16_t x, int16_t y)
-{
-    bool isAlive = false;
-
-    if (0 > x)
-    {
-        x = m_width + x;
-    }
-    else if (m_width <= x)
-    {
-        x -= m_width;
-    }
-    else
-    {
-        ;
-    }
 
-    if (0 > y)
-    {
-        y = m_height + y;
-    }
-    else if (m_height <= y)
-    {
-        y -= m_height;
-    }
-    else
-    {
-        ;
-    }
-
-    if ((0 <= x) &&
-        (0 <= y) &&
-        (m_width > x) &&
-        (m_height > y))
-    {
-        uint32_t    cellIndex       = x + m_width * y;
-        uint32_t    cellDataIndex   = cellIndex / BITS;
-        uint8_t     bitIndex        = cellIndex - (cellDataIndex * BITS);
-
-        isAlive = (0 != (m_grids[gridId][cellDataIndex] & (1 << bitIndex)));
-    }
-
-    return isAlive;
+    m_viewX         = 0U;
+    m_viewY         = 0U;
+    m_generation    = 0U;
+    m_hashCount     = 0U;
+    m_hashIndex     = 0U;
 }
 
-void GameOfLifePlugin::setCellState(uint8_t gridId, int16_t x, int16_t y, bool state)
+bool GameOfLifePlugin::isRepeatedGeneration(uint32_t hash)
 {
-    if (0 > x)
-    {
-        x = m_width + x;
-    }
-    else if (m_width <= x)
-    {
-        x -= m_width;
-    }
-    else
-    {
-        ;
-    }
-
-    if (0 > y)
-    {
-        y = m_height + y;
-    }
-    else if (m_height <= y)
-    {
-        y -= m_height;
-    }
-    else
-    {
-        ;
-    }
+    bool    isRepeated  = false;
+    uint8_t index       = 0U;
 
-    if ((0 <= x) &&
-        (0 <= y) &&
-        (m_width > x) &&
-        (m_height > y))
+    while((m_hashCount > index) && (false == isRepeated))
     {
-        uint32_t    cellIndex       = x + m_width * y;
-        uint32_t    cellDataIndex   = cellIndex / BITS;
-        uint8_t     bitIndex        = cellIndex - (cellDataIndex * BITS);
-
-        if (false == state)
+        if (hash == m_hashes[index])
         {
-            m_grids[gridId][cellDataIndex] &= ~(1 << bitIndex);
-        }
-        else
-        {
-            m_grids[gridId][cellDataIndex] |= 1 << bitIndex;
+            isRepeated = true;
         }
+
+        ++index;
     }
-}
 
-uint8_t GameOfLifePlugin::countAliveNeighbours(uint8_t gridId, int16_t x, int16_t y)
-{
-    const int16_t   MAX_X   = 3;    /* 3 cells per row */
-    const int16_t   MAX_Y   = 3;    /* 3 cells per column */
-    uint8_t         count   = 0U;
-    int16_t         dX      = 0;
-    int16_t         dY      = 0;
-
-    /* Cell neighbours, marked with a '#':
-     * ###
-     * #x#
-     * ###
-     */
+    m_hashes[m_hashIndex] = hash;
+    m_hashIndex = (m_hashIndex + 1U) % HASH_HISTORY;
 
-    for(dY = 0; dY < MAX_Y; ++dY)
+    if (HASH_HISTORY > m_hashCount)
     {
-        int16_t neighbourY = (y - 1) + dY;
-
-        for(dX = 0; dX < MAX_X; ++dX)
-        {
-            int16_t neighbourX = (x - 1) + dX;
-
-            if ((x != neighbourX) ||
-                (y != neighbourY))
-            {
-                if (true == getCellState(gridId, neighbourX, neighbourY))
-                {
-                    ++count;
-                }
-            }
-        }
+        ++m_hashCount;
     }
 
-    return count;
+    return isRepeated;
 }
 
 void GameOfLifePlugin::update(YAGfx& gfx, uint8_t gridId)
 {
-    int16_t x   = 0;
-    int16_t y   = 0;
+    int16_t     x       = 0;
+    int16_t     y       = 0;
+    uint16_t    worldY  = m_viewY;
 
     for(y = 0; y < m_height; ++y)
     {
+        const uint32_t* row     = &m_grids[gridId][worldY * m_wordsPerRow];
+        uint16_t        worldX  = m_viewX;
+
         for(x = 0; x < m_width; ++x)
         {
-            if (false == getCellState(gridId, x, y))
+            if (0U == (row[worldX / BITS] & (1U << (worldX % BITS))))
             {
                 gfx.drawPixel(x, y, ColorDef::BLACK);
             }
@@ -458,6 +321,20 @@ void GameOfLifePlugin::update(YAGfx& gfx, uint8_t gridId)
             {
                 gfx.drawPixel(x, y, ColorDef::BLUE);
             }
+
+            ++worldX;
+
+            if (m_worldWidth <= worldX)
+            {
+                worldX = 0U;
+            }
+        }
+
+        ++worldY;
+
+        if (m_worldHeight <= worldY)
+        {
+            worldY = 0U;
         }
     }
 }
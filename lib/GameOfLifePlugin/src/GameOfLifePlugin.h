@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
+#include "GameOfLife.h"
 #include <SimpleTimer.hpp>
 
 /******************************************************************************
@@ -69,6 +70,14 @@
  * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
  * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
  *
+ * The world is larger than the display and wraps around at its borders. The
+ * display shows a viewport, which pans slowly through the world.
+ *
+ * The cells are stored as bits, row by row, and a whole row word of 32 cells
+ * is calculated at once by a bit-sliced adder of its neighbours.
+ * Repeating generations, e.g. still lifes or blinkers, are detected by the
+ * hashes of the last generations and lead to a restart.
+ *
  * See https://en.wikipedia.org/wiki/Conway%27s_Game_of_Life
  */
 class GameOfLifePlugin : public Plugin
@@ -88,6 +97,15 @@ public:
         m_grids(),
         m_width(0U),
         m_height(0U),
+        m_worldWidth(0U),
+        m_worldHeight(0U),
+        m_wordsPerRow(0U),
+        m_viewX(0U),
+        m_viewY(0U),
+        m_generation(0U),
+        m_hashes(),
+        m_hashCount(0U),
+        m_hashIndex(0U),
         m_displayTimer(),
         m_restartTimer(),
         m_forceRestartTimer()
@@ -172,8 +190,8 @@ private:
     /** Number of grids */
     static const uint8_t    GRIDS                   = 2U;
 
-    /** Bits per grid data, derived from uint32_t. */
-    static const uint8_t    BITS                    = 32U;
+    /** Bits per grid data, see GameOfLife::BITS. */
+    static const uint8_t    BITS                    = GameOfLife::BITS;
 
     /** Display update period in ms */
     static const uint32_t   DISPLAY_PERIOD          = 250U;
@@ -184,11 +202,29 @@ private:
     /** Force restart period in ms. */
     static const uint32_t   FORCE_RESTART_PERIOD    = SIMPLE_TIMER_SECONDS(10U);
 
+    /** The world is this factor larger than the display in each direction. */
+    static const uint8_t    WORLD_SCALE             = 2U;
+
+    /** Number of generations after the viewport moves one cell further. */
+    static const uint8_t    PAN_GENERATIONS         = 4U;
+
+    /** Number of last generation hashes, which are used for cycle detection. */
+    static const uint8_t    HASH_HISTORY            = 8U;
+
     uint8_t     m_activeGrid;           /**< Current active grid */
     uint32_t    m_gridSize;             /**< Size of one grid in number of elements */
     uint32_t*   m_grids[GRIDS];         /**< Two grids as playfields. */
-    uint16_t    m_width;                /**< Grid width */
-    uint16_t    m_height;               /**< Grid height */
+    uint16_t    m_width;                /**< Display width */
+    uint16_t    m_height;               /**< Display height */
+    uint16_t    m_worldWidth;           /**< World width, a multiple of the bits per grid data */
+    uint16_t    m_worldHeight;          /**< World height */
+    uint16_t    m_wordsPerRow;          /**< Number of grid data elements per world row */
+    uint16_t    m_viewX;                /**< x-coordinate of the viewport in the world */
+    uint16_t    m_viewY;                /**< y-coordinate of the viewport in the world */
+    uint32_t    m_generation;           /**< Number of generations since the last restart */
+    uint32_t    m_hashes[HASH_HISTORY]; /**< Hashes of the last generations */
+    uint8_t     m_hashCount;            /**< Number of valid hashes */
+    uint8_t     m_hashIndex;            /**< Index of the oldest hash, which will be replaced next. */
     SimpleTimer m_displayTimer;         /**< Timer, used for cyclic display update. */
     SimpleTimer m_restartTimer;         /**< Timer, used to restart the whole game of life if grid is stable. */
     SimpleTimer m_forceRestartTimer;    /**< Timer, used to force a restart of the whole game of life. */
@@ -207,45 +243,24 @@ private:
 
     /**
      * Generate a random initial pattern.
+     * The cycle detection and the viewport are reset too.
      *
      * @param[in] gridId    Id of grid, where to generate.
      */
     void generateInitialPattern(uint8_t gridId);
 
     /**
-     * Get cell state.
-     *
-     * @param[in] gridId    Id of grid, where the cell lives
-     * @param[in] x         x-coordinate of cell
-     * @param[in] y         y-coordinate of cell
-     *
-     * @return Alive (true) or dead (false).
-     */
-    bool getCellState(uint8_t gridId, int16_t x, int16_t y);
-
-    /**
-     * Set cell state.
-     *
-     * @param[in] gridId    Id of grid, where the cell lives
-     * @param[in] x         x-coordinate of cell
-     * @param[in] y         y-coordinate of cell
-     * @param[in] state     Alive (true) or dead (false).
-     */
-    void setCellState(uint8_t gridId, int16_t x, int16_t y, bool state);
-
-    /**
-     * Count all alive neighbours of cell.
+     * Check whether the generation with the given hash was already seen in
+     * the last generations and add it to the history.
      *
-     * @param[in] gridId    Id of grid, where the cell lives
-     * @param[in] x         x-coordinate of cell
-     * @param[in] y         y-coordinate of cell
+     * @param[in] hash  Hash of the generation
      *
-     * @return Number of alive neighbours.
+     * @return If it repeats a previous generation, it will return true otherwise false.
      */
-    uint8_t countAliveNeighbours(uint8_t gridId, int16_t x, int16_t y);
+    bool isRepeatedGeneration(uint32_t hash);
 
     /**
-     * Update the display with the grid.
+     * Update the display with the viewport of the grid.
      *
      * @param[in] gfx       Graphics interface
      * @param[in] gridId    Grid id
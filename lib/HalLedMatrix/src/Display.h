@@ -238,6 +238,19 @@ private:
     {
         m_ledMatrix.drawPixel(x, y, color);
     }
+
+    /**
+     * Draw a horizontal span of pixels on the display.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the span
+     * @param[in] colors    Pixel colors in RGB888 format from left to right
+     * @param[in] count     Number of pixels
+     */
+    void drawSpan(int16_t x, int16_t y, const Color* colors, uint16_t count) final
+    {
+        m_ledMatrix.drawSpan(x, y, colors, count);
+    }
 };
 
 /******************************************************************************
@@ -37,6 +37,8 @@
 
 #include <Logging.h>
 #include <ArduinoJson.h>
+#include <NativeImg.h>
+#include <ImageCache.h>
 #include <Util.h>
 
 /******************************************************************************
@@ -74,6 +76,9 @@ const char* IconTextLampPlugin::TOPIC_ICON              = "/bitmap";
 /* Initialize bitmap image filename extension. */
 const char* IconTextLampPlugin::FILE_EXT_BITMAP         = ".bmp";
 
+/* Initialize GIF image filename extension. */
+const char* IconTextLampPlugin::FILE_EXT_GIF            = ".gif";
+
 /* Initialize sprite sheet parameter filename extension. */
 const char* IconTextLampPlugin::FILE_EXT_SPRITE_SHEET   = ".sprite";
 
@@ -221,6 +226,14 @@ bool IconTextLampPlugin::setTopic(const String& topic, const JsonObject& value)
             String fullPath = jsonFullPath.as<String>();
 
             isSuccessful = loadBitmap(fullPath);
+
+            /* The uploaded bitmap image is transcoded in the context of the
+             * upload, not by the display task.
+             */
+            if (true == isSuccessful)
+            {
+                transcodeBitmap();
+            }
         }
     }
     else
@@ -279,8 +292,11 @@ bool IconTextLampPlugin::isUploadAccepted(const String& topic, const String& src
 
     if (0U != topic.equals(TOPIC_ICON))
     {
-        /* Accept upload of bitmap file. */
-        if (0U != srcFilename.endsWith(FILE_EXT_BITMAP))
+        /* Accept upload of bitmap file. A GIF image file is stored as
+         * bitmap image file too, the bitmap widget detects it by its signature.
+         */
+        if ((0U != srcFilename.endsWith(FILE_EXT_BITMAP)) ||
+            (0U != srcFilename.endsWith(FILE_EXT_GIF)))
         {
             dstFilename = getFileName(FILE_EXT_BITMAP);
 
@@ -332,6 +348,9 @@ void IconTextLampPlugin::start(uint16_t width, uint16_t height)
     m_textCanvas.setPosAndSize(ICON_WIDTH, 0, width - ICON_WIDTH, tcHeight);
     (void)m_textCanvas.addWidget(m_textWidget);
 
+    /* A scrolling text is rendered only once. */
+    m_textWidget.setPreRendering(true);
+
     /* The text widget inside the text canvas is left aligned on x-axis and
      * aligned to the center of y-axis.
      */
@@ -368,6 +387,9 @@ void IconTextLampPlugin::stop()
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* A GIF animation keeps its file open. */
+    m_bitmapWidget.suspend();
+
     if (false != FILESYSTEM.remove(getFileName(FILE_EXT_BITMAP)))
     {
         LOG_INFO("File %s removed", getFileName(FILE_EXT_BITMAP).c_str());
@@ -379,14 +401,35 @@ void IconTextLampPlugin::stop()
     }
 }
 
-void IconTextLampPlugin::update(YAGfx& gfx)
+void IconTextLampPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* The display contains the content of the previous plugin. Clear it
+     * once and repaint everything. Afterwards only the dirty canvases are
+     * repainted.
+     */
     gfx.fillScreen(ColorDef::BLACK);
-    m_iconCanvas.update(gfx);
-    m_textCanvas.update(gfx);
-    m_lampCanvas.update(gfx);
+    m_iconCanvas.invalidate();
+    m_textCanvas.invalidate();
+    m_lampCanvas.invalidate();
+}
+
+void IconTextLampPlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* Don't keep the file of a GIF animation open, while it is not shown. */
+    m_bitmapWidget.suspend();
+}
+
+void IconTextLampPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    (void)m_iconCanvas.refresh(gfx);
+    (void)m_textCanvas.refresh(gfx);
+    (void)m_lampCanvas.refresh(gfx);
 }
 
 String IconTextLampPlugin::getText() const
@@ -418,6 +461,9 @@ bool IconTextLampPlugin::loadBitmap(const String& filename)
 
     if (0U != filename.endsWith(FILE_EXT_BITMAP))
     {
+        /* The file was overwritten by the upload. */
+        ImageCache::getInstance().invalidate(filename);
+
         status = m_bitmapWidget.load(FILESYSTEM, filename);
 
         /* Ensure that only the bitmap image file exists in the filesystem,
@@ -435,6 +481,8 @@ bool IconTextLampPlugin::loadBitmap(const String& filename)
 
         bmpFilename.replace(FILE_EXT_SPRITE_SHEET, FILE_EXT_BITMAP);
 
+        ImageCache::getInstance().invalidate(bmpFilename);
+
         status = m_bitmapWidget.loadSpriteSheet(FILESYSTEM, filename,  bmpFilename);
     }
     else
@@ -484,6 +532,16 @@ void IconTextLampPlugin::setLamp(uint8_t lampId, bool state)
  * Private Methods
  *****************************************************************************/
 
+void IconTextLampPlugin::transcodeBitmap()
+{
+    NativeImg nativeImg;
+
+    if (BmpImgLoader::RET_OK != nativeImg.transcode(FILESYSTEM, getFileName(FILE_EXT_BITMAP)))
+    {
+        LOG_WARNING("Failed to transcode %s.", getFileName(FILE_EXT_BITMAP).c_str());
+    }
+}
+
 String IconTextLampPlugin::getFileName(const String& ext)
 {
     return PluginConfigFsHandler::generateFullPath(getUID(), ext);
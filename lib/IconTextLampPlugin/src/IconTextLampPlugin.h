@@ -207,6 +207,20 @@ public:
      */
     void stop() final;
 
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -296,6 +310,11 @@ private:
      */
     static const char*      FILE_EXT_BITMAP;
 
+    /**
+     * Filename extension of GIF image file.
+     */
+    static const char*      FILE_EXT_GIF;
+
     /**
      * Filename extension of sprite sheet parameter file.
      */
@@ -317,6 +336,13 @@ private:
     bool                    m_hasTopicLampsChanged;             /**< Has the topic lamps content changed? */
     bool                    m_hasTopicLampChanged[MAX_LAMPS];   /**< Has the topic lamp content changed? */
 
+    /**
+     * Transcode the bitmap image file once to the native image format, so
+     * loading it again needs no decoding anymore.
+     * The icon is already loaded, therefore the mutex is not needed.
+     */
+    void transcodeBitmap();
+
     /**
      * Get filename with path.
      * 
@@ -37,6 +37,8 @@
 
 #include <Logging.h>
 #include <ArduinoJson.h>
+#include <NativeImg.h>
+#include <ImageCache.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -67,6 +69,9 @@ const char* IconTextPlugin::TOPIC_ICON              = "/bitmap";
 /* Initialize bitmap image filename extension. */
 const char* IconTextPlugin::FILE_EXT_BITMAP         = ".bmp";
 
+/* Initialize GIF image filename extension. */
+const char* IconTextPlugin::FILE_EXT_GIF            = ".gif";
+
 /* Initialize sprite sheet parameter filename extension. */
 const char* IconTextPlugin::FILE_EXT_SPRITE_SHEET   = ".sprite";
 
@@ -149,6 +154,14 @@ bool IconTextPlugin::setTopic(const String& topic, const JsonObject& value)
             String fullPath = jsonFullPath.as<String>();
 
             isSuccessful = loadBitmap(fullPath);
+
+            /* The uploaded bitmap image is transcoded in the context of the
+             * upload, not by the display task.
+             */
+            if (true == isSuccessful)
+            {
+                transcodeBitmap();
+            }
         }
     }
     else
@@ -181,8 +194,11 @@ bool IconTextPlugin::isUploadAccepted(const String& topic, const String& srcFile
 
     if (0U != topic.equals(TOPIC_ICON))
     {
-        /* Accept upload of bitmap file. */
-        if (0U != srcFilename.endsWith(FILE_EXT_BITMAP))
+        /* Accept upload of bitmap file. A GIF image file is stored as
+         * bitmap image file too, the bitmap widget detects it by its signature.
+         */
+        if ((0U != srcFilename.endsWith(FILE_EXT_BITMAP)) ||
+            (0U != srcFilename.endsWith(FILE_EXT_GIF)))
         {
             dstFilename = getFileName(FILE_EXT_BITMAP);
 
@@ -229,6 +245,9 @@ void IconTextPlugin::start(uint16_t width, uint16_t height)
 
     /* Choose font. */
     m_textWidget.setFont(Fonts::getFontByType(m_fontType));
+
+    /* A scrolling text is rendered only once. */
+    m_textWidget.setPreRendering(true);
     
     /* The text widget inside the text canvas is left aligned on x-axis and
      * aligned to the center of y-axis.
@@ -246,6 +265,9 @@ void IconTextPlugin::stop()
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* A GIF animation keeps its file open. */
+    m_bitmapWidget.suspend();
+
     if (false != FILESYSTEM.remove(getFileName(FILE_EXT_BITMAP)))
     {
         LOG_INFO("File %s removed", getFileName(FILE_EXT_BITMAP).c_str());
@@ -257,13 +279,33 @@ void IconTextPlugin::stop()
     }
 }
 
-void IconTextPlugin::update(YAGfx& gfx)
+void IconTextPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* The display contains the content of the previous plugin. Clear it
+     * once and repaint everything. Afterwards only the dirty canvases are
+     * repainted.
+     */
     gfx.fillScreen(ColorDef::BLACK);
-    m_iconCanvas.update(gfx);
-    m_textCanvas.update(gfx);
+    m_iconCanvas.invalidate();
+    m_textCanvas.invalidate();
+}
+
+void IconTextPlugin::inactive()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* Don't keep the file of a GIF animation open, while it is not shown. */
+    m_bitmapWidget.suspend();
+}
+
+void IconTextPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    (void)m_iconCanvas.refresh(gfx);
+    (void)m_textCanvas.refresh(gfx);
 }
 
 String IconTextPlugin::getText() const
@@ -295,6 +337,9 @@ bool IconTextPlugin::loadBitmap(const String& filename)
 
     if (0U != filename.endsWith(FILE_EXT_BITMAP))
     {
+        /* The file was overwritten by the upload. */
+        ImageCache::getInstance().invalidate(filename);
+
         status = m_bitmapWidget.load(FILESYSTEM, filename);
 
         /* Ensure that only the bitmap image file exists in the filesystem,
@@ -312,6 +357,8 @@ bool IconTextPlugin::loadBitmap(const String& filename)
 
         bmpFilename.replace(FILE_EXT_SPRITE_SHEET, FILE_EXT_BITMAP);
 
+        ImageCache::getInstance().invalidate(bmpFilename);
+
         status = m_bitmapWidget.loadSpriteSheet(FILESYSTEM, filename,  bmpFilename);
     }
     else
@@ -331,6 +378,16 @@ bool IconTextPlugin::loadBitmap(const String& filename)
  * Private Methods
  *****************************************************************************/
 
+void IconTextPlugin::transcodeBitmap()
+{
+    NativeImg nativeImg;
+
+    if (BmpImgLoader::RET_OK != nativeImg.transcode(FILESYSTEM, getFileName(FILE_EXT_BITMAP)))
+    {
+        LOG_WARNING("Failed to transcode %s.", getFileName(FILE_EXT_BITMAP).c_str());
+    }
+}
+
 String IconTextPlugin::getFileName(const String& ext)
 {
     return PluginConfigFsHandler::generateFullPath(getUID(), ext);
@@ -235,6 +235,20 @@ public:
      */
     void stop() final;
 
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -297,6 +311,11 @@ private:
      */
     static const char*      FILE_EXT_BITMAP;
 
+    /**
+     * Filename extension of GIF image file.
+     */
+    static const char*      FILE_EXT_GIF;
+
     /**
      * Filename extension of sprite sheet parameter file.
      */
@@ -311,6 +330,13 @@ private:
     mutable MutexRecursive  m_mutex;            /**< Mutex to protect against concurrent access. */
     bool                    m_hasTopicChanged;  /**< Has the topic text content changed? */
 
+    /**
+     * Transcode the bitmap image file once to the native image format, so
+     * loading it again needs no decoding anymore.
+     * The icon is already loaded, therefore the mutex is not needed.
+     */
+    void transcodeBitmap();
+
     /**
      * Get filename with path.
      * 
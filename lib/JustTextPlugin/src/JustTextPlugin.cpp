@@ -153,6 +153,9 @@ void JustTextPlugin::start(uint16_t width, uint16_t height)
     /* Choose font. */
     m_textWidget.setFont(Fonts::getFontByType(m_fontType));
 
+    /* A scrolling text is rendered only once. */
+    m_textWidget.setPreRendering(true);
+
     /* The text widget is left aligned on x-axis and aligned to the center
      * of y-axis.
      */
@@ -170,12 +173,27 @@ void JustTextPlugin::stop()
     /* Nothing to do. */
 }
 
-void JustTextPlugin::update(YAGfx& gfx)
+void JustTextPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* Force a complete repaint with the next update. */
     gfx.fillScreen(ColorDef::BLACK);
-    m_textWidget.update(gfx);
+    m_textWidget.invalidate();
+}
+
+void JustTextPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* The text widget covers the whole display, therefore it is
+     * sufficient to repaint only if the text changed or scrolled.
+     */
+    if (true == m_textWidget.isDirty())
+    {
+        gfx.fillScreen(ColorDef::BLACK);
+        m_textWidget.update(gfx);
+    }
 }
 
 String JustTextPlugin::getText() const
@@ -217,6 +217,14 @@ public:
      */
     void stop() final;
     
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "MatrixPlugin.h"
 
+#include <string.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -54,100 +56,127 @@
  * Local Variables
  *****************************************************************************/
 
+/* Palette is shared by all matrix plugin instances. */
+Color   MatrixPlugin::m_palette[MatrixPlugin::AGES];
+
+/* Palette is calculated by the first started plugin instance. */
+bool    MatrixPlugin::m_isPaletteReady  = false;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-void MatrixPlugin::active(YAGfx& gfx)
-{
-    /* Clear display */
-    gfx.fillScreen(ColorDef::BLACK);
-}
-
-void MatrixPlugin::inactive()
-{
-    /* Nothing to do. */
-}
-
-void MatrixPlugin::update(YAGfx& gfx)
+void MatrixPlugin::start(uint16_t width, uint16_t height)
 {
-    if ((false == m_timer.isTimerRunning()) ||
-        (true == m_timer.isTimeout()))
+    if (false == m_isPaletteReady)
     {
         const Color     CODE_COLOR(175U, 255U, 175U);
         const Color     TRAIL_COLOR(27U, 130U, 39U);
         const uint16_t  SCALE_FACTOR_NUMERATOR      = 192U;
         const uint16_t  SCALE_FACTOR_DENOMINATOR    = 256U;
-        int16_t         x       = 0;
-        int16_t         y       = 0;
-        Color           color;
+        uint8_t         age     = 0U;
         uint8_t         red     = 0U;
         uint8_t         green   = 0U;
         uint8_t         blue    = 0U;
 
-        /* Move "matrix code" one pixel row down (higher y value) and fade each
-         * pixel a little more to dark to achieve a color trail.
-         */
-        for(y = gfx.getHeight() - 1; y > 0; --y)
-        {
-            for(x = 0; x < gfx.getWidth(); ++x)
-            {
-                /* Get pixel from one row above. */
-                color = gfx.getColor(x, y - 1);
-
-                /* If the pixel has the code color, change to first trail color. */
-                if (CODE_COLOR == color)
-                {
-                    color = TRAIL_COLOR;
-                }
-
-                /* Fade color (destructive) to dark for the trail effect. */
-                color.get(red, green, blue);
-                red = static_cast<uint16_t>(red) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                green = static_cast<uint16_t>(green) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                blue = static_cast<uint16_t>(blue) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                color.set(red, green, blue);
-
-                /* Draw pixel at current position. */
-                gfx.drawPixel(x, y, color);
-            }
-        }
-
-        /* The lowest row is handled separately, because the code color must
-         * move one row down (higher y value) for the lightning effect.
-         */
-        for(x = 0; x < gfx.getWidth(); ++x)
-        {
-            /* Get Pixel */
-            color = gfx.getColor(x, 0);
+        m_palette[AGE_CODE] = CODE_COLOR;
 
-            /* Create color trail and lightning effect. */
-            if (CODE_COLOR == color)
-            {
-                color = TRAIL_COLOR;
+        /* Every age fades the trail color (destructive) a little more to dark. */
+        TRAIL_COLOR.get(red, green, blue);
 
-                gfx.drawPixel(x, y + 1, CODE_COLOR);
-            }
-
-            /* Fade color (destructive) to dark. */
-            color.get(red, green, blue);
+        for(age = AGE_CODE + 1U; age < AGE_DARK; ++age)
+        {
             red = static_cast<uint16_t>(red) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
             green = static_cast<uint16_t>(green) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
             blue = static_cast<uint16_t>(blue) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-            color.set(red, green, blue);
 
-            gfx.drawPixel(x, y, color);
+            m_palette[age].set(red, green, blue);
         }
 
-        /* Spawn new falling "matrix code". */
-        if (0 == random(2))
+        m_palette[AGE_DARK] = ColorDef::BLACK;
+
+        m_isPaletteReady = true;
+    }
+
+    /* No rain on an empty canvas, which keeps the update away from it. */
+    if ((nullptr == m_ages) &&
+        (0U < width) &&
+        (0U < height))
+    {
+        m_ages = new(std::nothrow) uint8_t[width * height];
+
+        if (nullptr != m_ages)
         {
-            x = random(gfx.getWidth());
-            gfx.drawPixel(x, 0, CODE_COLOR);
+            m_width     = width;
+            m_height    = height;
+            m_topRow    = 0U;
+
+            memset(m_ages, AGE_DARK, m_width * m_height);
         }
+    }
+}
+
+void MatrixPlugin::stop()
+{
+    if (nullptr != m_ages)
+    {
+        delete[] m_ages;
+        m_ages = nullptr;
+    }
+
+    m_width     = 0U;
+    m_height    = 0U;
+}
+
+void MatrixPlugin::active(YAGfx& gfx)
+{
+    /* Clear display */
+    gfx.fillScreen(ColorDef::BLACK);
+
+    /* Start with a dark sky. */
+    if (nullptr != m_ages)
+    {
+        memset(m_ages, AGE_DARK, m_width * m_height);
+    }
+
+    m_timer.stop();
+}
+
+void MatrixPlugin::inactive()
+{
+    /* Nothing to do. */
+}
+
+void MatrixPlugin::update(YAGfx& gfx)
+{
+    uint16_t    x   = 0U;
+    uint16_t    y   = 0U;
+
+    if (nullptr == m_ages)
+    {
+        return;
+    }
+
+    if ((false == m_timer.isTimerRunning()) ||
+        (true == m_timer.isTimeout()))
+    {
+        moveRain();
 
         m_timer.start(UPDATE_PERIOD);
     }
+
+    /* The whole rain is drawn every time, so it doesn't depend on the
+     * display content, which may be changed by others.
+     */
+    for(y = 0U; (y < m_height) && (y < gfx.getHeight()); ++y)
+    {
+        const uint8_t* row = getRow(y);
+
+        for(x = 0U; (x < m_width) && (x < gfx.getWidth()); ++x)
+        {
+            gfx.drawPixel(x, y, m_palette[row[x]]);
+        }
+    }
 }
 
 /******************************************************************************
@@ -158,6 +187,56 @@ void MatrixPlugin::update(YAGfx& gfx)
  * Private Methods
  *****************************************************************************/
 
+void MatrixPlugin::moveRain()
+{
+    uint8_t*    row = nullptr;
+    uint16_t    x   = 0U;
+    uint32_t    idx = 0U;
+
+    /* Move the "matrix code" one row down (higher y value) by rotating the
+     * ring buffer. The former bottom row is reused as new top row, which
+     * continues the former top row. The code itself moves only from the
+     * top row to the next row, for the lightning effect. Below it becomes
+     * part of the trail.
+     */
+    if (1U < m_height)
+    {
+        m_topRow = (m_topRow + m_height - 1U) % m_height;
+
+        memcpy(getRow(0U), getRow(1U), m_width);
+    }
+
+    /* Every pixel gets older, which means it fades to dark. */
+    for(idx = 0U; idx < (static_cast<uint32_t>(m_width) * m_height); ++idx)
+    {
+        if (AGE_DARK > m_ages[idx])
+        {
+            ++m_ages[idx];
+        }
+    }
+
+    /* The code from the top row stays code in the next row. */
+    if (1U < m_height)
+    {
+        row = getRow(1U);
+
+        for(x = 0U; x < m_width; ++x)
+        {
+            if ((AGE_CODE + 1U) == row[x])
+            {
+                row[x] = AGE_CODE;
+            }
+        }
+    }
+
+    /* Spawn new falling "matrix code". */
+    if (0 == random(2))
+    {
+        x = random(m_width);
+        getRow(0U)[x] = AGE_CODE;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -57,6 +57,13 @@
 
 /**
  * Shows the effect from the film "Matrix" over the whole display.
+ *
+ * The plugin keeps the age of every pixel in its own buffer, instead of
+ * reading the colors back from the display. Age 0 is the falling code,
+ * every further age is the trail, which fades a little more to dark.
+ * The rows are organized as ring buffer, so moving the rain one row down
+ * is only a rotation of the top row index. A palette maps the ages to
+ * colors.
  */
 class MatrixPlugin : public Plugin
 {
@@ -70,7 +77,11 @@ public:
      */
     MatrixPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_timer()
+        m_timer(),
+        m_ages(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_topRow(0U)
     {
     }
 
@@ -79,6 +90,11 @@ public:
      */
     ~MatrixPlugin()
     {
+        if (nullptr != m_ages)
+        {
+            delete[] m_ages;
+            m_ages = nullptr;
+        }
     }
 
     /**
@@ -94,6 +110,29 @@ public:
         return new MatrixPlugin(name, uid);
     }
 
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * If your display layout depends on canvas or font size, calculate it
+     * here.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -121,7 +160,43 @@ private:
     /** Display update period in ms. */
     static const uint32_t   UPDATE_PERIOD   = 100U;
 
-    SimpleTimer m_timer;    /**< Updates the display in a slower period than update() is called. */
+    /** Age of the falling code. */
+    static const uint8_t    AGE_CODE        = 0U;
+
+    /** Number of ages in the palette. The last one is always black. */
+    static const uint8_t    AGES            = 32U;
+
+    /** Age of a dark pixel, it won't get older. */
+    static const uint8_t    AGE_DARK        = AGES - 1U;
+
+    SimpleTimer m_timer;    /**< Moves the rain in a slower period than update() is called. */
+    uint8_t*    m_ages;     /**< Age of every pixel, row by row in a ring buffer. */
+    uint16_t    m_width;    /**< Width of the rain in pixel */
+    uint16_t    m_height;   /**< Height of the rain in pixel */
+    uint16_t    m_topRow;   /**< Ring buffer index of the top row */
+
+    /** Color of every age, shared by all instances. */
+    static Color    m_palette[AGES];
+
+    /** Is the palette calculated? */
+    static bool     m_isPaletteReady;
+
+    /**
+     * Get a row of the ring buffer.
+     *
+     * @param[in] y y-coordinate of the row
+     *
+     * @return Ages of the row
+     */
+    uint8_t* getRow(uint16_t y)
+    {
+        return &m_ages[((m_topRow + y) % m_height) * m_width];
+    }
+
+    /**
+     * Let the rain fall one row down and spawn new code.
+     */
+    void moveRain();
 };
 
 /******************************************************************************
@@ -0,0 +1,149 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metaballs demo plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MetaballsPlugin.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Horizontal speed of every ball in angle steps per 64 ms. */
+static const uint8_t BALL_SPEED_X[MetaballsKernel::BALLS]   = { 3U, 5U, 2U };
+
+/** Vertical speed of every ball in angle steps per 64 ms. */
+static const uint8_t BALL_SPEED_Y[MetaballsKernel::BALLS]   = { 4U, 2U, 7U };
+
+/** Phase of every ball, which spreads them over the canvas at the begin. */
+static const uint8_t BALL_PHASE[MetaballsKernel::BALLS]     = { 0U, 85U, 170U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void MetaballsKernel::start(uint16_t width, uint16_t height)
+{
+    uint32_t radius = ((width < height) ? width : height) / 3U;
+
+    if (2U > radius)
+    {
+        radius = 2U;
+    }
+
+    m_width     = width;
+    m_height    = height;
+    m_strength  = (radius * radius) << 8U;
+}
+
+void MetaballsKernel::beginFrame(uint32_t time)
+{
+    uint8_t idx     = 0U;
+    uint8_t steps   = time / 64U;
+
+    for(idx = 0U; idx < BALLS; ++idx)
+    {
+        uint8_t angleX = BALL_PHASE[idx] + steps * BALL_SPEED_X[idx];
+        uint8_t angleY = BALL_PHASE[idx] + steps * BALL_SPEED_Y[idx];
+
+        m_ballX[idx] = (static_cast<int32_t>(EffectMath::sin8(angleX)) * (m_width - 1U)) >> 8U;
+        m_ballY[idx] = (static_cast<int32_t>(EffectMath::cos8(angleY)) * (m_height - 1U)) >> 8U;
+    }
+
+    m_hue = time / 32U;
+}
+
+void MetaballsKernel::renderRow(Color* row, uint16_t width, uint16_t y)
+{
+    uint32_t    dySquare[BALLS];
+    uint8_t     idx         = 0U;
+    uint16_t    x           = 0U;
+
+    for(idx = 0U; idx < BALLS; ++idx)
+    {
+        int32_t dy = static_cast<int32_t>(y) - m_ballY[idx];
+
+        dySquare[idx] = dy * dy;
+    }
+
+    for(x = 0U; x < width; ++x)
+    {
+        uint32_t field = 0U;
+
+        for(idx = 0U; idx < BALLS; ++idx)
+        {
+            int32_t dx = static_cast<int32_t>(x) - m_ballX[idx];
+
+            field += m_strength / (dx * dx + dySquare[idx] + 1U);
+        }
+
+        if (UINT8_MAX < field)
+        {
+            field = UINT8_MAX;
+        }
+
+        /* The hue changes to the outside of the balls, while they fade out. */
+        row[x].setHsv(m_hue + (UINT8_MAX - field) / 4U, UINT8_MAX, field);
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Metaballs demo plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef METABALLSPLUGIN_H
+#define METABALLSPLUGIN_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ProceduralEffectPlugin.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Metaballs kernel. Every ball has a field, which decreases with the square
+ * of the distance. The fields of all balls are summed up per pixel, which
+ * lets the balls melt together if they come close. The balls move on
+ * Lissajous curves over the canvas.
+ *
+ * It is a per-row kernel, because the vertical distance to every ball is
+ * the same for the whole row.
+ */
+class MetaballsKernel : public ProceduralEffectKernel
+{
+public:
+
+    /**
+     * Constructs the kernel.
+     */
+    MetaballsKernel() :
+        ProceduralEffectKernel(),
+        m_width(0U),
+        m_height(0U),
+        m_strength(0U),
+        m_ballX(),
+        m_ballY(),
+        m_hue(0U)
+    {
+    }
+
+    /**
+     * Destroys the kernel.
+     */
+    ~MetaballsKernel()
+    {
+    }
+
+    /**
+     * Start the kernel.
+     *
+     * @param[in] width     Canvas width in pixel
+     * @param[in] height    Canvas height in pixel
+     */
+    void start(uint16_t width, uint16_t height);
+
+    /**
+     * Prepare the next frame.
+     *
+     * @param[in] time  Time in ms since the plugin is active.
+     */
+    void beginFrame(uint32_t time);
+
+    /**
+     * Calculate all pixel colors of a row.
+     *
+     * @param[out]  row     Pixel colors from left to right
+     * @param[in]   width   Number of pixels in the row
+     * @param[in]   y       y-coordinate of the row
+     */
+    void renderRow(Color* row, uint16_t width, uint16_t y);
+
+    /** Number of balls. */
+    static const uint8_t    BALLS   = 3U;
+
+private:
+
+    uint16_t    m_width;            /**< Canvas width in pixel */
+    uint16_t    m_height;           /**< Canvas height in pixel */
+    uint32_t    m_strength;         /**< Field strength of a ball, which is 255 at its radius. */
+    int32_t     m_ballX[BALLS];     /**< x-coordinate of every ball */
+    int32_t     m_ballY[BALLS];     /**< y-coordinate of every ball */
+    uint8_t     m_hue;              /**< Hue of the ball centers */
+};
+
+/**
+ * Shows animated metaballs over the whole display.
+ */
+class MetaballsPlugin : public ProceduralEffectPlugin<MetaballsKernel>
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    MetaballsPlugin(const String& name, uint16_t uid) :
+        ProceduralEffectPlugin<MetaballsKernel>(name, uid)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~MetaballsPlugin()
+    {
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new MetaballsPlugin(name, uid);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* METABALLSPLUGIN_H */
+
+/** @} */
@@ -0,0 +1,170 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Noise field demo plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef NOISEFIELDPLUGIN_H
+#define NOISEFIELDPLUGIN_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ProceduralEffectPlugin.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Noise field kernel. The canvas is a slice through a 3D value noise, which
+ * moves along the time axis and drifts slowly to the left. The noise selects
+ * the color on the color wheel.
+ */
+class NoiseFieldKernel : public ProceduralEffectKernel
+{
+public:
+
+    /**
+     * Constructs the kernel.
+     */
+    NoiseFieldKernel() :
+        ProceduralEffectKernel(),
+        m_offsetX(0U),
+        m_offsetZ(0U),
+        m_wheelPos(0U)
+    {
+    }
+
+    /**
+     * Destroys the kernel.
+     */
+    ~NoiseFieldKernel()
+    {
+    }
+
+    /**
+     * Prepare the next frame.
+     *
+     * @param[in] time  Time in ms since the plugin is active.
+     */
+    void beginFrame(uint32_t time);
+
+    /**
+     * Calculate the color of a single pixel.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    Color getPixel(uint16_t x, uint16_t y) const
+    {
+        Color   color;
+        uint8_t noise   = EffectMath::noise8(x * CELL_SCALE + m_offsetX, y * CELL_SCALE, m_offsetZ);
+
+        /* The value noise is mostly around its middle, therefore it is
+         * doubled to use the whole color wheel.
+         */
+        color.turnColorWheel(m_wheelPos + 2U * noise);
+
+        return color;
+    }
+
+private:
+
+    /**
+     * Noise coordinate units per pixel in 8.8 fixed-point format. 48 results
+     * in a lattice cell size of about 5 pixel.
+     */
+    static const uint16_t   CELL_SCALE  = 48U;
+
+    uint16_t    m_offsetX;  /**< Drift along the x-axis in 8.8 fixed-point format */
+    uint16_t    m_offsetZ;  /**< Position on the time axis in 8.8 fixed-point format */
+    uint8_t     m_wheelPos; /**< Color wheel position, which the noise is based on. */
+};
+
+/**
+ * Shows an animated noise field over the whole display.
+ */
+class NoiseFieldPlugin : public ProceduralEffectPlugin<ProceduralPixelKernel<NoiseFieldKernel>>
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    NoiseFieldPlugin(const String& name, uint16_t uid) :
+        ProceduralEffectPlugin<ProceduralPixelKernel<NoiseFieldKernel>>(name, uid)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~NoiseFieldPlugin()
+    {
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new NoiseFieldPlugin(name, uid);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* NOISEFIELDPLUGIN_H */
+
+/** @} */
@@ -0,0 +1,171 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plasma demo plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef PLASMAPLUGIN_H
+#define PLASMAPLUGIN_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ProceduralEffectPlugin.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Plasma kernel, which sums up three sine waves: a horizontal, a vertical and
+ * a diagonal one. Every wave has its own speed. The sum selects the color on
+ * the color wheel, which is slowly turned too.
+ */
+class PlasmaKernel : public ProceduralEffectKernel
+{
+public:
+
+    /**
+     * Constructs the kernel.
+     */
+    PlasmaKernel() :
+        ProceduralEffectKernel(),
+        m_phaseX(0U),
+        m_phaseY(0U),
+        m_phaseDiagonal(0U),
+        m_wheelPos(0U)
+    {
+    }
+
+    /**
+     * Destroys the kernel.
+     */
+    ~PlasmaKernel()
+    {
+    }
+
+    /**
+     * Prepare the next frame.
+     *
+     * @param[in] time  Time in ms since the plugin is active.
+     */
+    void beginFrame(uint32_t time);
+
+    /**
+     * Calculate the color of a single pixel.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    Color getPixel(uint16_t x, uint16_t y) const
+    {
+        Color       color;
+        uint16_t    sum     = EffectMath::sin8(x * WAVE_LENGTH_SCALE + m_phaseX) +
+                              EffectMath::sin8(y * WAVE_LENGTH_SCALE + m_phaseY) +
+                              EffectMath::sin8((x + y) * (WAVE_LENGTH_SCALE / 2U) + m_phaseDiagonal);
+
+        /* The sum is in the range [3; 765], multiplying by 85 / 256 maps it
+         * nearly to [0; 255] without a division.
+         */
+        color.turnColorWheel(m_wheelPos + ((sum * 85U) >> 8U));
+
+        return color;
+    }
+
+private:
+
+    /** Angle per pixel, which defines the wave length. 16 results in 16 pixel. */
+    static const uint8_t    WAVE_LENGTH_SCALE   = 16U;
+
+    uint8_t m_phaseX;           /**< Phase of the horizontal wave */
+    uint8_t m_phaseY;           /**< Phase of the vertical wave */
+    uint8_t m_phaseDiagonal;    /**< Phase of the diagonal wave */
+    uint8_t m_wheelPos;         /**< Color wheel position, which the plasma is based on. */
+};
+
+/**
+ * Shows an animated plasma over the whole display.
+ */
+class PlasmaPlugin : public ProceduralEffectPlugin<ProceduralPixelKernel<PlasmaKernel>>
+{
+public:
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    PlasmaPlugin(const String& name, uint16_t uid) :
+        ProceduralEffectPlugin<ProceduralPixelKernel<PlasmaKernel>>(name, uid)
+    {
+    }
+
+    /**
+     * Destroys the plugin.
+     */
+    ~PlasmaPlugin()
+    {
+    }
+
+    /**
+     * Plugin creation method, used to register on the plugin manager.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     *
+     * @return If successful, it will return the pointer to the plugin instance, otherwise nullptr.
+     */
+    static IPluginMaintenance* create(const String& name, uint16_t uid)
+    {
+        return new PlasmaPlugin(name, uid);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* PLASMAPLUGIN_H */
+
+/** @} */
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <Arduino.h>
 #include <YAGfx.h>
 #include <ArduinoJson.h>
 #include <Fonts.h>
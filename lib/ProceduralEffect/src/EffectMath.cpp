@@ -0,0 +1,196 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed-point math for procedural effects
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EffectMath.h"
+
+#include <ConstTable.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Pi, used to convert the table index to radian. */
+static constexpr double PI_RAD = 3.14159265358979323846;
+
+/**
+ * Calculate the sine by its Taylor series in Horner form. Up to the 13th
+ * order the error is far below the 8-bit resolution in the range [-pi; pi].
+ *
+ * @param[in] x         Angle in radian [-pi; pi]
+ * @param[in] xSquare   Angle in radian, squared
+ *
+ * @return Sine [-1; 1]
+ */
+static constexpr double sinTaylor(double x, double xSquare)
+{
+    return x * (1.0 - xSquare / 6.0 * (1.0 - xSquare / 20.0 * (1.0 - xSquare / 42.0 *
+           (1.0 - xSquare / 72.0 * (1.0 - xSquare / 110.0 * (1.0 - xSquare / 156.0))))));
+}
+
+/**
+ * Calculate the sine of the angle in radian.
+ *
+ * @param[in] x Angle in radian [-pi; pi]
+ *
+ * @return Sine [-1; 1]
+ */
+static constexpr double sinRad(double x)
+{
+    return sinTaylor(x, x * x);
+}
+
+/**
+ * Calculate a sine table entry.
+ *
+ * @param[in] idx   Angle [0; 255], which is a full circle.
+ *
+ * @return Sine [1; 255] with 128 as zero.
+ */
+static constexpr uint8_t sinEntry(uint32_t idx)
+{
+    return static_cast<uint8_t>(128.5 + 127.0 * sinRad((static_cast<int32_t>(idx) - ((128U > idx) ? 0 : 256)) * PI_RAD / 128.0));
+}
+
+/**
+ * Calculate a fade table entry by the smoothstep function 3t^2 - 2t^3.
+ *
+ * @param[in] idx   Position [0; 255]
+ *
+ * @return Faded position [0; 255]
+ */
+static constexpr uint8_t fadeEntry(uint32_t idx)
+{
+    return static_cast<uint8_t>(0.5 + 255.0 * (idx / 256.0) * (idx / 256.0) * (3.0 - 2.0 * (idx / 256.0)));
+}
+
+/**
+ * Scramble the upper bits into the lower bits. This is invertible and
+ * therefore keeps a permutation a permutation.
+ *
+ * @param[in] value Value [0; 255]
+ * @param[in] shift Number of bits to shift right
+ *
+ * @return Scrambled value [0; 255]
+ */
+static constexpr uint32_t xorShift8(uint32_t value, uint32_t shift)
+{
+    return value ^ (value >> shift);
+}
+
+/**
+ * Calculate a permutation table entry. An odd multiplier and an addend
+ * modulo 256 is a permutation, as well as the xor shift. Their combination
+ * is a permutation, without the visible patterns of the single steps.
+ *
+ * @param[in] idx   Index [0; 255]
+ *
+ * @return Permuted index [0; 255]
+ */
+static constexpr uint8_t permutationEntry(uint32_t idx)
+{
+    return static_cast<uint8_t>(xorShift8(((xorShift8((idx * 0x9dU + 0x5bU) & 0xffU, 4U) * 0x6bU) + 0x2fU) & 0xffU, 3U));
+}
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+const uint8_t EffectMath::SIN_TABLE[UINT8_MAX + 1U]         = { CONST_TABLE_256(sinEntry) };
+
+const uint8_t EffectMath::FADE_TABLE[UINT8_MAX + 1U]        = { CONST_TABLE_256(fadeEntry) };
+
+const uint8_t EffectMath::PERMUTATION_TABLE[UINT8_MAX + 1U] = { CONST_TABLE_256(permutationEntry) };
+
+uint8_t EffectMath::noise8(uint16_t x, uint16_t y, uint16_t z)
+{
+    const uint8_t*  perm    = PERMUTATION_TABLE;
+    uint8_t         xCell   = x >> 8U;
+    uint8_t         yCell   = y >> 8U;
+    uint8_t         zCell   = z >> 8U;
+    uint8_t         xFade   = FADE_TABLE[x & 0xffU];
+    uint8_t         yFade   = FADE_TABLE[y & 0xffU];
+    uint8_t         zFade   = FADE_TABLE[z & 0xffU];
+
+    /* Hash the eight corners of the lattice cell. All indices wrap around
+     * at 256, which makes the noise periodic.
+     */
+    uint8_t         a       = perm[xCell] + yCell;
+    uint8_t         b       = perm[static_cast<uint8_t>(xCell + 1U)] + yCell;
+    uint8_t         aa      = perm[a] + zCell;
+    uint8_t         ab      = perm[static_cast<uint8_t>(a + 1U)] + zCell;
+    uint8_t         ba      = perm[b] + zCell;
+    uint8_t         bb      = perm[static_cast<uint8_t>(b + 1U)] + zCell;
+
+    /* Interpolate along x, then y and at last z. */
+    uint8_t         front   = lerp8(lerp8(perm[aa], perm[ba], xFade),
+                                    lerp8(perm[ab], perm[bb], xFade),
+                                    yFade);
+    uint8_t         back    = lerp8(lerp8(perm[static_cast<uint8_t>(aa + 1U)], perm[static_cast<uint8_t>(ba + 1U)], xFade),
+                                    lerp8(perm[static_cast<uint8_t>(ab + 1U)], perm[static_cast<uint8_t>(bb + 1U)], xFade),
+                                    yFade);
+
+    return lerp8(front, back, zFade);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,150 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed-point math for procedural effects
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef EFFECT_MATH_H
+#define EFFECT_MATH_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fixed-point math, used by the procedural effect kernels.
+ *
+ * Angles are in the range [0; 255], which is a full circle. Trigonometric
+ * results are unsigned 8-bit values, with 128 as zero. Coordinates of the
+ * noise are 8.8 fixed-point values: the high byte selects the lattice cell
+ * and the low byte is the position inside the cell.
+ *
+ * All tables are calculated at compile time and stored in flash.
+ */
+namespace EffectMath
+{
+
+/** Sine of a full circle, [1; 255] with 128 as zero. */
+extern const uint8_t SIN_TABLE[UINT8_MAX + 1U];
+
+/** Smoothstep fade curve, used to interpolate between the noise lattice points. */
+extern const uint8_t FADE_TABLE[UINT8_MAX + 1U];
+
+/** Permutation of [0; 255], used to hash the noise lattice points. */
+extern const uint8_t PERMUTATION_TABLE[UINT8_MAX + 1U];
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the sine of an angle.
+ *
+ * @param[in] angle Angle [0; 255], which is a full circle.
+ *
+ * @return Sine [1; 255] with 128 as zero.
+ */
+inline uint8_t sin8(uint8_t angle)
+{
+    return SIN_TABLE[angle];
+}
+
+/**
+ * Get the cosine of an angle.
+ *
+ * @param[in] angle Angle [0; 255], which is a full circle.
+ *
+ * @return Cosine [1; 255] with 128 as zero.
+ */
+inline uint8_t cos8(uint8_t angle)
+{
+    return SIN_TABLE[static_cast<uint8_t>(angle + 64U)];
+}
+
+/**
+ * Scale a value by a factor, which is interpreted as fraction of 256.
+ *
+ * @param[in] value Value [0; 255]
+ * @param[in] scale Scale factor [0; 255]
+ *
+ * @return Scaled value
+ */
+inline uint8_t scale8(uint8_t value, uint8_t scale)
+{
+    return (static_cast<uint16_t>(value) * scale) >> 8U;
+}
+
+/**
+ * Linear interpolation between two values.
+ *
+ * @param[in] from      Value at fraction 0
+ * @param[in] to        Value at fraction 256
+ * @param[in] fraction  Fraction [0; 255]
+ *
+ * @return Interpolated value
+ */
+inline uint8_t lerp8(uint8_t from, uint8_t to, uint8_t fraction)
+{
+    return from + ((static_cast<int16_t>(to) - from) * fraction) / 256;
+}
+
+/**
+ * Get the 3D value noise at the given position. Neighboured positions
+ * result in similar values, which makes it smooth. The third dimension
+ * is usually the time, which lets the noise field evolve.
+ *
+ * @param[in] x x-coordinate in 8.8 fixed-point format
+ * @param[in] y y-coordinate in 8.8 fixed-point format
+ * @param[in] z z-coordinate in 8.8 fixed-point format
+ *
+ * @return Noise [0; 255]
+ */
+extern uint8_t noise8(uint16_t x, uint16_t y, uint16_t z);
+
+}
+
+#endif  /* EFFECT_MATH_H */
+
+/** @} */
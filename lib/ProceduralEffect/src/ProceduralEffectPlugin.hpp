@@ -0,0 +1,331 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Procedural effect plugin
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef PROCEDURAL_EFFECT_PLUGIN_HPP
+#define PROCEDURAL_EFFECT_PLUGIN_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <new>
+#include <Plugin.hpp>
+
+#include "EffectMath.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Base of a procedural effect kernel.
+ *
+ * A kernel calculates the effect only by the pixel coordinates and the
+ * time, which makes it independent of the previous frame. It is bound at
+ * compile time to the plugin, therefore its methods are not virtual and
+ * a kernel hides the ones it needs:
+ * - start(): Called once with the canvas size, e.g. to allocate buffers.
+ * - stop(): Called once before the plugin is destroyed.
+ * - beginFrame(): Called before every frame with the time in ms since the
+ *   plugin is active. Calculate everything here which is constant over
+ *   the whole frame.
+ * - renderRow(): Calculate all pixel colors of a row.
+ *
+ * A per-pixel kernel provides getPixel() instead of renderRow() and is
+ * wrapped by the ProceduralPixelKernel.
+ */
+class ProceduralEffectKernel
+{
+public:
+
+    /**
+     * Start the kernel.
+     *
+     * @param[in] width     Canvas width in pixel
+     * @param[in] height    Canvas height in pixel
+     */
+    void start(uint16_t width, uint16_t height)
+    {
+        PLUGIN_NOT_USED(width);
+        PLUGIN_NOT_USED(height);
+    }
+
+    /**
+     * Stop the kernel.
+     */
+    void stop()
+    {
+    }
+
+    /**
+     * Prepare the next frame.
+     *
+     * @param[in] time  Time in ms since the plugin is active.
+     */
+    void beginFrame(uint32_t time)
+    {
+        PLUGIN_NOT_USED(time);
+    }
+
+protected:
+
+    /**
+     * Constructs the kernel.
+     */
+    ProceduralEffectKernel()
+    {
+    }
+
+    /**
+     * Destroys the kernel.
+     */
+    ~ProceduralEffectKernel()
+    {
+    }
+};
+
+/**
+ * Adapts a per-pixel kernel to the row interface, which the procedural effect
+ * plugin requires. The pixel kernel shall provide
+ * Color getPixel(uint16_t x, uint16_t y), which is inlined into the row loop.
+ *
+ * @tparam TPixelKernel The per-pixel kernel.
+ */
+template < typename TPixelKernel >
+class ProceduralPixelKernel : public TPixelKernel
+{
+public:
+
+    /**
+     * Calculate all pixel colors of a row.
+     *
+     * @param[out]  row     Pixel colors from left to right
+     * @param[in]   width   Number of pixels in the row
+     * @param[in]   y       y-coordinate of the row
+     */
+    void renderRow(Color* row, uint16_t width, uint16_t y)
+    {
+        uint16_t x = 0U;
+
+        for(x = 0U; x < width; ++x)
+        {
+            row[x] = TPixelKernel::getPixel(x, y);
+        }
+    }
+};
+
+/**
+ * The procedural effect plugin runs a kernel over the whole canvas. It renders
+ * row by row into a row buffer and writes every row as a single span. The
+ * kernel is a template parameter, which allows the compiler to inline it into
+ * the row loop.
+ *
+ * A new effect is only a kernel and a plugin, which derives from this one
+ * and provides the create() method for the plugin manager.
+ *
+ * @tparam TKernel  The kernel, see ProceduralEffectKernel.
+ */
+template < typename TKernel >
+class ProceduralEffectPlugin : public Plugin
+{
+public:
+
+    /**
+     * Destroys the plugin.
+     */
+    virtual ~ProceduralEffectPlugin()
+    {
+        releaseRow();
+    }
+
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * If your display layout depends on canvas or font size, calculate it
+     * here.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) override
+    {
+        if ((nullptr == m_row) &&
+            (0U < width) &&
+            (0U < height))
+        {
+            m_row = new(std::nothrow) Color[width];
+
+            if (nullptr != m_row)
+            {
+                m_width     = width;
+                m_height    = height;
+
+                m_kernel.start(width, height);
+            }
+        }
+    }
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() override
+    {
+        if (nullptr != m_row)
+        {
+            m_kernel.stop();
+        }
+
+        releaseRow();
+    }
+
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) override
+    {
+        PLUGIN_NOT_USED(gfx);
+
+        m_timestamp = millis();
+    }
+
+    /**
+     * Update the display.
+     * The scheduler will call this method periodically.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void update(YAGfx& gfx) override
+    {
+        uint16_t    width   = gfx.getWidth();
+        uint16_t    height  = gfx.getHeight();
+        uint16_t    y       = 0U;
+
+        if (nullptr == m_row)
+        {
+            return;
+        }
+
+        /* The kernel is only prepared for the canvas size, given by start(). */
+        if (m_width < width)
+        {
+            width = m_width;
+        }
+
+        if (m_height < height)
+        {
+            height = m_height;
+        }
+
+        m_kernel.beginFrame(millis() - m_timestamp);
+
+        for(y = 0U; y < height; ++y)
+        {
+            m_kernel.renderRow(m_row, width, y);
+            gfx.drawSpan(0, y, m_row, width);
+        }
+    }
+
+protected:
+
+    TKernel m_kernel;   /**< The effect kernel */
+
+    /**
+     * Constructs the plugin.
+     *
+     * @param[in] name  Plugin name
+     * @param[in] uid   Unique id
+     */
+    ProceduralEffectPlugin(const String& name, uint16_t uid) :
+        Plugin(name, uid),
+        m_kernel(),
+        m_row(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_timestamp(0U)
+    {
+    }
+
+private:
+
+    Color*      m_row;          /**< Row buffer, which the kernel renders into. */
+    uint16_t    m_width;        /**< Canvas width in pixel, given by start() */
+    uint16_t    m_height;       /**< Canvas height in pixel, given by start() */
+    uint32_t    m_timestamp;    /**< Timestamp in ms, when the plugin was set active. */
+
+    ProceduralEffectPlugin();
+    ProceduralEffectPlugin(const ProceduralEffectPlugin& plugin);
+    ProceduralEffectPlugin& operator=(const ProceduralEffectPlugin& plugin);
+
+    /**
+     * Release the row buffer if allocated.
+     */
+    void releaseRow()
+    {
+        if (nullptr != m_row)
+        {
+            delete[] m_row;
+            m_row = nullptr;
+        }
+
+        m_width     = 0U;
+        m_height    = 0U;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* PROCEDURAL_EFFECT_PLUGIN_HPP */
+
+/** @} */
@@ -58,22 +58,70 @@
  * Public Methods
  *****************************************************************************/
 
+void RainbowPlugin::start(uint16_t width, uint16_t height)
+{
+    if ((nullptr == m_colors) &&
+        (0U < width) &&
+        (0U < height))
+    {
+        m_colorsSize    = width + height - 1U;
+        m_colors        = new(std::nothrow) Color[m_colorsSize];
+
+        if (nullptr == m_colors)
+        {
+            m_colorsSize = 0U;
+        }
+    }
+}
+
+void RainbowPlugin::stop()
+{
+    if (nullptr != m_colors)
+    {
+        delete[] m_colors;
+        m_colors = nullptr;
+        m_colorsSize = 0U;
+    }
+}
+
 void RainbowPlugin::update(YAGfx& gfx)
 {
     int16_t x       = 0;
     int16_t y       = 0;
-    uint8_t angle   = m_angle;
-    Color   color;
 
-    for(x = 0; x < gfx.getWidth(); ++x)
+    /* Use the color strip if available, which needs only one color wheel
+     * lookup per diagonal.
+     */
+    if ((nullptr != m_colors) &&
+        ((gfx.getWidth() + gfx.getHeight() - 1U) <= m_colorsSize))
     {
+        Color::fillColorWheel(m_colors, m_colorsSize, m_angle, ANGLE_DELTA);
+
         for(y = 0; y < gfx.getHeight(); ++y)
         {
-            color.turnColorWheel(angle + y * ANGLE_DELTA);
-            gfx.drawPixel(x, y, color);
+            const Color* row = &m_colors[y];
+
+            for(x = 0; x < gfx.getWidth(); ++x)
+            {
+                gfx.drawPixel(x, y, row[x]);
+            }
         }
+    }
+    else
+    {
+        uint8_t angle   = m_angle;
+        Color   color;
 
-        angle += ANGLE_DELTA;
+        for(x = 0; x < gfx.getWidth(); ++x)
+        {
+            for(y = 0; y < gfx.getHeight(); ++y)
+            {
+                color.turnColorWheel(angle + y * ANGLE_DELTA);
+                gfx.drawPixel(x, y, color);
+            }
+
+            angle += ANGLE_DELTA;
+        }
     }
 
     m_angle += ANGLE_DELTA;
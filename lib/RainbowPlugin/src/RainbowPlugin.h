@@ -56,6 +56,11 @@
 
 /**
  * Shows a rainbow over the whole display. Moving from left to right.
+ *
+ * Every pixel gets the color wheel position of its left neighbour plus one
+ * step, and the same applies to its upper neighbour. Therefore all pixels
+ * on a diagonal have the same color. Only one strip of (width + height - 1)
+ * colors is calculated per update and each row shows it shifted by one.
  */
 class RainbowPlugin : public Plugin
 {
@@ -69,7 +74,9 @@ public:
      */
     RainbowPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_angle(0U)
+        m_angle(0U),
+        m_colors(nullptr),
+        m_colorsSize(0U)
     {
     }
 
@@ -78,6 +85,11 @@ public:
      */
     ~RainbowPlugin()
     {
+        if (nullptr != m_colors)
+        {
+            delete[] m_colors;
+            m_colors = nullptr;
+        }
     }
 
     /**
@@ -93,6 +105,29 @@ public:
         return new RainbowPlugin(name, uid);
     }
 
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * If your display layout depends on canvas or font size, calculate it
+     * here.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -106,7 +141,9 @@ private:
     /** Angle step delta in degree, used for the color wheel. */
     static const uint8_t    ANGLE_DELTA = 1U;
 
-    uint8_t m_angle;    /**< Current color wheel angle */
+    uint8_t     m_angle;        /**< Current color wheel angle */
+    Color*      m_colors;       /**< Color strip, which is shown shifted in every row. */
+    uint16_t    m_colorsSize;   /**< Number of colors in the strip */
 };
 
 /******************************************************************************
@@ -109,7 +109,7 @@ bool SignalDetectorPlugin::setTopic(const String& topic, const JsonObject& value
 
     if (0U != topic.equals(TOPIC_CONFIG))
     {
-        const size_t        JSON_DOC_SIZE           = 512U;
+        const size_t        JSON_DOC_SIZE           = 1024U;
         DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
         JsonObject          jsonCfg                 = jsonDoc.to<JsonObject>();
         JsonArrayConst      jsonTones               = value["tones"];
@@ -145,7 +145,7 @@ bool SignalDetectorPlugin::setTopic(const String& topic, const JsonObject& value
 
             for(JsonVariantConst tone : jsonTones)
             {
-                if (AudioService::MAX_TONE_DETECTORS <= toneIdx)
+                if (AudioToneDetector::MAX_TONES <= toneIdx)
                 {
                     break;
                 }
@@ -403,21 +403,17 @@ void SignalDetectorPlugin::requestStoreToPersistentMemory()
 void SignalDetectorPlugin::getConfiguration(JsonObject& jsonCfg) const
 {
     MutexGuard<MutexRecursive>  guard(m_mutex);
-    uint8_t                     idx             = 0U;
-    JsonArray                   jsonTones       = jsonCfg.createNestedArray("tones");
+    uint8_t                     idx                 = 0U;
+    JsonArray                   jsonTones           = jsonCfg.createNestedArray("tones");
+    AudioToneDetector*          audioToneDetector   = AudioService::getInstance().getAudioToneDetector();
 
-    while(AudioService::MAX_TONE_DETECTORS > idx)
+    while((nullptr != audioToneDetector) && (AudioToneDetector::MAX_TONES > idx))
     {
-        AudioToneDetector*  audioToneDetector   = AudioService::getInstance().getAudioToneDetector(idx);
+        JsonObject jsonTone = jsonTones.createNestedObject();
 
-        if (nullptr != audioToneDetector)
-        {
-            JsonObject jsonTone = jsonTones.createNestedObject();
-
-            jsonTone["frequency"]   = audioToneDetector->getTargetFreq();
-            jsonTone["minDuration"] = audioToneDetector->getMinDuration();
-            jsonTone["threshold"]   = audioToneDetector->getThreshold();
-        }
+        jsonTone["frequency"]   = audioToneDetector->getTargetFreq(idx);
+        jsonTone["minDuration"] = audioToneDetector->getMinDuration(idx);
+        jsonTone["threshold"]   = audioToneDetector->getThreshold(idx);
 
         ++idx;
     }
@@ -448,15 +444,15 @@ bool SignalDetectorPlugin::setConfiguration(JsonObjectConst& jsonCfg)
     else
     {
         MutexGuard<MutexRecursive>  guard(m_mutex);
-        uint8_t                     idx = 0U;
+        uint8_t                     idx                 = 0U;
+        AudioToneDetector*          audioToneDetector   = AudioService::getInstance().getAudioToneDetector();
 
         status = true;
 
         for(JsonVariantConst tone : jsonTones)
         {
-            AudioToneDetector* audioToneDetector = AudioService::getInstance().getAudioToneDetector(idx);
-
-            if (nullptr == audioToneDetector)
+            if ((nullptr == audioToneDetector) ||
+                (AudioToneDetector::MAX_TONES <= idx))
             {
                 LOG_WARNING("Too many tone detector configurations.");
                 break;
@@ -484,9 +480,9 @@ bool SignalDetectorPlugin::setConfiguration(JsonObjectConst& jsonCfg)
                 }
                 else
                 {
-                    audioToneDetector->setTargetFreq(jsonTargetFreq.as<float>());
-                    audioToneDetector->setMinDuration(jsonMinDuration.as<uint32_t>());
-                    audioToneDetector->setThreshold(jsonThreshold.as<float>());
+                    audioToneDetector->setTargetFreq(idx, jsonTargetFreq.as<float>());
+                    audioToneDetector->setMinDuration(idx, jsonMinDuration.as<uint32_t>());
+                    audioToneDetector->setThreshold(idx, jsonThreshold.as<float>());
 
                     ++idx;
                 }
@@ -585,40 +581,34 @@ void SignalDetectorPlugin::initHttpClient()
 
 bool SignalDetectorPlugin::isSignalDetected()
 {
-    uint8_t idx                         = 0U;
-    bool    isDetected                  = false;
-    uint8_t countDetectedTones          = 0U;
-    uint8_t countEnabledToneDetectors   = 0U;
-
-    /* Every enabled tone detector must be considered.
-     * A target frequency of 0 Hz means, the tone detector is disabled.
+    uint8_t             idx                 = 0U;
+    bool                isDetected          = false;
+    uint8_t             countDetectedTones  = 0U;
+    uint8_t             countEnabledTones   = 0U;
+    AudioToneDetector*  audioToneDetector   = AudioService::getInstance().getAudioToneDetector();
+
+    /* Every enabled tone must be considered.
+     * A target frequency of 0 Hz means, the tone is disabled.
      */
-    while(AudioService::MAX_TONE_DETECTORS > idx)
+    while((nullptr != audioToneDetector) && (AudioToneDetector::MAX_TONES > idx))
     {
-        AudioToneDetector* audioToneDetector = AudioService::getInstance().getAudioToneDetector(idx);
-
-        if (nullptr != audioToneDetector)
+        if (true == audioToneDetector->isEnabled(idx))
         {
-            float freq = audioToneDetector->getTargetFreq();
+            ++countEnabledTones;
 
-            if ((AudioToneDetector::EPSILON < freq) || (-AudioToneDetector::EPSILON > freq))
+            if (true == audioToneDetector->isTargetFreqDetected(idx))
             {
-                ++countEnabledToneDetectors;
-
-                if (true == audioToneDetector->isTargetFreqDetected())
-                {
-                    LOG_INFO("Freq %u detected with magnitude %0.0f.", idx, audioToneDetector->getLastMagnitude());
+                LOG_INFO("Freq %u detected with magnitude %0.0f.", idx, audioToneDetector->getLastMagnitude(idx));
 
-                    ++countDetectedTones;
-                }
+                ++countDetectedTones;
             }
         }
 
         ++idx;
     }
 
-    if ((0U < countEnabledToneDetectors) &&
-        (countDetectedTones == countEnabledToneDetectors))
+    if ((0U < countEnabledTones) &&
+        (countDetectedTones == countEnabledTones))
     {
         isDetected = true;
     }
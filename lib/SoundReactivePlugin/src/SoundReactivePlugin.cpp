@@ -60,27 +60,6 @@
 /* Initialize plugin topic. */
 const char*     SoundReactivePlugin::TOPIC_CONFIG                       = "/config";
 
-/* Initialize the list with the high edge frequency bin of the center band frequency. */
-const uint16_t  SoundReactivePlugin::LIST_16_BAND_HIGH_EDGE_FREQ_BIN[]  =
-{
-    4U,
-    5U,
-    7U,
-    9U,
-    12U,
-    16U,
-    21U,
-    27U,
-    36U,
-    48U,
-    63U,
-    84U,
-    111U,
-    146U,
-    193U,
-    255U
-};
-
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -113,6 +92,7 @@ bool SoundReactivePlugin::setTopic(const String& topic, const JsonObject& value)
         DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
         JsonObject          jsonCfg                 = jsonDoc.to<JsonObject>();
         JsonVariantConst    jsonFreqBandLen         = value["freqBandLen"];
+        JsonVariantConst    jsonFreqBandScale       = value["freqBandScale"];
 
         /* The received configuration may not contain all single key/value pair.
          * Therefore read first the complete internal configuration and
@@ -131,6 +111,12 @@ bool SoundReactivePlugin::setTopic(const String& topic, const JsonObject& value)
             isSuccessful = true;
         }
 
+        if (false == jsonFreqBandScale.isNull())
+        {
+            jsonCfg["freqBandScale"] = jsonFreqBandScale.as<String>();
+            isSuccessful = true;
+        }
+
         if (true == isSuccessful)
         {
             JsonObjectConst jsonCfgConst = jsonCfg;
@@ -162,23 +148,13 @@ bool SoundReactivePlugin::hasTopicChanged(const String& topic)
 
 void SoundReactivePlugin::start(uint16_t width, uint16_t height)
 {
-    SpectrumAnalyzer*           spectrumAnalyzer = AudioService::getInstance().getSpectrumAnalyzer();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     PLUGIN_NOT_USED(width);
 
-    if (nullptr != spectrumAnalyzer)
-    {
-        m_freqBins = new(std::nothrow) float[spectrumAnalyzer->getFreqBinsLen()];
-
-        if (nullptr == m_freqBins)
-        {
-            LOG_ERROR("Couldn't get memory for frequency bins.");
-        }
-    }
-
     m_decayPeakTimer.start(DECAY_PEAK_PERIOD);
     m_maxHeight = height;
+    m_isFreqBandsReq = true;
 
     /* Try to load configuration. If there is no configuration available, a default configuration
      * will be created.
@@ -209,18 +185,24 @@ void SoundReactivePlugin::stop()
     m_cfgReloadTimer.stop();
     m_decayPeakTimer.stop();
 
-    if (nullptr != m_freqBins)
-    {
-        delete[] m_freqBins;
-        m_freqBins = nullptr;
-    }
-
     if (false != FILESYSTEM.remove(configurationFilename))
     {
         LOG_INFO("File %s removed", configurationFilename.c_str());
     }
 }
 
+void SoundReactivePlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    PLUGIN_NOT_USED(gfx);
+
+    /* Another plugin instance may have configured a different number or
+     * scale of frequency bands in the meantime.
+     */
+    m_isFreqBandsReq = true;
+}
+
 void SoundReactivePlugin::process(bool isConnected)
 {
     SpectrumAnalyzer*           spectrumAnalyzer = AudioService::getInstance().getSpectrumAnalyzer();
@@ -267,21 +249,35 @@ void SoundReactivePlugin::process(bool isConnected)
 
     decayPeak();
 
-    if (nullptr != spectrumAnalyzer)
+    /* The spectrum analyzer provides the frequency bands in the configured
+     * scale and number, therefore they can be shown directly.
+     */
+    if ((nullptr != spectrumAnalyzer) &&
+        (true == m_isFreqBandsReq))
     {
-        if (true == spectrumAnalyzer->areFreqBinsReady())
+        if (false == spectrumAnalyzer->setFreqBands(m_freqBandScale, m_numOfFreqBands))
         {
-            uint8_t         bandIdx     = 0U;
-            const size_t    freqBinLen  = spectrumAnalyzer->getFreqBinsLen();
+            LOG_WARNING("Frequency bands not supported: %u", m_numOfFreqBands);
+        }
 
-            if (nullptr != m_freqBins)
-            {
-                /* Copy frequency bins from spectrum analyzer. */
-                if (true == spectrumAnalyzer->getFreqBins(m_freqBins, freqBinLen))
-                {
-                    handleFreqBins(m_freqBins, freqBinLen);
-                }
-            }
+        m_isFreqBandsReq = false;
+    }
+
+    /* New spectrum available? */
+    if ((nullptr != spectrumAnalyzer) &&
+        (m_spectrumSequence != spectrumAnalyzer->getSequence()))
+    {
+        float freqBands[MAX_FREQ_BANDS];
+
+        /* Only the frequency bands are copied, not the whole spectrum.
+         * It fails as long as the spectrum has a different number of
+         * frequency bands.
+         */
+        if (true == spectrumAnalyzer->getFreqBands(freqBands, m_numOfFreqBands))
+        {
+            m_spectrumSequence = spectrumAnalyzer->getSequence();
+
+            handleFreqBands(freqBands);
         }
     }
 }
@@ -292,6 +288,12 @@ void SoundReactivePlugin::update(YAGfx& gfx)
     uint16_t                    barWidth        = gfx.getWidth() / m_numOfFreqBands;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
+    /* If the display is too small for all bands, the outer ones are cut. */
+    if (0U == barWidth)
+    {
+        barWidth = 1U;
+    }
+
     gfx.fillScreen(ColorDef::BLACK);
     
     for(bandIdx = 0U; bandIdx < m_numOfFreqBands; ++bandIdx)
@@ -350,13 +352,15 @@ void SoundReactivePlugin::getConfiguration(JsonObject& jsonCfg) const
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
-    jsonCfg["freqBandLen"] = m_numOfFreqBands;
+    jsonCfg["freqBandLen"]      = m_numOfFreqBands;
+    jsonCfg["freqBandScale"]    = (FREQ_BAND_SCALE_MEL == m_freqBandScale) ? "mel" : "log";
 }
 
 bool SoundReactivePlugin::setConfiguration(JsonObjectConst& jsonCfg)
 {
-    bool                status          = false;
-    JsonVariantConst    jsonFreqBandLen = jsonCfg["freqBandLen"];
+    bool                status              = false;
+    JsonVariantConst    jsonFreqBandLen     = jsonCfg["freqBandLen"];
+    JsonVariantConst    jsonFreqBandScale   = jsonCfg["freqBandScale"];
 
     if (false == jsonFreqBandLen.is<uint8_t>())
     {
@@ -364,10 +368,20 @@ bool SoundReactivePlugin::setConfiguration(JsonObjectConst& jsonCfg)
     }
     else
     {
-        NumOfBands numOfBands = static_cast<NumOfBands>(jsonFreqBandLen.as<uint8_t>());
+        NumOfBands      numOfBands  = static_cast<NumOfBands>(jsonFreqBandLen.as<uint8_t>());
+        FreqBandScale   scale       = FREQ_BAND_SCALE_LOG;
+
+        /* The scale is optional, because older configurations don't have it. */
+        if ((true == jsonFreqBandScale.is<String>()) &&
+            (jsonFreqBandScale.as<String>() == "mel"))
+        {
+            scale = FREQ_BAND_SCALE_MEL;
+        }
 
         if ((NUM_OF_BANDS_8 != numOfBands) &&
-            (NUM_OF_BANDS_16 != numOfBands))
+            (NUM_OF_BANDS_16 != numOfBands) &&
+            (NUM_OF_BANDS_24 != numOfBands) &&
+            (NUM_OF_BANDS_32 != numOfBands))
         {
             LOG_WARNING("freqBandLen not found or invalid type.");
         }
@@ -375,7 +389,13 @@ bool SoundReactivePlugin::setConfiguration(JsonObjectConst& jsonCfg)
         {
             MutexGuard<MutexRecursive>  guard(m_mutex);
 
-            m_numOfFreqBands = numOfBands;
+            if ((m_numOfFreqBands != numOfBands) ||
+                (m_freqBandScale != scale))
+            {
+                m_numOfFreqBands    = numOfBands;
+                m_freqBandScale     = scale;
+                m_isFreqBandsReq    = true;
+            }
 
             m_hasTopicChanged = true;
 
@@ -407,18 +427,20 @@ void SoundReactivePlugin::decayPeak()
     }
 }
 
-void SoundReactivePlugin::handleFreqBins(float* freqBins, size_t freqBinLen)
+void SoundReactivePlugin::handleFreqBands(float* freqBands)
 {
-    float           octaveFreqBands[MAX_FREQ_BANDS];
-    uint16_t        freqBinIdx                      = 0U;
     float           peak                            = 0.0F;
     float           avgDigital                      = 0.0F;
     uint8_t         bandIdx                         = 0U;
 
-    convertToOctaveFreqBands(octaveFreqBands, MAX_FREQ_BANDS, freqBins, freqBinLen);
-    avgDigital = calculateAmplitudeAverage(octaveFreqBands, MAX_FREQ_BANDS);
+    /* Calculate the amplitude average over the spectrum. */
+    for(bandIdx = 0U; bandIdx < m_numOfFreqBands; ++bandIdx)
+    {
+        avgDigital += freqBands[bandIdx];
+    }
+    avgDigital /= static_cast<float>(m_numOfFreqBands);
 
-    for(bandIdx = 0U; bandIdx < MAX_FREQ_BANDS; ++bandIdx)
+    for(bandIdx = 0U; bandIdx < m_numOfFreqBands; ++bandIdx)
     {
         /* If the ampltiude average is lower than the equivalent input noise (from datasheet),
          * the correction factors will be calculated. The amplitude average is used to detect
@@ -431,35 +453,33 @@ void SoundReactivePlugin::handleFreqBins(float* freqBins, size_t freqBinLen)
             constexpr const float   NOISE_FLOOR         = static_cast<float>(INMP441_NOISE_FLOOR_DIGITAL);
 
             /* Calculate with weighted average to avoid jumping. */
-            m_corrFactors[bandIdx] = WEIGHT_OLD_VALUE * m_corrFactors[bandIdx] + WEIGHT_NEW_VALUE * (NOISE_FLOOR / octaveFreqBands[bandIdx]);
+            m_corrFactors[bandIdx] = WEIGHT_OLD_VALUE * m_corrFactors[bandIdx] + WEIGHT_NEW_VALUE * (NOISE_FLOOR / freqBands[bandIdx]);
         }
 
-        /* Normalize */
-        octaveFreqBands[bandIdx] *= m_corrFactors[bandIdx];
-
-        /* Calculate the spectrum amplitude in dB SPL
+        /* Normalize and calculate the spectrum amplitude in dB SPL.
          * The shown frequency spectrum amplitudes consider now the silent and loud parts better.
          *
          * = sensitivity [dB SPL] + 20 * log10(frequency amplitude digital / sensitivity digital)
+         * = unit [dB SPL] + 20 * log10(frequency amplitude digital)
          */
-        octaveFreqBands[bandIdx] = INMP441_SENSITIVITY_SPL + 20.0F * log10f(octaveFreqBands[bandIdx] / static_cast<float>(IMMP441_SENSITIVITY_DIGITAL));
+        freqBands[bandIdx] = INMP441_UNIT_SPL + Decibel::fromAmplitude(freqBands[bandIdx] * m_corrFactors[bandIdx]);
 
         /* The amplitude shall consider only the dynamic range
-            * by removing the equivalent input noise level.
-            */
-        if (INMP441_NOISE_SPL >= octaveFreqBands[bandIdx])
+         * by removing the equivalent input noise level.
+         */
+        if (INMP441_NOISE_SPL >= freqBands[bandIdx])
         {
-            octaveFreqBands[bandIdx] = HEARING_THRESHOLD;
+            freqBands[bandIdx] = HEARING_THRESHOLD;
         }
         else
         {
-            octaveFreqBands[bandIdx] -= INMP441_NOISE_SPL;
+            freqBands[bandIdx] -= INMP441_NOISE_SPL;
         }
 
         /* Determine peak over all frequency bands for automatic gain control. */
-        if (octaveFreqBands[bandIdx] > peak)
+        if (freqBands[bandIdx] > peak)
         {
-            peak = octaveFreqBands[bandIdx];
+            peak = freqBands[bandIdx];
         }
     }
 
@@ -478,28 +498,13 @@ void SoundReactivePlugin::handleFreqBins(float* freqBins, size_t freqBinLen)
         }
     }
 
-    /* Downscale to the bar height in relation to dynamic range.
-     * If less frequency bands are shown, they will be simply averaged.
-     */
-    freqBinIdx = 0U;
-    for(bandIdx = 0U; bandIdx < MAX_FREQ_BANDS; ++bandIdx)
+    /* Downscale to the bar height in relation to dynamic range. */
+    for(bandIdx = 0U; bandIdx < m_numOfFreqBands; ++bandIdx)
     {
-        float       avg         = 0.0F;
         uint16_t    barHeight   = 0U;
         const float MAX_HEIGHT  = static_cast<float>(m_maxHeight);
 
-        if (NUM_OF_BANDS_8 == m_numOfFreqBands)
-        {
-            avg = (octaveFreqBands[freqBinIdx] + octaveFreqBands[freqBinIdx + 1U]) / 2.0F;
-            freqBinIdx += 2U;
-        }
-        else
-        {
-            avg = octaveFreqBands[freqBinIdx];
-            freqBinIdx += 1U;
-        }
-
-        barHeight = static_cast<uint16_t>((avg * MAX_HEIGHT) / m_peak);
+        barHeight = static_cast<uint16_t>((freqBands[bandIdx] * MAX_HEIGHT) / m_peak);
 
         if (m_maxHeight < barHeight)
         {
@@ -516,65 +521,6 @@ void SoundReactivePlugin::handleFreqBins(float* freqBins, size_t freqBinLen)
     }
 }
 
-void SoundReactivePlugin::convertToOctaveFreqBands(float* octaveFreqBands, size_t octaveFreqBandsLen, float* freqBins, size_t freqBinLen)
-{
-    uint16_t    freqBinIdx  = 0U;
-    int32_t     divisor     = 0;
-    uint8_t     bandIdx     = 0U;
-
-    /* Sum up the frequency bin results of the spectrum analyzer and
-     * create the octave frequency bands.
-     */
-    freqBinIdx  = 1U; /* Don't use the first frequency bin, because it contains the DC part. */
-    octaveFreqBands[bandIdx] = 0.0F;
-    while((freqBinLen > freqBinIdx) && (octaveFreqBandsLen > bandIdx))
-    {
-        octaveFreqBands[bandIdx] += static_cast<float>(freqBins[freqBinIdx]);
-        ++divisor; /* Count number of added frequency bins. */
-
-        /* If the current frequency bin is equal than the current
-         * high edge frequency of the band, the following frequency
-         * bin's will be assigned to the next band.
-         */
-        if (LIST_16_BAND_HIGH_EDGE_FREQ_BIN[bandIdx] == freqBinIdx)
-        {
-            /* Any frequency band added? */
-            if (0 < divisor)
-            {
-                /* Depends on how many frequency bins were added. */
-                octaveFreqBands[bandIdx] /= static_cast<float>(divisor);
-
-                divisor = 0;
-            }
-
-            ++bandIdx;
-
-            if (octaveFreqBandsLen > bandIdx)
-            {
-                octaveFreqBands[bandIdx] = static_cast<float>(freqBins[freqBinIdx]);
-                ++divisor; /* Count number of added frequency bins. */
-            }
-        }
-
-        ++freqBinIdx;
-    }
-}
-
-float SoundReactivePlugin::calculateAmplitudeAverage(float* octaveFreqBands, size_t octaveFreqBandsLen)
-{
-    float   avgDigital  = 0.0F;
-    uint8_t bandIdx     = 0U;
-
-    /* Calculate the amplitude average over the spectrum. */
-    for(bandIdx = 0U; bandIdx < octaveFreqBandsLen; ++bandIdx)
-    {
-        avgDigital += octaveFreqBands[bandIdx];
-    }
-    avgDigital /= static_cast<float>(octaveFreqBandsLen);
-
-    return avgDigital;
-}
-
 /******************************************************************************
  * External Functions
  *****************************************************************************/
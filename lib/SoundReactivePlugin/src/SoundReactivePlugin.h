@@ -50,6 +50,8 @@
 #include <Mutex.hpp>
 #include <math.h>
 #include <FileSystem.h>
+#include <FreqBandMapper.hpp>
+#include <Decibel.hpp>
 
 /******************************************************************************
  * Macros
@@ -80,9 +82,11 @@ public:
         m_barHeight{0U},
         m_peakHeight{0U},
         m_numOfFreqBands(NUM_OF_BANDS_16),
+        m_freqBandScale(FREQ_BAND_SCALE_LOG),
+        m_isFreqBandsReq(true),
         m_decayPeakTimer(),
         m_maxHeight(0U),
-        m_freqBins(nullptr),
+        m_spectrumSequence(0U),
         m_corrFactors(),
         m_peak(INMP441_MAX_SPL),
         m_cfgReloadTimer(),
@@ -105,11 +109,6 @@ public:
      */
     ~SoundReactivePlugin()
     {
-        if (nullptr != m_freqBins)
-        {
-            delete[] m_freqBins;
-        }
-
         m_mutex.destroy();
     }
 
@@ -209,6 +208,17 @@ public:
      */
     void stop() final;
 
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * The frequency band configuration of the spectrum analyzer is shared by
+     * all plugin instances, therefore it is applied again.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
     /**
      * Process the plugin.
      * Overwrite it if your plugin has cyclic stuff to do without being in a
@@ -233,7 +243,9 @@ private:
     enum NumOfBands
     {
         NUM_OF_BANDS_8  = 8,    /**< 8 bands */
-        NUM_OF_BANDS_16 = 16    /**< 16 bands */
+        NUM_OF_BANDS_16 = 16,   /**< 16 bands */
+        NUM_OF_BANDS_24 = 24,   /**< 24 bands */
+        NUM_OF_BANDS_32 = 32    /**< 32 bands */
     };
 
     /**
@@ -243,10 +255,9 @@ private:
 
     /**
      * The max. number of frequency bands, the plugin supports.
-     * If you change this, the number of frequency bins which to sum up
-     * must be calculated again.
+     * It corresponds to the max. frequency bands of the spectrum analyzer.
      */
-    static const uint8_t    MAX_FREQ_BANDS                      = 16U;
+    static const uint8_t    MAX_FREQ_BANDS                      = 32U;
 
     /**
      * Period in which the peak of a bar will be decayed in ms.
@@ -303,6 +314,12 @@ private:
      */
     static const constexpr int32_t  INMP441_NOISE_SPL           = INMP441_SENSITIVITY_SPL + 20.0f * log10f((1.0f * INMP441_NOISE_FLOOR_DIGITAL) / IMMP441_SENSITIVITY_DIGITAL);
 
+    /**
+     * INMP441 the sound pressure level in db SPL of a digital amplitude of 1.
+     * = sensitivity [db SPL] - 20 * log10(sensitivity digital)
+     */
+    static const constexpr float    INMP441_UNIT_SPL            = INMP441_SENSITIVITY_SPL - 20.0f * log10f(1.0f * IMMP441_SENSITIVITY_DIGITAL);
+
     /**
      * The human hearing threshold in dB SPL.
      */
@@ -313,12 +330,6 @@ private:
      */
     static const constexpr float    MIN_DYNAMIC_RANGE           = 40.0f;
 
-    /**
-     * List with the high edge frequency bin of the center band frequency.
-     * This list is valid for 16 bands.
-     */
-    static const uint16_t   LIST_16_BAND_HIGH_EDGE_FREQ_BIN[NUM_OF_BANDS_16];
-
     /**
      * The configuration in the persistent memory shall be cyclic loaded.
      * This mechanism ensure that manual changes in the file are considered.
@@ -329,10 +340,12 @@ private:
     mutable MutexRecursive  m_mutex;                        /**< Mutex to protect against concurrent access. */
     uint16_t                m_barHeight[MAX_FREQ_BANDS];    /**< The current height of every bar, which represents a frequency band. */
     uint16_t                m_peakHeight[MAX_FREQ_BANDS];   /**< The peak of every bar, which represents the peak in the frequency band. */
-    NumOfBands              m_numOfFreqBands;               /**< Current configured number of frequency bands, which to show. 8/16 are supported. */
+    NumOfBands              m_numOfFreqBands;               /**< Current configured number of frequency bands, which to show. 8/16/24/32 are supported. */
+    FreqBandScale           m_freqBandScale;                /**< Current configured frequency band scale. */
+    bool                    m_isFreqBandsReq;               /**< Shall the frequency band configuration be requested from the spectrum analyzer? */
     SimpleTimer             m_decayPeakTimer;               /**< Periodically decays the peak of a bar. */
     uint16_t                m_maxHeight;                    /**< Max. height of a bar in pixel. */
-    float*                  m_freqBins;                     /**< List of frequency bins, calculated from the spectrum analyzer results. On the heap to avoid stack overflow. */
+    uint32_t                m_spectrumSequence;             /**< Sequence number of the last handled spectrum. */
     float                   m_corrFactors[MAX_FREQ_BANDS];  /**< Correction factors per frequency band. The factors are calculated if the signal average is lower than the microphone noise floor. */
     float                   m_peak;                         /**< Determined signal peak over all frequency bands in dB SPL, used for AGC. */
     SimpleTimer             m_cfgReloadTimer;               /**< Timer is used to cyclic reload the configuration from persistent memory. */
@@ -367,34 +380,11 @@ private:
     void decayPeak();
 
     /**
-     * Handle frequency bins.
-     * 
-     * @param[out]  freqBins    Frequency bin buffer
-     * @param[in]   freqBinLen  Length of frequency bin buffer in elements.
-     * 
-     * @return If successful, it will return true otherwise false.
-     */
-    void handleFreqBins(float* freqBins, size_t freqBinLen);
-
-    /**
-     * Convert the frequency bins to octave frequency bands.
-     * 
-     * @param[out]  octaveFreqBands     Array of octave frequency bands
-     * @param[in]   octaveFreqBandsLen  Number of octave frequency bands
-     * @param[in]   freqBins            Array of frequency bins
-     * @param[in]   freqBinLen          Number of frequency bins
-     */
-    void convertToOctaveFreqBands(float* octaveFreqBands, size_t octaveFreqBandsLen, float* freqBins, size_t freqBinLen);
-
-    /**
-     * Calculate the average over the amplitudes of the octave frequency bands.
-     * 
-     * @param[in] octaveFreqBands       Array of octave frequency bands
-     * @param[in] octaveFreqBandsLen    Number of octave frequency bands
+     * Handle frequency bands.
      * 
-     * @return Average amplitude value
+     * @param[in] freqBands Frequency bands from the spectrum analyzer, with the configured number of elements.
      */
-    float calculateAmplitudeAverage(float* octaveFreqBands, size_t octaveFreqBandsLen);
+    void handleFreqBands(float* freqBands);
 };
 
 /******************************************************************************
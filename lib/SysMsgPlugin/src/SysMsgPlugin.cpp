@@ -67,6 +67,9 @@ void SysMsgPlugin::start(uint16_t width, uint16_t height)
     /* Choose font. */
     m_textWidget.setFont(Fonts::getFontByType(m_fontType));
 
+    /* A scrolling text is rendered only once. */
+    m_textWidget.setPreRendering(true);
+
     /* The text widget is left aligned on x-axis and aligned to the center
      * of y-axis.
      */
@@ -38,6 +38,8 @@
 
 #include <Logging.h>
 #include <Util.h>
+#include <NativeImg.h>
+#include <ImageCache.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -65,6 +67,9 @@ const char* ThreeIconPlugin::TOPIC_BITMAP               = "/bitmap";
 /* Initialize bitmap image filename extension. */
 const char* ThreeIconPlugin::FILE_EXT_BITMAP            = ".bmp";
 
+/* Initialize GIF image filename extension. */
+const char* ThreeIconPlugin::FILE_EXT_GIF               = ".gif";
+
 /* Initialize sprite sheet parameter filename extension. */
 const char* ThreeIconPlugin::FILE_EXT_SPRITE_SHEET      = ".sprite";
 
@@ -144,6 +149,14 @@ bool ThreeIconPlugin::setTopic(const String& topic, const JsonObject& value)
             {
                 String iconPath = jsonIconPath.as<String>();
                 isSuccessful = loadBitmap(iconPath, iconId);  
+
+                /* The uploaded bitmap image is transcoded in the context of
+                 * the upload, not by the display task.
+                 */
+                if (true == isSuccessful)
+                {
+                    transcodeBitmap(iconId);
+                }
             }
             /* Control command */
             else
@@ -252,8 +265,11 @@ bool ThreeIconPlugin::isUploadAccepted(const String& topic, const String& srcFil
         uint8_t     iconId              = MAX_ICONS;
         bool        status              = Util::strToUInt8(iconIdStr, iconId);
      
-         /* Accept upload of bitmap file. */
-        if ((false != status) && (0U != srcFilename.endsWith(FILE_EXT_BITMAP)))
+         /* Accept upload of bitmap file. A GIF image file is stored as
+          * bitmap image file too, the bitmap widget detects it by its signature.
+          */
+        if ((false != status) &&
+            ((0U != srcFilename.endsWith(FILE_EXT_BITMAP)) || (0U != srcFilename.endsWith(FILE_EXT_GIF))))
         {
             dstFilename = getFileName(iconId, FILE_EXT_BITMAP);
 
@@ -311,6 +327,9 @@ void ThreeIconPlugin::stop()
 
     for(iconId = 0U; iconId < MAX_ICONS; ++iconId)
     { 
+        /* A GIF animation keeps its file open. */
+        m_bitmapWidget[iconId].suspend();
+
         if (false != FILESYSTEM.remove(getFileName(iconId, FILE_EXT_BITMAP)))
         {
             LOG_INFO("File %s removed", getFileName(iconId, FILE_EXT_BITMAP).c_str());
@@ -323,12 +342,35 @@ void ThreeIconPlugin::stop()
     }
 }
 
-void ThreeIconPlugin::update(YAGfx& gfx)
+void ThreeIconPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
+    /* The display contains the content of the previous plugin. Clear it
+     * once and repaint everything. Afterwards the canvas is only repainted
+     * if one of the icons changed.
+     */
     gfx.fillScreen(ColorDef::BLACK);
-    m_threeIconCanvas.update(gfx);
+    m_threeIconCanvas.invalidate();
+}
+
+void ThreeIconPlugin::inactive()
+{
+    uint8_t                     iconId = 0U;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    /* Don't keep the files of GIF animations open, while they are not shown. */
+    for(iconId = 0U; iconId < MAX_ICONS; ++iconId)
+    {
+        m_bitmapWidget[iconId].suspend();
+    }
+}
+
+void ThreeIconPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    (void)m_threeIconCanvas.refresh(gfx);
 }
 
 bool ThreeIconPlugin::loadBitmap(const String& filename, uint8_t iconId)
@@ -341,6 +383,9 @@ bool ThreeIconPlugin::loadBitmap(const String& filename, uint8_t iconId)
 
         if (0U != filename.endsWith(FILE_EXT_BITMAP))
         {
+            /* The file was overwritten by the upload. */
+            ImageCache::getInstance().invalidate(filename);
+
             status = m_bitmapWidget[iconId].load(FILESYSTEM, filename);
 
             /* Ensure that only the bitmap image file exists in the filesystem,
@@ -360,6 +405,8 @@ bool ThreeIconPlugin::loadBitmap(const String& filename, uint8_t iconId)
 
             bmpFilename.replace(FILE_EXT_SPRITE_SHEET, FILE_EXT_BITMAP);
 
+            ImageCache::getInstance().invalidate(bmpFilename);
+
             status = m_bitmapWidget[iconId].loadSpriteSheet(FILESYSTEM, filename,  bmpFilename);
             
             m_isSpriteSheetAvailable[iconId] = status;
@@ -456,6 +503,16 @@ void ThreeIconPlugin::clearBitmap(uint8_t iconId)
  * Private Methods
  *****************************************************************************/
 
+void ThreeIconPlugin::transcodeBitmap(uint8_t iconId)
+{
+    NativeImg nativeImg;
+
+    if (BmpImgLoader::RET_OK != nativeImg.transcode(FILESYSTEM, getFileName(iconId, FILE_EXT_BITMAP)))
+    {
+        LOG_WARNING("Failed to transcode %s.", getFileName(iconId, FILE_EXT_BITMAP).c_str());
+    }
+}
+
 String ThreeIconPlugin::getFileName(uint8_t iconId, const String& ext)
 {
     return PluginConfigFsHandler::generateFullPath(getUID(), "_" + String(iconId) + ext);
@@ -198,6 +198,20 @@ public:
      */
     void stop() final;
 
+    /**
+     * This method will be called in case the plugin is set active, which means
+     * it will be shown on the display in the next step.
+     *
+     * @param[in] gfx   Display graphics interface
+     */
+    void active(YAGfx& gfx) final;
+
+    /**
+     * This method will be called in case the plugin is set inactive, which means
+     * it won't be shown on the display anymore.
+     */
+    void inactive() final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -295,6 +309,11 @@ private:
      */
     static const char*      FILE_EXT_BITMAP;
 
+    /**
+     * Filename extension of GIF image file.
+     */
+    static const char*      FILE_EXT_GIF;
+
     /**
      * Filename extension of sprite sheet parameter file.
      */
@@ -308,6 +327,15 @@ private:
     mutable MutexRecursive  m_mutex;                                /**< Mutex to protect against concurrent access. */
     bool                    m_hasTopicChanged;                      /**< Has the topic content changed? */
 
+    /**
+     * Transcode the bitmap image file of a icon once to the native image
+     * format, so loading it again needs no decoding anymore.
+     * The icon is already loaded, therefore the mutex is not needed.
+     *
+     * @param[in] iconId    The icon id.
+     */
+    void transcodeBitmap(uint8_t iconId);
+
     /**
      * Get image filename with path.
      * 
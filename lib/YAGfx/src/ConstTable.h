@@ -0,0 +1,82 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compile time lookup tables
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef CONST_TABLE_H
+#define CONST_TABLE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/* The following macros expand to a 256 entry initializer list, whose
+ * entries are calculated at compile time by the given constexpr function.
+ * C++11 provides no index sequences, therefore the expansion is done by
+ * the preprocessor.
+ */
+
+/** Expands to 4 table entries, starting at the given index. */
+#define CONST_TABLE_4(__func, __idx)    __func((__idx) + 0U), __func((__idx) + 1U), __func((__idx) + 2U), __func((__idx) + 3U)
+
+/** Expands to 16 table entries, starting at the given index. */
+#define CONST_TABLE_16(__func, __idx)   CONST_TABLE_4(__func, (__idx) + 0U), CONST_TABLE_4(__func, (__idx) + 4U), \
+                                        CONST_TABLE_4(__func, (__idx) + 8U), CONST_TABLE_4(__func, (__idx) + 12U)
+
+/** Expands to 64 table entries, starting at the given index. */
+#define CONST_TABLE_64(__func, __idx)   CONST_TABLE_16(__func, (__idx) + 0U), CONST_TABLE_16(__func, (__idx) + 16U), \
+                                        CONST_TABLE_16(__func, (__idx) + 32U), CONST_TABLE_16(__func, (__idx) + 48U)
+
+/** Expands to 256 table entries, starting at 0. */
+#define CONST_TABLE_256(__func)         CONST_TABLE_64(__func, 0U), CONST_TABLE_64(__func, 64U), \
+                                        CONST_TABLE_64(__func, 128U), CONST_TABLE_64(__func, 192U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* CONST_TABLE_H */
+
+/** @} */
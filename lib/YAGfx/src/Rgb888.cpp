@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "Rgb888.h"
+#include "ConstTable.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -54,41 +55,148 @@
  * Local Variables
  *****************************************************************************/
 
+/* The table entries are calculated at compile time. Therefore the constexpr
+ * functions are defined here, before the tables.
+ */
+
+/**
+ * Compose a RGB24 value from its base colors.
+ *
+ * @param[in] red   Red [0; 255]
+ * @param[in] green Green [0; 255]
+ * @param[in] blue  Blue [0; 255]
+ *
+ * @return Color in RGB24 format
+ */
+static constexpr uint32_t rgb24(uint32_t red, uint32_t green, uint32_t blue)
+{
+    return (red << 16U) | (green << 8U) | blue;
+}
+
+/**
+ * Calculate the color wheel entry by its inverted position. The wheel is
+ * divided into three segments: red + blue, green + blue, red + green.
+ *
+ * @param[in] invWheelPos   Inverted color wheel position [0; 255]
+ *
+ * @return Color in RGB24 format
+ */
+static constexpr uint32_t colorWheelSegment(uint32_t invWheelPos)
+{
+    return (invWheelPos < 85U) ? rgb24(UINT8_MAX - (invWheelPos * 3U), 0U, invWheelPos * 3U) :
+           (invWheelPos < 170U) ? rgb24(0U, (invWheelPos - 85U) * 3U, UINT8_MAX - ((invWheelPos - 85U) * 3U)) :
+           rgb24((invWheelPos - 170U) * 3U, UINT8_MAX - ((invWheelPos - 170U) * 3U), 0U);
+}
+
+/**
+ * Calculate a color wheel entry.
+ * A color is based on only two base colors, see Rgb888::turnColorWheel().
+ *
+ * @param[in] wheelPos  Color wheel position [0; 255]
+ *
+ * @return Color in RGB24 format
+ */
+static constexpr uint32_t colorWheelEntry(uint32_t wheelPos)
+{
+    return colorWheelSegment(UINT8_MAX - wheelPos);
+}
+
+/**
+ * Calculate the color in a hue segment.
+ *
+ * @param[in] segment   Hue segment [0; 5]
+ * @param[in] rise      Position inside the segment [0; 255]
+ *
+ * @return Color in RGB24 format
+ */
+static constexpr uint32_t hueSegment(uint32_t segment, uint32_t rise)
+{
+    return (0U == segment) ? rgb24(UINT8_MAX, rise, 0U) :
+           (1U == segment) ? rgb24(UINT8_MAX - rise, UINT8_MAX, 0U) :
+           (2U == segment) ? rgb24(0U, UINT8_MAX, rise) :
+           (3U == segment) ? rgb24(0U, UINT8_MAX - rise, UINT8_MAX) :
+           (4U == segment) ? rgb24(rise, 0U, UINT8_MAX) :
+           rgb24(UINT8_MAX, 0U, UINT8_MAX - rise);
+}
+
+/**
+ * Calculate a fully saturated hue with max. value.
+ * The color circle is divided into six segments.
+ *
+ * @param[in] hue   Hue [0; 255]
+ *
+ * @return Color in RGB24 format
+ */
+static constexpr uint32_t hueEntry(uint32_t hue)
+{
+    return hueSegment((hue * 6U) >> 8U, (hue * 6U) & 0xffU);
+}
+
+/** Color wheel in RGB24 format, see Rgb888::turnColorWheel(). */
+static constexpr uint32_t   COLOR_WHEEL_TABLE[UINT8_MAX + 1U]   = { CONST_TABLE_256(colorWheelEntry) };
+
+/** Fully saturated hues with max. value in RGB24 format, used for HSV and HSL. */
+static constexpr uint32_t   HUE_TABLE[UINT8_MAX + 1U]           = { CONST_TABLE_256(hueEntry) };
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void Rgb888::turnColorWheel(uint8_t wheelPos)
 {
-    const uint8_t COL_PARTS = 3U;
-    const uint8_t COL_RANGE = UINT8_MAX / COL_PARTS;
+    set(COLOR_WHEEL_TABLE[wheelPos]);
+}
+
+void Rgb888::setHsv(uint8_t hue, uint8_t saturation, uint8_t value)
+{
+    uint8_t chroma = (static_cast<uint16_t>(value) * saturation + (UINT8_MAX / 2U)) / UINT8_MAX;
+
+    setHueChroma(hue, chroma, value - chroma);
+}
+
+void Rgb888::setHsl(uint8_t hue, uint8_t saturation, uint8_t lightness)
+{
+    /* Chroma = (1 - |2L - 1|) * S */
+    uint16_t    doubleLightness = 2U * lightness;
+    uint16_t    range           = (UINT8_MAX < doubleLightness) ? ((2U * UINT8_MAX) - doubleLightness) : doubleLightness;
+    uint8_t     chroma          = (range * saturation + (UINT8_MAX / 2U)) / UINT8_MAX;
+    uint8_t     halfChroma      = chroma / 2U;
+    uint8_t     offset          = (lightness > halfChroma) ? (lightness - halfChroma) : 0U;
 
-    wheelPos = UINT8_MAX - wheelPos;
+    setHueChroma(hue, chroma, offset);
+}
+
+void Rgb888::fillColorWheel(Rgb888* colors, uint16_t count, uint8_t wheelPos, uint8_t wheelDelta)
+{
+    uint16_t idx = 0U;
 
-    /* Red + Blue ? */
-    if (wheelPos < COL_RANGE)
+    if (nullptr == colors)
     {
-        m_red   = UINT8_MAX - wheelPos * COL_PARTS;
-        m_green = 0U;
-        m_blue  = COL_PARTS * wheelPos;
+        return;
     }
-    /* Green + Blue ? */
-    else if (wheelPos < (2 * COL_RANGE))
+
+    for(idx = 0U; idx < count; ++idx)
     {
-        wheelPos -= COL_RANGE;
-        
-        m_red   = 0U;
-        m_green = COL_PARTS * wheelPos;
-        m_blue  = UINT8_MAX - wheelPos * COL_PARTS;
+        colors[idx].set(COLOR_WHEEL_TABLE[wheelPos]);
+        wheelPos += wheelDelta;
     }
-    /* Red + Green */
-    else
+}
+
+void Rgb888::fillHsv(Rgb888* colors, uint16_t count, uint8_t hue, uint8_t hueDelta, uint8_t saturation, uint8_t value)
+{
+    uint8_t     chroma  = (static_cast<uint16_t>(value) * saturation + (UINT8_MAX / 2U)) / UINT8_MAX;
+    uint8_t     offset  = value - chroma;
+    uint16_t    idx     = 0U;
+
+    if (nullptr == colors)
     {
-        wheelPos -= ((COL_PARTS - 1U) * COL_RANGE);
-        
-        m_red   = COL_PARTS * wheelPos;
-        m_green = UINT8_MAX - wheelPos * COL_PARTS;
-        m_blue  = 0U;
+        return;
+    }
+
+    for(idx = 0U; idx < count; ++idx)
+    {
+        colors[idx].setHueChroma(hue, chroma, offset);
+        hue += hueDelta;
     }
 }
 
@@ -100,6 +208,19 @@ void Rgb888::turnColorWheel(uint8_t wheelPos)
  * Private Methods
  *****************************************************************************/
 
+void Rgb888::setHueChroma(uint8_t hue, uint8_t chroma, uint8_t offset)
+{
+    const uint32_t  HUE         = HUE_TABLE[hue];
+    uint16_t        red         = offset + (static_cast<uint16_t>(extractRed(HUE)) * chroma + (UINT8_MAX / 2U)) / UINT8_MAX;
+    uint16_t        green       = offset + (static_cast<uint16_t>(extractGreen(HUE)) * chroma + (UINT8_MAX / 2U)) / UINT8_MAX;
+    uint16_t        blue        = offset + (static_cast<uint16_t>(extractBlue(HUE)) * chroma + (UINT8_MAX / 2U)) / UINT8_MAX;
+
+    /* Limit possible rounding errors. */
+    m_red   = (UINT8_MAX < red) ? UINT8_MAX : red;
+    m_green = (UINT8_MAX < green) ? UINT8_MAX : green;
+    m_blue  = (UINT8_MAX < blue) ? UINT8_MAX : blue;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
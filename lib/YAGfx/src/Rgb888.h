@@ -341,11 +341,56 @@ public:
      * Set color according to the position in the color wheel.
      * It provides typical rainbow colors, which means a color is based on
      * only two base colors.
+     * The intensity won't change.
      *
      * @param[in] wheelPos  Color wheel position
      */
     void turnColorWheel(uint8_t wheelPos);
 
+    /**
+     * Set color by hue, saturation and value (HSV) in fixed-point.
+     * The intensity won't change.
+     *
+     * @param[in] hue           Hue [0; 255], which covers the whole color circle.
+     * @param[in] saturation    Saturation [0; 255]
+     * @param[in] value         Value [0; 255]
+     */
+    void setHsv(uint8_t hue, uint8_t saturation, uint8_t value);
+
+    /**
+     * Set color by hue, saturation and lightness (HSL) in fixed-point.
+     * The intensity won't change.
+     *
+     * @param[in] hue           Hue [0; 255], which covers the whole color circle.
+     * @param[in] saturation    Saturation [0; 255]
+     * @param[in] lightness     Lightness [0; 255]
+     */
+    void setHsl(uint8_t hue, uint8_t saturation, uint8_t lightness);
+
+    /**
+     * Fill a row of colors with consecutive color wheel positions.
+     * The intensity of the colors won't change.
+     *
+     * @param[out] colors       Colors, which to fill.
+     * @param[in]  count        Number of colors
+     * @param[in]  wheelPos     Color wheel position of the first color
+     * @param[in]  wheelDelta   Color wheel position delta between two colors
+     */
+    static void fillColorWheel(Rgb888* colors, uint16_t count, uint8_t wheelPos, uint8_t wheelDelta);
+
+    /**
+     * Fill a row of colors with consecutive hues, but same saturation and value.
+     * The intensity of the colors won't change.
+     *
+     * @param[out] colors       Colors, which to fill.
+     * @param[in]  count        Number of colors
+     * @param[in]  hue          Hue of the first color
+     * @param[in]  hueDelta     Hue delta between two colors
+     * @param[in]  saturation   Saturation [0; 255]
+     * @param[in]  value        Value [0; 255]
+     */
+    static void fillHsv(Rgb888* colors, uint16_t count, uint8_t hue, uint8_t hueDelta, uint8_t saturation, uint8_t value);
+
     /**
      * Extract the red base color from a RGB24 value.
      * 
@@ -401,6 +446,17 @@ private:
         return (static_cast<uint16_t>(baseColor) * static_cast<uint16_t>(m_intensity)) / MAX_BRIGHT;
     }
 
+    /**
+     * Set color by a fully saturated hue, its chroma and the added
+     * lightness offset. This is the common part of the HSV and HSL
+     * conversion.
+     *
+     * @param[in] hue       Hue [0; 255]
+     * @param[in] chroma    Chroma [0; 255]
+     * @param[in] offset    Offset, added to every base color [0; 255 - chroma]
+     */
+    void setHueChroma(uint8_t hue, uint8_t chroma, uint8_t offset);
+
 };
 
 /******************************************************************************
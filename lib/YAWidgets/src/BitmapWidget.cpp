@@ -72,7 +72,9 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
         Widget::operator=(widget);
         
         m_bitmap        = widget.m_bitmap;
+        m_image         = widget.m_image;
         m_spriteSheet   = widget.m_spriteSheet;
+        m_gif           = widget.m_gif;
         m_timer         = widget.m_timer;
         m_duration      = widget.m_duration;
     }
@@ -82,8 +84,21 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
 
 void BitmapWidget::clear(const Color& color)
 {
-    if (true == m_spriteSheet.isEmpty())
+    if (true == m_gif.isOpen())
     {
+        m_gif.close();
+        m_timer.stop();
+    }
+    else if (true == m_spriteSheet.isEmpty())
+    {
+        /* The cached image is shared, therefore it is replaced by a own bitmap. */
+        if (true == m_image.isValid())
+        {
+            m_bitmap.release();
+            (void)m_bitmap.create(m_image.get()->getWidth(), m_image.get()->getHeight());
+            m_image.release();
+        }
+
         m_bitmap.fillScreen(color);
     }
     else
@@ -91,6 +106,8 @@ void BitmapWidget::clear(const Color& color)
         m_spriteSheet.release();
         m_timer.stop();
     }
+
+    invalidate();
 }
 
 bool BitmapWidget::load(FS& fs, const String& filename)
@@ -103,8 +120,18 @@ bool BitmapWidget::load(FS& fs, const String& filename)
     }
     else
     {
-        BmpImgLoader        loader;
-        BmpImgLoader::Ret   ret = loader.load(fs, filename, m_bitmap);
+        BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+        ImageCache::Handle  image;
+
+        /* A GIF animation is streamed, all other image files are decoded
+         * completely by the image cache.
+         */
+        ret = m_gif.open(fs, filename);
+
+        if (BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED == ret)
+        {
+            image = ImageCache::getInstance().load(fs, filename, ret);
+        }
 
         if (BmpImgLoader::RET_OK != ret)
         {
@@ -128,6 +155,9 @@ bool BitmapWidget::load(FS& fs, const String& filename)
             {
                 LOG_ERROR("Failed to load %s because of internal error.", filename.c_str());
             }
+
+            m_bitmap.release();
+            m_image.release();
         }
         else
         {
@@ -137,6 +167,11 @@ bool BitmapWidget::load(FS& fs, const String& filename)
             m_spriteSheet.release();
             m_timer.stop();
 
+            m_image = image;
+            m_bitmap.release();
+
+            invalidate();
+
             isSuccessful = true;
         }
     }
@@ -164,7 +199,11 @@ bool BitmapWidget::loadSpriteSheet(FS& fs, const String& spriteSheetFileName, co
         /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
          * shall be shown or the single bitmap image.
          */
-        m_bitmap.release();        
+        m_bitmap.release();
+        m_image.release();
+        m_gif.close();
+
+        invalidate();
 
         isSuccessful = true;
     }
@@ -49,6 +49,8 @@
 
 #include "Widget.hpp"
 #include "SpriteSheet.h"
+#include "ImageCache.h"
+#include "GifDecoder.h"
 
 /******************************************************************************
  * Macros
@@ -71,7 +73,9 @@ public:
     BitmapWidget() :
         Widget(WIDGET_TYPE),
         m_bitmap(),
+        m_image(),
         m_spriteSheet(),
+        m_gif(),
         m_timer(),
         m_duration(0U)
     {
@@ -85,7 +89,9 @@ public:
     BitmapWidget(const BitmapWidget& widget) :
         Widget(WIDGET_TYPE),
         m_bitmap(widget.m_bitmap),
+        m_image(widget.m_image),
         m_spriteSheet(widget.m_spriteSheet),
+        m_gif(widget.m_gif),
         m_timer(widget.m_timer),
         m_duration(widget.m_duration)
     {
@@ -117,11 +123,16 @@ public:
             m_bitmap.copy(bitmap);
         }
 
-        /* Release sprite sheet to avoid wasting memory. The widget can
-         * only show one of them.
+        m_image.release();
+
+        /* Release sprite sheet and GIF animation to avoid wasting memory.
+         * The widget can only show one of them.
          */
         m_spriteSheet.release();
+        m_gif.close();
         m_timer.stop();
+
+        invalidate();
     }
 
     /**
@@ -131,7 +142,22 @@ public:
      */
     const YAGfxBitmap& get() const
     {
-        return m_bitmap;
+        const YAGfxBitmap* bitmap = m_image.get();
+
+        if (true == m_gif.isOpen())
+        {
+            bitmap = &m_gif.getFrame();
+        }
+        else if (nullptr == bitmap)
+        {
+            bitmap = &m_bitmap;
+        }
+        else
+        {
+            ;
+        }
+
+        return *bitmap;
     }
 
     /**
@@ -144,6 +170,10 @@ public:
     /**
      * Load bitmap image from filesystem.
      * If a sprite sheet is active, it will be disabled.
+     * The image is shared via the image cache with all other users of the
+     * same image file.
+     * A GIF image file is detected by its signature and its frames are
+     * streamed from the filesystem, regardless of the file name.
      *
      * @param[in] fs        Filesystem
      * @param[in] filename  Filename with full path
@@ -190,15 +220,47 @@ public:
      * @param[in] isRepeat The state to be set.
      */
     void setSpriteSheetRepeatInfinite(bool repeat);
+
+    /**
+     * Close the file of a GIF animation, e.g. while the widget is not shown.
+     * The current frame stays and the file is opened again with the next
+     * frame.
+     */
+    void suspend()
+    {
+        m_gif.suspend();
+    }
     
+    /**
+     * Is the widget dirty and needs to be repainted?
+     * An animated sprite sheet or GIF is dirty, if the next frame shall be shown.
+     *
+     * @return If the widget is dirty, it will return true otherwise false.
+     */
+    bool isDirty() override
+    {
+        bool isDirty = Widget::isDirty();
+
+        if ((false == isDirty) &&
+            ((false == m_spriteSheet.isEmpty()) ||
+             ((true == m_gif.isOpen()) && (false == m_gif.isFinished()))))
+        {
+            isDirty = (false == m_timer.isTimerRunning()) || (true == m_timer.isTimeout());
+        }
+
+        return isDirty;
+    }
+
     /** Widget type string */
     static const char* WIDGET_TYPE;
 
 private:
 
-    YAGfxDynamicBitmap  m_bitmap;       /**< Bitmap image which is shown if no sprite sheet is loaded. */
+    YAGfxDynamicBitmap  m_bitmap;       /**< Bitmap image which is shown if no sprite sheet and no cached image is loaded. */
+    ImageCache::Handle  m_image;        /**< Cached bitmap image which is shown if no sprite sheet is loaded. */
     SpriteSheet         m_spriteSheet;  /**< Sprite sheet for animation with texture. */
-    SimpleTimer         m_timer;        /**< Timer used for sprite sheet. */
+    GifDecoder          m_gif;          /**< GIF animation, which frames are streamed from the filesystem. */
+    SimpleTimer         m_timer;        /**< Timer used for sprite sheet and GIF animation. */
     uint32_t            m_duration;     /**< Duration of one frame in ms. */
 
     /**
@@ -208,20 +270,41 @@ private:
      */
     void paint(YAGfx& gfx) override
     {
-        if (true == m_spriteSheet.isEmpty())
+        if (true == m_gif.isOpen())
+        {
+            /* Every frame of a GIF animation has its own delay. */
+            if (false == m_timer.isTimerRunning())
+            {
+                m_timer.start(m_gif.getDelay());
+            }
+            else if (true == m_timer.isTimeout())
+            {
+                (void)m_gif.next();
+                m_timer.start(m_gif.getDelay());
+            }
+            else
+            {
+                /* Nothing to do. */
+                ;
+            }
+
+            gfx.drawBitmap(m_posX, m_posY, m_gif.getFrame());
+        }
+        else if (true == m_spriteSheet.isEmpty())
         {
-            gfx.drawBitmap(m_posX, m_posY, m_bitmap);
+            gfx.drawBitmap(m_posX, m_posY, get());
         }
         else
         {
-            gfx.drawBitmap(m_posX, m_posY, m_spriteSheet.getFrame());
-
             /* If timer is not running, start it. */
             if (false == m_timer.isTimerRunning())
             {
                 m_timer.start(m_duration);
             }
-            /* If the timer has a timeout, select next sprite and restart timer. */
+            /* If the timer has a timeout, select next sprite and restart timer.
+             * The next sprite is selected before drawing, so the widget
+             * needs to be painted only once per frame of the sprite sheet.
+             */
             else if (true == m_timer.isTimeout())
             {
                 m_spriteSheet.next();
@@ -232,6 +315,8 @@ private:
                 /* Nothing to do. */
                 ;
             }
+
+            gfx.drawBitmap(m_posX, m_posY, m_spriteSheet.getFrame());
         }
     }
     
@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "BmpImgLoader.h"
 
+#include <new>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -46,9 +48,6 @@
  * Types and classes
  *****************************************************************************/
 
-/** Bitmap format signature "BM" */
-static const uint16_t BMP_SIGNATURE = 0x4D42;
-
 /**
  * To store general information about the bitmap image file.
  * Not needed after the file is loaded in memory.
@@ -97,19 +96,58 @@ typedef enum
 
 } CompressionMethod;
 
+/** RLE escape codes, which follow a 0 byte. */
+typedef enum
+{
+    RLE_ESCAPE_END_OF_LINE      = 0,    /**< End of line */
+    RLE_ESCAPE_END_OF_BITMAP    = 1,    /**< End of bitmap */
+    RLE_ESCAPE_DELTA            = 2     /**< Delta, followed by the horizontal and vertical offset. */
+
+} RleEscape;
+
+/**
+ * Buffered file reader, which is used for the RLE compressed pixel data,
+ * because it is read byte by byte.
+ */
+typedef struct
+{
+    uint8_t     data[64U];  /**< Buffered file data */
+    size_t      pos;        /**< Read position in the buffered data */
+    size_t      size;       /**< Number of buffered bytes */
+
+} ReadBuffer;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
+static bool readByte(File& fd, ReadBuffer& buffer, uint8_t& value);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Size of a palette entry in the file in bytes: blue, green, red, reserved. */
+static const uint8_t PALETTE_ENTRY_SIZE = 4U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap)
+{
+    BitmapRowSink   sink(bitmap);
+    Ret             ret = load(fs, fileName, sink);
+
+    if (RET_OK != ret)
+    {
+        bitmap.release();
+    }
+
+    return ret;
+}
+
+BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, IImgRowSink& sink)
 {
     Ret     ret = RET_OK;
     File    fd  = fs.open(fileName);
@@ -128,7 +166,7 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
             ret = RET_FILE_FORMAT_INVALID;
         }
         /* Is it not a bitmap file? */
-        else if (BMP_SIGNATURE != bmpFileHeader.signature)
+        else if (SIGNATURE != bmpFileHeader.signature)
         {
             ret = RET_FILE_FORMAT_UNSUPPORTED;
         }
@@ -136,105 +174,71 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
         {
             ret = RET_FILE_FORMAT_INVALID;
         }
-        /* Contains the bitmap file the supported DIB header?
-         * Planes must be 1.
-         * Compression is not supported.
-         * Palette colors are not supported.
-         * 24 and 32 bits per pixel are supported.
-         */
-        else if ((sizeof(dibHeader) != dibHeader.headerSize) ||
-                 (1 != dibHeader.planes) ||
-                 (COMPRESSION_METHOD_RGB != dibHeader.compression) ||
-                 (0 < dibHeader.paletteColors) ||
-                 ((24 != dibHeader.bpp) && (32 != dibHeader.bpp)))
+        else if (false == isFormatSupported(dibHeader))
         {
             ret = RET_FILE_FORMAT_UNSUPPORTED;
         }
-        /* Supported image size is limited. */
+        else if ((0 >= dibHeader.imageWidth) ||
+                 (0 == dibHeader.imageHeight))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        /* Supported image size is limited. ImageHeight is expressed as a
+         * negative number for top-down images.
+         */
         else if ((UINT16_MAX < dibHeader.imageWidth) ||
-                 (UINT16_MAX < dibHeader.imageHeight))
+                 (UINT16_MAX < dibHeader.imageHeight) ||
+                 (-UINT16_MAX > dibHeader.imageHeight))
         {
             ret = RET_IMG_TOO_BIG;
         }
         else
         {
-            uint16_t width  = abs(dibHeader.imageWidth);
-            uint16_t height = abs(dibHeader.imageHeight);
+            uint16_t    width   = abs(dibHeader.imageWidth);
+            uint16_t    height  = abs(dibHeader.imageHeight);
+            Color*      palette = nullptr;
 
-            bitmap.release();
+            if (8U >= dibHeader.bpp)
+            {
+                palette = new(std::nothrow) Color[1U << dibHeader.bpp];
+            }
 
-            if (false == bitmap.create(width, height))
+            if ((8U >= dibHeader.bpp) &&
+                (nullptr == palette))
+            {
+                ret = RET_IMG_TOO_BIG;
+            }
+            else if (false == sink.begin(width, height))
             {
                 ret = RET_IMG_TOO_BIG;
             }
+            else if ((nullptr != palette) &&
+                     (false == loadPalette(fd, dibHeader, palette)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else if (false == fd.seek(bmpFileHeader.offset, SeekSet))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else if (COMPRESSION_METHOD_RGB == dibHeader.compression)
+            {
+                ret = loadPixels(fd, dibHeader, palette, sink);
+            }
             else
             {
-                uint32_t    pos             = 0;
-                uint32_t    rowSize         = 0;
-                int16_t     y               = 0;
-                bool        isTopToBottom   = false;
-                uint16_t    bytePerPixel    = dibHeader.bpp / 8;
-
-                /* The bits representing the bitmap pixels are packed in rows.
-                 * The size of each row is rounded up to a multiple of 4 bytes
-                 * (a 32-bit DWORD) by padding.
-                 */
-                rowSize =  (dibHeader.bpp * bitmap.getWidth() + 31) / 32 * 4;
-
-                /* ImageHeight is expressed as a negative number for top-down images. */
-                if (0 > dibHeader.imageHeight)
-                {
-                    isTopToBottom = true;
-                }
-
-                while((bitmap.getHeight() > y) && (RET_OK == ret))
-                {
-                    int16_t x = 0;
-
-                    while((bitmap.getWidth() > x) && (RET_OK == ret))
-                    {
-                        uint8_t lineBuffer[bytePerPixel];
-
-                        if (false == isTopToBottom)
-                        {
-                            pos = x * bytePerPixel + (bitmap.getHeight() - y - 1) * rowSize;
-                        }
-                        else
-                        {
-                            pos = x * bytePerPixel + y * rowSize;
-                        }
-
-                        if (false == fd.seek(bmpFileHeader.offset + pos, SeekSet))
-                        {
-                            ret = RET_FILE_FORMAT_INVALID;
-                        }
-                        else if (sizeof(lineBuffer) != fd.read(lineBuffer, sizeof(lineBuffer)))
-                        {
-                            ret = RET_FILE_FORMAT_INVALID;
-                        }
-                        else
-                        {
-                            Color color(lineBuffer[2], lineBuffer[1], lineBuffer[0]);
-
-                            bitmap.drawPixel(x, y, color);
-                        }
-
-                        ++x;
-                    }
+                ret = loadRlePixels(fd, dibHeader, palette, sink);
+            }
 
-                    ++y;
-                }
+            if (nullptr != palette)
+            {
+                delete[] palette;
             }
         }
 
         fd.close();
     }
 
-    if (RET_OK != ret)
-    {
-        bitmap.release();
-    }
-
     return ret;
 }
 
@@ -270,6 +274,394 @@ bool BmpImgLoader::loadDibHeader(File& fd, BmpV5Header& header)
     return isSuccessful;
 }
 
+bool BmpImgLoader::isFormatSupported(const BmpV5Header& header) const
+{
+    bool isSupported = false;
+
+    /* Contains the bitmap file the supported DIB header?
+     * Larger DIB headers (v4, v5) start with the same fields.
+     * Planes must be 1.
+     */
+    if ((sizeof(header) <= header.headerSize) &&
+        (1U == header.planes))
+    {
+        /* 1, 4, 8, 24 and 32 bits per pixel are supported without compression.
+         * The palette colors are only used up to 8 bits per pixel.
+         */
+        if (COMPRESSION_METHOD_RGB == header.compression)
+        {
+            if ((1U == header.bpp) ||
+                (4U == header.bpp) ||
+                (8U == header.bpp))
+            {
+                isSupported = ((1U << header.bpp) >= header.paletteColors);
+            }
+            else if ((24U == header.bpp) ||
+                     (32U == header.bpp))
+            {
+                isSupported = true;
+            }
+            else
+            {
+                ;
+            }
+        }
+        /* RLE compressed images are always bottom-up. */
+        else if (((COMPRESSION_METHOD_RLE8 == header.compression) && (8U == header.bpp)) ||
+                 ((COMPRESSION_METHOD_RLE4 == header.compression) && (4U == header.bpp)))
+        {
+            isSupported = ((0 < header.imageHeight) &&
+                           ((1U << header.bpp) >= header.paletteColors));
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return isSupported;
+}
+
+bool BmpImgLoader::loadPalette(File& fd, const BmpV5Header& header, Color* palette)
+{
+    bool        isSuccessful    = true;
+    uint32_t    paletteColors   = header.paletteColors;
+
+    /* 0 means the default of 2^n colors. */
+    if (0U == paletteColors)
+    {
+        paletteColors = 1U << header.bpp;
+    }
+
+    /* The palette follows the DIB header. */
+    if (false == fd.seek(sizeof(BmpFileHeader) + header.headerSize, SeekSet))
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        uint8_t     entries[16U * PALETTE_ENTRY_SIZE];
+        uint32_t    index   = 0U;
+
+        /* Read several entries at once. */
+        while((paletteColors > index) && (true == isSuccessful))
+        {
+            uint32_t    cnt = paletteColors - index;
+            uint32_t    idx = 0U;
+
+            if ((sizeof(entries) / PALETTE_ENTRY_SIZE) < cnt)
+            {
+                cnt = sizeof(entries) / PALETTE_ENTRY_SIZE;
+            }
+
+            if ((cnt * PALETTE_ENTRY_SIZE) != fd.read(entries, cnt * PALETTE_ENTRY_SIZE))
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                for(idx = 0U; idx < cnt; ++idx)
+                {
+                    const uint8_t* entry = &entries[idx * PALETTE_ENTRY_SIZE];
+
+                    palette[index] = Color(entry[2], entry[1], entry[0]);
+                    ++index;
+                }
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+BmpImgLoader::Ret BmpImgLoader::loadPixels(File& fd, const BmpV5Header& header, const Color* palette, IImgRowSink& sink)
+{
+    Ret         ret         = RET_OK;
+    uint16_t    width       = abs(header.imageWidth);
+    uint16_t    height      = abs(header.imageHeight);
+
+    /* The bits representing the bitmap pixels are packed in rows.
+     * The size of each row is rounded up to a multiple of 4 bytes
+     * (a 32-bit DWORD) by padding.
+     */
+    uint32_t    rowSize     = (header.bpp * static_cast<uint32_t>(width) + 31U) / 32U * 4U;
+    uint8_t*    rowBuffer   = new(std::nothrow) uint8_t[rowSize];
+
+    if (nullptr == rowBuffer)
+    {
+        ret = RET_IMG_TOO_BIG;
+    }
+    else
+    {
+        uint16_t    row             = 0U;
+        bool        isTopToBottom   = false;
+
+        /* ImageHeight is expressed as a negative number for top-down images. */
+        if (0 > header.imageHeight)
+        {
+            isTopToBottom = true;
+        }
+
+        /* The rows are stored one after another, therefore they are read
+         * in file order and only the destination row differs.
+         */
+        while((height > row) && (RET_OK == ret))
+        {
+            if (rowSize != fd.read(rowBuffer, rowSize))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                uint16_t y = row;
+
+                if (false == isTopToBottom)
+                {
+                    y = height - row - 1U;
+                }
+
+                decodeRow(rowBuffer, header.bpp, palette, width, sink.getRow(y));
+                sink.endRow(y);
+            }
+
+            ++row;
+        }
+
+        delete[] rowBuffer;
+    }
+
+    return ret;
+}
+
+BmpImgLoader::Ret BmpImgLoader::loadRlePixels(File& fd, const BmpV5Header& header, const Color* palette, IImgRowSink& sink)
+{
+    Ret         ret         = RET_OK;
+    bool        isRle4      = (COMPRESSION_METHOD_RLE4 == header.compression);
+    bool        isEnd       = false;
+    uint16_t    width       = header.imageWidth;
+    uint16_t    height      = header.imageHeight;
+    uint32_t    x           = 0U;
+    uint32_t    row         = 0U;   /* Row in the file, which starts at the bottom of the image. */
+    Color*      pixels      = beginBlackRow(sink, height - 1U, width);
+    ReadBuffer  readBuffer;
+
+    readBuffer.pos  = 0U;
+    readBuffer.size = 0U;
+
+    while((false == isEnd) && (RET_OK == ret))
+    {
+        uint8_t cnt         = 0U;
+        uint8_t value       = 0U;
+        uint8_t rowsToSkip  = 0U;
+
+        if ((false == readByte(fd, readBuffer, cnt)) ||
+            (false == readByte(fd, readBuffer, value)))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        /* Encoded mode: The color index is repeated. In case of RLE4 the
+         * two color indices in the value are used alternately.
+         */
+        else if (0U < cnt)
+        {
+            uint8_t idx = 0U;
+
+            for(idx = 0U; idx < cnt; ++idx)
+            {
+                uint8_t colorIdx = value;
+
+                if (true == isRle4)
+                {
+                    colorIdx = (0U == (idx & 0x01U)) ? (value >> 4U) : (value & 0x0FU);
+                }
+
+                if (width > x)
+                {
+                    pixels[x] = palette[colorIdx];
+                }
+
+                ++x;
+            }
+        }
+        else if (RLE_ESCAPE_END_OF_LINE == value)
+        {
+            x           = 0U;
+            rowsToSkip  = 1U;
+        }
+        else if (RLE_ESCAPE_END_OF_BITMAP == value)
+        {
+            isEnd = true;
+        }
+        else if (RLE_ESCAPE_DELTA == value)
+        {
+            uint8_t dx = 0U;
+            uint8_t dy = 0U;
+
+            if ((false == readByte(fd, readBuffer, dx)) ||
+                (false == readByte(fd, readBuffer, dy)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                x           += dx;
+                rowsToSkip   = dy;
+            }
+        }
+        /* Absolute mode: The value is the number of uncompressed color
+         * indices, which follow. They are padded to a 16-bit boundary.
+         */
+        else
+        {
+            uint8_t     idx         = 0U;
+            uint8_t     data        = 0U;
+            uint16_t    byteCnt     = value;
+
+            if (true == isRle4)
+            {
+                byteCnt = (value + 1U) / 2U;
+            }
+
+            for(idx = 0U; (idx < value) && (RET_OK == ret); ++idx)
+            {
+                uint8_t colorIdx = 0U;
+
+                if ((false == isRle4) || (0U == (idx & 0x01U)))
+                {
+                    if (false == readByte(fd, readBuffer, data))
+                    {
+                        ret = RET_FILE_FORMAT_INVALID;
+                    }
+                }
+
+                if (false == isRle4)
+                {
+                    colorIdx = data;
+                }
+                else
+                {
+                    colorIdx = (0U == (idx & 0x01U)) ? (data >> 4U) : (data & 0x0FU);
+                }
+
+                if ((RET_OK == ret) &&
+                    (width > x))
+                {
+                    pixels[x] = palette[colorIdx];
+                }
+
+                ++x;
+            }
+
+            if ((RET_OK == ret) &&
+                (0U != (byteCnt & 0x01U)) &&
+                (false == readByte(fd, readBuffer, data)))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+        }
+
+        /* Complete the current row and continue with the next one,
+         * which starts black.
+         */
+        while((0U < rowsToSkip) && (false == isEnd))
+        {
+            sink.endRow(height - row - 1U);
+            ++row;
+            --rowsToSkip;
+
+            /* All rows decoded? */
+            if (height <= row)
+            {
+                isEnd = true;
+            }
+            else
+            {
+                pixels = beginBlackRow(sink, height - row - 1U, width);
+            }
+        }
+    }
+
+    /* The rows, which are not part of the encoding, are black. */
+    if ((RET_OK == ret) &&
+        (height > row))
+    {
+        sink.endRow(height - row - 1U);
+        ++row;
+
+        while(height > row)
+        {
+            (void)beginBlackRow(sink, height - row - 1U, width);
+            sink.endRow(height - row - 1U);
+            ++row;
+        }
+    }
+
+    return ret;
+}
+
+Color* BmpImgLoader::beginBlackRow(IImgRowSink& sink, uint16_t y, uint16_t width)
+{
+    Color*      pixels  = sink.getRow(y);
+    uint16_t    x       = 0U;
+
+    for(x = 0U; x < width; ++x)
+    {
+        pixels[x] = ColorDef::BLACK;
+    }
+
+    return pixels;
+}
+
+void BmpImgLoader::decodeRow(const uint8_t* rowBuffer, uint16_t bpp, const Color* palette, uint16_t width, Color* pixels)
+{
+    uint16_t    x       = 0U;
+
+    switch(bpp)
+    {
+    case 1U:
+        for(x = 0U; x < width; ++x)
+        {
+            uint8_t colorIdx = (rowBuffer[x >> 3U] >> (7U - (x & 0x07U))) & 0x01U;
+
+            pixels[x] = palette[colorIdx];
+        }
+        break;
+
+    case 4U:
+        for(x = 0U; x < width; ++x)
+        {
+            uint8_t colorIdx = (rowBuffer[x >> 1U] >> ((0U == (x & 0x01U)) ? 4U : 0U)) & 0x0FU;
+
+            pixels[x] = palette[colorIdx];
+        }
+        break;
+
+    case 8U:
+        for(x = 0U; x < width; ++x)
+        {
+            pixels[x] = palette[rowBuffer[x]];
+        }
+        break;
+
+    case 24U:
+    case 32U:
+        {
+            uint8_t         bytePerPixel    = bpp / 8U;
+            const uint8_t*  pixel           = rowBuffer;
+
+            for(x = 0U; x < width; ++x)
+            {
+                pixels[x] = Color(pixel[2], pixel[1], pixel[0]);
+                pixel += bytePerPixel;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -277,3 +669,36 @@ bool BmpImgLoader::loadDibHeader(File& fd, BmpV5Header& header)
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Read a single byte via the read buffer. The buffer is refilled from the
+ * file, if all buffered bytes are consumed.
+ *
+ * @param[in]       fd      File descriptor
+ * @param[in,out]   buffer  Read buffer
+ * @param[out]      value   Read byte
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool readByte(File& fd, ReadBuffer& buffer, uint8_t& value)
+{
+    bool isSuccessful = true;
+
+    if (buffer.size <= buffer.pos)
+    {
+        buffer.size = fd.read(buffer.data, sizeof(buffer.data));
+        buffer.pos  = 0U;
+    }
+
+    if (buffer.size <= buffer.pos)
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        value = buffer.data[buffer.pos];
+        ++buffer.pos;
+    }
+
+    return isSuccessful;
+}
@@ -47,6 +47,8 @@
 #include <YAGfxBitmap.h>
 #include <FS.h>
 
+#include "IImgRowSink.hpp"
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -61,10 +63,13 @@ typedef struct _BmpV5Header BmpV5Header;
 
 /**
  * Bitmap image loader, which supports images that have
- * - 24/32 bit per pixel
- * - No compression
- * - No palette colors
+ * - 1/4/8 bit per pixel with palette colors
+ * - 24/32 bit per pixel without palette colors
+ * - No compression or RLE8/RLE4 compression
  * - Resolution of max. 65535 x 65535 pixels
+ *
+ * The pixel data is read row by row into a row buffer, instead of pixel by
+ * pixel, to keep the number of file system accesses low.
  */
 class BmpImgLoader
 {
@@ -96,6 +101,9 @@ public:
         RET_IMG_TOO_BIG                 /**< Image size is too big. */
     };
 
+    /** Bitmap format signature "BM" */
+    static const uint16_t SIGNATURE = 0x4D42U;
+
     /**
      * Load bitmap image (.bmp) from file system to bitmap buffer.
      * 
@@ -107,6 +115,18 @@ public:
      */
     Ret load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap);
 
+    /**
+     * Load bitmap image (.bmp) from file system row by row to the row sink.
+     * Pixels, which are skipped by a RLE encoding, are black.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[in] sink      Row sink, which receives the image rows.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret load(FS& fs, const String& fileName, IImgRowSink& sink);
+
 private:
 
     /**
@@ -128,6 +148,76 @@ private:
      * @return If successful, it will return true otherwise false.
      */
     bool loadDibHeader(File& fd, BmpV5Header& header);
+
+    /**
+     * Is the bitmap image format, described by the DIB header, supported?
+     *
+     * @param[in] header    DIB header
+     *
+     * @return If supported, it will return true otherwise false.
+     */
+    bool isFormatSupported(const BmpV5Header& header) const;
+
+    /**
+     * Load the color palette from file system.
+     * Palette entries, which are not part of the file, are black.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] header        DIB header
+     * @param[out] palette      Color palette with 2^bpp entries
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool loadPalette(File& fd, const BmpV5Header& header, Color* palette);
+
+    /**
+     * Load the uncompressed pixel data row by row from file system.
+     * The file descriptor must point to the begin of the pixel data.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] header        DIB header
+     * @param[in] palette       Color palette, only used for 1/4/8 bit per pixel
+     * @param[in] sink          Row sink
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret loadPixels(File& fd, const BmpV5Header& header, const Color* palette, IImgRowSink& sink);
+
+    /**
+     * Load the RLE8/RLE4 compressed pixel data from file system.
+     * The file descriptor must point to the begin of the pixel data.
+     * Pixels, which are skipped by the encoding, are black.
+     *
+     * @param[in] fd            File descriptor
+     * @param[in] header        DIB header
+     * @param[in] palette       Color palette
+     * @param[in] sink          Row sink
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret loadRlePixels(File& fd, const BmpV5Header& header, const Color* palette, IImgRowSink& sink);
+
+    /**
+     * Get a row from the row sink, which is cleared to black.
+     *
+     * @param[in] sink          Row sink
+     * @param[in] y             Y-coordinate of the row
+     * @param[in] width         Row width in pixels
+     *
+     * @return Row buffer
+     */
+    Color* beginBlackRow(IImgRowSink& sink, uint16_t y, uint16_t width);
+
+    /**
+     * Decode a single uncompressed pixel row.
+     *
+     * @param[in] rowBuffer     Pixel row
+     * @param[in] bpp           Bits per pixel
+     * @param[in] palette       Color palette, only used for 1/4/8 bit per pixel
+     * @param[in] width         Row width in pixels
+     * @param[out] pixels       Decoded pixel row
+     */
+    void decodeRow(const uint8_t* rowBuffer, uint16_t bpp, const Color* palette, uint16_t width, Color* pixels);
 };
 
 /******************************************************************************
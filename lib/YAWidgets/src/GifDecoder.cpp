@@ -0,0 +1,946 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GifDecoder.h"
+
+#include <new>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Max. number of LZW codes, given by the max. code size of 12 bit. */
+static const uint16_t   LZW_MAX_CODES       = 4096U;
+
+/** Max. size of a color table in bytes (256 RGB colors). */
+static const uint16_t   COLOR_TABLE_SIZE    = 256U * 3U;
+
+/** Max. size of a data sub-block in bytes. */
+static const uint16_t   SUB_BLOCK_SIZE      = 255U;
+
+/**
+ * LZW working set and buffers. Its size is fixed and independent of the
+ * image size and the number of frames. The global color table is read into
+ * it again for every frame, because it exists only while a frame is decoded.
+ */
+struct GifDecoder::WorkArea
+{
+    uint16_t    prefix[LZW_MAX_CODES];              /**< Prefix code of every LZW code */
+    uint8_t     suffix[LZW_MAX_CODES];              /**< Last color index of every LZW code */
+    uint8_t     stack[LZW_MAX_CODES];               /**< Color indices of a single LZW code in reverse order */
+    uint8_t     globalColorTable[COLOR_TABLE_SIZE]; /**< Global color table (RGB) */
+    uint8_t     localColorTable[COLOR_TABLE_SIZE];  /**< Local color table (RGB) */
+    uint8_t     subBlock[SUB_BLOCK_SIZE];           /**< Current data sub-block */
+    uint8_t     subBlockLen;                        /**< Length of the current data sub-block */
+    uint8_t     subBlockPos;                        /**< Read position in the current data sub-block */
+    bool        isSubBlockEnd;                      /**< Block terminator found? */
+};
+
+/** Block types */
+typedef enum
+{
+    BLOCK_EXTENSION     = 0x21, /**< Extension introducer */
+    BLOCK_IMAGE         = 0x2C, /**< Image separator */
+    BLOCK_TRAILER       = 0x3B  /**< Trailer */
+
+} BlockType;
+
+/** Extension labels */
+typedef enum
+{
+    EXTENSION_GRAPHIC_CONTROL   = 0xF9, /**< Graphic control extension */
+    EXTENSION_APPLICATION       = 0xFF  /**< Application extension */
+
+} ExtensionLabel;
+
+/** Frame disposal methods */
+typedef enum
+{
+    DISPOSAL_NONE       = 0,    /**< No disposal specified */
+    DISPOSAL_KEEP       = 1,    /**< Leave the frame in place. */
+    DISPOSAL_BACKGROUND = 2,    /**< Restore the frame area to the background. */
+    DISPOSAL_PREVIOUS   = 3     /**< Restore the frame area to the previous canvas. */
+
+} Disposal;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint16_t getUInt16(const uint8_t* data);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Size of the GIF header and the logical screen descriptor in bytes. */
+static const uint8_t    HEADER_SIZE             = 13U;
+
+/** Size of the image descriptor in bytes, without the image separator. */
+static const uint8_t    IMAGE_DESCRIPTOR_SIZE   = 9U;
+
+/** Color table flag in the packed fields. */
+static const uint8_t    FLAG_COLOR_TABLE        = 0x80U;
+
+/** Interlace flag in the packed fields of the image descriptor. */
+static const uint8_t    FLAG_INTERLACE          = 0x40U;
+
+/** Transparent color flag in the packed fields of the graphic control extension. */
+static const uint8_t    FLAG_TRANSPARENT        = 0x01U;
+
+/** Max. LZW code size in bits. */
+static const uint8_t    LZW_MAX_CODE_SIZE       = 12U;
+
+/** Application identifier and authentication code of the looping extension. */
+static const char*      NETSCAPE_ID             = "NETSCAPE2.0";
+
+/** Frames with a shorter delay in 1/100 s are shown with the default delay, like web browsers do. */
+static const uint16_t   MIN_DELAY               = 2U;
+
+/** Default delay of a frame in ms. */
+static const uint32_t   DEFAULT_DELAY           = 100U;
+
+/** Interlaced images: first row of every pass. */
+static const uint8_t    INTERLACE_START[]       = { 0U, 4U, 2U, 1U };
+
+/** Interlaced images: row step of every pass. */
+static const uint8_t    INTERLACE_STEP[]        = { 8U, 8U, 4U, 2U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GifDecoder::GifDecoder(const GifDecoder& decoder) :
+    m_fs(decoder.m_fs),
+    m_fileName(decoder.m_fileName),
+    m_fd(),
+    m_canvas(decoder.m_canvas),
+    m_backup(decoder.m_backup),
+    m_work(nullptr),
+    m_isGlobalColorTable(decoder.m_isGlobalColorTable),
+    m_globalColorCnt(decoder.m_globalColorCnt),
+    m_firstFrameOffset(decoder.m_firstFrameOffset),
+    m_fileOffset(decoder.m_fileOffset),
+    m_gce(decoder.m_gce),
+    m_prevFrame(decoder.m_prevFrame),
+    m_delay(decoder.m_delay),
+    m_isLoopCntAvailable(decoder.m_isLoopCntAvailable),
+    m_loopCnt(decoder.m_loopCnt),
+    m_playCnt(decoder.m_playCnt),
+    m_frameIdx(decoder.m_frameIdx),
+    m_isFinished(decoder.m_isFinished)
+{
+}
+
+GifDecoder& GifDecoder::operator=(const GifDecoder& decoder)
+{
+    if (&decoder != this)
+    {
+        close();
+
+        m_fs                    = decoder.m_fs;
+        m_fileName              = decoder.m_fileName;
+        m_canvas                = decoder.m_canvas;
+        m_backup                = decoder.m_backup;
+        m_isGlobalColorTable    = decoder.m_isGlobalColorTable;
+        m_globalColorCnt        = decoder.m_globalColorCnt;
+        m_firstFrameOffset      = decoder.m_firstFrameOffset;
+        m_fileOffset            = decoder.m_fileOffset;
+        m_gce                   = decoder.m_gce;
+        m_prevFrame             = decoder.m_prevFrame;
+        m_delay                 = decoder.m_delay;
+        m_isLoopCntAvailable    = decoder.m_isLoopCntAvailable;
+        m_loopCnt               = decoder.m_loopCnt;
+        m_playCnt               = decoder.m_playCnt;
+        m_frameIdx              = decoder.m_frameIdx;
+        m_isFinished            = decoder.m_isFinished;
+    }
+
+    return *this;
+}
+
+GifDecoder::Ret GifDecoder::open(FS& fs, const String& fileName)
+{
+    Ret ret = BmpImgLoader::RET_OK;
+
+    close();
+
+    m_fd = fs.open(fileName);
+
+    if (false == m_fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        m_fs        = &fs;
+        m_fileName  = fileName;
+
+        ret = readHeader();
+
+        if (BmpImgLoader::RET_OK == ret)
+        {
+            ret = next();
+        }
+
+        if (BmpImgLoader::RET_OK != ret)
+        {
+            close();
+        }
+    }
+
+    return ret;
+}
+
+void GifDecoder::close()
+{
+    suspend();
+
+    m_canvas.release();
+    m_backup.release();
+
+    m_fs                    = nullptr;
+    m_fileName.clear();
+    m_isGlobalColorTable    = false;
+    m_globalColorCnt        = 0U;
+    m_firstFrameOffset      = 0U;
+    m_fileOffset            = 0U;
+    m_delay                 = 0U;
+    m_isLoopCntAvailable    = false;
+    m_loopCnt               = 0U;
+    m_playCnt               = 0U;
+    m_frameIdx              = 0U;
+    m_isFinished            = false;
+
+    resetGraphicControl();
+}
+
+GifDecoder::Ret GifDecoder::next()
+{
+    Ret     ret             = BmpImgLoader::RET_OK;
+    bool    isFrameDecoded  = false;
+    bool    isRewound       = false;
+
+    if (false == isOpen())
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else if (true == m_isFinished)
+    {
+        /* The last frame stays. */
+        ;
+    }
+    else
+    {
+        ret = beginFrame();
+
+        while((BmpImgLoader::RET_OK == ret) && (false == isFrameDecoded) && (false == m_isFinished))
+        {
+            int blockType = m_fd.read();
+
+            switch(blockType)
+            {
+            case BLOCK_EXTENSION:
+                ret = readExtension();
+                break;
+
+            case BLOCK_IMAGE:
+                ret = readImage();
+
+                if (BmpImgLoader::RET_OK == ret)
+                {
+                    ++m_frameIdx;
+                    isFrameDecoded = true;
+                }
+                break;
+
+            /* A missing trailer is handled like the trailer, because
+             * some encoders don't write it.
+             */
+            case BLOCK_TRAILER:
+            case -1:
+                /* Without any frame, the file is broken. */
+                if ((0U == m_frameIdx) ||
+                    (true == isRewound))
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+                else
+                {
+                    ++m_playCnt;
+
+                    /* Without loop count, the animation is played once. */
+                    if ((false == m_isLoopCntAvailable) ||
+                        ((0U != m_loopCnt) && (m_loopCnt < m_playCnt)))
+                    {
+                        m_isFinished = true;
+                    }
+                    else if (false == rewind())
+                    {
+                        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                    }
+                    else
+                    {
+                        isRewound = true;
+                    }
+                }
+                break;
+
+            default:
+                ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                break;
+            }
+        }
+
+        endFrame();
+
+        /* A corrupt or removed file stops the animation with the last
+         * successful decoded frame. If there is temporary not enough memory
+         * for the LZW working set, the frame is decoded next time.
+         */
+        if ((BmpImgLoader::RET_OK != ret) &&
+            (BmpImgLoader::RET_IMG_TOO_BIG != ret))
+        {
+            m_isFinished = true;
+        }
+    }
+
+    return ret;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+GifDecoder::Ret GifDecoder::readHeader()
+{
+    Ret     ret = BmpImgLoader::RET_OK;
+    uint8_t header[HEADER_SIZE];
+
+    if (HEADER_SIZE != m_fd.read(header, HEADER_SIZE))
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+    }
+    else if ((0 != memcmp(header, "GIF87a", 6U)) &&
+             (0 != memcmp(header, "GIF89a", 6U)))
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED;
+    }
+    else
+    {
+        uint16_t    width   = getUInt16(&header[6]);
+        uint16_t    height  = getUInt16(&header[8]);
+        uint8_t     flags   = header[10];
+
+        m_firstFrameOffset = HEADER_SIZE;
+
+        /* The global color table itself is read with every frame. */
+        if (0U != (flags & FLAG_COLOR_TABLE))
+        {
+            m_isGlobalColorTable    = true;
+            m_globalColorCnt        = 1U << ((flags & 0x07U) + 1U);
+            m_firstFrameOffset     += 3U * m_globalColorCnt;
+        }
+
+        m_fileOffset = m_firstFrameOffset;
+
+        if ((0U == width) ||
+                 (0U == height))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        /* The background is transparent, which is black on the display. */
+        else if (false == m_canvas.create(width, height))
+        {
+            ret = BmpImgLoader::RET_IMG_TOO_BIG;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return ret;
+}
+
+GifDecoder::Ret GifDecoder::beginFrame()
+{
+    Ret ret = BmpImgLoader::RET_OK;
+
+    if (false == m_fd)
+    {
+        m_fd = m_fs->open(m_fileName);
+    }
+
+    if (false == m_fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        m_work = new(std::nothrow) WorkArea;
+
+        if (nullptr == m_work)
+        {
+            ret = BmpImgLoader::RET_IMG_TOO_BIG;
+        }
+        else if ((true == m_isGlobalColorTable) &&
+                 ((false == m_fd.seek(HEADER_SIZE)) ||
+                  ((3U * m_globalColorCnt) != m_fd.read(m_work->globalColorTable, 3U * m_globalColorCnt))))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else if (false == m_fd.seek(m_fileOffset))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return ret;
+}
+
+void GifDecoder::endFrame()
+{
+    /* Without working set, the file wasn't read and its position is not valid. */
+    if (nullptr != m_work)
+    {
+        m_fileOffset = m_fd.position();
+
+        delete m_work;
+        m_work = nullptr;
+    }
+}
+
+GifDecoder::Ret GifDecoder::readExtension()
+{
+    Ret ret     = BmpImgLoader::RET_OK;
+    int label   = m_fd.read();
+
+    beginSubBlocks();
+
+    if (EXTENSION_GRAPHIC_CONTROL == label)
+    {
+        int flags   = readSubBlockByte();
+        int delayLo = readSubBlockByte();
+        int delayHi = readSubBlockByte();
+        int idx     = readSubBlockByte();
+
+        if ((0 > flags) ||
+            (0 > delayLo) ||
+            (0 > delayHi) ||
+            (0 > idx))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else
+        {
+            m_gce.disposal          = (flags >> 2U) & 0x07U;
+            m_gce.isTransparent     = (0U != (flags & FLAG_TRANSPARENT));
+            m_gce.transparentIdx    = idx;
+            m_gce.delay             = (delayHi << 8U) | delayLo;
+        }
+    }
+    else if (EXTENSION_APPLICATION == label)
+    {
+        size_t  idLen   = strlen(NETSCAPE_ID);
+        size_t  idx     = 0U;
+        bool    isEqual = true;
+
+        while((idLen > idx) && (true == isEqual))
+        {
+            if (NETSCAPE_ID[idx] != readSubBlockByte())
+            {
+                isEqual = false;
+            }
+
+            ++idx;
+        }
+
+        /* The loop count is only taken from the first animation run. */
+        if ((true == isEqual) &&
+            (0U == m_playCnt) &&
+            (1 == readSubBlockByte()))
+        {
+            int loopCntLo = readSubBlockByte();
+            int loopCntHi = readSubBlockByte();
+
+            if ((0 <= loopCntLo) &&
+                (0 <= loopCntHi))
+            {
+                m_isLoopCntAvailable    = true;
+                m_loopCnt               = (loopCntHi << 8U) | loopCntLo;
+            }
+        }
+    }
+    else if (0 > label)
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+    }
+    else
+    {
+        /* Not supported, skip it. */
+        ;
+    }
+
+    skipSubBlocks();
+
+    return ret;
+}
+
+GifDecoder::Ret GifDecoder::readImage()
+{
+    Ret     ret = BmpImgLoader::RET_OK;
+    uint8_t descriptor[IMAGE_DESCRIPTOR_SIZE];
+
+    if (IMAGE_DESCRIPTOR_SIZE != m_fd.read(descriptor, IMAGE_DESCRIPTOR_SIZE))
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+    }
+    else
+    {
+        Frame           frame;
+        uint8_t         flags       = descriptor[8];
+        const uint8_t*  colorTable  = nullptr;
+        uint16_t        colorCnt    = 0U;
+
+        frame.x         = static_cast<int16_t>(getUInt16(&descriptor[0]));
+        frame.y         = static_cast<int16_t>(getUInt16(&descriptor[2]));
+        frame.width     = getUInt16(&descriptor[4]);
+        frame.height    = getUInt16(&descriptor[6]);
+        frame.disposal  = m_gce.disposal;
+
+        if (0U != (flags & FLAG_COLOR_TABLE))
+        {
+            colorCnt    = 1U << ((flags & 0x07U) + 1U);
+            colorTable  = m_work->localColorTable;
+
+            if ((3U * colorCnt) != m_fd.read(m_work->localColorTable, 3U * colorCnt))
+            {
+                ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+            }
+        }
+        else if (true == m_isGlobalColorTable)
+        {
+            colorCnt    = m_globalColorCnt;
+            colorTable  = m_work->globalColorTable;
+        }
+        else
+        {
+            /* No color table, all pixels will be black. */
+            ;
+        }
+
+        if (BmpImgLoader::RET_OK == ret)
+        {
+            disposePrevFrame();
+
+            /* Save the canvas, if it shall be restored after this frame.
+             * If there is not enough memory, the frame will be kept.
+             */
+            if (DISPOSAL_PREVIOUS == frame.disposal)
+            {
+                if ((false == m_backup.isAllocated()) &&
+                    (false == m_backup.create(m_canvas.getWidth(), m_canvas.getHeight())))
+                {
+                    frame.disposal = DISPOSAL_KEEP;
+                }
+                else
+                {
+                    m_backup.copy(m_canvas);
+                }
+            }
+
+            ret = decodeImage(frame, colorTable, colorCnt, (0U != (flags & FLAG_INTERLACE)));
+
+            m_prevFrame = frame;
+
+            if (MIN_DELAY > m_gce.delay)
+            {
+                m_delay = DEFAULT_DELAY;
+            }
+            else
+            {
+                m_delay = m_gce.delay * 10U;
+            }
+
+            /* The graphic control is only valid for one frame. */
+            resetGraphicControl();
+        }
+    }
+
+    return ret;
+}
+
+GifDecoder::Ret GifDecoder::decodeImage(const Frame& frame, const uint8_t* colorTable, uint16_t colorCnt, bool isInterlaced)
+{
+    Ret         ret         = BmpImgLoader::RET_OK;
+    WorkArea&   work        = *m_work;
+    int         minCodeSize = m_fd.read();
+
+    /* The min. code size is at least 2 bit, but some encoders write 1 bit for monochrome images. */
+    if ((1 > minCodeSize) ||
+        (8 < minCodeSize))
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+    }
+    else
+    {
+        const uint16_t  CLEAR_CODE  = 1U << minCodeSize;
+        const uint16_t  EOI_CODE    = CLEAR_CODE + 1U;
+        const uint16_t  NO_CODE     = LZW_MAX_CODES;
+        uint8_t         codeSize    = minCodeSize + 1U;
+        uint16_t        nextCode    = EOI_CODE + 1U;
+        uint16_t        oldCode     = NO_CODE;
+        uint8_t         firstIdx    = 0U;
+        uint32_t        bitBuffer   = 0U;
+        uint8_t         bitCnt      = 0U;
+        bool            isEnd       = false;
+        uint32_t        pixelCnt    = static_cast<uint32_t>(frame.width) * frame.height;
+        uint32_t        pixelIdx    = 0U;
+        uint16_t        x           = 0U;
+        uint16_t        y           = 0U;
+        uint8_t         pass        = 0U;
+        uint16_t        code        = 0U;
+
+        for(code = 0U; code < CLEAR_CODE; ++code)
+        {
+            work.prefix[code] = NO_CODE;
+            work.suffix[code] = static_cast<uint8_t>(code);
+        }
+
+        if (true == isInterlaced)
+        {
+            y = INTERLACE_START[0];
+        }
+
+        beginSubBlocks();
+
+        while((false == isEnd) && (BmpImgLoader::RET_OK == ret))
+        {
+            uint16_t stackSize = 0U;
+
+            /* Get next code from the bit stream. */
+            while((codeSize > bitCnt) && (false == isEnd))
+            {
+                int data = readSubBlockByte();
+
+                if (0 > data)
+                {
+                    isEnd = true;
+                }
+                else
+                {
+                    bitBuffer |= static_cast<uint32_t>(data) << bitCnt;
+                    bitCnt += 8U;
+                }
+            }
+
+            if (true == isEnd)
+            {
+                /* Image data ends without end of information code. */
+                ;
+            }
+            else
+            {
+                code        = bitBuffer & ((1U << codeSize) - 1U);
+                bitBuffer >>= codeSize;
+                bitCnt     -= codeSize;
+
+                if (CLEAR_CODE == code)
+                {
+                    codeSize    = minCodeSize + 1U;
+                    nextCode    = EOI_CODE + 1U;
+                    oldCode     = NO_CODE;
+                }
+                else if (EOI_CODE == code)
+                {
+                    isEnd = true;
+                }
+                else if (NO_CODE == oldCode)
+                {
+                    /* First code after a clear code is always a color index. */
+                    if (CLEAR_CODE < code)
+                    {
+                        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                    }
+                    else
+                    {
+                        firstIdx                = work.suffix[code];
+                        work.stack[stackSize]   = firstIdx;
+                        ++stackSize;
+                        oldCode                 = code;
+                    }
+                }
+                else if (nextCode < code)
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+                else
+                {
+                    uint16_t inCode = code;
+
+                    /* Code not in the table yet, which is the special case
+                     * of a code, which consists of the previous code and its
+                     * first color index.
+                     */
+                    if (nextCode == code)
+                    {
+                        work.stack[stackSize] = firstIdx;
+                        ++stackSize;
+                        code = oldCode;
+                    }
+
+                    /* The table entries are linked backwards, therefore the
+                     * color indices are collected in reverse order.
+                     */
+                    while((CLEAR_CODE <= code) && (LZW_MAX_CODES > stackSize))
+                    {
+                        work.stack[stackSize] = work.suffix[code];
+                        ++stackSize;
+                        code = work.prefix[code];
+                    }
+
+                    if (LZW_MAX_CODES <= stackSize)
+                    {
+                        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                    }
+                    else
+                    {
+                        firstIdx                = work.suffix[code];
+                        work.stack[stackSize]   = firstIdx;
+                        ++stackSize;
+
+                        if (LZW_MAX_CODES > nextCode)
+                        {
+                            work.prefix[nextCode] = oldCode;
+                            work.suffix[nextCode] = firstIdx;
+                            ++nextCode;
+
+                            if ((nextCode == (1U << codeSize)) &&
+                                (LZW_MAX_CODE_SIZE > codeSize))
+                            {
+                                ++codeSize;
+                            }
+                        }
+
+                        oldCode = inCode;
+                    }
+                }
+            }
+
+            /* Draw the color indices of the code. */
+            while((0U < stackSize) && (BmpImgLoader::RET_OK == ret) && (pixelCnt > pixelIdx))
+            {
+                uint8_t colorIdx = 0U;
+
+                --stackSize;
+                colorIdx = work.stack[stackSize];
+
+                if ((false == m_gce.isTransparent) ||
+                    (m_gce.transparentIdx != colorIdx))
+                {
+                    Color color;
+
+                    if (colorCnt > colorIdx)
+                    {
+                        color.set(colorTable[3U * colorIdx], colorTable[3U * colorIdx + 1U], colorTable[3U * colorIdx + 2U]);
+                    }
+
+                    m_canvas.drawPixel(frame.x + x, frame.y + y, color);
+                }
+
+                ++pixelIdx;
+                ++x;
+
+                if (frame.width <= x)
+                {
+                    x = 0U;
+
+                    if (false == isInterlaced)
+                    {
+                        ++y;
+                    }
+                    else
+                    {
+                        y += INTERLACE_STEP[pass];
+
+                        while((frame.height <= y) && (3U > pass))
+                        {
+                            ++pass;
+                            y = INTERLACE_START[pass];
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Skip the rest of the image data, e.g. after the end of information code. */
+        skipSubBlocks();
+    }
+
+    return ret;
+}
+
+void GifDecoder::disposePrevFrame()
+{
+    if (DISPOSAL_BACKGROUND == m_prevFrame.disposal)
+    {
+        m_canvas.fillRect(m_prevFrame.x, m_prevFrame.y, m_prevFrame.width, m_prevFrame.height, ColorDef::BLACK);
+    }
+    else if (DISPOSAL_PREVIOUS == m_prevFrame.disposal)
+    {
+        int16_t x = 0;
+        int16_t y = 0;
+
+        for(y = m_prevFrame.y; y < (m_prevFrame.y + m_prevFrame.height); ++y)
+        {
+            for(x = m_prevFrame.x; x < (m_prevFrame.x + m_prevFrame.width); ++x)
+            {
+                m_canvas.drawPixel(x, y, m_backup.getColor(x, y));
+            }
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    m_prevFrame.disposal = DISPOSAL_NONE;
+}
+
+void GifDecoder::resetGraphicControl()
+{
+    m_gce.disposal          = DISPOSAL_NONE;
+    m_gce.isTransparent     = false;
+    m_gce.transparentIdx    = 0U;
+    m_gce.delay             = 0U;
+}
+
+void GifDecoder::beginSubBlocks()
+{
+    m_work->subBlockLen     = 0U;
+    m_work->subBlockPos     = 0U;
+    m_work->isSubBlockEnd   = false;
+}
+
+int GifDecoder::readSubBlockByte()
+{
+    int         data    = -1;
+    WorkArea&   work    = *m_work;
+
+    if ((work.subBlockLen <= work.subBlockPos) &&
+        (false == work.isSubBlockEnd))
+    {
+        int len = m_fd.read();
+
+        work.subBlockLen = 0U;
+        work.subBlockPos = 0U;
+
+        /* A zero length sub-block is the block terminator. */
+        if (0 >= len)
+        {
+            work.isSubBlockEnd = true;
+        }
+        else if (static_cast<size_t>(len) != m_fd.read(work.subBlock, len))
+        {
+            work.isSubBlockEnd = true;
+        }
+        else
+        {
+            work.subBlockLen = len;
+        }
+    }
+
+    if (work.subBlockLen > work.subBlockPos)
+    {
+        data = work.subBlock[work.subBlockPos];
+        ++work.subBlockPos;
+    }
+
+    return data;
+}
+
+void GifDecoder::skipSubBlocks()
+{
+    while(false == m_work->isSubBlockEnd)
+    {
+        m_work->subBlockPos = m_work->subBlockLen;
+        (void)readSubBlockByte();
+    }
+}
+
+bool GifDecoder::rewind()
+{
+    m_frameIdx = 0U;
+    resetGraphicControl();
+
+    return m_fd.seek(m_firstFrameOffset);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get 16-bit value from data, which is stored in little endian.
+ *
+ * @param[in] data  Data
+ *
+ * @return 16-bit value
+ */
+static uint16_t getUInt16(const uint8_t* data)
+{
+    return static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8U);
+}
@@ -0,0 +1,353 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef GIF_DECODER_H
+#define GIF_DECODER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+#include "BmpImgLoader.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The GIF decoder streams the frames of a (animated) GIF image file from the
+ * filesystem. Only one frame is decoded at a time into a canvas, which has
+ * the size of the GIF logical screen. The fixed size LZW working set is only
+ * allocated while a frame is decoded, therefore the memory consumption is
+ * independent of the number of frames.
+ *
+ * The file can be closed with suspend() while the animation is not shown.
+ * It is opened again on demand to decode the next frame.
+ */
+class GifDecoder
+{
+public:
+
+    /**
+     * The result codes are the same as for the bitmap image loader.
+     */
+    typedef BmpImgLoader::Ret Ret;
+
+    /**
+     * Constructs a GIF decoder, which is closed.
+     */
+    GifDecoder() :
+        m_fs(nullptr),
+        m_fileName(),
+        m_fd(),
+        m_canvas(),
+        m_backup(),
+        m_work(nullptr),
+        m_isGlobalColorTable(false),
+        m_globalColorCnt(0U),
+        m_firstFrameOffset(0U),
+        m_fileOffset(0U),
+        m_gce(),
+        m_prevFrame(),
+        m_delay(0U),
+        m_isLoopCntAvailable(false),
+        m_loopCnt(0U),
+        m_playCnt(0U),
+        m_frameIdx(0U),
+        m_isFinished(false)
+    {
+        resetGraphicControl();
+    }
+
+    /**
+     * Constructs a GIF decoder by copying another one.
+     * The copy continues with the current frame. Its file is not opened
+     * until the next frame is decoded.
+     *
+     * @param[in] decoder   GIF decoder, which to copy
+     */
+    GifDecoder(const GifDecoder& decoder);
+
+    /**
+     * Destroys the GIF decoder.
+     */
+    ~GifDecoder()
+    {
+        close();
+    }
+
+    /**
+     * Assigns a existing GIF decoder.
+     * The animation continues with the current frame. The file is not
+     * opened until the next frame is decoded.
+     *
+     * @param[in] decoder   GIF decoder, which to assign
+     */
+    GifDecoder& operator=(const GifDecoder& decoder);
+
+    /**
+     * Open GIF image file and decode the first frame.
+     * A already opened file will be closed before.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] fileName  Name of the file
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret open(FS& fs, const String& fileName);
+
+    /**
+     * Close the GIF image file and release all buffers.
+     */
+    void close();
+
+    /**
+     * Close the GIF image file, but keep the current frame. The file is
+     * opened again, when the next frame is decoded.
+     */
+    void suspend()
+    {
+        if (true == m_fd)
+        {
+            m_fd.close();
+        }
+    }
+
+    /**
+     * Is a GIF image file open? A suspended one is still open.
+     *
+     * @return If open, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return m_canvas.isAllocated();
+    }
+
+    /**
+     * Decode the next frame. After the last frame, the animation starts
+     * again from the beginning, as long as the loop count of the file
+     * allows it. Afterwards the last frame stays.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret next();
+
+    /**
+     * Get the current frame.
+     *
+     * @return Current frame
+     */
+    const YAGfxBitmap& getFrame() const
+    {
+        return m_canvas;
+    }
+
+    /**
+     * Get the time how long the current frame shall be shown.
+     *
+     * @return Delay in ms
+     */
+    uint32_t getDelay() const
+    {
+        return m_delay;
+    }
+
+    /**
+     * Is the animation finished, because the loop count of the file is
+     * exhausted or the file is corrupt? A finished animation shows the
+     * last frame.
+     *
+     * @return If finished, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return m_isFinished;
+    }
+
+private:
+
+    /**
+     * Graphic control of the next frame.
+     */
+    typedef struct
+    {
+        uint8_t     disposal;       /**< Disposal method */
+        bool        isTransparent;  /**< Is there a transparent color index? */
+        uint8_t     transparentIdx; /**< Transparent color index */
+        uint16_t    delay;          /**< Delay in 1/100 s */
+
+    } GraphicControl;
+
+    /**
+     * Position, size and disposal method of a frame.
+     */
+    typedef struct
+    {
+        int16_t     x;              /**< x-coordinate on the canvas */
+        int16_t     y;              /**< y-coordinate on the canvas */
+        uint16_t    width;          /**< Width in pixels */
+        uint16_t    height;         /**< Height in pixels */
+        uint8_t     disposal;       /**< Disposal method */
+
+    } Frame;
+
+    /**
+     * LZW working set and buffers, which are only allocated while a frame
+     * is decoded.
+     */
+    struct WorkArea;
+
+    FS*                 m_fs;                   /**< Filesystem of the opened file */
+    String              m_fileName;             /**< Name of the opened file */
+    File                m_fd;                   /**< Opened GIF image file, closed while suspended. */
+    YAGfxDynamicBitmap  m_canvas;               /**< Canvas with the current frame */
+    YAGfxDynamicBitmap  m_backup;               /**< Canvas backup, only used by frames which restore the previous canvas. */
+    WorkArea*           m_work;                 /**< LZW working set and buffers */
+    bool                m_isGlobalColorTable;   /**< Is a global color table available? */
+    uint16_t            m_globalColorCnt;       /**< Number of colors in the global color table */
+    uint32_t            m_firstFrameOffset;     /**< File offset of the first block after the global color table */
+    uint32_t            m_fileOffset;           /**< File offset of the block after the current frame */
+    GraphicControl      m_gce;                  /**< Graphic control of the next frame */
+    Frame               m_prevFrame;            /**< Previous frame, which is disposed before the next frame is drawn. */
+    uint32_t            m_delay;                /**< Delay of the current frame in ms */
+    bool                m_isLoopCntAvailable;   /**< Is a loop count available? */
+    uint16_t            m_loopCnt;              /**< Loop count, 0 means infinite. */
+    uint16_t            m_playCnt;              /**< Number of complete animation runs */
+    uint16_t            m_frameIdx;             /**< Index of the current frame in the current animation run */
+    bool                m_isFinished;           /**< Is the animation finished? */
+
+    /**
+     * Read the GIF header and the logical screen descriptor.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret readHeader();
+
+    /**
+     * Prepare decoding a frame: Open the file if necessary, allocate the
+     * LZW working set and read the global color table into it.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret beginFrame();
+
+    /**
+     * Remember the file position after the decoded frame and release the
+     * LZW working set.
+     */
+    void endFrame();
+
+    /**
+     * Read a extension block. Only the graphic control extension and the
+     * NETSCAPE2.0 application extension are evaluated, all others are
+     * skipped.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret readExtension();
+
+    /**
+     * Read a image block and draw it onto the canvas.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret readImage();
+
+    /**
+     * Decode the LZW compressed image data and draw the pixels onto the canvas.
+     *
+     * @param[in] frame         Frame position and size
+     * @param[in] colorTable    Color table (RGB), may be nullptr.
+     * @param[in] colorCnt      Number of colors in the color table
+     * @param[in] isInterlaced  Are the rows interlaced?
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret decodeImage(const Frame& frame, const uint8_t* colorTable, uint16_t colorCnt, bool isInterlaced);
+
+    /**
+     * Dispose the previous frame according to its disposal method.
+     */
+    void disposePrevFrame();
+
+    /**
+     * Reset the graphic control to the default values.
+     */
+    void resetGraphicControl();
+
+    /**
+     * Start reading a sequence of data sub-blocks.
+     */
+    void beginSubBlocks();
+
+    /**
+     * Read the next data byte of a sequence of data sub-blocks.
+     *
+     * @return Data byte or -1 at the end of the sequence.
+     */
+    int readSubBlockByte();
+
+    /**
+     * Skip the rest of a sequence of data sub-blocks, including the block
+     * terminator.
+     */
+    void skipSubBlocks();
+
+    /**
+     * Start the animation from the beginning again.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool rewind();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* GIF_DECODER_H */
+
+/** @} */
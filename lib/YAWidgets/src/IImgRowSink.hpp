@@ -0,0 +1,194 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Image row sink interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef IIMG_ROW_SINK_HPP
+#define IIMG_ROW_SINK_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAColor.h>
+#include <YAGfxBitmap.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The image row sink receives the decoded pixels of an image row by row.
+ * This way an image can be processed, without keeping all of its pixels in
+ * memory. The rows are provided either from top to bottom or from bottom
+ * to top, depending on the image file.
+ */
+class IImgRowSink
+{
+public:
+
+    /**
+     * Destroys the image row sink interface.
+     */
+    virtual ~IImgRowSink()
+    {
+    }
+
+    /**
+     * Begin a new image. It is called once, before any row is provided.
+     *
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     *
+     * @return If the image can be received, it will return true otherwise false.
+     */
+    virtual bool begin(uint16_t width, uint16_t height) = 0;
+
+    /**
+     * Get the buffer for a single row, which will be completely written
+     * by the image loader.
+     *
+     * @param[in] y Y-coordinate of the row
+     *
+     * @return Row buffer with the image width in pixels.
+     */
+    virtual Color* getRow(uint16_t y) = 0;
+
+    /**
+     * The row, which was requested before, is completely written.
+     *
+     * @param[in] y Y-coordinate of the row
+     */
+    virtual void endRow(uint16_t y) = 0;
+
+protected:
+
+    /**
+     * Constructs the image row sink interface.
+     */
+    IImgRowSink()
+    {
+    }
+
+private:
+
+};
+
+/**
+ * The bitmap row sink writes the rows directly to a bitmap buffer, which is
+ * created with the image size.
+ */
+class BitmapRowSink : public IImgRowSink
+{
+public:
+
+    /**
+     * Constructs the bitmap row sink.
+     *
+     * @param[in] bitmap    Bitmap buffer, which receives the image.
+     */
+    BitmapRowSink(YAGfxDynamicBitmap& bitmap) :
+        IImgRowSink(),
+        m_bitmap(bitmap)
+    {
+    }
+
+    /**
+     * Destroys the bitmap row sink.
+     */
+    ~BitmapRowSink()
+    {
+    }
+
+    /**
+     * Begin a new image, which creates the bitmap buffer.
+     *
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     *
+     * @return If the bitmap buffer is created, it will return true otherwise false.
+     */
+    bool begin(uint16_t width, uint16_t height) final
+    {
+        m_bitmap.release();
+
+        return m_bitmap.create(width, height);
+    }
+
+    /**
+     * Get the row in the bitmap buffer.
+     *
+     * @param[in] y Y-coordinate of the row
+     *
+     * @return Row in the bitmap buffer
+     */
+    Color* getRow(uint16_t y) final
+    {
+        return &m_bitmap.getColor(0, y);
+    }
+
+    /**
+     * The row is already part of the bitmap buffer, so nothing to do.
+     *
+     * @param[in] y Y-coordinate of the row
+     */
+    void endRow(uint16_t y) final
+    {
+        UTIL_NOT_USED(y);
+    }
+
+private:
+
+    YAGfxDynamicBitmap& m_bitmap;   /**< Bitmap buffer */
+
+    BitmapRowSink();
+    BitmapRowSink(const BitmapRowSink& sink);
+    BitmapRowSink& operator=(const BitmapRowSink& sink);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* IIMG_ROW_SINK_HPP */
+
+/** @} */
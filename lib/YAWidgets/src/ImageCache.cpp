@@ -0,0 +1,404 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cache of decoded images
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ImageCache.h"
+#include "NativeImg.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+const YAGfxDynamicBitmap* ImageCache::Handle::get() const
+{
+    const YAGfxDynamicBitmap* bitmap = nullptr;
+
+    if (nullptr != m_entry)
+    {
+        bitmap = &m_entry->bitmap;
+    }
+
+    return bitmap;
+}
+
+ImageCache::Handle ImageCache::load(FS& fs, const String& fileName, BmpImgLoader::Ret& ret)
+{
+    Handle  handle;
+    File    fd      = fs.open(fileName);
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        time_t      lastWrite   = fd.getLastWrite();
+        size_t      fileSize    = fd.size();
+        uint16_t    signature   = 0U;
+        bool        isNative    = false;
+        Entry*      entry       = nullptr;
+
+        /* Transcoded images are detected by their signature, because they
+         * keep the file name.
+         */
+        if ((true == NativeImg::readSignature(fd, signature)) &&
+            (NativeImg::SIGNATURE == signature))
+        {
+            isNative = true;
+        }
+
+        fd.close();
+
+        lock();
+
+        entry = find(fileName);
+
+        /* Image file changed since it was decoded? */
+        if ((nullptr != entry) &&
+            ((lastWrite != entry->lastWrite) ||
+             (fileSize != entry->fileSize)))
+        {
+            markStale(entry);
+            entry = nullptr;
+        }
+
+        if (nullptr != entry)
+        {
+            ++entry->refCnt;
+            ++m_useCnt;
+            entry->lastUse = m_useCnt;
+
+            ret = BmpImgLoader::RET_OK;
+        }
+        else
+        {
+            entry = add(fs, fileName, isNative, lastWrite, fileSize, ret);
+        }
+
+        handle.m_entry = entry;
+
+        unlock();
+    }
+
+    return handle;
+}
+
+void ImageCache::invalidate(const String& fileName)
+{
+    Entry* entry = nullptr;
+
+    lock();
+
+    entry = find(fileName);
+
+    if (nullptr != entry)
+    {
+        markStale(entry);
+    }
+
+    unlock();
+}
+
+void ImageCache::setBudget(size_t budget)
+{
+    lock();
+
+    m_budget = budget;
+    evict(m_budget);
+
+    unlock();
+}
+
+void ImageCache::clear()
+{
+    lock();
+    evict(0U);
+    unlock();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+ImageCache::~ImageCache()
+{
+    DLinkedListIterator<Entry*> it(m_entries);
+
+    while(true == it.first())
+    {
+        Entry* entry = *it.current();
+
+        it.remove();
+        delete entry;
+    }
+}
+
+void ImageCache::lock()
+{
+#ifndef NATIVE
+    (void)m_mutex.take(portMAX_DELAY);
+#endif  /* NATIVE */
+}
+
+void ImageCache::unlock()
+{
+#ifndef NATIVE
+    (void)m_mutex.give();
+#endif  /* NATIVE */
+}
+
+void ImageCache::acquire(Entry* entry)
+{
+    if (nullptr != entry)
+    {
+        lock();
+        ++entry->refCnt;
+        unlock();
+    }
+}
+
+void ImageCache::release(Entry* entry)
+{
+    if (nullptr != entry)
+    {
+        lock();
+
+        if (0U < entry->refCnt)
+        {
+            --entry->refCnt;
+
+            if (0U == entry->refCnt)
+            {
+                if (true == entry->isStale)
+                {
+                    destroy(entry);
+                }
+                else
+                {
+                    evict(m_budget);
+                }
+            }
+        }
+
+        unlock();
+    }
+}
+
+void ImageCache::markStale(Entry* entry)
+{
+    entry->isStale = true;
+
+    if (0U == entry->refCnt)
+    {
+        destroy(entry);
+    }
+}
+
+ImageCache::Entry* ImageCache::find(const String& fileName)
+{
+    Entry*                      entry   = nullptr;
+    DLinkedListIterator<Entry*> it(m_entries);
+
+    if (true == it.first())
+    {
+        do
+        {
+            Entry* current = *it.current();
+
+            if ((false == current->isStale) &&
+                (current->fileName == fileName))
+            {
+                entry = current;
+            }
+        }
+        while((nullptr == entry) && (true == it.next()));
+    }
+
+    return entry;
+}
+
+ImageCache::Entry* ImageCache::add(FS& fs, const String& fileName, bool isNative, time_t lastWrite, size_t fileSize, BmpImgLoader::Ret& ret)
+{
+    Entry* entry = new(std::nothrow) Entry();
+
+    if (nullptr == entry)
+    {
+        ret = BmpImgLoader::RET_IMG_TOO_BIG;
+    }
+    else
+    {
+        ret = decode(fs, fileName, isNative, entry->bitmap);
+
+        /* Under memory pressure, all images, which are not referenced
+         * anymore, are evicted and it is tried once again.
+         */
+        if (BmpImgLoader::RET_IMG_TOO_BIG == ret)
+        {
+            evict(0U);
+            ret = decode(fs, fileName, isNative, entry->bitmap);
+        }
+
+        if (BmpImgLoader::RET_OK == ret)
+        {
+            entry->fileName     = fileName;
+            entry->lastWrite    = lastWrite;
+            entry->fileSize     = fileSize;
+            entry->refCnt       = 1U;
+            entry->isStale      = false;
+
+            ++m_useCnt;
+            entry->lastUse = m_useCnt;
+
+            if (false == m_entries.append(entry))
+            {
+                ret = BmpImgLoader::RET_IMG_TOO_BIG;
+            }
+            else
+            {
+                m_size += getEntrySize(entry);
+                evict(m_budget);
+            }
+        }
+
+        if (BmpImgLoader::RET_OK != ret)
+        {
+            delete entry;
+            entry = nullptr;
+        }
+    }
+
+    return entry;
+}
+
+BmpImgLoader::Ret ImageCache::decode(FS& fs, const String& fileName, bool isNative, YAGfxDynamicBitmap& bitmap)
+{
+    BmpImgLoader::Ret ret = BmpImgLoader::RET_OK;
+
+    if (true == isNative)
+    {
+        NativeImg nativeImg;
+
+        ret = nativeImg.load(fs, fileName, bitmap);
+    }
+    else
+    {
+        BmpImgLoader loader;
+
+        ret = loader.load(fs, fileName, bitmap);
+    }
+
+    return ret;
+}
+
+void ImageCache::evict(size_t size)
+{
+    bool isEvicted = true;
+
+    while((size < m_size) && (true == isEvicted))
+    {
+        Entry*                      lruEntry    = nullptr;
+        DLinkedListIterator<Entry*> it(m_entries);
+
+        /* Search the least recently used entry, which is not referenced. */
+        if (true == it.first())
+        {
+            do
+            {
+                Entry* entry = *it.current();
+
+                if ((0U == entry->refCnt) &&
+                    ((nullptr == lruEntry) ||
+                     (static_cast<int32_t>(entry->lastUse - lruEntry->lastUse) < 0)))
+                {
+                    lruEntry = entry;
+                }
+            }
+            while(true == it.next());
+        }
+
+        if (nullptr == lruEntry)
+        {
+            isEvicted = false;
+        }
+        else
+        {
+            destroy(lruEntry);
+        }
+    }
+}
+
+void ImageCache::destroy(Entry* entry)
+{
+    DLinkedListIterator<Entry*> it(m_entries);
+
+    if (true == it.find(entry))
+    {
+        it.remove();
+        m_size -= getEntrySize(entry);
+        delete entry;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,404 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cache of decoded images
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <FS.h>
+#include <YAGfxBitmap.h>
+#include <LinkedList.hpp>
+
+#include "BmpImgLoader.h"
+
+#ifndef NATIVE
+#include <Mutex.hpp>
+#endif  /* NATIVE */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The image cache keeps decoded images in memory, so the same image file is
+ * decoded only once and shared by every user. An image is identified by its
+ * file name, its last write time and its file size. If the file changes,
+ * the cached image is not used anymore.
+ *
+ * Images are shared via reference counted handles. Images, which are not
+ * referenced anymore, stay in the cache as long as the memory budget allows
+ * it. If the cache exceeds the budget, they are evicted in least recently
+ * used order. Referenced images are never evicted.
+ */
+class ImageCache
+{
+private:
+
+    /* Forward declaration */
+    struct Entry;
+
+public:
+
+    /**
+     * Reference counted handle of a cached image.
+     * The image is kept in memory at least as long as a handle refers to it.
+     */
+    class Handle
+    {
+    public:
+
+        /**
+         * Constructs a handle, which refers to no image.
+         */
+        Handle() :
+            m_entry(nullptr)
+        {
+        }
+
+        /**
+         * Constructs a handle by copying another one.
+         *
+         * @param[in] handle    Handle, which to copy
+         */
+        Handle(const Handle& handle) :
+            m_entry(handle.m_entry)
+        {
+            ImageCache::getInstance().acquire(m_entry);
+        }
+
+        /**
+         * Destroys the handle and releases the image reference.
+         */
+        ~Handle()
+        {
+            release();
+        }
+
+        /**
+         * Assigns a handle.
+         *
+         * @param[in] handle    Handle, which to assign
+         *
+         * @return Handle
+         */
+        Handle& operator=(const Handle& handle)
+        {
+            if (&handle != this)
+            {
+                ImageCache::getInstance().acquire(handle.m_entry);
+                release();
+                m_entry = handle.m_entry;
+            }
+
+            return *this;
+        }
+
+        /**
+         * Does the handle refer to an image?
+         *
+         * @return If it refers to an image, it will return true otherwise false.
+         */
+        bool isValid() const
+        {
+            return (nullptr != m_entry);
+        }
+
+        /**
+         * Get the image. The image is shared and shall not be modified.
+         *
+         * @return Image bitmap or nullptr, if the handle refers to no image.
+         */
+        const YAGfxDynamicBitmap* get() const;
+
+        /**
+         * Release the image reference.
+         */
+        void release()
+        {
+            ImageCache::getInstance().release(m_entry);
+            m_entry = nullptr;
+        }
+
+    private:
+
+        friend class ImageCache;
+
+        Entry*  m_entry;    /**< Cache entry or nullptr */
+    };
+
+    /**
+     * Get the image cache instance.
+     *
+     * @return Image cache
+     */
+    static ImageCache& getInstance()
+    {
+        static ImageCache instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Load bitmap image (.bmp) from file system or from the cache, if it is
+     * already decoded.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[out] ret      Result of the image loader
+     *
+     * @return Image handle, which is invalid in case of an error.
+     */
+    Handle load(FS& fs, const String& fileName, BmpImgLoader::Ret& ret);
+
+    /**
+     * Invalidate the cached image of a file, e.g. after it was overwritten.
+     * The last write time and the file size may not detect a change, because
+     * of the file system time resolution. Handles, which still refer to the
+     * image, stay valid. The next load decodes the file again.
+     *
+     * @param[in] fileName  Name of the image file
+     */
+    void invalidate(const String& fileName);
+
+    /**
+     * Get the memory budget in bytes.
+     *
+     * @return Memory budget in bytes
+     */
+    size_t getBudget() const
+    {
+        return m_budget;
+    }
+
+    /**
+     * Set the memory budget in bytes. Images, which are not referenced
+     * anymore, are evicted until the cache fits into the budget again.
+     *
+     * @param[in] budget    Memory budget in bytes
+     */
+    void setBudget(size_t budget);
+
+    /**
+     * Get the memory in bytes, used by all cached images.
+     *
+     * @return Used memory in bytes
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get the number of cached images.
+     *
+     * @return Number of cached images
+     */
+    uint32_t getEntryCnt() const
+    {
+        return m_entries.getNumOfElements();
+    }
+
+    /**
+     * Evict all images, which are not referenced anymore.
+     */
+    void clear();
+
+    /** Default memory budget in bytes. */
+    static const size_t DEFAULT_BUDGET  = 32U * 1024U;
+
+private:
+
+    /**
+     * A single cached image.
+     */
+    struct Entry
+    {
+        String              fileName;   /**< Name of the image file */
+        time_t              lastWrite;  /**< Last write time of the image file */
+        size_t              fileSize;   /**< Size of the image file in bytes */
+        YAGfxDynamicBitmap  bitmap;     /**< Decoded image */
+        uint32_t            refCnt;     /**< Number of handles, which refer to the image. */
+        uint32_t            lastUse;    /**< Use counter value of the last use, used for the least recently used order. */
+        bool                isStale;    /**< The file changed, therefore it is not used for new handles anymore. */
+    };
+
+#ifndef NATIVE
+    MutexRecursive      m_mutex;    /**< Mutex to protect the cache against concurrent access. */
+#endif  /* NATIVE */
+    DLinkedList<Entry*> m_entries;  /**< Cached images */
+    size_t              m_size;     /**< Memory in bytes, used by all cached images. */
+    size_t              m_budget;   /**< Memory budget in bytes */
+    uint32_t            m_useCnt;   /**< Use counter, which is incremented with every use of an image. */
+
+    /**
+     * Constructs the image cache.
+     */
+    ImageCache() :
+#ifndef NATIVE
+        m_mutex(),
+#endif  /* NATIVE */
+        m_entries(),
+        m_size(0U),
+        m_budget(DEFAULT_BUDGET),
+        m_useCnt(0U)
+    {
+#ifndef NATIVE
+        (void)m_mutex.create();
+#endif  /* NATIVE */
+    }
+
+    /**
+     * Destroys the image cache.
+     */
+    ~ImageCache();
+
+    /**
+     * Lock the cache against concurrent access.
+     */
+    void lock();
+
+    /**
+     * Unlock the cache.
+     */
+    void unlock();
+
+    /**
+     * Add a reference to the cache entry.
+     *
+     * @param[in] entry Cache entry, may be nullptr.
+     */
+    void acquire(Entry* entry);
+
+    /**
+     * Remove a reference from the cache entry. A stale entry is evicted
+     * with its last reference.
+     *
+     * @param[in] entry Cache entry, may be nullptr.
+     */
+    void release(Entry* entry);
+
+    /**
+     * Mark the cache entry as stale, so it is not used for new handles
+     * anymore. It is evicted immediately, if it is not referenced.
+     *
+     * @param[in] entry Cache entry
+     */
+    void markStale(Entry* entry);
+
+    /**
+     * Find the cache entry of an image file, which is not stale.
+     *
+     * @param[in] fileName  Name of the image file
+     *
+     * @return Cache entry or nullptr, if not found.
+     */
+    Entry* find(const String& fileName);
+
+    /**
+     * Decode the image file and add it to the cache.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the image file
+     * @param[in] isNative  Is it a native image file?
+     * @param[in] lastWrite Last write time of the image file
+     * @param[in] fileSize  Size of the image file in bytes
+     * @param[out] ret      Result of the image loader
+     *
+     * @return Cache entry with one reference or nullptr in case of an error.
+     */
+    Entry* add(FS& fs, const String& fileName, bool isNative, time_t lastWrite, size_t fileSize, BmpImgLoader::Ret& ret);
+
+    /**
+     * Decode the image file, either a native image or a bitmap image.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the image file
+     * @param[in] isNative  Is it a native image file?
+     * @param[out] bitmap   Bitmap buffer
+     *
+     * @return Result of the image loader
+     */
+    BmpImgLoader::Ret decode(FS& fs, const String& fileName, bool isNative, YAGfxDynamicBitmap& bitmap);
+
+    /**
+     * Evict least recently used entries, which are not referenced anymore,
+     * until the cache fits into the given size.
+     *
+     * @param[in] size  Max. size in bytes
+     */
+    void evict(size_t size);
+
+    /**
+     * Remove the entry from the cache and destroy it.
+     *
+     * @param[in] entry Cache entry
+     */
+    void destroy(Entry* entry);
+
+    /**
+     * Get the memory in bytes, used by the image of a cache entry.
+     *
+     * @param[in] entry Cache entry
+     *
+     * @return Memory in bytes
+     */
+    static size_t getEntrySize(const Entry* entry)
+    {
+        return static_cast<size_t>(entry->bitmap.getWidth()) * entry->bitmap.getHeight() * sizeof(Color);
+    }
+
+    ImageCache(const ImageCache& cache);
+    ImageCache& operator=(const ImageCache& cache);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* IMAGE_CACHE_H */
+
+/** @} */
@@ -139,7 +139,11 @@ public:
      */
     void setOnState(bool state)
     {
-        m_isOn = state;
+        if (m_isOn != state)
+        {
+            m_isOn = state;
+            invalidate();
+        }
     }
 
     /**
@@ -160,6 +164,7 @@ public:
     void setColorOff(const Color& color)
     {
         m_colorOff = color;
+        invalidate();
     }
 
     /**
@@ -180,6 +185,7 @@ public:
     void setColorOn(const Color& color)
     {
         m_colorOn = color;
+        invalidate();
     }
 
     /**
@@ -200,6 +206,7 @@ public:
     void setWidth(uint16_t width)
     {
         m_width = width;
+        invalidate();
     }
 
     /**
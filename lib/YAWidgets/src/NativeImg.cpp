@@ -0,0 +1,572 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native image file
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NativeImg.h"
+
+#include <new>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Native image file header. All values are stored in the byte order of the
+ * target.
+ */
+typedef struct _NativeImgHeader
+{
+    uint16_t    signature;      /**< Native image signature for file format identification. */
+    uint8_t     version;        /**< File format version */
+    uint8_t     pixelSize;      /**< Size of a single pixel in bytes, which depends on the target pixel format. */
+    uint8_t     compression;    /**< Compression method of the pixel data. */
+    uint8_t     flags;          /**< Flags, see FLAG_* */
+    uint16_t    width;          /**< Image width in pixels */
+    uint16_t    height;         /**< Image height in pixels */
+    uint16_t    frameWidth;     /**< Frame width in pixels */
+    uint16_t    frameHeight;    /**< Frame height in pixels */
+    uint8_t     frameCnt;       /**< Number of frames */
+    uint8_t     fps;            /**< Frames per second */
+    uint32_t    dataSize;       /**< Size of the pixel data in bytes. */
+
+} __attribute__ ((packed)) NativeImgHeader;
+
+typedef enum
+{
+    COMPRESSION_NONE    = 0,    /**< Raw pixels */
+    COMPRESSION_RLE     = 1     /**< Packets of a repeat count (1 byte) and a single pixel. */
+
+} Compression;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Supported file format version */
+static const uint8_t    VERSION             = 1U;
+
+/** Flag: Repeat the animation infinite. */
+static const uint8_t    FLAG_REPEAT         = 0x01U;
+
+/** Max. number of pixels in a RLE packet. */
+static const uint8_t    RLE_MAX_CNT         = UINT8_MAX;
+
+/** Size of a RLE packet in bytes. */
+static const size_t     RLE_PACKET_SIZE     = 1U + sizeof(Color);
+
+/** Number of RLE packets, which are read at once. */
+static const size_t     RLE_PACKETS_PER_READ = 16U;
+
+/** Extension of the temporary file, used during transcoding. */
+static const char*      TMP_FILE_EXT        = ".tmp";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+NativeImg::Ret NativeImg::load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, Meta* meta)
+{
+    BitmapRowSink   sink(bitmap);
+    Ret             ret = load(fs, fileName, sink, meta);
+
+    if (BmpImgLoader::RET_OK != ret)
+    {
+        bitmap.release();
+    }
+
+    return ret;
+}
+
+NativeImg::Ret NativeImg::load(FS& fs, const String& fileName, IImgRowSink& sink, Meta* meta)
+{
+    Ret     ret = BmpImgLoader::RET_OK;
+    File    fd  = fs.open(fileName);
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        NativeImgHeader header;
+
+        if (sizeof(header) != fd.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        /* Is it not a native image file or was it created for a different target? */
+        else if ((SIGNATURE != header.signature) ||
+                 (VERSION != header.version) ||
+                 (sizeof(Color) != header.pixelSize) ||
+                 ((COMPRESSION_NONE != header.compression) && (COMPRESSION_RLE != header.compression)))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED;
+        }
+        else if ((0U == header.width) ||
+                 (0U == header.height))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else
+        {
+            uint32_t pixelCnt = static_cast<uint32_t>(header.width) * header.height;
+
+            if (false == sink.begin(header.width, header.height))
+            {
+                ret = BmpImgLoader::RET_IMG_TOO_BIG;
+            }
+            else if (COMPRESSION_NONE == header.compression)
+            {
+                if (((pixelCnt * sizeof(Color)) != header.dataSize) ||
+                    (false == readRawPixels(fd, header.width, header.height, sink)))
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+            }
+            else if ((0U != (header.dataSize % RLE_PACKET_SIZE)) ||
+                     (false == readRlePixels(fd, header.width, header.height, sink)))
+            {
+                ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                ;
+            }
+
+            if ((BmpImgLoader::RET_OK == ret) &&
+                (nullptr != meta))
+            {
+                meta->frameWidth    = header.frameWidth;
+                meta->frameHeight   = header.frameHeight;
+                meta->frameCnt      = header.frameCnt;
+                meta->fps           = header.fps;
+                meta->isRepeat      = (0U != (header.flags & FLAG_REPEAT));
+            }
+        }
+
+        fd.close();
+    }
+
+    return ret;
+}
+
+NativeImg::Ret NativeImg::save(FS& fs, const String& fileName, const YAGfxBitmap& bitmap, const Meta* meta)
+{
+    Ret         ret         = BmpImgLoader::RET_OK;
+    uint16_t    width       = bitmap.getWidth();
+    uint16_t    height      = bitmap.getHeight();
+    uint32_t    pixelCnt    = static_cast<uint32_t>(width) * height;
+    uint32_t    packetCnt   = getRlePacketCnt(bitmap);
+    uint8_t*    rowBuffer   = nullptr;
+
+    if (0U == pixelCnt)
+    {
+        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+    }
+    else
+    {
+        NativeImgHeader header;
+
+        header.signature    = SIGNATURE;
+        header.version      = VERSION;
+        header.pixelSize    = sizeof(Color);
+        header.width        = width;
+        header.height       = height;
+
+        if (nullptr == meta)
+        {
+            header.flags        = FLAG_REPEAT;
+            header.frameWidth   = width;
+            header.frameHeight  = height;
+            header.frameCnt     = 1U;
+            header.fps          = 0U;
+        }
+        else
+        {
+            header.flags        = (true == meta->isRepeat) ? FLAG_REPEAT : 0U;
+            header.frameWidth   = meta->frameWidth;
+            header.frameHeight  = meta->frameHeight;
+            header.frameCnt     = meta->frameCnt;
+            header.fps          = meta->fps;
+        }
+
+        /* Run-length encoding is only used, if it saves space. */
+        if ((packetCnt * RLE_PACKET_SIZE) < (pixelCnt * sizeof(Color)))
+        {
+            header.compression  = COMPRESSION_RLE;
+            header.dataSize     = packetCnt * RLE_PACKET_SIZE;
+        }
+        else
+        {
+            header.compression  = COMPRESSION_NONE;
+            header.dataSize     = pixelCnt * sizeof(Color);
+
+            rowBuffer = new(std::nothrow) uint8_t[width * sizeof(Color)];
+        }
+
+        if ((COMPRESSION_NONE == header.compression) &&
+            (nullptr == rowBuffer))
+        {
+            ret = BmpImgLoader::RET_IMG_TOO_BIG;
+        }
+        else
+        {
+            File fd = fs.open(fileName, FILE_WRITE);
+
+            if (false == fd)
+            {
+                ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+            }
+            else if (sizeof(header) != fd.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)))
+            {
+                ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+            }
+            else if (COMPRESSION_RLE == header.compression)
+            {
+                if (false == writeRlePixels(fd, bitmap))
+                {
+                    ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                }
+            }
+            else
+            {
+                int16_t y = 0;
+
+                /* The bitmap may be a view on another one, therefore the
+                 * pixels are copied row by row.
+                 */
+                while((height > y) && (BmpImgLoader::RET_OK == ret))
+                {
+                    int16_t x = 0;
+
+                    for(x = 0; x < width; ++x)
+                    {
+                        (void)memcpy(&rowBuffer[x * sizeof(Color)], &bitmap.getColor(x, y), sizeof(Color));
+                    }
+
+                    if ((width * sizeof(Color)) != fd.write(rowBuffer, width * sizeof(Color)))
+                    {
+                        ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+                    }
+
+                    ++y;
+                }
+            }
+
+            if (true == fd)
+            {
+                fd.close();
+            }
+        }
+
+        if (nullptr != rowBuffer)
+        {
+            delete[] rowBuffer;
+        }
+    }
+
+    return ret;
+}
+
+NativeImg::Ret NativeImg::transcode(FS& fs, const String& fileName)
+{
+    Ret         ret         = BmpImgLoader::RET_OK;
+    File        fd          = fs.open(fileName);
+    uint16_t    signature   = 0U;
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        if (false == readSignature(fd, signature))
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+
+        fd.close();
+    }
+
+    /* Only bitmap images are transcoded. Already transcoded images and
+     * other image formats, e.g. GIF animations, are kept as they are.
+     */
+    if ((BmpImgLoader::RET_OK == ret) &&
+        (BmpImgLoader::SIGNATURE == signature))
+    {
+        BmpImgLoader        loader;
+        YAGfxDynamicBitmap  bitmap;
+        String              tmpFileName = fileName + TMP_FILE_EXT;
+
+        ret = loader.load(fs, fileName, bitmap);
+
+        if (BmpImgLoader::RET_OK == ret)
+        {
+            /* The image is written to a temporary file first, which replaces
+             * the original file by renaming it. The rename is atomic, therefore
+             * either the bitmap image or the native image exists, even after
+             * a power loss.
+             */
+            ret = save(fs, tmpFileName, bitmap);
+
+            if ((BmpImgLoader::RET_OK == ret) &&
+                (false == fs.rename(tmpFileName, fileName)))
+            {
+                ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+            }
+
+            if (BmpImgLoader::RET_OK != ret)
+            {
+                (void)fs.remove(tmpFileName);
+            }
+        }
+    }
+
+    return ret;
+}
+
+bool NativeImg::readSignature(File& fd, uint16_t& signature)
+{
+    bool isSuccessful = true;
+
+    if (sizeof(signature) != fd.read(reinterpret_cast<uint8_t*>(&signature), sizeof(signature)))
+    {
+        isSuccessful = false;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint32_t NativeImg::getRlePacketCnt(const YAGfxBitmap& bitmap) const
+{
+    uint32_t        packetCnt   = 0U;
+    uint32_t        runLength   = 0U;
+    const Color*    prevColor   = nullptr;
+    int16_t         x           = 0;
+    int16_t         y           = 0;
+
+    for(y = 0; y < bitmap.getHeight(); ++y)
+    {
+        for(x = 0; x < bitmap.getWidth(); ++x)
+        {
+            const Color* color = &bitmap.getColor(x, y);
+
+            if ((nullptr == prevColor) ||
+                (RLE_MAX_CNT <= runLength) ||
+                (0 != memcmp(prevColor, color, sizeof(Color))))
+            {
+                ++packetCnt;
+                runLength = 0U;
+            }
+
+            ++runLength;
+            prevColor = color;
+        }
+    }
+
+    return packetCnt;
+}
+
+bool NativeImg::writeRlePixels(File& fd, const YAGfxBitmap& bitmap)
+{
+    bool            isSuccessful    = true;
+    uint8_t         packet[RLE_PACKET_SIZE];
+    const Color*    prevColor       = nullptr;
+    int16_t         x               = 0;
+    int16_t         y               = 0;
+
+    packet[0] = 0U;
+
+    for(y = 0; (y < bitmap.getHeight()) && (true == isSuccessful); ++y)
+    {
+        for(x = 0; (x < bitmap.getWidth()) && (true == isSuccessful); ++x)
+        {
+            const Color* color = &bitmap.getColor(x, y);
+
+            /* Flush the current packet, if the run ends. */
+            if ((nullptr != prevColor) &&
+                ((RLE_MAX_CNT <= packet[0]) ||
+                 (0 != memcmp(prevColor, color, sizeof(Color)))))
+            {
+                if (sizeof(packet) != fd.write(packet, sizeof(packet)))
+                {
+                    isSuccessful = false;
+                }
+
+                packet[0] = 0U;
+            }
+
+            if (0U == packet[0])
+            {
+                (void)memcpy(&packet[1], color, sizeof(Color));
+            }
+
+            ++packet[0];
+            prevColor = color;
+        }
+    }
+
+    /* Flush the last packet. */
+    if ((true == isSuccessful) &&
+        (0U < packet[0]) &&
+        (sizeof(packet) != fd.write(packet, sizeof(packet))))
+    {
+        isSuccessful = false;
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::readRawPixels(File& fd, uint16_t width, uint16_t height, IImgRowSink& sink)
+{
+    bool        isSuccessful    = true;
+    size_t      rowSize         = width * sizeof(Color);
+    uint16_t    y               = 0U;
+
+    /* The pixels are stored in the pixel format of the target, therefore
+     * every row is read directly into the row buffer.
+     */
+    while((height > y) && (true == isSuccessful))
+    {
+        uint8_t* pixels = reinterpret_cast<uint8_t*>(sink.getRow(y));
+
+        if (rowSize != fd.read(pixels, rowSize))
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            sink.endRow(y);
+        }
+
+        ++y;
+    }
+
+    return isSuccessful;
+}
+
+bool NativeImg::readRlePixels(File& fd, uint16_t width, uint16_t height, IImgRowSink& sink)
+{
+    bool        isSuccessful    = true;
+    uint8_t     packets[RLE_PACKETS_PER_READ * RLE_PACKET_SIZE];
+    uint16_t    x               = 0U;
+    uint16_t    y               = 0U;
+    Color*      pixels          = sink.getRow(y);
+
+    /* Several packets are read at once, until all rows are complete.
+     * A packet may continue in the next row.
+     */
+    while((height > y) && (true == isSuccessful))
+    {
+        size_t  size    = fd.read(packets, sizeof(packets));
+        size_t  pos     = 0U;
+
+        if ((0U == size) ||
+            (0U != (size % RLE_PACKET_SIZE)))
+        {
+            isSuccessful = false;
+        }
+
+        while((size > pos) && (true == isSuccessful))
+        {
+            uint8_t cnt     = packets[pos];
+            Color   color;
+
+            (void)memcpy(reinterpret_cast<uint8_t*>(&color), &packets[pos + 1U], sizeof(Color));
+
+            if (0U == cnt)
+            {
+                isSuccessful = false;
+            }
+
+            while((0U < cnt) && (true == isSuccessful))
+            {
+                if (height <= y)
+                {
+                    isSuccessful = false;
+                }
+                else
+                {
+                    pixels[x] = color;
+                    ++x;
+                    --cnt;
+
+                    if (width <= x)
+                    {
+                        sink.endRow(y);
+                        x = 0U;
+                        ++y;
+
+                        if (height > y)
+                        {
+                            pixels = sink.getRow(y);
+                        }
+                    }
+                }
+            }
+
+            pos += RLE_PACKET_SIZE;
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
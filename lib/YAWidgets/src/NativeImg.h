@@ -0,0 +1,220 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native image file
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef NATIVE_IMG_H
+#define NATIVE_IMG_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+#include "BmpImgLoader.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The native image file stores the pixels in the pixel format of the target,
+ * so loading needs no decoding. It consists of a small header with the
+ * image size and frame metadata, followed by the pixels row by row from top
+ * to bottom. The pixels are either raw or run-length encoded, whatever is
+ * smaller.
+ *
+ * A bitmap image (.bmp) can be transcoded to a native image once, e.g. after
+ * it was uploaded.
+ */
+class NativeImg
+{
+public:
+
+    /**
+     * The result codes are the same as for the bitmap image loader.
+     */
+    typedef BmpImgLoader::Ret Ret;
+
+    /**
+     * Frame metadata for animations.
+     */
+    typedef struct
+    {
+        uint16_t    frameWidth;     /**< Frame width in pixels */
+        uint16_t    frameHeight;    /**< Frame height in pixels */
+        uint8_t     frameCnt;       /**< Number of frames */
+        uint8_t     fps;            /**< Frames per second */
+        bool        isRepeat;       /**< Repeat the animation infinite or run it once. */
+
+    } Meta;
+
+    /** Native image file signature "PX" */
+    static const uint16_t SIGNATURE = 0x5850U;
+
+    /**
+     * Construct a native image object.
+     */
+    NativeImg()
+    {
+    }
+
+    /**
+     * Destroy the native image object.
+     */
+    ~NativeImg()
+    {
+    }
+
+    /**
+     * Load native image from file system to bitmap buffer.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[out] bitmap   Bitmap buffer
+     * @param[out] meta     Frame metadata, optional
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, Meta* meta = nullptr);
+
+    /**
+     * Load native image from file system row by row to the row sink.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[in] sink      Row sink, which receives the image rows.
+     * @param[out] meta     Frame metadata, optional
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret load(FS& fs, const String& fileName, IImgRowSink& sink, Meta* meta = nullptr);
+
+    /**
+     * Save bitmap as native image to file system.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[in] bitmap    Bitmap
+     * @param[in] meta      Frame metadata, optional. If not available, the whole bitmap is a single frame.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret save(FS& fs, const String& fileName, const YAGfxBitmap& bitmap, const Meta* meta = nullptr);
+
+    /**
+     * Transcode a bitmap image file (.bmp) in place to a native image.
+     * The file keeps its name and is replaced atomically by renaming a
+     * temporary file. If it is not a bitmap image, e.g. it is already a
+     * native image, nothing happens.
+     *
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret transcode(FS& fs, const String& fileName);
+
+    /**
+     * Read the file signature.
+     *
+     * @param[in] fd        File descriptor, which points to the file begin.
+     * @param[out] signature File signature
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool readSignature(File& fd, uint16_t& signature);
+
+private:
+
+    /**
+     * Get the number of run-length encoded packets of the bitmap.
+     *
+     * @param[in] bitmap    Bitmap
+     *
+     * @return Number of packets
+     */
+    uint32_t getRlePacketCnt(const YAGfxBitmap& bitmap) const;
+
+    /**
+     * Write the run-length encoded pixels of the bitmap.
+     *
+     * @param[in] fd        File descriptor
+     * @param[in] bitmap    Bitmap
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeRlePixels(File& fd, const YAGfxBitmap& bitmap);
+
+    /**
+     * Read the raw pixels row by row into the row sink.
+     *
+     * @param[in] fd        File descriptor
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     * @param[in] sink      Row sink
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readRawPixels(File& fd, uint16_t width, uint16_t height, IImgRowSink& sink);
+
+    /**
+     * Read the run-length encoded pixels row by row into the row sink.
+     *
+     * @param[in] fd        File descriptor
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     * @param[in] sink      Row sink
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readRlePixels(File& fd, uint16_t width, uint16_t height, IImgRowSink& sink);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* NATIVE_IMG_H */
+
+/** @} */
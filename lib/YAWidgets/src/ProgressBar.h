@@ -131,11 +131,13 @@ public:
     {
         if (100 < progress)
         {
-            m_progress = 100;
+            progress = 100;
         }
-        else
+
+        if (m_progress != progress)
         {
             m_progress = progress;
+            invalidate();
         }
     }
 
@@ -147,6 +149,7 @@ public:
     void setColor(const Color& color)
     {
         m_color = color;
+        invalidate();
         return;
     }
 
@@ -160,6 +163,7 @@ public:
         if (ALGORITHM_MAX > algorithm)
         {
             m_algorithm = algorithm;
+            invalidate();
         }
     }
 
@@ -35,7 +35,6 @@
 #include "SpriteSheet.h"
 
 #include <ArduinoJson.h>
-#include <BmpImgLoader.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -66,7 +65,6 @@ SpriteSheet& SpriteSheet::operator=(const SpriteSheet& spriteSheet)
     if (this != (&spriteSheet))
     {
         m_texture       = spriteSheet.m_texture;
-        m_textureMap    = spriteSheet.m_textureMap;
         m_frame         = spriteSheet.m_frame;
         m_frameCnt      = spriteSheet.m_frameCnt;
         m_fps           = spriteSheet.m_fps;
@@ -91,16 +89,18 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
     if ((0U < frameWidth) &&
         (0U < frameHeight))
     {
-        BmpImgLoader loader;
-
-        if (BmpImgLoader::RET_OK == loader.load(fs, fileName, m_texture))
+        /* The texture image is compressed while it is loaded, so it is
+         * never completely decoded in memory. The frame size must be lower
+         * or equal to the texture size, which is checked during loading.
+         */
+        if (BmpImgLoader::RET_OK == m_texture.load(fs, fileName, frameWidth, frameHeight))
         {
-            /* The frame size must be lower or equal to the texture size. */
-            if ((m_texture.getWidth() >= frameWidth) &&
-                (m_texture.getHeight() >= frameHeight))
+            m_frame.release();
+
+            if (true == m_frame.create(frameWidth, frameHeight))
             {
-                m_framesX   = m_texture.getWidth() / frameWidth;
-                m_framesY   = m_texture.getHeight() / frameHeight;
+                m_framesX   = m_texture.getFramesX();
+                m_framesY   = m_texture.getFramesY();
 
                 /* A 0 number of frames requests the automatic frame count calculation.
                  * This assumes that there will be no frame gaps in the texture image.
@@ -114,20 +114,16 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
                     m_frameCnt = frameCnt;
                 }
 
-                m_textureMap.setOffsetX(0);
-                m_textureMap.setOffsetY(0);
-                m_textureMap.setWidth(frameWidth);
-                m_textureMap.setHeight(frameHeight);
-
                 m_fps = fps;
                 reset();
 
                 isSuccessful = true;
             }
-            else
-            {
-                m_texture.release();
-            }
+        }
+
+        if (false == isSuccessful)
+        {
+            release();
         }
     }
 
@@ -197,6 +193,9 @@ bool SpriteSheet::load(FS& fs, const String& spriteSheetFileName, const String&
 
 void SpriteSheet::next()
 {
+    uint8_t prevFrameX = m_currentFrameX;
+    uint8_t prevFrameY = m_currentFrameY;
+
     if (false == m_isForward)
     {
         moveBackward();
@@ -206,9 +205,12 @@ void SpriteSheet::next()
         moveForward();
     }
 
-    /* Calculate and set the frame offset in the texture image. */
-    m_textureMap.setOffsetX(m_currentFrameX * m_frame.getWidth());
-    m_textureMap.setOffsetY(m_currentFrameY * m_frame.getHeight());
+    /* Only a changed frame needs to be decoded. */
+    if ((prevFrameX != m_currentFrameX) ||
+        (prevFrameY != m_currentFrameY))
+    {
+        decodeFrame();
+    }
 }
 
 void SpriteSheet::reset()
@@ -222,9 +224,7 @@ void SpriteSheet::reset()
         moveToEnd();
     }
 
-    /* Calculate and set the frame offset in the texture image. */
-    m_textureMap.setOffsetX(m_currentFrameX * m_frame.getWidth());
-    m_textureMap.setOffsetY(m_currentFrameY * m_frame.getHeight());
+    decodeFrame();
 }
 
 /******************************************************************************
@@ -374,6 +374,13 @@ void SpriteSheet::moveBackward()
     }
 }
 
+void SpriteSheet::decodeFrame()
+{
+    uint16_t frameIdx = static_cast<uint16_t>(m_currentFrameY) * m_framesX + m_currentFrameX;
+
+    (void)m_texture.decode(frameIdx, m_frame);
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -44,10 +44,11 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
-#include <YAGfxMap.h>
 #include <YAGfxBitmap.h>
 #include <FS.h>
 
+#include "SpriteTexture.h"
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -65,6 +66,9 @@
  * 
  * The order of the sprites shall follow in x-direction from 0 to N and
  * continue in the next y row and so on.
+ *
+ * The texture is kept compressed in memory and only the current frame is
+ * decoded to a frame buffer, whenever the animation moves to another frame.
  */
 class SpriteSheet
 {
@@ -75,8 +79,7 @@ public:
      */
     SpriteSheet() :
         m_texture(),
-        m_textureMap(m_texture),
-        m_frame(m_textureMap),
+        m_frame(),
         m_frameCnt(0U),
         m_fps(DEFAULT_FPS),
         m_repeat(true),
@@ -95,7 +98,6 @@ public:
      */
     SpriteSheet(const SpriteSheet& spriteSheet) :
         m_texture(spriteSheet.m_texture),
-        m_textureMap(spriteSheet.m_textureMap),
         m_frame(spriteSheet.m_frame),
         m_frameCnt(spriteSheet.m_frameCnt),
         m_fps(spriteSheet.m_fps),
@@ -263,11 +265,12 @@ public:
     void reset();
 
     /**
-     * Release the internal pixel buffer with texture.
+     * Release the compressed texture and the frame buffer.
      */
     void release()
     {
         m_texture.release();
+        m_frame.release();
     }
 
     /**
@@ -277,7 +280,7 @@ public:
      */
     bool isEmpty() const
     {
-        return !m_texture.isAllocated();
+        return !m_texture.isValid();
     }
 
 private:
@@ -287,9 +290,8 @@ private:
      */
     static const uint8_t    DEFAULT_FPS = 12U;
 
-    YAGfxDynamicBitmap  m_texture;          /**< Texture image. */
-    YAGfxMap            m_textureMap;       /**< Map canvas over the texture image. */
-    YAGfxOverlayBitmap  m_frame;            /**< The current frame. */
+    SpriteTexture       m_texture;          /**< Compressed texture image. */
+    YAGfxDynamicBitmap  m_frame;            /**< Frame buffer with the decoded current frame. */
     uint8_t             m_frameCnt;         /**< Number of frames in the texture. */
     uint8_t             m_fps;              /**< Number of frames per second. */
     bool                m_repeat;           /**< Repeat animation continuously or it runs just once. */
@@ -332,6 +334,11 @@ private:
      * Move current frame one frame backward, but only if the animation repeats infinite.
      */
     void moveBackward();
+
+    /**
+     * Decode the current frame from the texture to the frame buffer.
+     */
+    void decodeFrame();
 };
 
 /******************************************************************************
@@ -0,0 +1,796 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compressed sprite sheet texture
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SpriteTexture.h"
+#include "IImgRowSink.hpp"
+#include "NativeImg.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * The encoder receives the texture image row by row and compresses the frames
+ * of a row of frames, as soon as it is complete. It works in two passes over
+ * the texture image: The first pass determines the colors and the number of
+ * packets of every frame. The second pass compresses the frames.
+ */
+class SpriteTexture::Encoder : public IImgRowSink
+{
+public:
+
+    /**
+     * Constructs the encoder.
+     *
+     * @param[in] texture       Sprite texture, which receives the compressed frames.
+     * @param[in] frameWidth    Frame width in pixels
+     * @param[in] frameHeight   Frame height in pixels
+     */
+    Encoder(SpriteTexture& texture, uint16_t frameWidth, uint16_t frameHeight) :
+        IImgRowSink(),
+        m_texture(texture),
+        m_frameWidth(frameWidth),
+        m_frameHeight(frameHeight),
+        m_width(0U),
+        m_height(0U),
+        m_isEncoding(false),
+        m_band(nullptr),
+        m_rowCnt(0U),
+        m_bandCnt(0U),
+        m_palette(nullptr),
+        m_paletteSize(0U),
+        m_isPaletteFull(false)
+    {
+    }
+
+    /**
+     * Destroys the encoder.
+     */
+    ~Encoder()
+    {
+        if (nullptr != m_band)
+        {
+            delete[] m_band;
+        }
+
+        releasePalette();
+    }
+
+    /**
+     * Begin a pass over the texture image.
+     *
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     *
+     * @return If the texture image can be compressed, it will return true otherwise false.
+     */
+    bool begin(uint16_t width, uint16_t height) final;
+
+    /**
+     * Get the buffer for a single row.
+     *
+     * @param[in] y Y-coordinate of the row
+     *
+     * @return Row buffer
+     */
+    Color* getRow(uint16_t y) final;
+
+    /**
+     * The row is complete. If the row of frames is complete, its frames
+     * are processed.
+     *
+     * @param[in] y Y-coordinate of the row
+     */
+    void endRow(uint16_t y) final;
+
+    /**
+     * Finish the first pass by selecting the encoding and allocating the
+     * memory for the compressed frames.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool prepare();
+
+    /**
+     * Are all rows of frames processed in the current pass?
+     *
+     * @return If all are processed, it will return true otherwise false.
+     */
+    bool isComplete() const
+    {
+        return (m_texture.m_framesY == m_bandCnt);
+    }
+
+private:
+
+    SpriteTexture&  m_texture;          /**< Sprite texture, which receives the compressed frames. */
+    uint16_t        m_frameWidth;       /**< Frame width in pixels */
+    uint16_t        m_frameHeight;      /**< Frame height in pixels */
+    uint16_t        m_width;            /**< Texture image width in pixels */
+    uint16_t        m_height;           /**< Texture image height in pixels */
+    bool            m_isEncoding;       /**< Is it the second pass, which compresses the frames? */
+    Color*          m_band;             /**< A single row of frames and one additional row for the rows, which belong to no frame. */
+    uint16_t        m_rowCnt;           /**< Number of complete rows in the current row of frames. */
+    uint16_t        m_bandCnt;          /**< Number of processed rows of frames. */
+    Color*          m_palette;          /**< Colors of the texture image, which are found so far. */
+    uint16_t        m_paletteSize;      /**< Number of colors, which are found so far. */
+    bool            m_isPaletteFull;    /**< The texture image has more colors than the palette can hold. */
+
+    /**
+     * Process the frames of a complete row of frames.
+     *
+     * @param[in] bandIdx   Index of the row of frames
+     */
+    void processBand(uint16_t bandIdx);
+
+    /**
+     * Add the colors of a frame to the palette.
+     *
+     * @param[in] pixels    Frame pixels in the row of frames
+     */
+    void addColors(const Color* pixels);
+
+    /**
+     * Release the palette, which is only used to collect the colors.
+     */
+    void releasePalette()
+    {
+        if (nullptr != m_palette)
+        {
+            delete[] m_palette;
+            m_palette = nullptr;
+        }
+    }
+
+    Encoder();
+    Encoder(const Encoder& encoder);
+    Encoder& operator=(const Encoder& encoder);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static BmpImgLoader::Ret loadRows(FS& fs, const String& fileName, IImgRowSink& sink);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+BmpImgLoader::Ret SpriteTexture::load(FS& fs, const String& fileName, uint16_t frameWidth, uint16_t frameHeight)
+{
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+    Encoder             encoder(*this, frameWidth, frameHeight);
+
+    release();
+
+    /* First pass determines the colors and the size of the frames. */
+    ret = loadRows(fs, fileName, encoder);
+
+    if (BmpImgLoader::RET_OK == ret)
+    {
+        if (false == encoder.isComplete())
+        {
+            ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+        }
+        else if (false == encoder.prepare())
+        {
+            ret = BmpImgLoader::RET_IMG_TOO_BIG;
+        }
+        else
+        {
+            /* Second pass compresses the frames. */
+            ret = loadRows(fs, fileName, encoder);
+
+            if ((BmpImgLoader::RET_OK == ret) &&
+                (false == encoder.isComplete()))
+            {
+                ret = BmpImgLoader::RET_FILE_FORMAT_INVALID;
+            }
+        }
+    }
+
+    if (BmpImgLoader::RET_OK != ret)
+    {
+        release();
+    }
+
+    return ret;
+}
+
+void SpriteTexture::release()
+{
+    if (nullptr != m_palette)
+    {
+        delete[] m_palette;
+        m_palette = nullptr;
+    }
+
+    if (nullptr != m_data)
+    {
+        delete[] m_data;
+        m_data = nullptr;
+    }
+
+    if (nullptr != m_frameOffsets)
+    {
+        delete[] m_frameOffsets;
+        m_frameOffsets = nullptr;
+    }
+
+    m_encoding      = ENCODING_RAW;
+    m_paletteSize   = 0U;
+    m_dataSize      = 0U;
+    m_frameCnt      = 0U;
+    m_framesX       = 0U;
+    m_framesY       = 0U;
+    m_frameWidth    = 0U;
+    m_frameHeight   = 0U;
+}
+
+bool SpriteTexture::decode(uint16_t frameIdx, YAGfxDynamicBitmap& frame) const
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != m_data) &&
+        (m_frameCnt > frameIdx) &&
+        (m_frameWidth == frame.getWidth()) &&
+        (m_frameHeight == frame.getHeight()))
+    {
+        const uint8_t*  packet      = &m_data[m_frameOffsets[frameIdx]];
+        const size_t    packetSize  = getPacketSize();
+        Color*          pixels      = &frame.getColor(0, 0);
+        uint32_t        pixelCnt    = static_cast<uint32_t>(m_frameWidth) * m_frameHeight;
+        uint32_t        pixelIdx    = 0U;
+
+        /* The frame was encoded by ourself, therefore the packets are
+         * considered valid.
+         */
+        while(pixelCnt > pixelIdx)
+        {
+            uint8_t cnt = 1U;
+            Color   color;
+
+            switch(m_encoding)
+            {
+            case ENCODING_RAW:
+                (void)memcpy(reinterpret_cast<uint8_t*>(&color), packet, sizeof(Color));
+                break;
+
+            case ENCODING_RLE:
+                cnt = packet[0];
+                (void)memcpy(reinterpret_cast<uint8_t*>(&color), &packet[1], sizeof(Color));
+                break;
+
+            case ENCODING_PALETTE:
+                cnt     = packet[0];
+                color   = m_palette[packet[1]];
+                break;
+
+            default:
+                break;
+            }
+
+            while(0U < cnt)
+            {
+                pixels[pixelIdx] = color;
+                ++pixelIdx;
+                --cnt;
+            }
+
+            packet += packetSize;
+        }
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SpriteTexture::copy(const SpriteTexture& texture)
+{
+    release();
+
+    if (true == texture.isValid())
+    {
+        bool isSuccessful = true;
+
+        if (0U < texture.m_paletteSize)
+        {
+            m_palette = new(std::nothrow) Color[texture.m_paletteSize];
+
+            if (nullptr == m_palette)
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                uint16_t idx = 0U;
+
+                for(idx = 0U; idx < texture.m_paletteSize; ++idx)
+                {
+                    m_palette[idx] = texture.m_palette[idx];
+                }
+            }
+        }
+
+        m_data          = new(std::nothrow) uint8_t[texture.m_dataSize];
+        m_frameOffsets  = new(std::nothrow) uint32_t[texture.m_frameCnt];
+
+        if ((false == isSuccessful) ||
+            (nullptr == m_data) ||
+            (nullptr == m_frameOffsets))
+        {
+            release();
+        }
+        else
+        {
+            (void)memcpy(m_data, texture.m_data, texture.m_dataSize);
+            (void)memcpy(m_frameOffsets, texture.m_frameOffsets, texture.m_frameCnt * sizeof(uint32_t));
+
+            m_encoding      = texture.m_encoding;
+            m_paletteSize   = texture.m_paletteSize;
+            m_dataSize      = texture.m_dataSize;
+            m_frameCnt      = texture.m_frameCnt;
+            m_framesX       = texture.m_framesX;
+            m_framesY       = texture.m_framesY;
+            m_frameWidth    = texture.m_frameWidth;
+            m_frameHeight   = texture.m_frameHeight;
+        }
+    }
+}
+
+uint8_t SpriteTexture::getPaletteIdx(const Color& color) const
+{
+    uint16_t idx = 0U;
+
+    while((m_paletteSize > idx) &&
+          (0 != memcmp(&m_palette[idx], &color, sizeof(Color))))
+    {
+        ++idx;
+    }
+
+    return static_cast<uint8_t>(idx);
+}
+
+size_t SpriteTexture::getPacketSize() const
+{
+    size_t packetSize = 0U;
+
+    switch(m_encoding)
+    {
+    case ENCODING_RAW:
+        packetSize = sizeof(Color);
+        break;
+
+    case ENCODING_RLE:
+        packetSize = 1U + sizeof(Color);
+        break;
+
+    case ENCODING_PALETTE:
+        packetSize = 2U;
+        break;
+
+    default:
+        break;
+    }
+
+    return packetSize;
+}
+
+uint32_t SpriteTexture::encodeFrame(const Color* pixels, uint16_t stride, uint8_t* buffer) const
+{
+    uint32_t        packetCnt   = 0U;
+    const size_t    packetSize  = getPacketSize();
+    uint8_t*        packet      = nullptr;
+    const Color*    prevColor   = nullptr;
+    uint8_t         runLength   = 0U;
+    uint16_t        x           = 0U;
+    uint16_t        y           = 0U;
+
+    for(y = 0U; y < m_frameHeight; ++y)
+    {
+        const Color* row = &pixels[static_cast<size_t>(y) * stride];
+
+        for(x = 0U; x < m_frameWidth; ++x)
+        {
+            const Color* color = &row[x];
+
+            /* Start a new packet, if the run ends. Raw colors have no runs. */
+            if ((ENCODING_RAW == m_encoding) ||
+                (nullptr == prevColor) ||
+                (RLE_MAX_CNT <= runLength) ||
+                (0 != memcmp(prevColor, color, sizeof(Color))))
+            {
+                if (nullptr != buffer)
+                {
+                    packet = &buffer[packetCnt * packetSize];
+
+                    switch(m_encoding)
+                    {
+                    case ENCODING_RAW:
+                        (void)memcpy(packet, color, sizeof(Color));
+                        break;
+
+                    case ENCODING_RLE:
+                        (void)memcpy(&packet[1], color, sizeof(Color));
+                        break;
+
+                    case ENCODING_PALETTE:
+                        packet[1] = getPaletteIdx(*color);
+                        break;
+
+                    default:
+                        break;
+                    }
+                }
+
+                ++packetCnt;
+                runLength = 0U;
+            }
+
+            ++runLength;
+
+            if ((nullptr != packet) &&
+                (ENCODING_RAW != m_encoding))
+            {
+                packet[0] = runLength;
+            }
+
+            prevColor = color;
+        }
+    }
+
+    return packetCnt;
+}
+
+bool SpriteTexture::Encoder::begin(uint16_t width, uint16_t height)
+{
+    bool isSuccessful = false;
+
+    /* The second pass must provide the same texture image. */
+    if (true == m_isEncoding)
+    {
+        if ((m_width == width) &&
+            (m_height == height))
+        {
+            m_rowCnt    = 0U;
+            m_bandCnt   = 0U;
+
+            isSuccessful = true;
+        }
+    }
+    /* The frame size must be lower or equal to the texture size. */
+    else if ((0U < m_frameWidth) &&
+             (0U < m_frameHeight) &&
+             (width >= m_frameWidth) &&
+             (height >= m_frameHeight))
+    {
+        uint16_t    framesX     = width / m_frameWidth;
+        uint16_t    framesY     = height / m_frameHeight;
+        uint32_t    frameCnt    = static_cast<uint32_t>(framesX) * framesY;
+
+        if (UINT16_MAX >= frameCnt)
+        {
+            m_band                      = new(std::nothrow) Color[static_cast<size_t>(width) * (m_frameHeight + 1U)];
+            m_texture.m_frameOffsets    = new(std::nothrow) uint32_t[frameCnt];
+        }
+
+        if ((nullptr != m_band) &&
+            (nullptr != m_texture.m_frameOffsets))
+        {
+            m_palette = new(std::nothrow) Color[PALETTE_MAX_SIZE];
+
+            /* Without palette, the colors are run-length encoded. */
+            if (nullptr == m_palette)
+            {
+                m_isPaletteFull = true;
+            }
+
+            m_width                 = width;
+            m_height                = height;
+            m_texture.m_encoding    = ENCODING_RLE;
+            m_texture.m_frameCnt    = frameCnt;
+            m_texture.m_framesX     = framesX;
+            m_texture.m_framesY     = framesY;
+            m_texture.m_frameWidth  = m_frameWidth;
+            m_texture.m_frameHeight = m_frameHeight;
+
+            isSuccessful = true;
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccessful;
+}
+
+Color* SpriteTexture::Encoder::getRow(uint16_t y)
+{
+    uint16_t bandRow = m_frameHeight;
+
+    /* Rows, which belong to no frame, use the additional row. */
+    if ((m_texture.m_framesY * m_frameHeight) > y)
+    {
+        bandRow = y % m_frameHeight;
+    }
+
+    return &m_band[static_cast<size_t>(bandRow) * m_width];
+}
+
+void SpriteTexture::Encoder::endRow(uint16_t y)
+{
+    /* The rows are provided in order, either from top to bottom or from
+     * bottom to top. Therefore a row of frames is complete, after all of
+     * its rows are received.
+     */
+    if ((m_texture.m_framesY * m_frameHeight) > y)
+    {
+        ++m_rowCnt;
+
+        if (m_frameHeight <= m_rowCnt)
+        {
+            processBand(y / m_frameHeight);
+
+            m_rowCnt = 0U;
+            ++m_bandCnt;
+        }
+    }
+}
+
+bool SpriteTexture::Encoder::prepare()
+{
+    bool        isSuccessful    = true;
+    size_t      rawFrameSize    = static_cast<size_t>(m_frameWidth) * m_frameHeight * sizeof(Color);
+    uint32_t    packetCnt       = 0U;
+    uint16_t    frameIdx        = 0U;
+    size_t      dataSize        = 0U;
+
+    for(frameIdx = 0U; frameIdx < m_texture.m_frameCnt; ++frameIdx)
+    {
+        packetCnt += m_texture.m_frameOffsets[frameIdx];
+    }
+
+    if (false == m_isPaletteFull)
+    {
+        m_texture.m_palette = new(std::nothrow) Color[m_paletteSize];
+
+        if (nullptr == m_texture.m_palette)
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            uint16_t idx = 0U;
+
+            for(idx = 0U; idx < m_paletteSize; ++idx)
+            {
+                m_texture.m_palette[idx] = m_palette[idx];
+            }
+
+            m_texture.m_paletteSize = m_paletteSize;
+            m_texture.m_encoding    = ENCODING_PALETTE;
+        }
+    }
+    /* Run-length encoded colors are only used, if it saves space. */
+    else if ((static_cast<size_t>(packetCnt) * m_texture.getPacketSize()) >= (rawFrameSize * m_texture.m_frameCnt))
+    {
+        m_texture.m_encoding = ENCODING_RAW;
+    }
+    else
+    {
+        ;
+    }
+
+    /* The collected colors are not needed anymore. */
+    releasePalette();
+
+    if (true == isSuccessful)
+    {
+        /* The number of packets per frame is replaced by the frame offset. */
+        for(frameIdx = 0U; frameIdx < m_texture.m_frameCnt; ++frameIdx)
+        {
+            uint32_t framePacketCnt = m_texture.m_frameOffsets[frameIdx];
+
+            m_texture.m_frameOffsets[frameIdx] = dataSize;
+
+            if (ENCODING_RAW == m_texture.m_encoding)
+            {
+                dataSize += rawFrameSize;
+            }
+            else
+            {
+                dataSize += framePacketCnt * m_texture.getPacketSize();
+            }
+        }
+
+        m_texture.m_data = new(std::nothrow) uint8_t[dataSize];
+
+        if (nullptr == m_texture.m_data)
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            m_texture.m_dataSize    = dataSize;
+            m_isEncoding            = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void SpriteTexture::Encoder::processBand(uint16_t bandIdx)
+{
+    uint16_t frameX = 0U;
+
+    for(frameX = 0U; frameX < m_texture.m_framesX; ++frameX)
+    {
+        uint16_t        frameIdx    = bandIdx * m_texture.m_framesX + frameX;
+        const Color*    pixels      = &m_band[frameX * m_frameWidth];
+
+        if (false == m_isEncoding)
+        {
+            addColors(pixels);
+            m_texture.m_frameOffsets[frameIdx] = m_texture.encodeFrame(pixels, m_width, nullptr);
+        }
+        else
+        {
+            (void)m_texture.encodeFrame(pixels, m_width, &m_texture.m_data[m_texture.m_frameOffsets[frameIdx]]);
+        }
+    }
+}
+
+void SpriteTexture::Encoder::addColors(const Color* pixels)
+{
+    const Color*    prevColor   = nullptr;
+    uint16_t        x           = 0U;
+    uint16_t        y           = 0U;
+
+    for(y = 0U; (y < m_frameHeight) && (false == m_isPaletteFull); ++y)
+    {
+        const Color* row = &pixels[static_cast<size_t>(y) * m_width];
+
+        for(x = 0U; (x < m_frameWidth) && (false == m_isPaletteFull); ++x)
+        {
+            const Color* color = &row[x];
+
+            /* Neighbour pixels have often the same color, which is already
+             * part of the palette.
+             */
+            if ((nullptr == prevColor) ||
+                (0 != memcmp(prevColor, color, sizeof(Color))))
+            {
+                uint16_t idx = 0U;
+
+                while((m_paletteSize > idx) &&
+                      (0 != memcmp(&m_palette[idx], color, sizeof(Color))))
+                {
+                    ++idx;
+                }
+
+                if (m_paletteSize == idx)
+                {
+                    if (PALETTE_MAX_SIZE <= m_paletteSize)
+                    {
+                        m_isPaletteFull = true;
+                    }
+                    else
+                    {
+                        m_palette[m_paletteSize] = *color;
+                        ++m_paletteSize;
+                    }
+                }
+            }
+
+            prevColor = color;
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Load the texture image file row by row to the row sink.
+ * The image format is detected by the file signature.
+ *
+ * @param[in] fs        File system
+ * @param[in] fileName  Name of the texture image file
+ * @param[in] sink      Row sink
+ *
+ * @return If successful, it will return RET_OK. See BmpImgLoader::Ret type for more informations.
+ */
+static BmpImgLoader::Ret loadRows(FS& fs, const String& fileName, IImgRowSink& sink)
+{
+    BmpImgLoader::Ret   ret         = BmpImgLoader::RET_OK;
+    File                fd          = fs.open(fileName);
+    uint16_t            signature   = 0U;
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        bool isNative = ((true == NativeImg::readSignature(fd, signature)) && (NativeImg::SIGNATURE == signature));
+
+        fd.close();
+
+        if (true == isNative)
+        {
+            NativeImg nativeImg;
+
+            ret = nativeImg.load(fs, fileName, sink);
+        }
+        else
+        {
+            BmpImgLoader loader;
+
+            ret = loader.load(fs, fileName, sink);
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,303 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compressed sprite sheet texture
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef SPRITE_TEXTURE_H
+#define SPRITE_TEXTURE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+#include "BmpImgLoader.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The sprite texture keeps the frames of a texture image compressed in
+ * memory, so only a single frame needs to be decoded at a time.
+ *
+ * The frames are cut out of the texture image in x-direction from 0 to N and
+ * continue in the next row. Every frame is encoded on its own, with one of
+ * the following encodings, selected for the whole texture:
+ * - Run-length encoded palette indices, if the texture has at most 256 colors.
+ * - Run-length encoded colors, if it saves space.
+ * - Raw colors otherwise.
+ *
+ * The texture image is compressed row by row while it is loaded, so only a
+ * single row of frames needs to be kept decoded in memory. Therefore the
+ * texture image file is read twice: first to determine the colors and the
+ * size of the compressed frames, second to compress them.
+ */
+class SpriteTexture
+{
+public:
+
+    /**
+     * Constructs a sprite texture, without frames.
+     */
+    SpriteTexture() :
+        m_encoding(ENCODING_RAW),
+        m_palette(nullptr),
+        m_paletteSize(0U),
+        m_data(nullptr),
+        m_dataSize(0U),
+        m_frameOffsets(nullptr),
+        m_frameCnt(0U),
+        m_framesX(0U),
+        m_framesY(0U),
+        m_frameWidth(0U),
+        m_frameHeight(0U)
+    {
+    }
+
+    /**
+     * Constructs a sprite texture by copy.
+     * If not enough memory is available, the copy will be empty.
+     *
+     * @param[in] texture   The sprite texture, which to copy from.
+     */
+    SpriteTexture(const SpriteTexture& texture) :
+        m_encoding(ENCODING_RAW),
+        m_palette(nullptr),
+        m_paletteSize(0U),
+        m_data(nullptr),
+        m_dataSize(0U),
+        m_frameOffsets(nullptr),
+        m_frameCnt(0U),
+        m_framesX(0U),
+        m_framesY(0U),
+        m_frameWidth(0U),
+        m_frameHeight(0U)
+    {
+        copy(texture);
+    }
+
+    /**
+     * Destroys the sprite texture.
+     */
+    ~SpriteTexture()
+    {
+        release();
+    }
+
+    /**
+     * Assigns a sprite texture.
+     * If not enough memory is available, the sprite texture will be empty.
+     *
+     * @param[in] texture   The sprite texture, which to copy from.
+     *
+     * @return The sprite texture itself.
+     */
+    SpriteTexture& operator=(const SpriteTexture& texture)
+    {
+        if (this != (&texture))
+        {
+            copy(texture);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Load the texture image from file system and compress its frames.
+     * Supported are bitmap images (.bmp) and native images.
+     * Every frame of the texture will be compressed, including the frames
+     * in a gap of the last row.
+     *
+     * @param[in] fs            File system
+     * @param[in] fileName      Name of the texture image file
+     * @param[in] frameWidth    Frame width in pixels
+     * @param[in] frameHeight   Frame height in pixels
+     *
+     * @return If successful, it will return RET_OK. See BmpImgLoader::Ret type for more informations.
+     */
+    BmpImgLoader::Ret load(FS& fs, const String& fileName, uint16_t frameWidth, uint16_t frameHeight);
+
+    /**
+     * Release the compressed frames.
+     */
+    void release();
+
+    /**
+     * Are compressed frames available?
+     *
+     * @return If frames are available, it will return true otherwise false.
+     */
+    bool isValid() const
+    {
+        return (nullptr != m_data);
+    }
+
+    /**
+     * Get number of frames.
+     *
+     * @return Number of frames
+     */
+    uint16_t getFrameCnt() const
+    {
+        return m_frameCnt;
+    }
+
+    /**
+     * Get number of frames on the texture x-axis.
+     *
+     * @return Number of frames on the x-axis
+     */
+    uint16_t getFramesX() const
+    {
+        return m_framesX;
+    }
+
+    /**
+     * Get number of frames on the texture y-axis.
+     *
+     * @return Number of frames on the y-axis
+     */
+    uint16_t getFramesY() const
+    {
+        return m_framesY;
+    }
+
+    /**
+     * Get the memory in bytes, used by the compressed frames.
+     *
+     * @return Used memory in bytes
+     */
+    size_t getSize() const
+    {
+        return (m_paletteSize * sizeof(Color)) + m_dataSize + (m_frameCnt * sizeof(uint32_t));
+    }
+
+    /**
+     * Decode a single frame to the frame bitmap, which must have the
+     * frame size.
+     *
+     * @param[in] frameIdx  Frame index
+     * @param[out] frame    Frame bitmap
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool decode(uint16_t frameIdx, YAGfxDynamicBitmap& frame) const;
+
+private:
+
+    /* Forward declaration */
+    class Encoder;
+
+    /**
+     * Frame encodings.
+     */
+    enum Encoding
+    {
+        ENCODING_RAW = 0,   /**< Raw colors */
+        ENCODING_RLE,       /**< Run-length encoded colors */
+        ENCODING_PALETTE    /**< Run-length encoded palette indices */
+    };
+
+    /** Max. number of palette colors. */
+    static const uint16_t   PALETTE_MAX_SIZE    = 256U;
+
+    /** Max. number of pixels in a single run. */
+    static const uint8_t    RLE_MAX_CNT         = UINT8_MAX;
+
+    Encoding    m_encoding;     /**< Encoding of the frames. */
+    Color*      m_palette;      /**< Color palette, only used for the palette encoding. */
+    uint16_t    m_paletteSize;  /**< Number of palette colors. */
+    uint8_t*    m_data;         /**< Encoded frames */
+    size_t      m_dataSize;     /**< Size of the encoded frames in bytes. */
+    uint32_t*   m_frameOffsets; /**< Offset of every frame in the encoded frames. */
+    uint16_t    m_frameCnt;     /**< Number of frames */
+    uint16_t    m_framesX;      /**< Number of frames on the texture x-axis */
+    uint16_t    m_framesY;      /**< Number of frames on the texture y-axis */
+    uint16_t    m_frameWidth;   /**< Frame width in pixels */
+    uint16_t    m_frameHeight;  /**< Frame height in pixels */
+
+    /**
+     * Copy the compressed frames of another sprite texture.
+     *
+     * @param[in] texture   The sprite texture, which to copy from.
+     */
+    void copy(const SpriteTexture& texture);
+
+    /**
+     * Get the palette index of a color.
+     *
+     * @param[in] color Color, which must be part of the palette.
+     *
+     * @return Palette index
+     */
+    uint8_t getPaletteIdx(const Color& color) const;
+
+    /**
+     * Get the size of the encoded packet, which covers one or more pixels.
+     *
+     * @return Packet size in bytes
+     */
+    size_t getPacketSize() const;
+
+    /**
+     * Encode a single frame. If no buffer is given, only the number of
+     * packets will be determined.
+     *
+     * @param[in] pixels    Pixel rows, which contain the frame.
+     * @param[in] stride    Number of pixels of a single row.
+     * @param[out] buffer   Buffer for the encoded frame or nullptr
+     *
+     * @return Number of packets of the encoded frame
+     */
+    uint32_t encodeFrame(const Color* pixels, uint16_t stride, uint8_t* buffer) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* SPRITE_TEXTURE_H */
+
+/** @} */
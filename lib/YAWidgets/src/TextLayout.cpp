@@ -0,0 +1,173 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Text layout
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TextLayout.h"
+
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+TextLayout::TextLayout(const TextLayout& layout) :
+    m_text(),
+    m_runs(nullptr),
+    m_maxRuns(0U),
+    m_runCnt(0U),
+    m_width(0U)
+{
+    *this = layout;
+}
+
+TextLayout& TextLayout::operator=(const TextLayout& layout)
+{
+    if (&layout != this)
+    {
+        if (true == reset(layout.m_runCnt))
+        {
+            uint16_t index = 0U;
+
+            for(index = 0U; index < layout.m_runCnt; ++index)
+            {
+                m_runs[index] = layout.m_runs[index];
+            }
+
+            m_runCnt    = layout.m_runCnt;
+            m_text      = layout.m_text;
+            m_width     = layout.m_width;
+        }
+    }
+
+    return *this;
+}
+
+bool TextLayout::reset(uint16_t maxRuns)
+{
+    bool isSuccessful = true;
+
+    m_text.clear();
+    m_runCnt    = 0U;
+    m_width     = 0U;
+
+    /* Reuse the runs if possible. */
+    if (m_maxRuns < maxRuns)
+    {
+        release();
+
+        m_runs = new(std::nothrow) Run[maxRuns];
+
+        if (nullptr == m_runs)
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            m_maxRuns = maxRuns;
+        }
+    }
+
+    return isSuccessful;
+}
+
+TextLayout::Run* TextLayout::appendRun(uint16_t begin)
+{
+    Run* run = nullptr;
+
+    if (m_maxRuns > m_runCnt)
+    {
+        run = &m_runs[m_runCnt];
+
+        *run        = Run();
+        run->begin  = begin;
+
+        /* The color is kept until it is changed. */
+        if (0U < m_runCnt)
+        {
+            run->isColorSet = m_runs[m_runCnt - 1U].isColorSet;
+            run->color      = m_runs[m_runCnt - 1U].color;
+        }
+
+        ++m_runCnt;
+    }
+
+    return run;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void TextLayout::release()
+{
+    if (nullptr != m_runs)
+    {
+        delete[] m_runs;
+        m_runs = nullptr;
+    }
+
+    m_maxRuns   = 0U;
+    m_runCnt    = 0U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
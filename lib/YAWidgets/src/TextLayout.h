@@ -0,0 +1,273 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Text layout
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <YAColor.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The layout of a text, which is the result of parsing a format string once.
+ * It contains the text without format tags and a list of runs. A run is a
+ * part of the text, which is drawn with the same color in a single line.
+ * A new run starts with every format tag and with every line break.
+ */
+class TextLayout
+{
+public:
+
+    /**
+     * Text alignment, which is applied at the begin of a run.
+     */
+    enum Alignment
+    {
+        ALIGNMENT_NONE = 0, /**< Continue at the current cursor position. */
+        ALIGNMENT_LEFT,     /**< Alignment left */
+        ALIGNMENT_RIGHT,    /**< Alignment right */
+        ALIGNMENT_CENTER    /**< Alignment center */
+    };
+
+    /**
+     * A run of characters with the same properties.
+     */
+    struct Run
+    {
+        uint16_t    begin;      /**< Index of the first character in the text. */
+        uint16_t    length;     /**< Number of characters. */
+        uint16_t    width;      /**< Width in pixel, which is the sum of the character advances. */
+        int16_t     inkBegin;   /**< Most left pixel of the glyphs, relative to the run begin. */
+        int16_t     inkEnd;     /**< Most right pixel + 1 of the glyphs, relative to the run begin. */
+        uint16_t    restWidth;  /**< Width in pixel of the text from this run up to the end. Only used for alignment. */
+        bool        isColorSet; /**< Is a text color set or shall the default text color be used? */
+        Color       color;      /**< Text color, if set. */
+        Alignment   alignment;  /**< Alignment at the begin of the run. */
+        bool        isNewLine;  /**< Does the run start in the next line? */
+
+        /**
+         * Initializes a empty run.
+         */
+        Run() :
+            begin(0U),
+            length(0U),
+            width(0U),
+            inkBegin(0),
+            inkEnd(0),
+            restWidth(0U),
+            isColorSet(false),
+            color(),
+            alignment(ALIGNMENT_NONE),
+            isNewLine(false)
+        {
+        }
+    };
+
+    /**
+     * Constructs an empty text layout.
+     */
+    TextLayout() :
+        m_text(),
+        m_runs(nullptr),
+        m_maxRuns(0U),
+        m_runCnt(0U),
+        m_width(0U)
+    {
+    }
+
+    /**
+     * Constructs a text layout by copy.
+     *
+     * @param[in] layout    Text layout, which to copy.
+     */
+    TextLayout(const TextLayout& layout);
+
+    /**
+     * Destroys the text layout.
+     */
+    ~TextLayout()
+    {
+        release();
+    }
+
+    /**
+     * Assign a text layout.
+     *
+     * @param[in] layout    Text layout, which to assign.
+     *
+     * @return The text layout itself.
+     */
+    TextLayout& operator=(const TextLayout& layout);
+
+    /**
+     * Clear the text layout and reserve memory for the given number of runs.
+     *
+     * @param[in] maxRuns   Max. number of runs
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool reset(uint16_t maxRuns);
+
+    /**
+     * Clear the text layout and release its memory.
+     */
+    void clear()
+    {
+        m_text.clear();
+        release();
+        m_width = 0U;
+    }
+
+    /**
+     * Append a new run, which starts at the given index of the text.
+     * It takes over the color of the previous run.
+     *
+     * @param[in] begin Index of the first character in the text.
+     *
+     * @return If successful, it will return the new run otherwise nullptr.
+     */
+    Run* appendRun(uint16_t begin);
+
+    /**
+     * Set the text without format tags.
+     *
+     * @param[in] text  Text
+     */
+    void setText(const char* text)
+    {
+        m_text = text;
+    }
+
+    /**
+     * Get the text without format tags.
+     *
+     * @return Text
+     */
+    const String& getText() const
+    {
+        return m_text;
+    }
+
+    /**
+     * Get number of runs.
+     *
+     * @return Number of runs
+     */
+    uint16_t getRunCnt() const
+    {
+        return m_runCnt;
+    }
+
+    /**
+     * Get a run.
+     *
+     * @param[in] index Run index
+     *
+     * @return Run
+     */
+    const Run& getRun(uint16_t index) const
+    {
+        return m_runs[index];
+    }
+
+    /**
+     * Get a run.
+     *
+     * @param[in] index Run index
+     *
+     * @return Run
+     */
+    Run& getRun(uint16_t index)
+    {
+        return m_runs[index];
+    }
+
+    /**
+     * Get the text width in pixel. In case of several lines, it will be the
+     * width of the longest line.
+     *
+     * @return Text width in pixel
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Set the text width in pixel.
+     *
+     * @param[in] width Text width in pixel
+     */
+    void setWidth(uint16_t width)
+    {
+        m_width = width;
+    }
+
+private:
+
+    String      m_text;     /**< Text without format tags. */
+    Run*        m_runs;     /**< Runs */
+    uint16_t    m_maxRuns;  /**< Max. number of runs */
+    uint16_t    m_runCnt;   /**< Number of used runs */
+    uint16_t    m_width;    /**< Text width in pixel */
+
+    /**
+     * Release the runs.
+     */
+    void release();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* TEXT_LAYOUT_H */
+
+/** @} */
@@ -0,0 +1,496 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pre-rendered text strip
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TextStrip.h"
+
+#include <new>
+#include <utility>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of pixels, which are drawn with a single span. */
+static const uint16_t   SPAN_MAX_PIXELS = 32U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+TextStrip::TextStrip(const TextStrip& strip) :
+    m_mask(nullptr),
+    m_colorRuns(nullptr),
+    m_colorRunCnt(0U),
+    m_width(0U),
+    m_height(0U),
+    m_bytesPerRow(0U),
+    m_offsetX(0),
+    m_offsetY(0),
+    m_advance(0U)
+{
+    *this = strip;
+}
+
+TextStrip& TextStrip::operator=(const TextStrip& strip)
+{
+    if (&strip != this)
+    {
+        uint32_t maskSize = static_cast<uint32_t>(strip.m_bytesPerRow) * strip.m_height;
+
+        release();
+
+        if ((nullptr != strip.m_mask) &&
+            (true == allocate(maskSize, strip.m_colorRunCnt)))
+        {
+            uint16_t index = 0U;
+
+            memcpy(m_mask, strip.m_mask, maskSize);
+
+            for(index = 0U; index < strip.m_colorRunCnt; ++index)
+            {
+                m_colorRuns[index] = strip.m_colorRuns[index];
+            }
+
+            m_colorRunCnt   = strip.m_colorRunCnt;
+            m_width         = strip.m_width;
+            m_height        = strip.m_height;
+            m_bytesPerRow   = strip.m_bytesPerRow;
+            m_offsetX       = strip.m_offsetX;
+            m_offsetY       = strip.m_offsetY;
+            m_advance       = strip.m_advance;
+        }
+    }
+
+    return *this;
+}
+
+bool TextStrip::create(const TextLayout& layout, YAFont& font)
+{
+    bool            isSuccessful    = false;
+    bool            isSupported    = true;
+    const GFXfont*  gfxFont         = font.getGfxFont();
+    const char*     text            = layout.getText().c_str();
+    uint16_t        runIndex        = 0U;
+    size_t          charIndex       = 0U;
+    size_t          runEnd          = 0U;
+    int16_t         penX            = 0;
+    int16_t         minX            = INT16_MAX;
+    int16_t         maxX            = INT16_MIN;
+    int16_t         minY            = INT16_MAX;
+    int16_t         maxY            = INT16_MIN;
+
+    release();
+
+    /* Determine the area, which is covered by the glyphs.
+     * Only a single line can be pre-rendered.
+     */
+    if (nullptr == gfxFont)
+    {
+        isSupported = false;
+    }
+    else
+    {
+        for(runIndex = 0U; runIndex < layout.getRunCnt(); ++runIndex)
+        {
+            const TextLayout::Run& run = layout.getRun(runIndex);
+
+            if (true == run.isNewLine)
+            {
+                isSupported = false;
+                break;
+            }
+
+            charIndex   = run.begin;
+            runEnd      = run.begin + run.length;
+
+            while(runEnd > charIndex)
+            {
+                const GFXglyph* glyph = font.getGlyphByCodepoint(Utf8::decode(text, charIndex));
+
+                if (nullptr != glyph)
+                {
+                    if ((0U < glyph->width) &&
+                        (0U < glyph->height))
+                    {
+                        int16_t posX = penX + glyph->xOffset;
+
+                        if (minX > posX)
+                        {
+                            minX = posX;
+                        }
+
+                        if (maxX < (posX + glyph->width))
+                        {
+                            maxX = posX + glyph->width;
+                        }
+
+                        if (minY > glyph->yOffset)
+                        {
+                            minY = glyph->yOffset;
+                        }
+
+                        if (maxY < (glyph->yOffset + glyph->height))
+                        {
+                            maxY = glyph->yOffset + glyph->height;
+                        }
+                    }
+
+                    penX += glyph->xAdvance;
+                }
+            }
+        }
+    }
+
+    /* At least one visible glyph is necessary. */
+    if ((true == isSupported) &&
+        (minX < maxX))
+    {
+        uint16_t width          = maxX - minX;
+        uint16_t height         = maxY - minY;
+        uint16_t bytesPerRow    = (width + 7U) / 8U;
+        uint32_t maskSize       = static_cast<uint32_t>(bytesPerRow) * height;
+
+        if ((MAX_MASK_SIZE >= maskSize) &&
+            (true == allocate(maskSize, layout.getRunCnt())))
+        {
+            m_width         = width;
+            m_height        = height;
+            m_bytesPerRow   = bytesPerRow;
+            m_offsetX       = minX;
+            m_offsetY       = minY;
+            m_advance       = penX;
+
+            memset(m_mask, 0, maskSize);
+
+            isSuccessful = true;
+
+            penX = 0;
+            for(runIndex = 0U; (runIndex < layout.getRunCnt()) && (true == isSuccessful); ++runIndex)
+            {
+                const TextLayout::Run&  run         = layout.getRun(runIndex);
+                uint16_t                begin       = 0U;
+                ColorRun*               colorRun    = nullptr;
+
+                /* The first color run starts always at the strip begin. */
+                if ((0U < m_colorRunCnt) &&
+                    (minX < penX))
+                {
+                    begin = penX - minX;
+                }
+
+                if (0U < m_colorRunCnt)
+                {
+                    colorRun = &m_colorRuns[m_colorRunCnt - 1U];
+                }
+
+                /* Start a new color run only if the color changes. A run,
+                 * which contains no pixel is overwritten.
+                 */
+                if ((nullptr == colorRun) ||
+                    ((colorRun->isColorSet != run.isColorSet) || (colorRun->color != run.color)))
+                {
+                    if ((nullptr == colorRun) ||
+                        (colorRun->begin < begin))
+                    {
+                        colorRun = &m_colorRuns[m_colorRunCnt];
+                        ++m_colorRunCnt;
+                    }
+
+                    colorRun->begin         = begin;
+                    colorRun->isColorSet    = run.isColorSet;
+                    colorRun->color         = run.color;
+                }
+
+                charIndex   = run.begin;
+                runEnd      = run.begin + run.length;
+
+                while((runEnd > charIndex) && (true == isSuccessful))
+                {
+                    const GFXglyph* glyph = font.getGlyphByCodepoint(Utf8::decode(text, charIndex));
+
+                    if (nullptr != glyph)
+                    {
+                        uint8_t         glyphBytesPerRow    = 0U;
+                        const uint8_t*  glyphMask           = font.getGlyphMask(*glyph, glyphBytesPerRow);
+
+                        /* A font, which can not be cached, is not pre-rendered. */
+                        if (nullptr == glyphMask)
+                        {
+                            isSuccessful = false;
+                        }
+                        else
+                        {
+                            renderGlyph(glyphMask, glyphBytesPerRow, *glyph, penX + glyph->xOffset - minX, glyph->yOffset - minY);
+                            penX += glyph->xAdvance;
+                        }
+                    }
+                }
+            }
+
+            if (false == isSuccessful)
+            {
+                release();
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+void TextStrip::release()
+{
+    if (nullptr != m_mask)
+    {
+        delete[] m_mask;
+        m_mask = nullptr;
+    }
+
+    if (nullptr != m_colorRuns)
+    {
+        delete[] m_colorRuns;
+        m_colorRuns = nullptr;
+    }
+
+    m_colorRunCnt   = 0U;
+    m_width         = 0U;
+    m_height        = 0U;
+    m_bytesPerRow   = 0U;
+    m_offsetX       = 0;
+    m_offsetY       = 0;
+    m_advance       = 0U;
+}
+
+void TextStrip::swap(TextStrip& strip)
+{
+    std::swap(m_mask, strip.m_mask);
+    std::swap(m_colorRuns, strip.m_colorRuns);
+    std::swap(m_colorRunCnt, strip.m_colorRunCnt);
+    std::swap(m_width, strip.m_width);
+    std::swap(m_height, strip.m_height);
+    std::swap(m_bytesPerRow, strip.m_bytesPerRow);
+    std::swap(m_offsetX, strip.m_offsetX);
+    std::swap(m_offsetY, strip.m_offsetY);
+    std::swap(m_advance, strip.m_advance);
+}
+
+void TextStrip::draw(YAGfx& gfx, int16_t cursorX, int16_t cursorY, const Color& defaultColor) const
+{
+    int32_t     originX     = static_cast<int32_t>(cursorX) + m_offsetX;
+    int32_t     originY     = static_cast<int32_t>(cursorY) + m_offsetY;
+    int32_t     colBegin    = 0;
+    int32_t     colEnd      = m_width;
+    int32_t     rowBegin    = 0;
+    int32_t     rowEnd      = m_height;
+    uint16_t    runIndex    = 0U;
+
+    if (nullptr == m_mask)
+    {
+        return;
+    }
+
+    /* Clip the strip to the canvas. */
+    if (0 > originX)
+    {
+        colBegin = -originX;
+    }
+
+    if (gfx.getWidth() < (originX + colEnd))
+    {
+        colEnd = gfx.getWidth() - originX;
+    }
+
+    if (0 > originY)
+    {
+        rowBegin = -originY;
+    }
+
+    if (gfx.getHeight() < (originY + rowEnd))
+    {
+        rowEnd = gfx.getHeight() - originY;
+    }
+
+    for(runIndex = 0U; runIndex < m_colorRunCnt; ++runIndex)
+    {
+        const ColorRun& colorRun    = m_colorRuns[runIndex];
+        const Color&    color       = (true == colorRun.isColorSet) ? colorRun.color : defaultColor;
+        int32_t         runBegin    = colorRun.begin;
+        int32_t         runEnd      = m_width;
+        int32_t         row         = 0;
+        Color           spanColors[SPAN_MAX_PIXELS];
+        uint16_t        idx         = 0U;
+
+        if ((runIndex + 1U) < m_colorRunCnt)
+        {
+            runEnd = m_colorRuns[runIndex + 1U].begin;
+        }
+
+        if (colBegin > runBegin)
+        {
+            runBegin = colBegin;
+        }
+
+        if (colEnd < runEnd)
+        {
+            runEnd = colEnd;
+        }
+
+        /* All pixels of a color run have the same color. */
+        for(idx = 0U; idx < SPAN_MAX_PIXELS; ++idx)
+        {
+            spanColors[idx] = color;
+        }
+
+        for(row = rowBegin; (row < rowEnd) && (runBegin < runEnd); ++row)
+        {
+            const uint8_t*  rowBits = &m_mask[row * m_bytesPerRow];
+            int32_t         col     = runBegin;
+
+            while(runEnd > col)
+            {
+                uint8_t bits = rowBits[col / 8];
+
+                /* Skip 8 pixel at once, if none of them is set. */
+                if (0U == bits)
+                {
+                    col = (col | 7) + 1;
+                }
+                else if (0U == (bits & (0x80U >> (col % 8))))
+                {
+                    ++col;
+                }
+                else
+                /* Draw the set pixels in a row as one span. */
+                {
+                    int32_t spanBegin = col;
+
+                    while((runEnd > col) &&
+                          ((col - spanBegin) < SPAN_MAX_PIXELS) &&
+                          (0U != (rowBits[col / 8] & (0x80U >> (col % 8)))))
+                    {
+                        ++col;
+                    }
+
+                    gfx.drawSpan(originX + spanBegin, originY + row, spanColors, col - spanBegin);
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool TextStrip::allocate(uint32_t maskSize, uint16_t colorRunCnt)
+{
+    bool isSuccessful = false;
+
+    m_mask      = new(std::nothrow) uint8_t[maskSize];
+    m_colorRuns = new(std::nothrow) ColorRun[colorRunCnt];
+
+    if ((nullptr == m_mask) ||
+        (nullptr == m_colorRuns))
+    {
+        release();
+    }
+    else
+    {
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void TextStrip::renderGlyph(const uint8_t* glyphMask, uint8_t bytesPerRow, const GFXglyph& glyph, int16_t posX, int16_t posY)
+{
+    uint8_t shift   = posX % 8U;
+    uint8_t y       = 0U;
+    uint8_t idx     = 0U;
+
+    for(y = 0U; y < glyph.height; ++y)
+    {
+        uint8_t*        row     = &m_mask[(posY + y) * m_bytesPerRow + (posX / 8U)];
+        const uint8_t*  maskRow = &glyphMask[y * bytesPerRow];
+
+        /* The glyph mask bytes are shifted to the glyph position. The bits
+         * after the glyph width are zero and not written, because they may
+         * be outside the strip.
+         */
+        for(idx = 0U; idx < bytesPerRow; ++idx)
+        {
+            uint8_t bits    = maskRow[idx];
+            uint8_t bitsHi  = bits >> shift;
+            uint8_t bitsLo  = (0U == shift) ? 0U : static_cast<uint8_t>(bits << (8U - shift));
+
+            if (0U != bitsHi)
+            {
+                row[idx] |= bitsHi;
+            }
+
+            if (0U != bitsLo)
+            {
+                row[idx + 1U] |= bitsLo;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,221 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Pre-rendered text strip
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef TEXT_STRIP_H
+#define TEXT_STRIP_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfx.h>
+#include <YAFont.h>
+#include "TextLayout.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A single line text layout, which is rendered once into a 1 bit mask.
+ * The colors are kept as horizontal color runs. Drawing the strip only
+ * copies the visible window of the mask to the canvas, which is cheaper
+ * than rendering every glyph again and again while scrolling.
+ */
+class TextStrip
+{
+public:
+
+    /**
+     * Max. size of the mask in byte. Longer texts are not pre-rendered.
+     */
+    static const uint16_t   MAX_MASK_SIZE   = 2048U;
+
+    /**
+     * Constructs an empty text strip.
+     */
+    TextStrip() :
+        m_mask(nullptr),
+        m_colorRuns(nullptr),
+        m_colorRunCnt(0U),
+        m_width(0U),
+        m_height(0U),
+        m_bytesPerRow(0U),
+        m_offsetX(0),
+        m_offsetY(0),
+        m_advance(0U)
+    {
+    }
+
+    /**
+     * Constructs a text strip by copy.
+     *
+     * @param[in] strip Text strip, which to copy.
+     */
+    TextStrip(const TextStrip& strip);
+
+    /**
+     * Destroys the text strip.
+     */
+    ~TextStrip()
+    {
+        release();
+    }
+
+    /**
+     * Assign a text strip.
+     *
+     * @param[in] strip Text strip, which to assign.
+     *
+     * @return The text strip itself.
+     */
+    TextStrip& operator=(const TextStrip& strip);
+
+    /**
+     * Render the text layout with the given font into the strip.
+     * The glyph masks are taken from the glyph cache of the font.
+     * Layouts with several lines, a too large mask or fonts which can not
+     * be cached are not supported.
+     *
+     * @param[in] layout    Text layout
+     * @param[in] font      Font, used to render the text.
+     *
+     * @return If successful rendered, it will return true otherwise false.
+     */
+    bool create(const TextLayout& layout, YAFont& font);
+
+    /**
+     * Release the strip.
+     */
+    void release();
+
+    /**
+     * Exchange the content with another text strip, without copying
+     * the mask and the color runs.
+     *
+     * @param[in,out] strip Text strip, which to exchange with.
+     */
+    void swap(TextStrip& strip);
+
+    /**
+     * Is the strip available for drawing?
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    bool isAvailable() const
+    {
+        return (nullptr != m_mask);
+    }
+
+    /**
+     * Draw the visible part of the strip. The text starts at the given
+     * cursor position, like it would be drawn character by character.
+     *
+     * @param[in] gfx           Graphics interface
+     * @param[in] cursorX       Cursor x-coordinate
+     * @param[in] cursorY       Cursor y-coordinate, which is the baseline.
+     * @param[in] defaultColor  Color of the text parts, which have no color set.
+     */
+    void draw(YAGfx& gfx, int16_t cursorX, int16_t cursorY, const Color& defaultColor) const;
+
+    /**
+     * Get the distance in pixel, the cursor moves by drawing the text.
+     *
+     * @return Cursor advance in pixel
+     */
+    uint16_t getAdvance() const
+    {
+        return m_advance;
+    }
+
+private:
+
+    /**
+     * A horizontal part of the strip with the same color.
+     */
+    struct ColorRun
+    {
+        uint16_t    begin;      /**< First column of the run in the strip. */
+        bool        isColorSet; /**< Is a text color set or shall the default text color be used? */
+        Color       color;      /**< Text color, if set. */
+    };
+
+    uint8_t*    m_mask;         /**< 1 bit mask, row by row. The MSB is the left pixel. */
+    ColorRun*   m_colorRuns;    /**< Color runs, sorted by column. */
+    uint16_t    m_colorRunCnt;  /**< Number of color runs. */
+    uint16_t    m_width;        /**< Strip width in pixel. */
+    uint16_t    m_height;       /**< Strip height in pixel. */
+    uint16_t    m_bytesPerRow;  /**< Number of bytes per mask row. */
+    int16_t     m_offsetX;      /**< x-offset of the strip, relative to the cursor. */
+    int16_t     m_offsetY;      /**< y-offset of the strip, relative to the baseline. */
+    uint16_t    m_advance;      /**< Cursor advance in pixel. */
+
+    /**
+     * Allocate the mask and the color runs.
+     *
+     * @param[in] maskSize      Mask size in byte
+     * @param[in] colorRunCnt   Max. number of color runs
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool allocate(uint32_t maskSize, uint16_t colorRunCnt);
+
+    /**
+     * Render a single rasterized glyph mask into the mask.
+     *
+     * @param[in] glyphMask     The rasterized glyph mask
+     * @param[in] bytesPerRow   Number of bytes per glyph mask row
+     * @param[in] glyph         The glyph
+     * @param[in] posX          x-coordinate of the upper left glyph corner in the strip
+     * @param[in] posY          y-coordinate of the upper left glyph corner in the strip
+     */
+    void renderGlyph(const uint8_t* glyphMask, uint8_t bytesPerRow, const GFXglyph& glyph, int16_t posX, int16_t posY);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* TEXT_STRIP_H */
+
+/** @} */
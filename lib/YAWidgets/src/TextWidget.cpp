@@ -37,6 +37,8 @@
 #include <Fonts.h>
 #include <Util.h>
 #include <Logging.h>
+#include <string.h>
+#include <new>
 
 /******************************************************************************
  * Compiler Switches
@@ -78,6 +80,33 @@ uint32_t                    TextWidget::m_scrollPause       = TextWidget::DEFAUL
  * Public Methods
  *****************************************************************************/
 
+void TextWidget::setPreRendering(bool isEnabled)
+{
+    m_isPreRenderingEnabled = isEnabled;
+
+    /* Pre-render the texts, which are already scrolling. */
+    if ((true == m_isPreRenderingEnabled) &&
+        (true == m_scrollInfo.isEnabled))
+    {
+        (void)m_strip.create(m_layout, m_gfxText.getFont());
+    }
+    else
+    {
+        m_strip.release();
+    }
+
+    if ((true == m_isPreRenderingEnabled) &&
+        (true == m_handleNewText) &&
+        (true == m_scrollInfoNew.isEnabled))
+    {
+        (void)m_stripNew.create(m_layoutNew, m_gfxText.getFont());
+    }
+    else
+    {
+        m_stripNew.release();
+    }
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -89,14 +118,11 @@ uint32_t                    TextWidget::m_scrollPause       = TextWidget::DEFAUL
 void TextWidget::prepareNewText(YAGfx& gfx)
 {
     const uint16_t  SCROLL_DISTANCE = gfx.getWidth() / 2U; /* Distance in pixel after a scrolling text starts to repeat. */
-    uint16_t        textWidth       = 0U;
-    uint16_t        textHeight      = 0U;
-    String          str             = removeFormatTags(m_formatStrNew);
 
-    /* Get bounding box of the text, without any format tags. */
-    if (true == m_gfxText.getTextBoundingBox(gfx.getWidth(), str.c_str(), textWidth, textHeight))
+    /* Parse the format tags only once. The layout provides the text width too. */
+    if (true == createLayout(m_formatStrNew, m_layoutNew))
     {
-        m_scrollInfoNew.textWidth   = textWidth;
+        m_scrollInfoNew.textWidth   = m_layoutNew.getWidth();
         m_handleNewText             = true;
 
         /* Can new text be static shown or must it be scrolled? */
@@ -140,6 +166,8 @@ void TextWidget::prepareNewText(YAGfx& gfx)
 
                 /* Immediate take over. */
                 m_formatStr     = m_formatStrNew;
+                m_layout        = m_layoutNew;
+                m_strip.release();
                 m_scrollInfo    = m_scrollInfoNew;
                 m_handleNewText = false;
             }
@@ -164,6 +192,12 @@ void TextWidget::prepareNewText(YAGfx& gfx)
 
                 /* Because the scroll timer is stopped, it must be enabled again. */
                 m_scrollTimer.start(0U);
+
+                /* The current text is scrolling now too. */
+                if (true == m_isPreRenderingEnabled)
+                {
+                    (void)m_strip.create(m_layout, m_gfxText.getFont());
+                }
             }
         }
         /* Current text is scrolling. */
@@ -202,6 +236,17 @@ void TextWidget::prepareNewText(YAGfx& gfx)
                 }
             }
         }
+
+        /* A scrolling text is rendered only once, if pre-rendering is enabled. */
+        if ((true == m_isPreRenderingEnabled) &&
+            (true == m_scrollInfoNew.isEnabled))
+        {
+            (void)m_stripNew.create(m_layoutNew, m_gfxText.getFont());
+        }
+        else
+        {
+            m_stripNew.release();
+        }
     }
 }
 
@@ -216,18 +261,9 @@ void TextWidget::paint(YAGfx& gfx)
         m_isNewTextAvailable = false;
     }
 
-    /* Show current text. */
-    m_gfxText.setTextCursorPos(m_posX + m_scrollInfo.offset, cursorY);
-    show(gfx, m_formatStr, m_scrollInfo.isEnabled);
-
-    /* Show new text. */
-    if (true == m_handleNewText)
-    {
-        m_gfxText.setTextCursorPos(m_posX + m_scrollInfoNew.offset, cursorY);
-        show(gfx, m_formatStrNew, m_scrollInfoNew.isEnabled);
-    }
-
-    /* Is it time to scroll the text(s) again? */
+    /* Is it time to scroll the text(s) again? The text(s) are moved before
+     * they are shown, so every scroll step is painted only once.
+     */
     if (true == m_scrollTimer.isTimeout())
     {
         /* Handle scrolling text. */
@@ -266,6 +302,9 @@ void TextWidget::paint(YAGfx& gfx)
             {
                 m_handleNewText = false;
                 m_formatStr     = m_formatStrNew;
+                m_layout        = m_layoutNew;
+                m_strip.swap(m_stripNew);
+                m_stripNew.release();
                 m_scrollingCnt  = 0U;
 
                 /* Any additional new format string available? */
@@ -292,6 +331,9 @@ void TextWidget::paint(YAGfx& gfx)
                     m_scrollInfo.offsetDest = 0;
                     m_scrollInfo.offset     = 0;
                     m_scrollInfo.textWidth  = m_scrollInfoNew.textWidth;
+
+                    /* A static text is not pre-rendered. */
+                    m_strip.release();
                 }
                 else
                 /* Continue scrolling with new text. */
@@ -314,20 +356,56 @@ void TextWidget::paint(YAGfx& gfx)
             m_scrollTimer.start(m_scrollPause);
         }
     }
+
+    /* Show current text. */
+    m_gfxText.setTextCursorPos(m_posX + m_scrollInfo.offset, cursorY);
+    show(gfx, m_layout, m_strip, m_scrollInfo.isEnabled);
+
+    /* Show new text. */
+    if (true == m_handleNewText)
+    {
+        m_gfxText.setTextCursorPos(m_posX + m_scrollInfoNew.offset, cursorY);
+        show(gfx, m_layoutNew, m_stripNew, m_scrollInfoNew.isEnabled);
+    }
 }
 
-String TextWidget::removeFormatTags(const String& formatStr) const
+bool TextWidget::createLayout(const String& formatStr, TextLayout& layout) const
 {
-    uint32_t    index       = 0U;
-    bool        escapeFound = false;
-    bool        useChar     = false;
-    String      str;
-    uint32_t    length      = formatStr.length();
+    bool                status      = false;
+    const char*         str         = formatStr.c_str();
+    uint32_t            length      = formatStr.length();
+    uint32_t            index       = 0U;
+    uint16_t            maxRuns     = 1U;
+    bool                escapeFound = false;
+    bool                useChar     = false;
+    TextLayout::Run*    run         = nullptr;
+    char*               text        = new(std::nothrow) char[length + 1U];
+    uint16_t            textLength  = 0U;
+
+    /* Every format tag and every line break may start a new run. */
+    for(index = 0U; index < length; ++index)
+    {
+        if (('\\' == str[index]) ||
+            ('\n' == str[index]))
+        {
+            ++maxRuns;
+        }
+    }
 
-    while(length > index)
+    /* The text without format tags is collected in a temporary buffer,
+     * which avoids to grow the string character by character.
+     */
+    if ((nullptr != text) &&
+        (true == layout.reset(maxRuns)))
+    {
+        run = layout.appendRun(0U);
+    }
+
+    index = 0U;
+    while((length > index) && (nullptr != run))
     {
         /* Escape found? */
-        if ('\\' == formatStr[index])
+        if ('\\' == str[index])
         {
             /* Another escape found? */
             if (true == escapeFound)
@@ -348,11 +426,26 @@ String TextWidget::removeFormatTags(const String& formatStr) const
             for(keywordIndex = 0U; keywordIndex < UTIL_ARRAY_NUM(m_keywordHandlers); ++keywordIndex)
             {
                 KeywordHandler  handler     = m_keywordHandlers[keywordIndex];
+                TextLayout::Run tagRun;
                 uint8_t         overstep    = 0U;
-                bool            status      = (this->*handler)(nullptr, nullptr, false, formatStr.substring(index), false, overstep);
+                bool            isHandled   = (this->*handler)(&str[index], tagRun, overstep);
 
-                if (true == status)
+                if (true == isHandled)
                 {
+                    /* Every format tag starts a new run. */
+                    run = layout.appendRun(textLength);
+
+                    if (nullptr != run)
+                    {
+                        if (true == tagRun.isColorSet)
+                        {
+                            run->isColorSet = true;
+                            run->color      = tagRun.color;
+                        }
+
+                        run->alignment = tagRun.alignment;
+                    }
+
                     index += overstep;
                     break;
                 }
@@ -370,77 +463,188 @@ String TextWidget::removeFormatTags(const String& formatStr) const
             useChar = true;
         }
 
-        if (true == useChar)
+        if ((true == useChar) &&
+            (nullptr != run))
         {
             useChar = false;
-            str += formatStr[index];
-            ++index;
-        }
-    }
-
-    return str;
-}
 
-void TextWidget::show(YAGfx& gfx, const String& formatStr, bool isScrolling)
-{
-    uint32_t    index           = 0U;
-    bool        escapeFound     = false;
-    bool        useChar         = false;
-    uint32_t    length          = formatStr.length();
-    Color       textColorBackup = m_gfxText.getTextColor();
+            text[textLength] = str[index];
+            ++textLength;
 
-    while(length > index)
-    {
-        /* Escape found? */
-        if ('\\' == formatStr[index])
-        {
-            /* Another escape found? */
-            if (true == escapeFound)
+            /* Every line break starts a new run in the next line. */
+            if ('\n' == str[index])
             {
-                escapeFound = false;
-                useChar     = true;
+                run = layout.appendRun(textLength);
+
+                if (nullptr != run)
+                {
+                    run->isNewLine = true;
+                }
             }
             else
             {
-                escapeFound = true;
-                ++index;
+                ++run->length;
             }
+
+            ++index;
         }
-        else if (true == escapeFound)
+    }
+
+    if (nullptr != run)
+    {
+        const YAFont&   font        = m_gfxText.getFont();
+        uint16_t        runIndex    = 0U;
+        uint16_t        textWidth   = 0U;
+        uint16_t        textHeight  = 0U;
+
+        text[textLength] = '\0';
+        layout.setText(text);
+
+        /* Determine the width of every run and the area which is covered by its glyphs. */
+        for(runIndex = 0U; runIndex < layout.getRunCnt(); ++runIndex)
         {
-            uint32_t keywordIndex = 0U;
+            TextLayout::Run&    layoutRun   = layout.getRun(runIndex);
+            size_t              charIndex   = layoutRun.begin;
+            size_t              runEnd      = layoutRun.begin + layoutRun.length;
+            int16_t             posX        = 0;
 
-            for(keywordIndex = 0U; keywordIndex < UTIL_ARRAY_NUM(m_keywordHandlers); ++keywordIndex)
+            while(runEnd > charIndex)
             {
-                KeywordHandler  handler     = m_keywordHandlers[keywordIndex];
-                uint8_t         overstep    = 0U;
-                bool            status      = (this->*handler)(&gfx, &m_gfxText, false, formatStr.substring(index), isScrolling, overstep);
+                const GFXglyph* glyph = font.getGlyphByCodepoint(Utf8::decode(text, charIndex));
 
-                if (true == status)
+                if (nullptr != glyph)
                 {
-                    index += overstep;
-                    break;
+                    int16_t inkBegin    = posX + glyph->xOffset;
+                    int16_t inkEnd      = inkBegin + glyph->width;
+
+                    if ((0U == layoutRun.width) ||
+                        (layoutRun.inkBegin > inkBegin))
+                    {
+                        layoutRun.inkBegin = inkBegin;
+                    }
+
+                    if (layoutRun.inkEnd < inkEnd)
+                    {
+                        layoutRun.inkEnd = inkEnd;
+                    }
+
+                    posX            += glyph->xAdvance;
+                    layoutRun.width += glyph->xAdvance;
                 }
             }
 
-            if (UTIL_ARRAY_NUM(m_keywordHandlers) <= keywordIndex)
+            /* The alignment depends on the width of the remaining text. */
+            if ((TextLayout::ALIGNMENT_RIGHT == layoutRun.alignment) ||
+                (TextLayout::ALIGNMENT_CENTER == layoutRun.alignment))
             {
-                useChar = true;
+                if (true == m_gfxText.getTextBoundingBox(UINT16_MAX, &text[layoutRun.begin], textWidth, textHeight))
+                {
+                    layoutRun.restWidth = textWidth;
+                }
             }
-
-            escapeFound = false;
         }
-        else
+
+        /* Get bounding box of the text, without any format tags. */
+        if (true == m_gfxText.getTextBoundingBox(UINT16_MAX, text, textWidth, textHeight))
         {
-            useChar = true;
+            layout.setWidth(textWidth);
+            status = true;
         }
+    }
+
+    if (nullptr != text)
+    {
+        delete[] text;
+    }
+
+    return status;
+}
+
+String TextWidget::removeFormatTags(const String& formatStr) const
+{
+    TextLayout layout;
+
+    (void)createLayout(formatStr, layout);
+
+    return layout.getText();
+}
 
-        if (true == useChar)
+void TextWidget::show(YAGfx& gfx, const TextLayout& layout, const TextStrip& strip, bool isScrolling)
+{
+    const char* text            = layout.getText().c_str();
+    int16_t     canvasWidth     = static_cast<int16_t>(gfx.getWidth());
+    Color       textColorBackup = m_gfxText.getTextColor();
+    uint16_t    runIndex        = 0U;
+
+    /* A pre-rendered scrolling text is drawn at once. */
+    if ((true == isScrolling) &&
+        (true == strip.isAvailable()))
+    {
+        int16_t cursorX = m_gfxText.getTextCursorPosX();
+        int16_t cursorY = m_gfxText.getTextCursorPosY();
+
+        strip.draw(gfx, cursorX, cursorY, textColorBackup);
+        m_gfxText.setTextCursorPos(cursorX + static_cast<int16_t>(strip.getAdvance()), cursorY);
+    }
+    else
+    {
+        for(runIndex = 0U; runIndex < layout.getRunCnt(); ++runIndex)
         {
-            useChar = false;
+            const TextLayout::Run&  run = layout.getRun(runIndex);
+            int16_t                 posX;
 
-            m_gfxText.drawChar(gfx, formatStr[index]);
-            ++index;
+            /* The line break is in front of the run. */
+            if (true == run.isNewLine)
+            {
+                m_gfxText.drawChar(gfx, '\n');
+            }
+
+            posX = m_gfxText.getTextCursorPosX();
+
+            /* A aligned text is only possible if its not scrolling. */
+            if (false == isScrolling)
+            {
+                if (TextLayout::ALIGNMENT_RIGHT == run.alignment)
+                {
+                    posX = canvasWidth - static_cast<int16_t>(run.restWidth);
+                }
+                else if (TextLayout::ALIGNMENT_CENTER == run.alignment)
+                {
+                    posX += (canvasWidth - posX - static_cast<int16_t>(run.restWidth)) / 2;
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            /* Draw only the runs, which are visible on the canvas. */
+            if ((0 < (posX + run.inkEnd)) &&
+                (canvasWidth > (posX + run.inkBegin)))
+            {
+                size_t charIndex    = run.begin;
+                size_t runEnd       = run.begin + run.length;
+
+                if (true == run.isColorSet)
+                {
+                    m_gfxText.setTextColor(run.color);
+                }
+                else
+                {
+                    m_gfxText.setTextColor(textColorBackup);
+                }
+
+                m_gfxText.setTextCursorPos(posX, m_gfxText.getTextCursorPosY());
+
+                while(runEnd > charIndex)
+                {
+                    m_gfxText.drawCodepoint(gfx, Utf8::decode(text, charIndex));
+                }
+            }
+            else
+            {
+                m_gfxText.setTextCursorPos(posX + static_cast<int16_t>(run.width), m_gfxText.getTextCursorPosY());
+            }
         }
     }
 
@@ -448,27 +652,29 @@ void TextWidget::show(YAGfx& gfx, const String& formatStr, bool isScrolling)
     m_gfxText.setTextColor(textColorBackup);
 }
 
-bool TextWidget::handleColor(YAGfx* gfx, YAGfxText* gfxText, bool noAction, const String& formatStr, bool isScrolling, uint8_t& overstep) const
+bool TextWidget::handleColor(const char* formatStr, TextLayout::Run& run, uint8_t& overstep) const
 {
     bool status = false;
 
-    UTIL_NOT_USED(isScrolling);
-
     if ('#' == formatStr[0])
     {
         const uint8_t   RGB_HEX_LEN = 6U;
-        String          colorStr    = String("0x") + formatStr.substring(1, 1 + RGB_HEX_LEN);
+        char            colorStr[3U + RGB_HEX_LEN]  = "0x";
+        uint8_t         index       = 0U;
         uint32_t        colorRGB888 = 0U;
-        bool            convStatus  = Util::strToUInt32(colorStr, colorRGB888);
 
-        if (true == convStatus)
+        /* Take over up to 6 hex digits, the conversion will fail for the invalid ones. */
+        while((RGB_HEX_LEN > index) && ('\0' != formatStr[1U + index]))
         {
-            if ((false == noAction) &&
-                (nullptr != gfx) &&
-                (nullptr != gfxText))
-            {
-                gfxText->setTextColor(colorRGB888);
-            }
+            colorStr[2U + index] = formatStr[1U + index];
+            ++index;
+        }
+        colorStr[2U + index] = '\0';
+
+        if (true == Util::strToUInt32(String(colorStr), colorRGB888))
+        {
+            run.isColorSet  = true;
+            run.color       = colorRGB888;
 
             overstep    = 1U + RGB_HEX_LEN;
             status      = true;
@@ -478,58 +684,31 @@ bool TextWidget::handleColor(YAGfx* gfx, YAGfxText* gfxText, bool noAction, cons
     return status;
 }
 
-bool TextWidget::handleAlignment(YAGfx* gfx, YAGfxText* gfxText, bool noAction, const String& formatStr, bool isScrolling, uint8_t& overstep) const
+bool TextWidget::handleAlignment(const char* formatStr, TextLayout::Run& run, uint8_t& overstep) const
 {
     bool status                 = false;
     const uint8_t   KEYWORD_LEN = 6U;
 
     /* Alignment left? */
-    if (true == formatStr.startsWith("lalign"))
+    if (0 == strncmp(formatStr, "lalign", KEYWORD_LEN))
     {
-        overstep    = KEYWORD_LEN;
-        status      = true;
+        run.alignment   = TextLayout::ALIGNMENT_LEFT;
+        overstep        = KEYWORD_LEN;
+        status          = true;
     }
     /* Alignment right? */
-    else if (true == formatStr.startsWith("ralign"))
+    else if (0 == strncmp(formatStr, "ralign", KEYWORD_LEN))
     {
-        if ((false == noAction) &&
-            (nullptr != gfx) &&
-            (nullptr != gfxText) &&
-            (false == isScrolling))
-        {
-            String      text        = removeFormatTags(formatStr.substring(KEYWORD_LEN));
-            uint16_t    textWidth   = 0U;
-            uint16_t    textHeight  = 0U;
-
-            if (true == gfxText->getTextBoundingBox(gfx->getWidth(), text.c_str(), textWidth, textHeight))
-            {
-                gfxText->setTextCursorPos(gfx->getWidth() - textWidth, gfxText->getTextCursorPosY());
-            }
-        }
-
-        overstep    = KEYWORD_LEN;
-        status      = true;
+        run.alignment   = TextLayout::ALIGNMENT_RIGHT;
+        overstep        = KEYWORD_LEN;
+        status          = true;
     }
     /* Alignment center? */
-    else if (true == formatStr.startsWith("calign"))
+    else if (0 == strncmp(formatStr, "calign", KEYWORD_LEN))
     {
-        if ((false == noAction) &&
-            (nullptr != gfx) &&
-            (nullptr != gfxText) &&
-            (false == isScrolling))
-        {
-            String      text        = removeFormatTags(formatStr.substring(KEYWORD_LEN));
-            uint16_t    textWidth   = 0U;
-            uint16_t    textHeight  = 0U;
-
-            if (true == gfxText->getTextBoundingBox(gfx->getWidth(), text.c_str(), textWidth, textHeight))
-            {
-                gfxText->setTextCursorPos(gfxText->getTextCursorPosX() + (gfx->getWidth() - gfxText->getTextCursorPosX() - textWidth) / 2, gfxText->getTextCursorPosY());
-            }
-        }
-
-        overstep    = KEYWORD_LEN;
-        status      = true;
+        run.alignment   = TextLayout::ALIGNMENT_CENTER;
+        overstep        = KEYWORD_LEN;
+        status          = true;
     }
     else
     {
@@ -50,6 +50,8 @@
 #include <YAFont.h>
 #include <YAGfxText.h>
 #include <SimpleTimer.hpp>
+#include "TextLayout.h"
+#include "TextStrip.h"
 
 /******************************************************************************
  * Macros
@@ -72,6 +74,14 @@
  * - "\\lalign" : Alignment left
  * - "\\ralign" : Alignment right
  * - "\\calign" : Alignment center
+ *
+ * The format string is parsed only once into a text layout, which is kept
+ * until the text or the font changes.
+ *
+ * Optional a scrolling text can be pre-rendered into a text strip. Then every
+ * frame just copies the visible window of the strip, instead of drawing
+ * every glyph again. Texts with several lines or which are too long, are
+ * still drawn character by character.
  */
 class TextWidget : public Widget
 {
@@ -92,7 +102,12 @@ public:
         m_gfxText(DEFAULT_FONT, DEFAULT_TEXT_COLOR),
         m_scrollingCnt(0U),
         m_scrollOffset(0),
-        m_scrollTimer()
+        m_scrollTimer(),
+        m_layout(),
+        m_layoutNew(),
+        m_isPreRenderingEnabled(false),
+        m_strip(),
+        m_stripNew()
     {
     }
 
@@ -115,8 +130,14 @@ public:
         m_gfxText(DEFAULT_FONT, DEFAULT_TEXT_COLOR),
         m_scrollingCnt(0U),
         m_scrollOffset(0),
-        m_scrollTimer()
+        m_scrollTimer(),
+        m_layout(),
+        m_layoutNew(),
+        m_isPreRenderingEnabled(false),
+        m_strip(),
+        m_stripNew()
     {
+        (void)createLayout(m_formatStr, m_layout);
     }
 
     /**
@@ -136,7 +157,12 @@ public:
         m_gfxText(widget.m_gfxText),
         m_scrollingCnt(widget.m_scrollingCnt),
         m_scrollOffset(widget.m_scrollOffset),
-        m_scrollTimer(widget.m_scrollTimer)
+        m_scrollTimer(widget.m_scrollTimer),
+        m_layout(widget.m_layout),
+        m_layoutNew(widget.m_layoutNew),
+        m_isPreRenderingEnabled(widget.m_isPreRenderingEnabled),
+        m_strip(widget.m_strip),
+        m_stripNew(widget.m_stripNew)
     {
     }
 
@@ -169,6 +195,11 @@ public:
             m_scrollingCnt          = widget.m_scrollingCnt;
             m_scrollOffset          = widget.m_scrollOffset;
             m_scrollTimer           = widget.m_scrollTimer;
+            m_layout                = widget.m_layout;
+            m_layoutNew             = widget.m_layoutNew;
+            m_isPreRenderingEnabled = widget.m_isPreRenderingEnabled;
+            m_strip                 = widget.m_strip;
+            m_stripNew              = widget.m_stripNew;
         }
 
         return *this;
@@ -203,6 +234,8 @@ public:
             {
                 m_formatStrTmp = formatStr;
             }
+
+            invalidate();
         }
 
         m_scrollingCnt = 0U;
@@ -225,6 +258,13 @@ public:
         m_scrollInfo.offsetDest = 0;
         m_scrollInfo.stopAtDest = false;
         m_scrollInfo.textWidth  = 0U;
+
+        m_layout.clear();
+        m_layoutNew.clear();
+        m_strip.release();
+        m_stripNew.release();
+
+        invalidate();
     }
 
     /**
@@ -255,6 +295,7 @@ public:
     void setTextColor(const Color& color)
     {
         m_gfxText.setTextColor(color);
+        invalidate();
         return;
     }
 
@@ -276,7 +317,10 @@ public:
     void setFont(const YAFont& font)
     {
         m_gfxText.setFont(font);
+        (void)createLayout(m_formatStr, m_layout);
+        m_strip.release();
         m_isNewTextAvailable = true;
+        invalidate();
     }
 
     /**
@@ -289,6 +333,38 @@ public:
         return m_gfxText.getFont();
     }
 
+    /**
+     * Enable or disable the pre-rendering of scrolling texts.
+     * A pre-rendered text needs additional memory, but drawing it
+     * is much cheaper.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false) it.
+     */
+    void setPreRendering(bool isEnabled);
+
+    /**
+     * Is the pre-rendering of scrolling texts enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isPreRenderingEnabled() const
+    {
+        return m_isPreRenderingEnabled;
+    }
+
+    /**
+     * Is the widget dirty and needs to be repainted?
+     * A scrolling text is dirty, if it shall be moved.
+     *
+     * @return If the widget is dirty, it will return true otherwise false.
+     */
+    bool isDirty() override
+    {
+        return (true == Widget::isDirty()) ||
+               (true == m_isNewTextAvailable) ||
+               (true == m_scrollTimer.isTimeout());
+    }
+
     /**
      * Change scroll speed of all text widgets by changing the pause between each movement.
      *
@@ -354,7 +430,7 @@ public:
 private:
 
     /** Keyword handler method. */
-    typedef bool (TextWidget::*KeywordHandler)(YAGfx* gfx, YAGfxText* gfxText, bool noAction, const String& formatStr, bool isScrolling, uint8_t& overstep) const;
+    typedef bool (TextWidget::*KeywordHandler)(const char* formatStr, TextLayout::Run& run, uint8_t& overstep) const;
 
     /**
      * Scroll information, used per text.
@@ -391,6 +467,11 @@ private:
     uint32_t        m_scrollingCnt;         /**< Counts how often a text was complete scrolled. */
     int16_t         m_scrollOffset;         /**< Pixel offset of cursor x position, used for scrolling. */
     SimpleTimer     m_scrollTimer;          /**< Timer, used for scrolling */
+    TextLayout      m_layout;               /**< Layout of the current shown text. */
+    TextLayout      m_layoutNew;            /**< Layout of the new text. */
+    bool            m_isPreRenderingEnabled;/**< Is pre-rendering of scrolling texts enabled? */
+    TextStrip       m_strip;                /**< Pre-rendered current text, only if scrolling. */
+    TextStrip       m_stripNew;             /**< Pre-rendered new text, only if scrolling. */
 
     static KeywordHandler   m_keywordHandlers[];    /**< List of all supported keyword handlers. */
     static uint32_t         m_scrollPause;          /**< Pause in ms, between each scroll movement. */
@@ -409,6 +490,16 @@ private:
      */
     void paint(YAGfx& gfx) override;
 
+    /**
+     * Parse the format string into a text layout.
+     *
+     * @param[in]   formatStr   String which contains format tags
+     * @param[out]  layout      Text layout
+     *
+     * @return If the layout is complete, it will return true otherwise false.
+     */
+    bool createLayout(const String& formatStr, TextLayout& layout) const;
+
     /**
      * Remove format tags from string.
      *
@@ -419,39 +510,38 @@ private:
     String removeFormatTags(const String& formatStr) const;
 
     /**
-     * Show formatted text.
-     * Format tags:
-     * - #RRGGBB Color in HTML form (RGB888)
+     * Show the text of a layout at the current text cursor position.
+     * Only the runs, which intersect the canvas are drawn. A scrolling text
+     * is drawn from the pre-rendered strip, if available.
      *
      * @param[in] gfx           Graphics, used to draw the characters
-     * @param[in] formatStr     String which contains format tags
+     * @param[in] layout        Text layout
+     * @param[in] strip         Pre-rendered text
      * @param[in] isScrolling   Is text scrolling or not.
      */
-    void show(YAGfx& gfx, const String& formatStr, bool isScrolling);
+    void show(YAGfx& gfx, const TextLayout& layout, const TextStrip& strip, bool isScrolling);
 
     /**
      * Handles the keyword for color changes.
      *
-     * @param[in] gfx       Graphics interface, only necessary if actions shall take place.
-     * @param[in] noAction  The handler shall take no action. This is only used to get rid of the keywords in the text.
-     * @param[in] formatStr String which may contain keywords.
-     * @param[out] overstep Number of characters, which must be overstepped before the next normal character comes.
+     * @param[in]   formatStr   String which may start with the keyword.
+     * @param[out]  run         Run, which gets the text color.
+     * @param[out]  overstep    Number of characters, which must be overstepped before the next normal character comes.
      *
      * @return If keyword is handled successful, it returns true otherwise false.
      */
-    bool handleColor(YAGfx* gfx, YAGfxText* gfxText, bool noAction, const String& formatStr, bool isScrolling, uint8_t& overstep) const;
+    bool handleColor(const char* formatStr, TextLayout::Run& run, uint8_t& overstep) const;
 
     /**
      * Handles the keyword for alignment changes.
      *
-     * @param[in] gfx       Graphics interface, only necessary if actions shall take place.
-     * @param[in] noAction  The handler shall take no action. This is only used to get rid of the keywords in the text.
-     * @param[in] formatStr String which may contain keywords.
-     * @param[out] overstep Number of characters, which must be overstepped before the next normal character comes.
+     * @param[in]   formatStr   String which may start with the keyword.
+     * @param[out]  run         Run, which gets the alignment.
+     * @param[out]  overstep    Number of characters, which must be overstepped before the next normal character comes.
      *
      * @return If keyword is handled successful, it returns true otherwise false.
      */
-    bool handleAlignment(YAGfx* gfx, YAGfxText* gfxText, bool noAction, const String& formatStr, bool isScrolling, uint8_t& overstep) const;
+    bool handleAlignment(const char* formatStr, TextLayout::Run& run, uint8_t& overstep) const;
 };
 
 /******************************************************************************
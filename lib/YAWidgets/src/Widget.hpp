@@ -58,6 +58,10 @@
 /**
  * Base widget, which contains the position
  * inside a canvas and declares the graphics interface.
+ * 
+ * Every widget tracks whether it needs to be repainted (dirty). It becomes
+ * dirty, if its content or position changes and clean again by update().
+ * A widget group uses it to repaint only, if one of its widgets is dirty.
  */
 class Widget
 {
@@ -87,6 +91,7 @@ public:
             m_posY      = widget.m_posY;
             /* m_name is not assigned! */
             m_isEnabled = widget.m_isEnabled;
+            m_isDirty   = true;
         }
 
         return *this;
@@ -100,8 +105,14 @@ public:
      */
     void move(int16_t x, int16_t y)
     {
-        m_posX = x;
-        m_posY = y;
+        if ((m_posX != x) ||
+            (m_posY != y))
+        {
+            m_posX = x;
+            m_posY = y;
+
+            invalidate();
+        }
     }
 
     /**
@@ -124,12 +135,37 @@ public:
      */
     void update(YAGfx& gfx)
     {
+        /* The widget is clean before painting, which allows an animated
+         * widget to invalidate itself during painting again.
+         */
+        m_isDirty = false;
+
         if (true == m_isEnabled)
         {
             paint(gfx);
         }
     }
 
+    /**
+     * Mark the widget as dirty, which means it needs to be repainted.
+     */
+    void invalidate()
+    {
+        m_isDirty = true;
+    }
+
+    /**
+     * Is the widget dirty and needs to be repainted?
+     * Note, it must be overriden by the inherited widget, if it changes
+     * without any method call, e.g. by a timer.
+     * 
+     * @return If the widget is dirty, it will return true otherwise false.
+     */
+    virtual bool isDirty()
+    {
+        return m_isDirty;
+    }
+
     /**
      * Get widget type as string.
      * 
@@ -177,7 +213,11 @@ public:
      */
     void enable()
     {
-        m_isEnabled = true;
+        if (false == m_isEnabled)
+        {
+            m_isEnabled = true;
+            invalidate();
+        }
     }
 
     /**
@@ -186,7 +226,11 @@ public:
      */
     void disable()
     {
-        m_isEnabled = false;
+        if (true == m_isEnabled)
+        {
+            m_isEnabled = false;
+            invalidate();
+        }
     }
 
     /**
@@ -217,6 +261,7 @@ protected:
     int16_t     m_posY;         /**< Upper left corner (y-coordinate) of the widget in a canvas. */
     String      m_name;         /**< Widget name for identification. */
     bool        m_isEnabled;    /**< If widget is enabled, it will be drawn otherwise not. */
+    bool        m_isDirty;      /**< If widget is dirty, it needs to be repainted. */
 
     /**
      * Constructs a widget at position (0, 0) in the canvas.
@@ -228,7 +273,8 @@ protected:
         m_posX(0),
         m_posY(0),
         m_name(),
-        m_isEnabled(true)
+        m_isEnabled(true),
+        m_isDirty(true)
     {
     }
 
@@ -244,7 +290,8 @@ protected:
         m_posX(x),
         m_posY(y),
         m_name(),
-        m_isEnabled(true)
+        m_isEnabled(true),
+        m_isDirty(true)
     {
     }
 
@@ -259,7 +306,8 @@ protected:
         m_posX(widget.m_posX),
         m_posY(widget.m_posY),
         m_name(),
-        m_isEnabled(widget.m_isEnabled)
+        m_isEnabled(widget.m_isEnabled),
+        m_isDirty(true)
     {
     }
 
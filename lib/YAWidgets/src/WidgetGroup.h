@@ -47,6 +47,7 @@
 #include <WString.h>
 #include <LinkedList.hpp>
 #include <Widget.hpp>
+#include <ColorDef.hpp>
 
 /******************************************************************************
  * Macros
@@ -58,6 +59,10 @@
 
 /**
  * This class defines a widget group and can contain several widgets.
+ * 
+ * In retained mode, see refresh(), the group is only repainted if the group
+ * itself or one of its widgets is dirty. Because widgets may overlap, the
+ * whole group is cleared and all its widgets are repainted in this case.
  */
 class WidgetGroup : public Widget, private YAGfx
 {
@@ -76,7 +81,8 @@ public:
         m_width(width),
         m_height(height),
         m_widgets(),
-        m_gfx(nullptr)
+        m_gfx(nullptr),
+        m_backgroundColor(ColorDef::BLACK)
     {
     }
 
@@ -90,7 +96,8 @@ public:
         m_width(group.m_width),
         m_height(group.m_height),
         m_widgets(group.m_widgets),
-        m_gfx(group.m_gfx)
+        m_gfx(group.m_gfx),
+        m_backgroundColor(group.m_backgroundColor)
     {
     }
 
@@ -116,8 +123,9 @@ public:
 
             m_width     = group.m_width;
             m_height    = group.m_height;
-            m_widgets   = group.m_widgets;
-            m_gfx       = group.m_gfx;
+            m_widgets           = group.m_widgets;
+            m_gfx               = group.m_gfx;
+            m_backgroundColor   = group.m_backgroundColor;
         }
 
         return *this;
@@ -197,6 +205,7 @@ public:
     void setWidth(uint16_t width)
     {
         m_width = width;
+        invalidate();
     }
 
     /**
@@ -207,6 +216,7 @@ public:
     void setHeight(uint16_t height)
     {
         m_height = height;
+        invalidate();
     }
 
     /**
@@ -223,6 +233,31 @@ public:
         m_posY      = offsY;
         m_width     = width;
         m_height    = height;
+
+        invalidate();
+    }
+
+    /**
+     * Get the background color, which is used to clear the group in
+     * retained mode.
+     * 
+     * @return Background color
+     */
+    const Color& getBackgroundColor() const
+    {
+        return m_backgroundColor;
+    }
+
+    /**
+     * Set the background color, which is used to clear the group in
+     * retained mode.
+     * 
+     * @param[in] color Background color
+     */
+    void setBackgroundColor(const Color& color)
+    {
+        m_backgroundColor = color;
+        invalidate();
     }
 
     /**
@@ -235,6 +270,9 @@ public:
     bool addWidget(Widget& widget)
     {
         Widget* ptr = &widget;
+
+        invalidate();
+
         return m_widgets.append(ptr);
     }
 
@@ -256,6 +294,8 @@ public:
             /* Remove widget */
             it.remove();
             status = true;
+
+            invalidate();
         }
 
         return status;
@@ -306,15 +346,67 @@ public:
         return widget;
     }
 
+    /**
+     * Is the group or one of its widgets dirty and needs to be repainted?
+     *
+     * @return If dirty, it will return true otherwise false.
+     */
+    bool isDirty() override
+    {
+        bool isDirty = Widget::isDirty();
+
+        if (false == isDirty)
+        {
+            DLinkedListIterator<Widget*> it(m_widgets);
+
+            if (true == it.first())
+            {
+                do
+                {
+                    isDirty = (*it.current())->isDirty();
+                }
+                while(  (false == isDirty) &&
+                        (true == it.next()));
+            }
+        }
+
+        return isDirty;
+    }
+
+    /**
+     * Update the group in retained mode. Only if the group is dirty, its
+     * area will be cleared with the background color and all of its
+     * widgets are repainted. Otherwise the canvas is kept as it is.
+     *
+     * @param[in] gfx   Graphics interface
+     *
+     * @return If the group was repainted, it will return true otherwise false.
+     */
+    bool refresh(YAGfx& gfx)
+    {
+        bool isRepainted = false;
+
+        if (true == isDirty())
+        {
+            gfx.fillRect(m_posX, m_posY, m_width, m_height, m_backgroundColor);
+            update(gfx);
+
+            isRepainted = true;
+        }
+
+        return isRepainted;
+    }
+
     /** Widget type string */
     static const char*      WIDGET_TYPE;
 
 private:
 
-    uint16_t                m_width;    /**< Canvas width in pixels */
-    uint16_t                m_height;   /**< Canvas height in pixels */
-    DLinkedList<Widget*>    m_widgets;  /**< Widgets in the group */
-    YAGfx*                  m_gfx;      /**< Graphics interface of the underlying layer */
+    uint16_t                m_width;            /**< Canvas width in pixels */
+    uint16_t                m_height;           /**< Canvas height in pixels */
+    DLinkedList<Widget*>    m_widgets;          /**< Widgets in the group */
+    YAGfx*                  m_gfx;              /**< Graphics interface of the underlying layer */
+    Color                   m_backgroundColor;  /**< Background color, used to clear the group in retained mode. */
 
     /**
      * Paint the widget with the given graphics interface.
@@ -0,0 +1,285 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  FFT backend benchmarks of the spectrum analyzer.
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The arduinoFFT float calculation is the reference, which the fixed-point
+ * FFT is compared against.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <math.h>
+#include <arduinoFFT.h>
+#include <RealFftQ15.hpp>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void generateSamples(int32_t* samples, float amplitude);
+static void calculateReference(const int32_t* samples, float* magnitudes);
+static void testAccuracy();
+static void benchmarkReference();
+static void benchmarkQ15();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME          = "AudioFft";
+
+/** Number of samples, same as the audio driver provides. */
+static const uint32_t   SAMPLES             = 512U;
+
+/** Number of frequency bins. */
+static const uint32_t   FREQ_BINS           = SAMPLES / 2U;
+
+/** Sample rate in Hz, same as the audio driver uses. */
+static const float      SAMPLE_RATE         = 14080.0F;
+
+/** Amplitude of a loud signal, about 94 dB SPL of the INMP441. */
+static const float      AMPLITUDE_LOUD      = 420426.0F;
+
+/** Amplitude of a quiet signal. */
+static const float      AMPLITUDE_QUIET     = 4204.0F;
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS          = 1000U;
+
+/** Real values of the reference calculation. */
+static float            gReal[SAMPLES];
+
+/** Imaginary values of the reference calculation. */
+static float            gImag[SAMPLES];
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testAccuracy);
+    RUN_TEST(benchmarkReference);
+    RUN_TEST(benchmarkQ15);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Generate the samples of a 1000 Hz tone, a 4000 Hz tone with a tenth of
+ * its amplitude and a little bit noise.
+ *
+ * @param[out]  samples     Sample buffer
+ * @param[in]   amplitude   Amplitude of the 1000 Hz tone
+ */
+static void generateSamples(int32_t* samples, float amplitude)
+{
+    const float TWO_PI  = 6.2831853F;
+    uint32_t    noise   = 0x2545F491U;
+    uint32_t    idx     = 0U;
+
+    for(idx = 0U; idx < SAMPLES; ++idx)
+    {
+        float value = amplitude * sinf(TWO_PI * 1000.0F * idx / SAMPLE_RATE) +
+                      amplitude * 0.1F * sinf(TWO_PI * 4000.0F * idx / SAMPLE_RATE);
+
+        noise ^= noise << 13U;
+        noise ^= noise >> 17U;
+        noise ^= noise << 5U;
+
+        value += amplitude * 0.001F * (static_cast<float>(noise & 0xffffU) / 32768.0F - 1.0F);
+
+        samples[idx] = static_cast<int32_t>(value);
+    }
+}
+
+/**
+ * Calculate the amplitude spectrum the same way as the spectrum analyzer
+ * with the arduinoFFT backend.
+ *
+ * @param[in]   samples     Sample buffer
+ * @param[out]  magnitudes  Linear amplitude of every frequency bin
+ */
+static void calculateReference(const int32_t* samples, float* magnitudes)
+{
+    ArduinoFFT<float>   fft(gReal, gImag, SAMPLES, SAMPLE_RATE);
+    uint32_t            idx = 0U;
+
+    for(idx = 0U; idx < SAMPLES; ++idx)
+    {
+        gReal[idx] = static_cast<float>(samples[idx]);
+        gImag[idx] = 0.0F;
+    }
+
+    fft.windowing(FFTWindow::Hamming, FFTDirection::Forward);
+    fft.compute(FFTDirection::Forward);
+    fft.complexToMagnitude();
+
+    for(idx = 1U; idx < FREQ_BINS; ++idx)
+    {
+        magnitudes[idx] = gReal[idx] * 2.0F / (SAMPLES * 0.54F);
+    }
+
+    magnitudes[0] = gReal[0] / (SAMPLES * 0.54F);
+}
+
+/**
+ * Compare the fixed-point FFT against the reference for a loud and a quiet
+ * signal. The error of every bin shall be small in relation to the peak.
+ */
+static void testAccuracy()
+{
+    static RealFftQ15<SAMPLES>  fft;
+    const float                 AMPLITUDES[]    = { AMPLITUDE_LOUD, AMPLITUDE_QUIET };
+    int32_t                     samples[SAMPLES];
+    float                       reference[FREQ_BINS];
+    float                       magnitudes[FREQ_BINS];
+    uint32_t                    amplitudeIdx    = 0U;
+
+    for(amplitudeIdx = 0U; amplitudeIdx < UTIL_ARRAY_NUM(AMPLITUDES); ++amplitudeIdx)
+    {
+        const float amplitude   = AMPLITUDES[amplitudeIdx];
+        uint32_t    peakIdx     = 0U;
+        uint32_t    idx         = 0U;
+
+        generateSamples(samples, amplitude);
+        calculateReference(samples, reference);
+        fft.calculate(samples, magnitudes);
+
+        for(idx = 1U; idx < FREQ_BINS; ++idx)
+        {
+            if (reference[peakIdx] < reference[idx])
+            {
+                peakIdx = idx;
+            }
+
+            TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.002F, reference[idx], magnitudes[idx]);
+        }
+
+        /* The 1000 Hz tone is in bin 36 and its amplitude is measured nearly correct. */
+        TEST_ASSERT_EQUAL_UINT32(36U, peakIdx);
+        TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.2F, amplitude, magnitudes[peakIdx]);
+    }
+}
+
+/**
+ * Benchmark the arduinoFFT float reference.
+ */
+static void benchmarkReference()
+{
+    static int32_t  samples[SAMPLES];
+    static float    magnitudes[FREQ_BINS];
+
+    generateSamples(samples, AMPLITUDE_LOUD);
+
+    (void)Benchmark::run(SUITE_NAME, "arduinoFFT float 512", ITERATIONS,
+        []() {
+            calculateReference(samples, magnitudes);
+        }
+    );
+}
+
+/**
+ * Benchmark the fixed-point FFT.
+ */
+static void benchmarkQ15()
+{
+    static RealFftQ15<SAMPLES>  fft;
+    static int32_t              samples[SAMPLES];
+    static float                magnitudes[FREQ_BINS];
+
+    generateSamples(samples, AMPLITUDE_LOUD);
+
+    (void)Benchmark::run(SUITE_NAME, "RealFftQ15 512", ITERATIONS,
+        []() {
+            fft.calculate(samples, magnitudes);
+        }
+    );
+}
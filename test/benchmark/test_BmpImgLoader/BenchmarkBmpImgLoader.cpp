@@ -0,0 +1,333 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the bitmap image loader.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <FS.h>
+#include <BmpImgLoader.h>
+#include <ImageCache.h>
+#include <NativeImg.h>
+#include <GifDecoder.h>
+#include <SpriteSheet.h>
+#include <YAGfxBitmap.h>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+#include "../../common/BmpFile.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t getGradientColor(uint16_t x, uint16_t y);
+static void benchmarkBmpImgLoader(const char* name, uint16_t width, uint16_t height);
+static void benchmarkLoadIcon();
+static void benchmarkLoadSpriteSheet();
+static void benchmarkLoadLargeImage();
+static void benchmarkLoadCachedSpriteSheet();
+static void benchmarkLoadNativeSpriteSheet();
+static void benchmarkLoadGif();
+static void benchmarkGifNextFrame();
+static void benchmarkSpriteSheetNextFrame();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME          = "BmpImgLoader";
+
+/** Name of the temporary generated bitmap file. */
+static const char*      BMP_FILE_NAME       = "./benchmarkBmpImgLoader.bmp";
+
+/** GIF image with 128x64 pixels of noise. */
+static const char*      GIF_FILE_NAME_LARGE = "./test/test_GifDecoder/testLarge.gif";
+
+/** GIF animation with 4x4 pixels, which is repeated infinite. */
+static const char*      GIF_FILE_NAME_ANIM  = "./test/test_GifDecoder/testAnim.gif";
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS          = 20U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(benchmarkLoadIcon);
+    RUN_TEST(benchmarkLoadSpriteSheet);
+    RUN_TEST(benchmarkLoadLargeImage);
+    RUN_TEST(benchmarkLoadCachedSpriteSheet);
+    RUN_TEST(benchmarkLoadNativeSpriteSheet);
+    RUN_TEST(benchmarkLoadGif);
+    RUN_TEST(benchmarkGifNextFrame);
+    RUN_TEST(benchmarkSpriteSheetNextFrame);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(BMP_FILE_NAME);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the color of a gradient image.
+ *
+ * @param[in] x x-coordinate
+ * @param[in] y y-coordinate
+ *
+ * @return Color in RGB24 format
+ */
+static uint32_t getGradientColor(uint16_t x, uint16_t y)
+{
+    return 0x800000U | (static_cast<uint32_t>(y & 0xFFU) << 8U) | static_cast<uint32_t>(x & 0xFFU);
+}
+
+/**
+ * Benchmark loading a bitmap image with the given size.
+ *
+ * @param[in] name      Benchmark name
+ * @param[in] width     Image width in pixels
+ * @param[in] height    Image height in pixels
+ */
+static void benchmarkBmpImgLoader(const char* name, uint16_t width, uint16_t height)
+{
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  bitmap;
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+
+    TEST_ASSERT_TRUE(BmpFile::create(BMP_FILE_NAME, width, height, getGradientColor));
+
+    (void)Benchmark::run(SUITE_NAME, name, ITERATIONS,
+        [&loader, &bitmap, &localFileSystem, &ret]() {
+            ret = loader.load(localFileSystem, BMP_FILE_NAME, bitmap);
+        }
+    );
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT16(width, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(height, bitmap.getHeight());
+
+    /* The bottom-up rows of the file are in top-down order in the bitmap. */
+    TEST_ASSERT_EQUAL_UINT32(getGradientColor(0U, 0U), bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(getGradientColor(width - 1U, height - 1U), bitmap.getColor(width - 1, height - 1));
+}
+
+/**
+ * Benchmark loading a single icon.
+ */
+static void benchmarkLoadIcon()
+{
+    benchmarkBmpImgLoader("load 8x8 24bpp", 8U, 8U);
+}
+
+/**
+ * Benchmark loading a sprite sheet.
+ */
+static void benchmarkLoadSpriteSheet()
+{
+    benchmarkBmpImgLoader("load 64x64 24bpp", 64U, 64U);
+}
+
+/**
+ * Benchmark loading a large image.
+ */
+static void benchmarkLoadLargeImage()
+{
+    benchmarkBmpImgLoader("load 256x128 24bpp", 256U, 128U);
+}
+
+/**
+ * Benchmark loading a sprite sheet, which is already in the image cache.
+ */
+static void benchmarkLoadCachedSpriteSheet()
+{
+    ImageCache&         cache   = ImageCache::getInstance();
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+    ImageCache::Handle  handle;
+
+    TEST_ASSERT_TRUE(BmpFile::create(BMP_FILE_NAME, 64U, 64U, getGradientColor));
+
+    (void)Benchmark::run(SUITE_NAME, "load 64x64 24bpp cached", ITERATIONS,
+        [&cache, &localFileSystem, &ret, &handle]() {
+            handle = cache.load(localFileSystem, BMP_FILE_NAME, ret);
+        }
+    );
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+
+    handle.release();
+    cache.clear();
+}
+
+/**
+ * Benchmark loading a sprite sheet, which was transcoded to a native image.
+ */
+static void benchmarkLoadNativeSpriteSheet()
+{
+    NativeImg           nativeImg;
+    YAGfxDynamicBitmap  bitmap;
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+
+    TEST_ASSERT_TRUE(BmpFile::create(BMP_FILE_NAME, 64U, 64U, getGradientColor));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.transcode(localFileSystem, BMP_FILE_NAME));
+
+    (void)Benchmark::run(SUITE_NAME, "load 64x64 native", ITERATIONS,
+        [&nativeImg, &bitmap, &localFileSystem, &ret]() {
+            ret = nativeImg.load(localFileSystem, BMP_FILE_NAME, bitmap);
+        }
+    );
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT32(getGradientColor(0U, 0U), bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(getGradientColor(63U, 63U), bitmap.getColor(63, 63));
+}
+
+/**
+ * Benchmark opening a GIF image, which decodes the first frame.
+ */
+static void benchmarkLoadGif()
+{
+    GifDecoder          decoder;
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+
+    (void)Benchmark::run(SUITE_NAME, "load 128x64 gif", ITERATIONS,
+        [&decoder, &localFileSystem, &ret]() {
+            ret = decoder.open(localFileSystem, GIF_FILE_NAME_LARGE);
+        }
+    );
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+}
+
+/**
+ * Benchmark decoding the frames of a GIF animation. The frames are streamed,
+ * so no memory is allocated per frame.
+ */
+static void benchmarkGifNextFrame()
+{
+    GifDecoder          decoder;
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret = BmpImgLoader::RET_OK;
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.open(localFileSystem, GIF_FILE_NAME_ANIM));
+
+    (void)Benchmark::run(SUITE_NAME, "gif next frame 4x4", ITERATIONS,
+        [&decoder, &ret]() {
+            ret = decoder.next();
+        }
+    );
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_FALSE(decoder.isFinished());
+}
+
+/**
+ * Benchmark moving a sprite sheet animation to the next frame, which decodes
+ * the frame from the compressed texture. Every pixel of the gradient has its
+ * own color, which is the worst case for the compression.
+ */
+static void benchmarkSpriteSheetNextFrame()
+{
+    SpriteSheet spriteSheet;
+    FS          localFileSystem;
+
+    TEST_ASSERT_TRUE(BmpFile::create(BMP_FILE_NAME, 64U, 64U, getGradientColor));
+    TEST_ASSERT_TRUE(spriteSheet.loadTexture(localFileSystem, BMP_FILE_NAME, 8U, 8U));
+
+    (void)Benchmark::run(SUITE_NAME, "sprite sheet next frame 8x8", ITERATIONS,
+        [&spriteSheet]() {
+            spriteSheet.next();
+        }
+    );
+
+    TEST_ASSERT_EQUAL_UINT16(8U, spriteSheet.getFrameWidth());
+}
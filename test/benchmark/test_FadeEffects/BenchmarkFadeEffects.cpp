@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the fade effects.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <YAGfxBitmap.h>
+#include <FadeLinear.h>
+#include <FadeMoveX.h>
+#include <FadeMoveY.h>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void benchmarkFadeEffect(const char* name, IFadeEffect& fadeEffect);
+static void benchmarkFadeLinear();
+static void benchmarkFadeMoveX();
+static void benchmarkFadeMoveY();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME  = "FadeEffects";
+
+/** Display width in pixels, which represents a large matrix. */
+static const uint16_t   WIDTH       = 64U;
+
+/** Display height in pixels, which represents a large matrix. */
+static const uint16_t   HEIGHT      = 64U;
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS  = 20U;
+
+/**
+ * Max. number of fade steps per fade in or fade out. Used as safeguard
+ * against an effect which never finishes.
+ */
+static const uint32_t   MAX_STEPS   = 1000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(benchmarkFadeLinear);
+    RUN_TEST(benchmarkFadeMoveX);
+    RUN_TEST(benchmarkFadeMoveY);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Benchmark a complete fade out and a complete fade in of the given effect.
+ * One operation is the whole fade sequence, not a single fade step.
+ *
+ * @param[in] name          Benchmark name
+ * @param[in] fadeEffect    Fade effect, which to measure.
+ */
+static void benchmarkFadeEffect(const char* name, IFadeEffect& fadeEffect)
+{
+    YAGfxDynamicBitmap  display(WIDTH, HEIGHT);
+    YAGfxDynamicBitmap  prev(WIDTH, HEIGHT);
+    YAGfxDynamicBitmap  next(WIDTH, HEIGHT);
+    uint32_t            steps   = 0U;
+    String              benchmarkName;
+
+    TEST_ASSERT_TRUE(display.isAllocated());
+    TEST_ASSERT_TRUE(prev.isAllocated());
+    TEST_ASSERT_TRUE(next.isAllocated());
+
+    prev.fillScreen(ColorDef::RED);
+    next.fillScreen(ColorDef::BLUE);
+
+    fadeEffect.init();
+
+    benchmarkName = name;
+    benchmarkName += " fadeOut";
+
+    (void)Benchmark::run(SUITE_NAME, benchmarkName.c_str(), ITERATIONS,
+        [&display, &prev, &next, &fadeEffect, &steps]() {
+            uint32_t step = 0U;
+
+            while((MAX_STEPS > step) && (false == fadeEffect.fadeOut(display, prev, next)))
+            {
+                ++step;
+            }
+
+            steps = step;
+        }
+    );
+    TEST_ASSERT_LESS_THAN(MAX_STEPS, steps);
+
+    benchmarkName = name;
+    benchmarkName += " fadeIn";
+
+    (void)Benchmark::run(SUITE_NAME, benchmarkName.c_str(), ITERATIONS,
+        [&display, &prev, &next, &fadeEffect, &steps]() {
+            uint32_t step = 0U;
+
+            while((MAX_STEPS > step) && (false == fadeEffect.fadeIn(display, prev, next)))
+            {
+                ++step;
+            }
+
+            steps = step;
+        }
+    );
+    TEST_ASSERT_LESS_THAN(MAX_STEPS, steps);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, display.getColor(0, 0));
+}
+
+/**
+ * Benchmark the linear fade effect.
+ */
+static void benchmarkFadeLinear()
+{
+    FadeLinear fadeEffect;
+
+    benchmarkFadeEffect("FadeLinear", fadeEffect);
+}
+
+/**
+ * Benchmark the fade effect, which moves along the x-axis.
+ */
+static void benchmarkFadeMoveX()
+{
+    FadeMoveX fadeEffect;
+
+    benchmarkFadeEffect("FadeMoveX", fadeEffect);
+}
+
+/**
+ * Benchmark the fade effect, which moves along the y-axis.
+ */
+static void benchmarkFadeMoveY()
+{
+    FadeMoveY fadeEffect;
+
+    benchmarkFadeEffect("FadeMoveY", fadeEffect);
+}
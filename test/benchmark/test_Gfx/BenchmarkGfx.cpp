@@ -0,0 +1,225 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the graphics primitives.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <YAGfx.h>
+#include <YAGfxBitmap.h>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void benchmarkFill();
+static void benchmarkBlit();
+static void benchmarkCopy();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME  = "Gfx";
+
+/** Canvas width in pixels, which represents a large matrix. */
+static const uint16_t   WIDTH       = 64U;
+
+/** Canvas height in pixels, which represents a large matrix. */
+static const uint16_t   HEIGHT      = 64U;
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS  = 1000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(benchmarkFill);
+    RUN_TEST(benchmarkBlit);
+    RUN_TEST(benchmarkCopy);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Benchmark filling the canvas.
+ */
+static void benchmarkFill()
+{
+    YAGfxDynamicBitmap  canvas(WIDTH, HEIGHT);
+    Color               color(ColorDef::RED);
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+
+    (void)Benchmark::run(SUITE_NAME, "fillScreen 64x64", ITERATIONS,
+        [&canvas, &color]() {
+            canvas.fillScreen(color);
+        }
+    );
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, canvas.getColor(WIDTH - 1, HEIGHT - 1));
+
+    (void)Benchmark::run(SUITE_NAME, "fillRect 16x16", ITERATIONS,
+        [&canvas, &color]() {
+            canvas.fillRect(8, 8, 16U, 16U, color);
+        }
+    );
+
+    (void)Benchmark::run(SUITE_NAME, "drawHLine 64", ITERATIONS,
+        [&canvas, &color]() {
+            canvas.drawHLine(0, HEIGHT / 2, WIDTH, color);
+        }
+    );
+
+    (void)Benchmark::run(SUITE_NAME, "drawVLine 64", ITERATIONS,
+        [&canvas, &color]() {
+            canvas.drawVLine(WIDTH / 2, 0, HEIGHT, color);
+        }
+    );
+}
+
+/**
+ * Benchmark drawing a bitmap into the canvas.
+ */
+static void benchmarkBlit()
+{
+    YAGfxDynamicBitmap          canvas(WIDTH, HEIGHT);
+    YAGfxDynamicBitmap          bitmap(WIDTH, HEIGHT);
+    YAGfxStaticBitmap<8U, 8U>   icon;
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+    TEST_ASSERT_TRUE(bitmap.isAllocated());
+
+    bitmap.fillScreen(ColorDef::GREEN);
+    icon.fillScreen(ColorDef::BLUE);
+
+    (void)Benchmark::run(SUITE_NAME, "drawBitmap 64x64", ITERATIONS,
+        [&canvas, &bitmap]() {
+            canvas.drawBitmap(0, 0, bitmap);
+        }
+    );
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::GREEN, canvas.getColor(WIDTH - 1, HEIGHT - 1));
+
+    (void)Benchmark::run(SUITE_NAME, "drawBitmap 8x8", ITERATIONS,
+        [&canvas, &icon]() {
+            canvas.drawBitmap(4, 4, icon);
+        }
+    );
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, canvas.getColor(4, 4));
+
+    (void)Benchmark::run(SUITE_NAME, "drawBitmap 64x64 clipped", ITERATIONS,
+        [&canvas, &bitmap]() {
+            canvas.drawBitmap(WIDTH / 2, HEIGHT / 2, bitmap);
+        }
+    );
+}
+
+/**
+ * Benchmark copying a framebuffer.
+ */
+static void benchmarkCopy()
+{
+    YAGfxDynamicBitmap  canvas(WIDTH, HEIGHT);
+    YAGfxDynamicBitmap  framebuffer(WIDTH, HEIGHT);
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+    TEST_ASSERT_TRUE(framebuffer.isAllocated());
+
+    framebuffer.fillScreen(ColorDef::YELLOW);
+
+    (void)Benchmark::run(SUITE_NAME, "copy 64x64", ITERATIONS,
+        [&canvas, &framebuffer]() {
+            canvas.copy(framebuffer);
+        }
+    );
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::YELLOW, canvas.getColor(WIDTH - 1, HEIGHT - 1));
+}
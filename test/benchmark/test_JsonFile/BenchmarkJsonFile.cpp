@@ -0,0 +1,206 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the JSON configuration file handling.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <FS.h>
+#include <ArduinoJson.h>
+#include <JsonFile.h>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void fillSlotConfiguration(JsonDocument& jsonDoc);
+static void benchmarkSave();
+static void benchmarkLoad();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME      = "JsonFile";
+
+/** Name of the temporary JSON file. */
+static const char*      JSON_FILE_NAME  = "./benchmarkJsonFile.json";
+
+/** JSON document size in byte, like the plugin manager uses for the slot configuration. */
+static const size_t     JSON_DOC_SIZE   = 4096U;
+
+/** Number of slots in the configuration. */
+static const uint8_t    MAX_SLOTS       = 16U;
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS      = 100U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(benchmarkSave);
+    RUN_TEST(benchmarkLoad);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(JSON_FILE_NAME);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Fill the JSON document with a slot configuration, like the plugin manager
+ * stores it.
+ *
+ * @param[in] jsonDoc   JSON document
+ */
+static void fillSlotConfiguration(JsonDocument& jsonDoc)
+{
+    JsonArray   jsonSlots   = jsonDoc.createNestedArray("slotConfiguration");
+    uint8_t     slotId      = 0U;
+
+    for(slotId = 0U; slotId < MAX_SLOTS; ++slotId)
+    {
+        JsonObject jsonSlot = jsonSlots.createNestedObject();
+
+        jsonSlot["name"]        = "IconTextLampPlugin";
+        jsonSlot["uid"]         = 1000U + slotId;
+        jsonSlot["alias"]       = "livingroom";
+        jsonSlot["fontType"]    = "default";
+        jsonSlot["duration"]    = 30000U;
+    }
+}
+
+/**
+ * Benchmark saving a JSON configuration file.
+ */
+static void benchmarkSave()
+{
+    FS                  localFileSystem;
+    JsonFile            jsonFile(localFileSystem);
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    bool                isSuccessful    = false;
+
+    fillSlotConfiguration(jsonDoc);
+    TEST_ASSERT_FALSE(jsonDoc.overflowed());
+
+    (void)Benchmark::run(SUITE_NAME, "save slot configuration", ITERATIONS,
+        [&jsonFile, &jsonDoc, &isSuccessful]() {
+            isSuccessful = jsonFile.save(JSON_FILE_NAME, jsonDoc);
+        }
+    );
+
+    TEST_ASSERT_TRUE(isSuccessful);
+}
+
+/**
+ * Benchmark loading a JSON configuration file.
+ */
+static void benchmarkLoad()
+{
+    FS                  localFileSystem;
+    JsonFile            jsonFile(localFileSystem);
+    DynamicJsonDocument jsonDocSave(JSON_DOC_SIZE);
+    DynamicJsonDocument jsonDocLoad(JSON_DOC_SIZE);
+    bool                isSuccessful    = false;
+
+    fillSlotConfiguration(jsonDocSave);
+    TEST_ASSERT_TRUE(jsonFile.save(JSON_FILE_NAME, jsonDocSave));
+
+    (void)Benchmark::run(SUITE_NAME, "load slot configuration", ITERATIONS,
+        [&jsonFile, &jsonDocLoad, &isSuccessful]() {
+            isSuccessful = jsonFile.load(JSON_FILE_NAME, jsonDocLoad);
+        }
+    );
+
+    TEST_ASSERT_TRUE(isSuccessful);
+    TEST_ASSERT_EQUAL_UINT32(MAX_SLOTS, jsonDocLoad["slotConfiguration"].as<JsonArray>().size());
+    TEST_ASSERT_EQUAL_UINT32(1000U, jsonDocLoad["slotConfiguration"][0]["uid"].as<uint32_t>());
+}
@@ -0,0 +1,291 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Golden frame and render time regression of the plugins.
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * The first run records the golden files, every further run compares the
+ * plugin output against them. The golden files are stored in the directory
+ * given by the environment variable PLUGIN_FRAMES_GOLDEN_DIR or by default
+ * in the PlatformIO working directory.
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <FirePlugin.h>
+#include <RainbowPlugin.h>
+#include <MatrixPlugin.h>
+#include <WormPlugin.h>
+#include <PlasmaPlugin.h>
+#include <NoiseFieldPlugin.h>
+#include <MetaballsPlugin.h>
+#include <Util.h>
+
+#include "../../common/PluginFrameRecorder.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void runPlugin(IPluginMaintenance& plugin);
+static void testDeterminism();
+static void benchmarkFirePlugin();
+static void benchmarkRainbowPlugin();
+static void benchmarkMatrixPlugin();
+static void benchmarkWormPlugin();
+static void benchmarkPlasmaPlugin();
+static void benchmarkNoiseFieldPlugin();
+static void benchmarkMetaballsPlugin();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME          = "PluginFrames";
+
+/** Default directory of the golden files, relative to the project directory. */
+static const char*      GOLDEN_DIR_DEFAULT  = "./test/benchmark/test_PluginFrames/golden";
+
+/** Name of the temporary file, used to check the determinism. */
+static const char*      TMP_FILE_NAME       = "./pluginFramesDeterminism.bin";
+
+/** Canvas width in pixels, which represents a typical LED matrix. */
+static const uint16_t   WIDTH               = 32U;
+
+/** Canvas height in pixels, which represents a typical LED matrix. */
+static const uint16_t   HEIGHT              = 8U;
+
+/** Number of frames per plugin, which is 10 s display time. */
+static const uint32_t   FRAMES              = 500U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testDeterminism);
+    RUN_TEST(benchmarkFirePlugin);
+    RUN_TEST(benchmarkRainbowPlugin);
+    RUN_TEST(benchmarkMatrixPlugin);
+    RUN_TEST(benchmarkWormPlugin);
+    RUN_TEST(benchmarkPlasmaPlugin);
+    RUN_TEST(benchmarkNoiseFieldPlugin);
+    RUN_TEST(benchmarkMetaballsPlugin);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(TMP_FILE_NAME);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Drive the plugin through the frames and compare them with its golden file.
+ * A missing golden file is a failure. If the environment variable
+ * PLUGIN_FRAMES_RECORD is set, the golden file is recorded instead.
+ *
+ * @param[in] plugin    The plugin under test.
+ */
+static void runPlugin(IPluginMaintenance& plugin)
+{
+    PluginFrameRecorder         recorder(WIDTH, HEIGHT);
+    PluginFrameRecorder::Result result;
+    const char*                 goldenDir   = getenv("PLUGIN_FRAMES_GOLDEN_DIR");
+    bool                        isRecordReq = (nullptr != getenv("PLUGIN_FRAMES_RECORD"));
+    String                      fileName;
+    char                        msg[64];
+
+    if (nullptr == goldenDir)
+    {
+        goldenDir = GOLDEN_DIR_DEFAULT;
+    }
+
+    fileName  = goldenDir;
+    fileName += "/pluginFrames";
+    fileName += plugin.getName();
+    fileName += ".bin";
+
+    result = recorder.run(SUITE_NAME, plugin, FRAMES, fileName.c_str(), isRecordReq);
+
+    if (true == result.isRecorded)
+    {
+        printf("Golden file %s recorded.\n", fileName.c_str());
+    }
+
+    TEST_ASSERT_FALSE_MESSAGE(result.isGoldenMissing, "Golden file missing, record it with PLUGIN_FRAMES_RECORD set.");
+
+    (void)snprintf(msg, sizeof(msg), "First different frame: %u", result.mismatchFrame);
+    TEST_ASSERT_TRUE_MESSAGE(result.isEqual, msg);
+}
+
+/**
+ * Check that a plugin run is reproducible.
+ */
+static void testDeterminism()
+{
+    PluginFrameRecorder         recorder(WIDTH, HEIGHT);
+    PluginFrameRecorder::Result result;
+    FirePlugin                  plugin("FirePlugin", 0U);
+
+    (void)remove(TMP_FILE_NAME);
+
+    result = recorder.run(SUITE_NAME, plugin, FRAMES, TMP_FILE_NAME, true);
+    TEST_ASSERT_TRUE(result.isRecorded);
+    TEST_ASSERT_TRUE(result.isEqual);
+
+    /* Same seed and clock, so the second run must reproduce the frames. */
+    result = recorder.run(SUITE_NAME, plugin, FRAMES, TMP_FILE_NAME, false);
+    TEST_ASSERT_FALSE(result.isRecorded);
+    TEST_ASSERT_TRUE(result.isEqual);
+}
+
+/**
+ * Golden frames and render time of the fire plugin.
+ */
+static void benchmarkFirePlugin()
+{
+    FirePlugin plugin("FirePlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the rainbow plugin.
+ */
+static void benchmarkRainbowPlugin()
+{
+    RainbowPlugin plugin("RainbowPlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the matrix plugin.
+ */
+static void benchmarkMatrixPlugin()
+{
+    MatrixPlugin plugin("MatrixPlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the worm plugin.
+ */
+static void benchmarkWormPlugin()
+{
+    WormPlugin plugin("WormPlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the plasma plugin.
+ */
+static void benchmarkPlasmaPlugin()
+{
+    PlasmaPlugin plugin("PlasmaPlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the noise field plugin.
+ */
+static void benchmarkNoiseFieldPlugin()
+{
+    NoiseFieldPlugin plugin("NoiseFieldPlugin", 0U);
+
+    runPlugin(plugin);
+}
+
+/**
+ * Golden frames and render time of the metaballs plugin.
+ */
+static void benchmarkMetaballsPlugin()
+{
+    MetaballsPlugin plugin("MetaballsPlugin", 0U);
+
+    runPlugin(plugin);
+}
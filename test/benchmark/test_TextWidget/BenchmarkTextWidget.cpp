@@ -0,0 +1,275 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the text widget and the text rendering.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <TextWidget.h>
+#include <YAGfxBitmap.h>
+#include <YAGfxText.h>
+#include <VirtualClock.hpp>
+#include <Util.h>
+
+#include "../../common/Benchmark.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static String createLongText(uint32_t minLength, bool withFormatTags);
+static void benchmarkDrawText();
+static void benchmarkTextWidgetScrolling();
+static void benchmarkTextWidgetFormatTags();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Benchmark suite name */
+static const char*      SUITE_NAME      = "TextWidget";
+
+/** Canvas width in pixels, like a typical 32x8 LED matrix. */
+static const uint16_t   WIDTH           = 32U;
+
+/** Canvas height in pixels, like a typical 32x8 LED matrix. */
+static const uint16_t   HEIGHT          = 8U;
+
+/** Length of a long text in characters, e.g. a news line. */
+static const uint32_t   LONG_TEXT_LEN   = 500U;
+
+/** Number of measured operations per benchmark. */
+static const uint32_t   ITERATIONS      = 200U;
+
+/**
+ * Virtual clock, which is stepped by the scroll pause every frame. This way
+ * the text is really scrolling, without waiting for it.
+ */
+static VirtualClock     gClock;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(benchmarkDrawText);
+    RUN_TEST(benchmarkTextWidgetScrolling);
+    RUN_TEST(benchmarkTextWidgetFormatTags);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    gClock.set(0UL);
+    setClock(&gClock);
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    setClock(nullptr);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Create a long text by repeating a sentence.
+ *
+ * @param[in] minLength         Min. number of characters in the text.
+ * @param[in] withFormatTags    If true, every sentence gets a color format tag.
+ *
+ * @return Long text
+ */
+static String createLongText(uint32_t minLength, bool withFormatTags)
+{
+    const char* SENTENCE    = "The quick brown fox jumps over the lazy dog. ";
+    String      text;
+
+    while(minLength > text.length())
+    {
+        if (true == withFormatTags)
+        {
+            text += "\\#FF8000";
+        }
+
+        text += SENTENCE;
+    }
+
+    return text;
+}
+
+/**
+ * Benchmark drawing a long text directly via text gfx.
+ */
+static void benchmarkDrawText()
+{
+    YAGfxDynamicBitmap  canvas(WIDTH, HEIGHT);
+    YAGfxText           gfxText(TextWidget::DEFAULT_FONT, ColorDef::WHITE);
+    String              text = createLongText(LONG_TEXT_LEN, false);
+    int16_t             cursorY = TextWidget::DEFAULT_FONT.getHeight() - 1;
+    volatile uint16_t   textWidth = 0U; /* Keeps the bounding box calculation from being optimized away. */
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+
+    (void)Benchmark::run(SUITE_NAME, "drawText 500 chars", ITERATIONS,
+        [&canvas, &gfxText, &text, cursorY]() {
+            gfxText.setTextCursorPos(0, cursorY);
+            gfxText.drawText(canvas, text.c_str());
+        }
+    );
+
+    (void)Benchmark::run(SUITE_NAME, "getTextBoundingBox 500 chars", ITERATIONS,
+        [&gfxText, &text, &textWidth]() {
+            uint16_t boxWidth   = 0U;
+            uint16_t boxHeight  = 0U;
+
+            (void)gfxText.getTextBoundingBox(WIDTH, text.c_str(), boxWidth, boxHeight);
+            textWidth = boxWidth;
+        }
+    );
+    TEST_ASSERT_GREATER_THAN(WIDTH, textWidth);
+}
+
+/**
+ * Benchmark a text widget, which scrolls a long text.
+ */
+static void benchmarkTextWidgetScrolling()
+{
+    YAGfxDynamicBitmap  canvas(WIDTH, HEIGHT);
+    TextWidget          textWidget;
+    String              text = createLongText(LONG_TEXT_LEN, false);
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+
+    textWidget.setFormatStr(text);
+
+    (void)Benchmark::run(SUITE_NAME, "update scrolling 500 chars", ITERATIONS,
+        [&canvas, &textWidget]() {
+            gClock.step(TextWidget::DEFAULT_SCROLL_PAUSE);
+            canvas.fillScreen(ColorDef::BLACK);
+            textWidget.update(canvas);
+        }
+    );
+
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), textWidget.getStr().c_str());
+
+    textWidget.clear();
+    textWidget.setPreRendering(true);
+    textWidget.setFormatStr(text);
+
+    (void)Benchmark::run(SUITE_NAME, "update scrolling 500 chars pre-rendered", ITERATIONS,
+        [&canvas, &textWidget]() {
+            gClock.step(TextWidget::DEFAULT_SCROLL_PAUSE);
+            canvas.fillScreen(ColorDef::BLACK);
+            textWidget.update(canvas);
+        }
+    );
+}
+
+/**
+ * Benchmark a text widget, which contains format tags.
+ */
+static void benchmarkTextWidgetFormatTags()
+{
+    YAGfxDynamicBitmap  canvas(WIDTH, HEIGHT);
+    TextWidget          textWidget;
+    String              text = createLongText(LONG_TEXT_LEN, true);
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+
+    textWidget.setFormatStr(text);
+
+    (void)Benchmark::run(SUITE_NAME, "update scrolling 500 chars with format tags", ITERATIONS,
+        [&canvas, &textWidget]() {
+            gClock.step(TextWidget::DEFAULT_SCROLL_PAUSE);
+            canvas.fillScreen(ColorDef::BLACK);
+            textWidget.update(canvas);
+        }
+    );
+
+    (void)Benchmark::run(SUITE_NAME, "getStr 500 chars with format tags", ITERATIONS,
+        [&textWidget]() {
+            (void)textWidget.getStr();
+        }
+    );
+
+    (void)Benchmark::run(SUITE_NAME, "setFormatStr and update", ITERATIONS,
+        [&canvas, &textWidget, &text]() {
+            textWidget.clear();
+            textWidget.setFormatStr(text);
+            textWidget.update(canvas);
+        }
+    );
+}
@@ -0,0 +1,335 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Microbenchmark support for the native test environment.
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * Every benchmark result is written as a single JSON object per line to
+ * stdout, e.g.
+ * {"suite":"Gfx","benchmark":"fillScreen","iterations":1000,"nsPerOp":812,"bytesPerOp":0,"allocsPerOp":0}
+ *
+ * If the environment variable BENCHMARK_RESULT_FILE is set, the results are
+ * additionally appended to the file it refers to.
+ *
+ * Note, the allocation counting replaces the global new/delete operators.
+ * Therefore this header shall be included only once per test suite.
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <new>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Runs a microbenchmark and reports the time and the heap allocations per
+ * operation in a machine-readable form.
+ */
+class Benchmark
+{
+public:
+
+    /**
+     * Result of a single benchmark.
+     */
+    struct Result
+    {
+        uint32_t    iterations;     /**< Number of measured operations */
+        uint64_t    nsPerOp;        /**< Average duration of one operation in ns */
+        uint64_t    bytesPerOp;     /**< Average allocated heap memory per operation in byte */
+        uint64_t    allocsPerOp;    /**< Average number of heap allocations per operation */
+
+        /**
+         * Initializes the benchmark result.
+         */
+        Result() :
+            iterations(0U),
+            nsPerOp(0U),
+            bytesPerOp(0U),
+            allocsPerOp(0U)
+        {
+        }
+    };
+
+    /**
+     * Run a benchmark. The operation is called once before the measurement
+     * starts, to warm up caches and lazy initialized data.
+     *
+     * @tparam TOperation   Callable type of the operation, signature void().
+     *
+     * @param[in] suite         Name of the benchmark suite
+     * @param[in] name          Name of the benchmark
+     * @param[in] iterations    Number of operations, which to measure
+     * @param[in] operation     The operation, which to measure.
+     *
+     * @return Benchmark result
+     */
+    template < typename TOperation >
+    static Result run(const char* suite, const char* name, uint32_t iterations, TOperation operation)
+    {
+        Result                                  result;
+        uint32_t                                idx         = 0U;
+        std::chrono::steady_clock::time_point   start;
+        std::chrono::steady_clock::time_point   end;
+        uint64_t                                durationNs  = 0U;
+
+        /* Warm up */
+        operation();
+
+        resetAllocStatistics();
+
+        start = std::chrono::steady_clock::now();
+
+        for(idx = 0U; idx < iterations; ++idx)
+        {
+            operation();
+        }
+
+        end = std::chrono::steady_clock::now();
+
+        durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        if (0U < iterations)
+        {
+            result.iterations   = iterations;
+            result.nsPerOp      = durationNs / iterations;
+            result.bytesPerOp   = getAllocatedBytes() / iterations;
+            result.allocsPerOp  = getAllocations() / iterations;
+        }
+
+        report(suite, name, result);
+
+        return result;
+    }
+
+    /**
+     * Report a benchmark result as JSON object in a single line.
+     *
+     * @param[in] suite     Name of the benchmark suite
+     * @param[in] name      Name of the benchmark
+     * @param[in] result    Benchmark result
+     */
+    static void report(const char* suite, const char* name, const Result& result)
+    {
+        const char* resultFileName  = getenv("BENCHMARK_RESULT_FILE");
+
+        print(stdout, suite, name, result);
+
+        if (nullptr != resultFileName)
+        {
+            FILE* fd = fopen(resultFileName, "a");
+
+            if (nullptr != fd)
+            {
+                print(fd, suite, name, result);
+                fclose(fd);
+            }
+        }
+    }
+
+    /**
+     * Count a heap allocation. Called by the global new operators.
+     *
+     * @param[in] size  Number of allocated bytes
+     */
+    static void countAlloc(size_t size)
+    {
+        getAllocatedBytes() += size;
+        ++getAllocations();
+    }
+
+private:
+
+    /**
+     * Get number of allocated bytes since last statistics reset.
+     *
+     * @return Number of allocated bytes
+     */
+    static uint64_t& getAllocatedBytes()
+    {
+        static uint64_t allocatedBytes = 0U;
+
+        return allocatedBytes;
+    }
+
+    /**
+     * Get number of allocations since last statistics reset.
+     *
+     * @return Number of allocations
+     */
+    static uint64_t& getAllocations()
+    {
+        static uint64_t allocations = 0U;
+
+        return allocations;
+    }
+
+    /**
+     * Reset the allocation statistics.
+     */
+    static void resetAllocStatistics()
+    {
+        getAllocatedBytes() = 0U;
+        getAllocations()    = 0U;
+    }
+
+    /**
+     * Print benchmark result as JSON object in a single line.
+     *
+     * @param[in] stream    Output stream
+     * @param[in] suite     Name of the benchmark suite
+     * @param[in] name      Name of the benchmark
+     * @param[in] result    Benchmark result
+     */
+    static void print(FILE* stream, const char* suite, const char* name, const Result& result)
+    {
+        fprintf(stream,
+            "{\"suite\":\"%s\",\"benchmark\":\"%s\",\"iterations\":%u,\"nsPerOp\":%llu,\"bytesPerOp\":%llu,\"allocsPerOp\":%llu}\n",
+            suite,
+            name,
+            result.iterations,
+            static_cast<unsigned long long>(result.nsPerOp),
+            static_cast<unsigned long long>(result.bytesPerOp),
+            static_cast<unsigned long long>(result.allocsPerOp));
+        fflush(stream);
+    }
+
+    Benchmark();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Allocate memory and count it for the benchmark statistics.
+ *
+ * @param[in] size  Number of bytes
+ *
+ * @return Pointer to allocated memory or nullptr
+ */
+static inline void* benchmarkAlloc(size_t size)
+{
+    Benchmark::countAlloc(size);
+
+    return malloc((0U == size) ? 1U : size);
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = benchmarkAlloc(size);
+
+    if (nullptr == ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    return benchmarkAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    return benchmarkAlloc(size);
+}
+
+/**
+ * Release memory, allocated by benchmarkAlloc().
+ *
+ * It is not inlined, because otherwise the compiler sees a free() call on a
+ * pointer returned by operator new and warns about mismatched allocation
+ * functions (-Wmismatched-new-delete), although both sides are replaced here.
+ *
+ * @param[in] ptr   Pointer to allocated memory or nullptr
+ */
+static __attribute__((noinline)) void benchmarkFree(void* ptr)
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    benchmarkFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    benchmarkFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    benchmarkFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t& tag) noexcept
+{
+    (void)tag;
+
+    benchmarkFree(ptr);
+}
+
+#endif  /* BENCHMARK_HPP */
+
+/** @} */
@@ -0,0 +1,170 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Bitmap image file generator for tests and benchmarks.
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef BMP_FILE_HPP
+#define BMP_FILE_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Creates uncompressed 24 bpp bottom-up bitmap image files (.bmp), whose
+ * pixels are provided by a callback.
+ */
+class BmpFile
+{
+public:
+
+    /**
+     * Get the color of a single pixel.
+     *
+     * @param[in] x x-coordinate, 0 is left.
+     * @param[in] y y-coordinate, 0 is top.
+     *
+     * @return Color in RGB24 format
+     */
+    typedef uint32_t (*GetColor)(uint16_t x, uint16_t y);
+
+    /**
+     * Create a bitmap image file.
+     *
+     * @param[in] fileName  Name of the bitmap file
+     * @param[in] width     Image width in pixels
+     * @param[in] height    Image height in pixels
+     * @param[in] getColor  Provides the color of every pixel.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool create(const char* fileName, uint16_t width, uint16_t height, GetColor getColor)
+    {
+        bool    isSuccessful    = false;
+        FILE*   fd              = fopen(fileName, "wb");
+
+        if (nullptr != fd)
+        {
+            const uint32_t  ROW_SIZE    = (24U * width + 31U) / 32U * 4U;
+            const uint32_t  IMAGE_SIZE  = ROW_SIZE * height;
+            uint16_t        x           = 0U;
+            uint16_t        y           = 0U;
+
+            /* Bitmap file header */
+            writeLittleEndian(fd, 0x4D42U, 2U); /* "BM" */
+            writeLittleEndian(fd, FILE_HEADER_SIZE + DIB_HEADER_SIZE + IMAGE_SIZE, 4U);
+            writeLittleEndian(fd, 0U, 2U);
+            writeLittleEndian(fd, 0U, 2U);
+            writeLittleEndian(fd, FILE_HEADER_SIZE + DIB_HEADER_SIZE, 4U);
+
+            /* DIB header */
+            writeLittleEndian(fd, DIB_HEADER_SIZE, 4U);
+            writeLittleEndian(fd, width, 4U);
+            writeLittleEndian(fd, height, 4U);
+            writeLittleEndian(fd, 1U, 2U);  /* Planes */
+            writeLittleEndian(fd, 24U, 2U); /* Bits per pixel */
+            writeLittleEndian(fd, 0U, 4U);  /* No compression */
+            writeLittleEndian(fd, IMAGE_SIZE, 4U);
+            writeLittleEndian(fd, 2835U, 4U);
+            writeLittleEndian(fd, 2835U, 4U);
+            writeLittleEndian(fd, 0U, 4U);  /* No palette */
+            writeLittleEndian(fd, 0U, 4U);
+
+            /* Pixel array, bottom-up in BGR order. */
+            for(y = height; y > 0U; --y)
+            {
+                for(x = 0U; x < width; ++x)
+                {
+                    writeLittleEndian(fd, getColor(x, y - 1U), 3U);
+                }
+
+                writeLittleEndian(fd, 0U, ROW_SIZE - (3U * width));
+            }
+
+            isSuccessful = (0 == fclose(fd));
+        }
+
+        return isSuccessful;
+    }
+
+private:
+
+    /** Bitmap file header size in bytes. */
+    static const uint32_t   FILE_HEADER_SIZE    = 14U;
+
+    /** DIB header (BITMAPINFOHEADER) size in bytes. */
+    static const uint32_t   DIB_HEADER_SIZE     = 40U;
+
+    /**
+     * Write value in little endian byte order to file.
+     *
+     * @param[in] fd    File descriptor
+     * @param[in] value Value
+     * @param[in] size  Value size in byte
+     */
+    static void writeLittleEndian(FILE* fd, uint32_t value, uint8_t size)
+    {
+        uint8_t idx = 0U;
+
+        for(idx = 0U; idx < size; ++idx)
+        {
+            (void)fputc(static_cast<int>(value & 0xFFU), fd);
+            value >>= 8U;
+        }
+    }
+
+    /** Not instantiated, only static methods are provided. */
+    BmpFile();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* BMP_FILE_HPP */
+
+/** @} */
@@ -0,0 +1,496 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin frame recorder for golden image and performance regression.
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * A plugin is driven through a number of frames with a virtual clock and a
+ * seeded random number generator, so every run produces the same frames.
+ * The frames are recorded to a golden file. If the golden file already
+ * exists, the frames are compared against it instead. The render time of
+ * the plugin update is reported per frame like every other benchmark.
+ *
+ * Golden file format (little endian):
+ * - Magic "PXFR" (4 byte)
+ * - Version (uint8_t)
+ * - Width and height in pixel (uint16_t each)
+ * - Number of frames (uint32_t)
+ * - Per frame: encoded size (uint32_t), followed by run length encoded
+ *   pixels in row-major order. Every run is a count (uint8_t, 1 - 255) and
+ *   the RGB888 color (3 byte).
+ *
+ * The golden files are recorded only on request, e.g. after an intended
+ * change of a plugin output. A missing golden file is a failure.
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef PLUGIN_FRAME_RECORDER_HPP
+#define PLUGIN_FRAME_RECORDER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include <Arduino.h>
+#include <VirtualClock.hpp>
+#include <YAGfxBitmap.h>
+#include <IPluginMaintenance.hpp>
+
+#include "Benchmark.hpp"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Drives a plugin deterministic through a number of frames, records them to
+ * a golden file or compares them against it and measures the render time.
+ */
+class PluginFrameRecorder
+{
+public:
+
+    /**
+     * Result of a plugin run.
+     */
+    struct Result
+    {
+        bool        isRecorded;      /**< Frames were recorded to the golden file. */
+        bool        isGoldenMissing; /**< The golden file to compare with doesn't exist. */
+        bool        isEqual;         /**< All frames are equal to the golden file or were recorded. */
+        uint32_t    mismatchFrame;   /**< Index of the first different frame, only valid if not equal. */
+        uint64_t    nsPerFrame;      /**< Average render time per frame in ns */
+        uint64_t    maxNsPerFrame;   /**< Max. render time of a single frame in ns */
+
+        /**
+         * Initializes the result.
+         */
+        Result() :
+            isRecorded(false),
+            isGoldenMissing(false),
+            isEqual(false),
+            mismatchFrame(0U),
+            nsPerFrame(0U),
+            maxNsPerFrame(0U)
+        {
+        }
+    };
+
+    /**
+     * Constructs the plugin frame recorder.
+     *
+     * @param[in] width         Canvas width in pixel
+     * @param[in] height        Canvas height in pixel
+     * @param[in] seed          Seed of the random number generator
+     * @param[in] framePeriod   Virtual time between two frames in ms
+     */
+    PluginFrameRecorder(uint16_t width, uint16_t height, uint32_t seed = DEFAULT_SEED, uint32_t framePeriod = DEFAULT_FRAME_PERIOD) :
+        m_canvas(width, height),
+        m_clock(),
+        m_seed(seed),
+        m_framePeriod(framePeriod),
+        m_frame()
+    {
+    }
+
+    /**
+     * Destroys the plugin frame recorder.
+     */
+    ~PluginFrameRecorder()
+    {
+    }
+
+    /**
+     * Get the canvas, the plugin draws on. After a run it contains the
+     * last frame.
+     *
+     * @return Canvas
+     */
+    YAGfxDynamicBitmap& getCanvas()
+    {
+        return m_canvas;
+    }
+
+    /**
+     * Drive the plugin through its whole life cycle: start, active, the
+     * given number of frames, inactive and stop. Before each frame the
+     * virtual clock is stepped by the frame period and the plugin is
+     * processed. Only the plugin update is measured.
+     *
+     * If recording is requested, the frames are written to the golden file.
+     * Otherwise they are compared with the golden file, which must exist.
+     *
+     * @param[in] suite         Name of the benchmark suite, used for reporting.
+     * @param[in] plugin        The plugin, which to drive.
+     * @param[in] frames        Number of frames
+     * @param[in] fileName      Name of the golden file
+     * @param[in] isRecordReq   Record the golden file instead of comparing with it.
+     *
+     * @return Result
+     */
+    Result run(const char* suite, IPluginMaintenance& plugin, uint32_t frames, const char* fileName, bool isRecordReq)
+    {
+        Result              result;
+        Benchmark::Result   report;
+        FILE*               fd          = nullptr;
+        uint64_t            durationNs  = 0U;
+        uint32_t            frameIdx    = 0U;
+
+        if (false == m_canvas.isAllocated())
+        {
+            return result;
+        }
+
+        if (false == isRecordReq)
+        {
+            fd = fopen(fileName, "rb");
+
+            if (nullptr == fd)
+            {
+                result.isGoldenMissing = true;
+                return result;
+            }
+        }
+
+        if (nullptr == fd)
+        {
+            fd = fopen(fileName, "wb");
+
+            if (nullptr == fd)
+            {
+                return result;
+            }
+
+            result.isRecorded = true;
+            writeHeader(fd, frames);
+        }
+        else if (false == checkHeader(fd, frames))
+        {
+            fclose(fd);
+            return result;
+        }
+        else
+        {
+            ;
+        }
+
+        result.isEqual = true;
+
+        m_clock.set(0U);
+        setClock(&m_clock);
+        randomSeed(m_seed);
+
+        m_canvas.fillScreen(ColorDef::BLACK);
+        plugin.start(m_canvas.getWidth(), m_canvas.getHeight());
+        plugin.active(m_canvas);
+
+        for(frameIdx = 0U; frameIdx < frames; ++frameIdx)
+        {
+            std::chrono::steady_clock::time_point   start;
+            uint64_t                                frameNs = 0U;
+
+            m_clock.step(m_framePeriod);
+            plugin.process(false);
+
+            start = std::chrono::steady_clock::now();
+            plugin.update(m_canvas);
+            frameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            durationNs += frameNs;
+
+            if (result.maxNsPerFrame < frameNs)
+            {
+                result.maxNsPerFrame = frameNs;
+            }
+
+            encodeFrame();
+
+            if (true == result.isRecorded)
+            {
+                writeFrame(fd);
+            }
+            else if ((true == result.isEqual) &&
+                     (false == compareFrame(fd)))
+            {
+                result.isEqual          = false;
+                result.mismatchFrame    = frameIdx;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        plugin.inactive();
+        plugin.stop();
+
+        setClock(nullptr);
+        fclose(fd);
+
+        if (0U < frames)
+        {
+            result.nsPerFrame = durationNs / frames;
+        }
+
+        report.iterations   = frames;
+        report.nsPerOp      = result.nsPerFrame;
+        Benchmark::report(suite, plugin.getName(), report);
+
+        return result;
+    }
+
+    /** Default seed of the random number generator. */
+    static const uint32_t   DEFAULT_SEED            = 0x50495845U;
+
+    /** Default virtual time between two frames in ms, same as the display update period. */
+    static const uint32_t   DEFAULT_FRAME_PERIOD    = 20U;
+
+private:
+
+    /** Golden file format version */
+    static const uint8_t    VERSION                 = 1U;
+
+    /** Max. number of pixels in a single run */
+    static const uint8_t    MAX_RUN_LENGTH          = UINT8_MAX;
+
+    YAGfxDynamicBitmap      m_canvas;       /**< Canvas, the plugin draws on. */
+    VirtualClock            m_clock;        /**< Deterministic clock */
+    uint32_t                m_seed;         /**< Seed of the random number generator */
+    uint32_t                m_framePeriod;  /**< Virtual time between two frames in ms */
+    std::vector<uint8_t>    m_frame;        /**< Current encoded frame */
+
+    PluginFrameRecorder(const PluginFrameRecorder& recorder);
+    PluginFrameRecorder& operator=(const PluginFrameRecorder& recorder);
+
+    /**
+     * Write a 16-bit value in little endian order.
+     *
+     * @param[in] fd    File descriptor
+     * @param[in] value Value
+     */
+    static void writeUInt16(FILE* fd, uint16_t value)
+    {
+        uint8_t buffer[2U] = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8U) };
+
+        (void)fwrite(buffer, 1U, sizeof(buffer), fd);
+    }
+
+    /**
+     * Write a 32-bit value in little endian order.
+     *
+     * @param[in] fd    File descriptor
+     * @param[in] value Value
+     */
+    static void writeUInt32(FILE* fd, uint32_t value)
+    {
+        writeUInt16(fd, static_cast<uint16_t>(value));
+        writeUInt16(fd, static_cast<uint16_t>(value >> 16U));
+    }
+
+    /**
+     * Read a 32-bit value in little endian order.
+     *
+     * @param[in]   fd      File descriptor
+     * @param[out]  value   Value
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    static bool readUInt32(FILE* fd, uint32_t& value)
+    {
+        uint8_t buffer[4U];
+        bool    isSuccessful = false;
+
+        if (sizeof(buffer) == fread(buffer, 1U, sizeof(buffer), fd))
+        {
+            value = static_cast<uint32_t>(buffer[0U]) |
+                    (static_cast<uint32_t>(buffer[1U]) << 8U) |
+                    (static_cast<uint32_t>(buffer[2U]) << 16U) |
+                    (static_cast<uint32_t>(buffer[3U]) << 24U);
+
+            isSuccessful = true;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Write the golden file header.
+     *
+     * @param[in] fd        File descriptor
+     * @param[in] frames    Number of frames
+     */
+    void writeHeader(FILE* fd, uint32_t frames) const
+    {
+        (void)fwrite("PXFR", 1U, 4U, fd);
+        (void)fputc(VERSION, fd);
+        writeUInt16(fd, m_canvas.getWidth());
+        writeUInt16(fd, m_canvas.getHeight());
+        writeUInt32(fd, frames);
+    }
+
+    /**
+     * Check whether the golden file header matches the current run.
+     *
+     * @param[in] fd        File descriptor
+     * @param[in] frames    Number of frames
+     *
+     * @return If it matches, it will return true otherwise false.
+     */
+    bool checkHeader(FILE* fd, uint32_t frames) const
+    {
+        uint8_t     magic[5U];
+        uint32_t    size    = 0U;
+        uint32_t    count   = 0U;
+        bool        isValid = false;
+
+        if ((sizeof(magic) == fread(magic, 1U, sizeof(magic), fd)) &&
+            (0 == memcmp(magic, "PXFR", 4U)) &&
+            (VERSION == magic[4U]) &&
+            (true == readUInt32(fd, size)) &&
+            (true == readUInt32(fd, count)))
+        {
+            uint32_t expectedSize = static_cast<uint32_t>(m_canvas.getWidth()) |
+                                    (static_cast<uint32_t>(m_canvas.getHeight()) << 16U);
+
+            isValid = (expectedSize == size) && (frames == count);
+        }
+
+        return isValid;
+    }
+
+    /**
+     * Run length encode the current canvas.
+     */
+    void encodeFrame()
+    {
+        int16_t     x       = 0;
+        int16_t     y       = 0;
+        uint8_t     count   = 0U;
+        uint32_t    last    = 0U;
+
+        m_frame.clear();
+
+        for(y = 0; y < m_canvas.getHeight(); ++y)
+        {
+            for(x = 0; x < m_canvas.getWidth(); ++x)
+            {
+                uint32_t color = m_canvas.getColor(x, y);
+
+                if ((0U < count) &&
+                    ((MAX_RUN_LENGTH == count) || (last != color)))
+                {
+                    appendRun(count, last);
+                    count = 0U;
+                }
+
+                last = color;
+                ++count;
+            }
+        }
+
+        if (0U < count)
+        {
+            appendRun(count, last);
+        }
+    }
+
+    /**
+     * Append a single run to the encoded frame.
+     *
+     * @param[in] count Number of pixels
+     * @param[in] color Color of the pixels in RGB24 format
+     */
+    void appendRun(uint8_t count, uint32_t color)
+    {
+        m_frame.push_back(count);
+        m_frame.push_back(static_cast<uint8_t>(color >> 16U));
+        m_frame.push_back(static_cast<uint8_t>(color >> 8U));
+        m_frame.push_back(static_cast<uint8_t>(color));
+    }
+
+    /**
+     * Write the encoded frame to the golden file.
+     *
+     * @param[in] fd    File descriptor
+     */
+    void writeFrame(FILE* fd) const
+    {
+        writeUInt32(fd, m_frame.size());
+        (void)fwrite(m_frame.data(), 1U, m_frame.size(), fd);
+    }
+
+    /**
+     * Compare the encoded frame with the next frame in the golden file.
+     *
+     * @param[in] fd    File descriptor
+     *
+     * @return If both are equal, it will return true otherwise false.
+     */
+    bool compareFrame(FILE* fd) const
+    {
+        uint32_t    size    = 0U;
+        bool        isEqual = false;
+
+        if ((true == readUInt32(fd, size)) &&
+            (m_frame.size() == size))
+        {
+            std::vector<uint8_t> golden(size);
+
+            if ((size == fread(golden.data(), 1U, size, fd)) &&
+                (golden == m_frame))
+            {
+                isEqual = true;
+            }
+        }
+
+        return isEqual;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* PLUGIN_FRAME_RECORDER_HPP */
+
+/** @} */
@@ -96,6 +96,7 @@ public:
     void setPenColor(const Color& color)
     {
         m_color = color;
+        invalidate();
         return;
     }
 
@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include <unity.h>
 #include <BitmapWidget.h>
+#include <FS.h>
 #include <Util.h>
 
 #include "../common/YAGfxTest.hpp"
@@ -55,11 +56,18 @@
  *****************************************************************************/
 
 static void testBitmapWidget();
+static void testBitmapWidgetGif();
 
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** GIF animation with 4x4 pixels, the first frame is red. */
+static const char*  FILE_NAME_GIF   = "./test/test_GifDecoder/testAnim.gif";
+
+/** Bitmap image file with 2x2 pixels. */
+static const char*  FILE_NAME_BMP   = "./test/test_BmpImgLoader/test24bpp.bmp";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -90,6 +98,7 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testBitmapWidget);
+    RUN_TEST(testBitmapWidgetGif);
 
     return UNITY_END();
 }
@@ -191,3 +200,45 @@ static void testBitmapWidget()
 
     return;
 }
+
+/**
+ * Test bitmap widget with a GIF animation.
+ */
+static void testBitmapWidgetGif()
+{
+    YAGfxTest       testGfx;
+    BitmapWidget    bitmapWidget;
+    FS              localFileSystem;
+    Color*          displayBuffer   = nullptr;
+
+    /* The GIF is detected by its signature. */
+    TEST_ASSERT_TRUE(bitmapWidget.load(localFileSystem, FILE_NAME_GIF));
+    TEST_ASSERT_EQUAL_UINT16(4U, bitmapWidget.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(4U, bitmapWidget.get().getHeight());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, bitmapWidget.get().getColor(3, 3));
+
+    /* The animation is dirty until the frame timer runs. */
+    TEST_ASSERT_TRUE(bitmapWidget.isDirty());
+    testGfx.fill(ColorDef::BLACK);
+    bitmapWidget.update(testGfx);
+    displayBuffer = testGfx.getBuffer();
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, displayBuffer[3 + 3 * YAGfxTest::WIDTH]);
+
+    /* A copy shows the current frame of the same animation. */
+    {
+        BitmapWidget copy(bitmapWidget);
+
+        TEST_ASSERT_EQUAL_UINT16(4U, copy.get().getWidth());
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, copy.get().getColor(0, 0));
+    }
+
+    /* Loading a bitmap image file replaces the animation. */
+    TEST_ASSERT_TRUE(bitmapWidget.load(localFileSystem, FILE_NAME_BMP));
+    TEST_ASSERT_EQUAL_UINT16(2U, bitmapWidget.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2U, bitmapWidget.get().getHeight());
+
+    /* Clearing stops the animation. */
+    TEST_ASSERT_TRUE(bitmapWidget.load(localFileSystem, FILE_NAME_GIF));
+    bitmapWidget.clear(ColorDef::BLACK);
+    TEST_ASSERT_EQUAL_UINT16(0U, bitmapWidget.get().getWidth());
+}
@@ -55,6 +55,8 @@
  *****************************************************************************/
 
 static void testBmpImgLoader();
+static void testBmpImgLoaderPalette();
+static void testBmpImgLoaderRle();
 
 /******************************************************************************
  * Local Variables
@@ -90,6 +92,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testBmpImgLoader);
+    RUN_TEST(testBmpImgLoaderPalette);
+    RUN_TEST(testBmpImgLoaderRle);
 
     return UNITY_END();
 }
@@ -140,6 +144,23 @@ static void testBmpImgLoader()
     TEST_ASSERT_EQUAL_UINT32(0xff0000, bitmap.getColor(0, 1));
     TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(1, 1));
 
+    /* Load test image:
+     * 2x2 pixels, stored top-down
+     * (0, 0) blue
+     * (1, 0) green
+     * (0, 1) red
+     * (1, 1) white
+     * 24 bpp, no compression
+     * No color palette
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test24bppTopDown.bmp", bitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, bitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, bitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(1, 1));
+
     /* Load test image:
      * 2x2 pixels
      * (0, 0) blue
@@ -159,3 +180,106 @@ static void testBmpImgLoader()
 
     return;
 }
+
+/**
+ * Test bitmap image loader with palette images.
+ */
+static void testBmpImgLoaderPalette()
+{
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  bitmap;
+    FS                  localFileSystem;
+
+    /* Load test image:
+     * 2x2 pixels
+     * (0, 0) blue
+     * (1, 0) white
+     * (0, 1) white
+     * (1, 1) blue
+     * 1 bpp, no compression
+     * 2 palette colors
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test1bpp.bmp", bitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(1, 1));
+
+    /* Load test image:
+     * 2x2 pixels
+     * (0, 0) blue
+     * (1, 0) green
+     * (0, 1) red
+     * (1, 1) white
+     * 4 bpp, no compression
+     * Default number of palette colors (16)
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test4bpp.bmp", bitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, bitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, bitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(1, 1));
+
+    /* Load test image:
+     * 2x2 pixels
+     * (0, 0) blue
+     * (1, 0) green
+     * (0, 1) red
+     * (1, 1) white
+     * 8 bpp, no compression
+     * 4 palette colors
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test8bpp.bmp", bitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, bitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, bitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, bitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(1, 1));
+
+    return;
+}
+
+/**
+ * Test bitmap image loader with RLE compressed images.
+ */
+static void testBmpImgLoaderRle()
+{
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  bitmap;
+    FS                  localFileSystem;
+    const char*         fileNames[] =
+    {
+        "./test/test_BmpImgLoader/testRle8.bmp",
+        "./test/test_BmpImgLoader/testRle4.bmp"
+    };
+    uint8_t             idx         = 0U;
+
+    /* Load test images:
+     * 4x2 pixels
+     * Row 0: blue, blue, black (skipped by delta), blue
+     * Row 1: red, green, white (absolute mode), black (skipped by end of line)
+     * 8 bpp with RLE8 compression and 4 bpp with RLE4 compression
+     * 5 palette colors
+     */
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(fileNames); ++idx)
+    {
+        TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, fileNames[idx], bitmap));
+        TEST_ASSERT_EQUAL_UINT16(4, bitmap.getWidth());
+        TEST_ASSERT_EQUAL_UINT16(2, bitmap.getHeight());
+        TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(0, 0));
+        TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(1, 0));
+        TEST_ASSERT_EQUAL_UINT32(0x000000, bitmap.getColor(2, 0));
+        TEST_ASSERT_EQUAL_UINT32(0x0000ff, bitmap.getColor(3, 0));
+        TEST_ASSERT_EQUAL_UINT32(0xff0000, bitmap.getColor(0, 1));
+        TEST_ASSERT_EQUAL_UINT32(0x00ff00, bitmap.getColor(1, 1));
+        TEST_ASSERT_EQUAL_UINT32(0xffffff, bitmap.getColor(2, 1));
+        TEST_ASSERT_EQUAL_UINT32(0x000000, bitmap.getColor(3, 1));
+    }
+
+    return;
+}
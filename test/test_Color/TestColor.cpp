@@ -53,6 +53,8 @@
  *****************************************************************************/
 
 static void testColor();
+static void testColorWheel();
+static void testColorHsvHsl();
 
 /******************************************************************************
  * Local Variables
@@ -88,6 +90,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testColor);
+    RUN_TEST(testColorWheel);
+    RUN_TEST(testColorHsvHsl);
 
     return UNITY_END();
 }
@@ -182,3 +186,112 @@ static void testColor()
 
     return;
 }
+
+/**
+ * Test the color wheel.
+ */
+static void testColorWheel()
+{
+    const uint8_t   COL_PARTS   = 3U;
+    const uint8_t   COL_RANGE   = UINT8_MAX / COL_PARTS;
+    Color           colors[UINT8_MAX + 1U];
+    uint16_t        wheelPos    = 0U;
+
+    Color::fillColorWheel(colors, UINT8_MAX + 1U, 0U, 1U);
+
+    /* Compare the lookup table against the calculated color wheel. */
+    for(wheelPos = 0U; wheelPos <= UINT8_MAX; ++wheelPos)
+    {
+        Color   color;
+        uint8_t invWheelPos = UINT8_MAX - wheelPos;
+        uint8_t red         = 0U;
+        uint8_t green       = 0U;
+        uint8_t blue        = 0U;
+
+        if (invWheelPos < COL_RANGE)
+        {
+            red     = UINT8_MAX - invWheelPos * COL_PARTS;
+            blue    = COL_PARTS * invWheelPos;
+        }
+        else if (invWheelPos < (2U * COL_RANGE))
+        {
+            invWheelPos -= COL_RANGE;
+            green   = COL_PARTS * invWheelPos;
+            blue    = UINT8_MAX - invWheelPos * COL_PARTS;
+        }
+        else
+        {
+            invWheelPos -= ((COL_PARTS - 1U) * COL_RANGE);
+            red     = COL_PARTS * invWheelPos;
+            green   = UINT8_MAX - invWheelPos * COL_PARTS;
+        }
+
+        color.turnColorWheel(wheelPos);
+        TEST_ASSERT_EQUAL_UINT8(red, color.getRed());
+        TEST_ASSERT_EQUAL_UINT8(green, color.getGreen());
+        TEST_ASSERT_EQUAL_UINT8(blue, color.getBlue());
+
+        /* The row helper shall provide the same colors. */
+        TEST_ASSERT_EQUAL_UINT32(color, colors[wheelPos]);
+    }
+
+    /* The row helper shall wrap around the color wheel. */
+    Color::fillColorWheel(colors, 4U, 254U, 1U);
+    TEST_ASSERT_EQUAL_UINT32(colors[2], Color(ColorDef::RED));
+}
+
+/**
+ * Test the HSV and HSL conversion.
+ */
+static void testColorHsvHsl()
+{
+    Color   color;
+    Color   colors[4U];
+    uint8_t idx     = 0U;
+
+    /* Fully saturated hues */
+    color.setHsv(0U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, color);
+    color.setHsv(128U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::CYAN, color);
+    color.setHsv(171U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT8(255U, color.getBlue());
+    TEST_ASSERT_EQUAL_UINT8(0U, color.getGreen());
+
+    /* No saturation results in gray, no value in black. */
+    color.setHsv(123U, 0U, 200U);
+    TEST_ASSERT_EQUAL_UINT32(0x00c8c8c8U, color);
+    color.setHsv(123U, 255U, 0U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, color);
+
+    /* Half saturation */
+    color.setHsv(0U, 128U, 255U);
+    TEST_ASSERT_EQUAL_UINT8(255U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(127U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(127U, color.getBlue());
+
+    /* HSL: Half lightness is the pure color, full lightness is white. */
+    color.setHsl(0U, 255U, 127U);
+    TEST_ASSERT_EQUAL_UINT32(0x00fe0000U, color);
+    color.setHsl(0U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::WHITE, color);
+    color.setHsl(0U, 255U, 0U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, color);
+    color.setHsl(200U, 0U, 100U);
+    TEST_ASSERT_EQUAL_UINT32(0x00646464U, color);
+
+    /* The intensity is kept. */
+    color.setIntensity(0U);
+    color.setHsv(0U, 255U, 255U);
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, color);
+
+    /* Row helper */
+    Color::fillHsv(colors, 4U, 10U, 20U, 200U, 150U);
+
+    for(idx = 0U; idx < 4U; ++idx)
+    {
+        color.setIntensity(255U);
+        color.setHsv(10U + idx * 20U, 200U, 150U);
+        TEST_ASSERT_EQUAL_UINT32(color, colors[idx]);
+    }
+}
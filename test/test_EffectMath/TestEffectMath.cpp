@@ -0,0 +1,198 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed-point math of the procedural effects tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdlib.h>
+#include <Util.h>
+#include <EffectMath.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testTrigonometry();
+static void testInterpolation();
+static void testNoise();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testTrigonometry);
+    RUN_TEST(testInterpolation);
+    RUN_TEST(testNoise);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the sine and cosine tables.
+ */
+static void testTrigonometry()
+{
+    uint16_t angle = 0U;
+
+    /* Zero, maximum and minimum at the quarters of the circle. */
+    TEST_ASSERT_EQUAL_UINT8(128U, EffectMath::sin8(0U));
+    TEST_ASSERT_EQUAL_UINT8(255U, EffectMath::sin8(64U));
+    TEST_ASSERT_EQUAL_UINT8(128U, EffectMath::sin8(128U));
+    TEST_ASSERT_EQUAL_UINT8(1U, EffectMath::sin8(192U));
+
+    TEST_ASSERT_EQUAL_UINT8(255U, EffectMath::cos8(0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, EffectMath::cos8(128U));
+
+    /* 30 degree is about 21 steps, which is half of the amplitude. */
+    TEST_ASSERT_UINT8_WITHIN(1U, 128U + 63U, EffectMath::sin8(21U));
+
+    /* The sine is point symmetric to the half circle. */
+    for(angle = 1U; angle < 128U; ++angle)
+    {
+        TEST_ASSERT_EQUAL_UINT16(256U, EffectMath::sin8(angle) + EffectMath::sin8(256U - angle));
+    }
+}
+
+/**
+ * Test the scaling and the linear interpolation.
+ */
+static void testInterpolation()
+{
+    TEST_ASSERT_EQUAL_UINT8(0U, EffectMath::scale8(255U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(127U, EffectMath::scale8(255U, 128U));
+    TEST_ASSERT_EQUAL_UINT8(254U, EffectMath::scale8(255U, 255U));
+
+    TEST_ASSERT_EQUAL_UINT8(10U, EffectMath::lerp8(10U, 200U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(105U, EffectMath::lerp8(10U, 200U, 128U));
+    TEST_ASSERT_EQUAL_UINT8(105U, EffectMath::lerp8(200U, 10U, 128U));
+    TEST_ASSERT_EQUAL_UINT8(199U, EffectMath::lerp8(10U, 200U, 255U));
+
+    /* The fade curve is monotonic and flat at its begin. */
+    TEST_ASSERT_EQUAL_UINT8(0U, EffectMath::FADE_TABLE[0U]);
+    TEST_ASSERT_EQUAL_UINT8(128U, EffectMath::FADE_TABLE[128U]);
+    TEST_ASSERT_EQUAL_UINT8(255U, EffectMath::FADE_TABLE[255U]);
+}
+
+/**
+ * Test the value noise.
+ */
+static void testNoise()
+{
+    bool        isUsed[UINT8_MAX + 1U]  = { false };
+    uint16_t    idx                     = 0U;
+    uint8_t     previous                = EffectMath::noise8(0U, 0U, 0U);
+
+    /* The permutation table contains every value exactly once. */
+    for(idx = 0U; idx <= UINT8_MAX; ++idx)
+    {
+        TEST_ASSERT_FALSE(isUsed[EffectMath::PERMUTATION_TABLE[idx]]);
+        isUsed[EffectMath::PERMUTATION_TABLE[idx]] = true;
+    }
+
+    /* On the lattice points the noise is the hash of the lattice cell. */
+    idx = static_cast<uint8_t>(EffectMath::PERMUTATION_TABLE[3U] + 5U);
+    idx = static_cast<uint8_t>(EffectMath::PERMUTATION_TABLE[idx] + 7U);
+    TEST_ASSERT_EQUAL_UINT8(EffectMath::PERMUTATION_TABLE[idx], EffectMath::noise8(3U << 8U, 5U << 8U, 7U << 8U));
+
+    /* The noise is smooth, neighboured positions have similar values. */
+    for(idx = 1U; idx < 1024U; ++idx)
+    {
+        uint8_t current = EffectMath::noise8(idx * 8U, idx * 3U, idx);
+
+        TEST_ASSERT_UINT8_WITHIN(24U, previous, current);
+        previous = current;
+    }
+
+    /* The noise is deterministic. */
+    TEST_ASSERT_EQUAL_UINT8(EffectMath::noise8(1234U, 5678U, 910U), EffectMath::noise8(1234U, 5678U, 910U));
+}
@@ -0,0 +1,301 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Frequency band mapper tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <FreqBandMapper.hpp>
+#include <Decibel.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Number of frequency bins, like the spectrum analyzer. */
+static const uint32_t   BINS        = 256U;
+
+/** Max. number of frequency bands. */
+static const uint8_t    MAX_BANDS   = 32U;
+
+/** Frequency band mapper under test. */
+typedef FreqBandMapper<BINS, MAX_BANDS> TestMapper;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testConfigure();
+static void testLogBands();
+static void testConstantSpectrum();
+static void testMelBands();
+static void testFastLog();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Sample rate in Hz. */
+static const uint32_t   SAMPLE_RATE = 44100U;
+
+/** The mapper is too large for the stack. */
+static TestMapper       gMapper;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testConfigure);
+    RUN_TEST(testLogBands);
+    RUN_TEST(testConstantSpectrum);
+    RUN_TEST(testMelBands);
+    RUN_TEST(testFastLog);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Check the parameter validation of the configuration.
+ */
+static void testConfigure()
+{
+    TEST_ASSERT_EQUAL_UINT8(0U, gMapper.getBandsLen());
+
+    TEST_ASSERT_FALSE(gMapper.configure(FREQ_BAND_SCALE_LOG, 0U, SAMPLE_RATE));
+    TEST_ASSERT_FALSE(gMapper.configure(FREQ_BAND_SCALE_LOG, MAX_BANDS + 1U, SAMPLE_RATE));
+    TEST_ASSERT_FALSE(gMapper.configure(FREQ_BAND_SCALE_MEL, 16U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, gMapper.getBandsLen());
+
+    TEST_ASSERT_TRUE(gMapper.configure(FREQ_BAND_SCALE_LOG, 1U, SAMPLE_RATE));
+    TEST_ASSERT_EQUAL_UINT8(1U, gMapper.getBandsLen());
+
+    TEST_ASSERT_TRUE(gMapper.configure(FREQ_BAND_SCALE_MEL, MAX_BANDS, SAMPLE_RATE));
+    TEST_ASSERT_EQUAL_UINT8(MAX_BANDS, gMapper.getBandsLen());
+}
+
+/**
+ * A single frequency bin shall be mapped to its logarithmic band only.
+ */
+static void testLogBands()
+{
+    /* High edge frequency bins of 16 bands, which are 1/2 octaves. */
+    const uint32_t  HIGH_EDGE_BINS[16U] = { 4U, 5U, 7U, 9U, 12U, 16U, 21U, 28U, 37U, 48U, 64U, 84U, 111U, 146U, 193U, 255U };
+    float           bins[BINS];
+    float           bands[MAX_BANDS];
+    uint32_t        binIdx              = 0U;
+    uint8_t         bandIdx             = 0U;
+    uint32_t        lowEdgeBin          = 1U;
+
+    TEST_ASSERT_TRUE(gMapper.configure(FREQ_BAND_SCALE_LOG, 16U, SAMPLE_RATE));
+
+    for(bandIdx = 0U; bandIdx < 16U; ++bandIdx)
+    {
+        uint32_t binsPerBand = HIGH_EDGE_BINS[bandIdx] - lowEdgeBin + 1U;
+
+        for(binIdx = 0U; binIdx < BINS; ++binIdx)
+        {
+            bins[binIdx] = 0.0F;
+        }
+
+        bins[HIGH_EDGE_BINS[bandIdx]] = 1.0F;
+        gMapper.map(bins, bands);
+
+        TEST_ASSERT_EQUAL_FLOAT(1.0F / static_cast<float>(binsPerBand), bands[bandIdx]);
+
+        if (0U < bandIdx)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, bands[bandIdx - 1U]);
+        }
+
+        if (15U > bandIdx)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, bands[bandIdx + 1U]);
+        }
+
+        lowEdgeBin = HIGH_EDGE_BINS[bandIdx] + 1U;
+    }
+}
+
+/**
+ * A constant spectrum shall result in the same value in every band,
+ * independent of the scale and the number of bands.
+ */
+static void testConstantSpectrum()
+{
+    const FreqBandScale SCALES[]        = { FREQ_BAND_SCALE_LOG, FREQ_BAND_SCALE_MEL };
+    const uint8_t       BANDS_LENS[]    = { 1U, 8U, 16U, 24U, 32U };
+    float               bins[BINS];
+    float               bands[MAX_BANDS];
+    uint32_t            binIdx          = 0U;
+    uint8_t             scaleIdx        = 0U;
+    uint8_t             lenIdx          = 0U;
+
+    for(binIdx = 0U; binIdx < BINS; ++binIdx)
+    {
+        bins[binIdx] = 2.0F;
+    }
+
+    for(scaleIdx = 0U; scaleIdx < UTIL_ARRAY_NUM(SCALES); ++scaleIdx)
+    {
+        for(lenIdx = 0U; lenIdx < UTIL_ARRAY_NUM(BANDS_LENS); ++lenIdx)
+        {
+            uint8_t bandIdx = 0U;
+
+            TEST_ASSERT_TRUE(gMapper.configure(SCALES[scaleIdx], BANDS_LENS[lenIdx], SAMPLE_RATE));
+            gMapper.map(bins, bands);
+
+            for(bandIdx = 0U; bandIdx < BANDS_LENS[lenIdx]; ++bandIdx)
+            {
+                TEST_ASSERT_FLOAT_WITHIN(0.0001F, 2.0F, bands[bandIdx]);
+            }
+        }
+    }
+}
+
+/**
+ * A frequency bin shall contribute to two neighbour mel bands at most and
+ * the band with the nearest center shall get most of it.
+ */
+static void testMelBands()
+{
+    float       bins[BINS];
+    float       bands[MAX_BANDS];
+    uint32_t    binIdx      = 0U;
+
+    TEST_ASSERT_TRUE(gMapper.configure(FREQ_BAND_SCALE_MEL, 24U, SAMPLE_RATE));
+
+    for(binIdx = 1U; binIdx < BINS; ++binIdx)
+    {
+        uint32_t    idx         = 0U;
+        uint8_t     bandIdx     = 0U;
+        uint8_t     nonZero     = 0U;
+        uint8_t     firstBand   = MAX_BANDS;
+
+        for(idx = 0U; idx < BINS; ++idx)
+        {
+            bins[idx] = (idx == binIdx) ? 1.0F : 0.0F;
+        }
+
+        gMapper.map(bins, bands);
+
+        for(bandIdx = 0U; bandIdx < gMapper.getBandsLen(); ++bandIdx)
+        {
+            if (0.0F < bands[bandIdx])
+            {
+                if (MAX_BANDS == firstBand)
+                {
+                    firstBand = bandIdx;
+                }
+                else
+                {
+                    /* Only neighbours are allowed. */
+                    TEST_ASSERT_EQUAL_UINT8(firstBand + 1U, bandIdx);
+                }
+
+                ++nonZero;
+            }
+        }
+
+        TEST_ASSERT_TRUE(2U >= nonZero);
+    }
+}
+
+/**
+ * Check the accuracy of the fast logarithm and the dB conversion.
+ */
+static void testFastLog()
+{
+    const float VALUES[]    = { 0.001F, 0.5F, 1.0F, 1.5F, 2.0F, 3.0F, 10.0F, 1234.5F, 65536.0F };
+    uint8_t     idx         = 0U;
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(VALUES); ++idx)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.01F, log2f(VALUES[idx]), Decibel::fastLog2(VALUES[idx]));
+        TEST_ASSERT_FLOAT_WITHIN(0.06F, 20.0F * log10f(VALUES[idx]), Decibel::fromAmplitude(VALUES[idx]));
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(Decibel::MIN_DECIBEL, Decibel::fromAmplitude(0.0F));
+    TEST_ASSERT_EQUAL_FLOAT(Decibel::MIN_DECIBEL, Decibel::fromAmplitude(-1.0F));
+}
@@ -0,0 +1,301 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Game of Life world calculation tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <Util.h>
+#include <GameOfLife.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool isAlive(const uint32_t* world, uint16_t wordsPerRow, int32_t x, int32_t y, uint16_t height);
+static uint32_t calculateNextGenerationNaive(const uint32_t* src, uint32_t* dst, uint16_t wordsPerRow, uint16_t height);
+static void testWrapAround();
+static void testRandomWorlds();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of row words per world row. */
+static const uint16_t   MAX_WORDS_PER_ROW   = 4U;
+
+/** Max. world height in rows. */
+static const uint16_t   MAX_HEIGHT          = 32U;
+
+/** Number of generations, which are compared per random world. */
+static const uint32_t   GENERATIONS         = 16U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testWrapAround);
+    RUN_TEST(testRandomWorlds);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the state of a cell. The coordinates wrap around at the world borders.
+ *
+ * @param[in] world         World
+ * @param[in] wordsPerRow   Number of row words per world row
+ * @param[in] x             x-coordinate, may be outside the world.
+ * @param[in] y             y-coordinate, may be outside the world.
+ * @param[in] height        World height in rows
+ *
+ * @return If the cell is alive, it will return true otherwise false.
+ */
+static bool isAlive(const uint32_t* world, uint16_t wordsPerRow, int32_t x, int32_t y, uint16_t height)
+{
+    int32_t width   = static_cast<int32_t>(wordsPerRow) * GameOfLife::BITS;
+    int32_t worldX  = ((x % width) + width) % width;
+    int32_t worldY  = ((y % height) + height) % height;
+
+    return (0U != (world[(worldY * wordsPerRow) + (worldX / GameOfLife::BITS)] & (1U << (worldX % GameOfLife::BITS))));
+}
+
+/**
+ * Calculate the next generation cell by cell, by counting the neighbours.
+ * It is the reference for the bit-sliced calculation.
+ *
+ * @param[in]   src         World with the current generation
+ * @param[out]  dst         World for the next generation
+ * @param[in]   wordsPerRow Number of row words per world row
+ * @param[in]   height      World height in rows
+ *
+ * @return Hash of the next generation
+ */
+static uint32_t calculateNextGenerationNaive(const uint32_t* src, uint32_t* dst, uint16_t wordsPerRow, uint16_t height)
+{
+    const int32_t   WIDTH   = static_cast<int32_t>(wordsPerRow) * GameOfLife::BITS;
+    uint32_t        hash    = 2166136261U;
+    int32_t         y       = 0;
+    int32_t         x       = 0;
+
+    for(y = 0; y < height; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
+        {
+            uint32_t*   word        = &dst[(y * wordsPerRow) + (x / GameOfLife::BITS)];
+            uint32_t    mask        = 1U << (x % GameOfLife::BITS);
+            uint8_t     neighbours  = 0U;
+            int32_t     dx          = 0;
+            int32_t     dy          = 0;
+            bool        alive       = isAlive(src, wordsPerRow, x, y, height);
+
+            for(dy = -1; dy <= 1; ++dy)
+            {
+                for(dx = -1; dx <= 1; ++dx)
+                {
+                    if (((0 != dx) || (0 != dy)) &&
+                        (true == isAlive(src, wordsPerRow, x + dx, y + dy, height)))
+                    {
+                        ++neighbours;
+                    }
+                }
+            }
+
+            if ((3U == neighbours) ||
+                ((2U == neighbours) && (true == alive)))
+            {
+                *word |= mask;
+            }
+            else
+            {
+                *word &= ~mask;
+            }
+        }
+    }
+
+    /* Same FNV-1a hash over the row words as the bit-sliced calculation. */
+    for(x = 0; x < (static_cast<int32_t>(wordsPerRow) * height); ++x)
+    {
+        hash ^= dst[x];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+/**
+ * Test the wrap around at the world borders.
+ */
+static void testWrapAround()
+{
+    const uint16_t  WORDS_PER_ROW               = 2U;
+    const uint16_t  HEIGHT                      = 8U;
+    const int32_t   WIDTH                       = WORDS_PER_ROW * GameOfLife::BITS;
+    uint32_t        src[WORDS_PER_ROW * HEIGHT] = { 0U };
+    uint32_t        dst[WORDS_PER_ROW * HEIGHT] = { 0U };
+
+    /* Horizontal blinker in the top row, crossing the left and right border. */
+    src[(0U * WORDS_PER_ROW) + 1U] = 1U << (GameOfLife::BITS - 1U);
+    src[(0U * WORDS_PER_ROW) + 0U] = (1U << 0U) | (1U << 1U);
+
+    (void)GameOfLife::calculateNextGeneration(src, dst, WORDS_PER_ROW, HEIGHT);
+
+    /* Vertical blinker at x = 0, crossing the top and bottom border. */
+    TEST_ASSERT_TRUE(isAlive(dst, WORDS_PER_ROW, 0, HEIGHT - 1, HEIGHT));
+    TEST_ASSERT_TRUE(isAlive(dst, WORDS_PER_ROW, 0, 0, HEIGHT));
+    TEST_ASSERT_TRUE(isAlive(dst, WORDS_PER_ROW, 0, 1, HEIGHT));
+    TEST_ASSERT_FALSE(isAlive(dst, WORDS_PER_ROW, WIDTH - 1, 0, HEIGHT));
+    TEST_ASSERT_FALSE(isAlive(dst, WORDS_PER_ROW, 1, 0, HEIGHT));
+
+    /* And back again. */
+    (void)GameOfLife::calculateNextGeneration(dst, src, WORDS_PER_ROW, HEIGHT);
+
+    TEST_ASSERT_EQUAL_UINT32(1U << (GameOfLife::BITS - 1U), src[(0U * WORDS_PER_ROW) + 1U]);
+    TEST_ASSERT_EQUAL_UINT32((1U << 0U) | (1U << 1U), src[(0U * WORDS_PER_ROW) + 0U]);
+    TEST_ASSERT_EQUAL_UINT32(0U, src[((HEIGHT - 1U) * WORDS_PER_ROW) + 0U]);
+    TEST_ASSERT_EQUAL_UINT32(0U, src[(1U * WORDS_PER_ROW) + 0U]);
+}
+
+/**
+ * Compare the bit-sliced calculation with the naive neighbour count on
+ * random worlds. The world sizes are derived from display sizes like the
+ * plugin does it: the display is scaled by two and the world width is
+ * rounded up to whole row words. Therefore display widths, which are not
+ * a multiple of the row word size, are covered too.
+ */
+static void testRandomWorlds()
+{
+    const uint16_t  DISPLAY_SIZES[][2U] =
+    {
+        /* Width, height */
+        { 1U,  1U  },
+        { 5U,  3U  },
+        { 16U, 8U  },
+        { 20U, 7U  },
+        { 32U, 8U  },
+        { 37U, 16U },
+        { 64U, 16U }
+    };
+    uint8_t         sizeIdx             = 0U;
+
+    randomSeed(0x4C494645U);
+
+    for(sizeIdx = 0U; sizeIdx < UTIL_ARRAY_NUM(DISPLAY_SIZES); ++sizeIdx)
+    {
+        uint16_t    wordsPerRow                         = ((DISPLAY_SIZES[sizeIdx][0U] * 2U) + (GameOfLife::BITS - 1U)) / GameOfLife::BITS;
+        uint16_t    height                              = DISPLAY_SIZES[sizeIdx][1U] * 2U;
+        uint32_t    world[MAX_WORDS_PER_ROW * MAX_HEIGHT] = { 0U };
+        uint32_t    next[MAX_WORDS_PER_ROW * MAX_HEIGHT]  = { 0U };
+        uint32_t    ref[MAX_WORDS_PER_ROW * MAX_HEIGHT]   = { 0U };
+        uint32_t    idx                                 = 0U;
+        uint32_t    generation                          = 0U;
+
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(MAX_WORDS_PER_ROW, wordsPerRow);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(MAX_HEIGHT, height);
+
+        for(idx = 0U; idx < (static_cast<uint32_t>(wordsPerRow) * height); ++idx)
+        {
+            world[idx] = (static_cast<uint32_t>(random(0x10000)) << 16U) | static_cast<uint32_t>(random(0x10000));
+        }
+
+        for(generation = 0U; generation < GENERATIONS; ++generation)
+        {
+            uint32_t hash       = GameOfLife::calculateNextGeneration(world, next, wordsPerRow, height);
+            uint32_t hashRef    = calculateNextGenerationNaive(world, ref, wordsPerRow, height);
+
+            TEST_ASSERT_EQUAL_UINT32_ARRAY(ref, next, static_cast<uint32_t>(wordsPerRow) * height);
+            TEST_ASSERT_EQUAL_UINT32(hashRef, hash);
+
+            for(idx = 0U; idx < (static_cast<uint32_t>(wordsPerRow) * height); ++idx)
+            {
+                world[idx] = next[idx];
+            }
+        }
+    }
+}
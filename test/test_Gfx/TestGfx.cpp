@@ -123,7 +123,9 @@ static void testGfx()
     int16_t     x       = 0;
     int16_t     y       = 0;
     Color       color   = 0U;
+    Color       span[YAGfxTest::WIDTH + 2U];
     YAGfxStaticBitmap<YAGfxTest::WIDTH, YAGfxTest::HEIGHT>  bitmap;
+    YAGfxDynamicBitmap                                      dynamicBitmap(YAGfxTest::WIDTH, YAGfxTest::HEIGHT);
 
     /* Verify screen size */
     TEST_ASSERT_EQUAL_UINT16(YAGfxTest::WIDTH, testGfx.getWidth());
@@ -234,5 +236,39 @@ static void testGfx()
     testGfx.fillScreen(0U);
     TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, YAGfxTest::HEIGHT, 0U));
 
+    /* Test drawing a span, which is clipped on the left and right side. */
+    for(x = 0; x < static_cast<int16_t>(YAGfxTest::WIDTH + 2U); ++x)
+    {
+        span[x] = COLOR;
+    }
+
+    testGfx.drawSpan(-1, 1, span, YAGfxTest::WIDTH + 2U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, 1U, 0U));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 1, YAGfxTest::WIDTH, 1U, COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 2, YAGfxTest::WIDTH, YAGfxTest::HEIGHT - 2U, 0U));
+
+    /* Test drawing a span directly into the bitmap pixel buffers. */
+    span[1] = 0U;
+    bitmap.fillScreen(0U);
+    bitmap.drawSpan(-1, 2, span, 3U);
+    bitmap.drawSpan(YAGfxTest::WIDTH - 1, 3, span, 3U);
+    bitmap.drawSpan(0, YAGfxTest::HEIGHT, span, 3U);
+    bitmap.drawSpan(0, -1, span, 3U);
+    TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(0, 2));
+    TEST_ASSERT_EQUAL_UINT16(COLOR, bitmap.getColor(1, 2));
+    TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(2, 2));
+    TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(YAGfxTest::WIDTH - 2, 3));
+    TEST_ASSERT_EQUAL_UINT16(COLOR, bitmap.getColor(YAGfxTest::WIDTH - 1, 3));
+
+    dynamicBitmap.fillScreen(0U);
+    dynamicBitmap.drawSpan(YAGfxTest::WIDTH - 2, 0, span, 3U);
+    TEST_ASSERT_EQUAL_UINT16(COLOR, dynamicBitmap.getColor(YAGfxTest::WIDTH - 2, 0));
+    TEST_ASSERT_EQUAL_UINT16(0U, dynamicBitmap.getColor(YAGfxTest::WIDTH - 1, 0));
+    TEST_ASSERT_EQUAL_UINT16(0U, dynamicBitmap.getColor(0, 1));
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, YAGfxTest::HEIGHT, 0U));
+
     return;
 }
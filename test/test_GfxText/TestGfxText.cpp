@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include <unity.h>
 #include <YAGfxText.h>
+#include <YAFont.h>
 #include <TomThumb.h>
 #include <Util.h>
 
@@ -55,7 +56,12 @@
  * Prototypes
  *****************************************************************************/
 
+static bool isGlyphPixelSet(const GFXglyph& glyph, uint8_t x, uint8_t y);
 static void testGfxText();
+static void testGlyphCache();
+static void testTextCulling();
+static void testUtf8();
+static void testLargeFont();
 
 /******************************************************************************
  * Local Variables
@@ -91,6 +97,10 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testGfxText);
+    RUN_TEST(testGlyphCache);
+    RUN_TEST(testTextCulling);
+    RUN_TEST(testUtf8);
+    RUN_TEST(testLargeFont);
 
     return UNITY_END();
 }
@@ -115,6 +125,23 @@ extern void tearDown(void)
  * Local Functions
  *****************************************************************************/
 
+/**
+ * Get a single glyph pixel directly from the bit-packed TomThumb bitmap.
+ *
+ * @param[in] glyph The glyph
+ * @param[in] x     x-coordinate inside the glyph
+ * @param[in] y     y-coordinate inside the glyph
+ *
+ * @return If the pixel is set, it will return true otherwise false.
+ */
+static bool isGlyphPixelSet(const GFXglyph& glyph, uint8_t x, uint8_t y)
+{
+    uint16_t    bitIdx  = y * glyph.width + x;
+    uint8_t     bits    = TomThumb.bitmap[glyph.bitmapOffset + (bitIdx / 8U)];
+
+    return (0U != (bits & (0x80U >> (bitIdx % 8U))));
+}
+
 /**
  * Test the text graphic functions.
  */
@@ -172,3 +199,286 @@ static void testGfxText()
 
     return;
 }
+
+/**
+ * Test the glyph cache and the drawing of cached glyphs.
+ */
+static void testGlyphCache()
+{
+    BaseGlyphCache<Color>   glyphCache;
+    YAGfxTest               testGfx;
+    YAGfxText               testGfxText;
+    const Color             COLOR       = 0x1234;
+    const int16_t           CURSOR_X    = 2;
+    const int16_t           CURSOR_Y    = 6;
+    uint16_t                glyphCnt    = TomThumb.last - TomThumb.first + 1U;
+    uint16_t                glyphIdx    = 0U;
+    uint8_t                 pass        = 0U;
+    uint8_t                 x           = 0U;
+    uint8_t                 y           = 0U;
+    const GFXglyph*         glyph       = nullptr;
+    const uint8_t*          mask        = nullptr;
+
+    /* The font has more glyphs than the cache slots, otherwise the eviction is not tested. */
+    TEST_ASSERT_GREATER_THAN_UINT16(BaseGlyphCache<Color>::MAX_SLOTS, glyphCnt);
+    TEST_ASSERT_EQUAL_UINT8(0U, glyphCache.getCachedGlyphCnt());
+
+    /* Every glyph mask must be equal to the glyph bitmap, even if it
+     * was evicted and rasterized again.
+     */
+    for(pass = 0U; pass < 2U; ++pass)
+    {
+        for(glyphIdx = 0U; glyphIdx < glyphCnt; ++glyphIdx)
+        {
+            glyph   = &TomThumb.glyph[glyphIdx];
+            mask    = glyphCache.get(TomThumb, glyphCnt, glyphIdx);
+
+            TEST_ASSERT_NOT_NULL(mask);
+            TEST_ASSERT_EQUAL_UINT8(1U, glyphCache.getBytesPerRow());
+
+            for(y = 0U; y < glyph->height; ++y)
+            {
+                for(x = 0U; x < glyph->width; ++x)
+                {
+                    bool isMaskPixelSet = (0U != (mask[y] & (0x80U >> x)));
+
+                    TEST_ASSERT_EQUAL(isGlyphPixelSet(*glyph, x, y), isMaskPixelSet);
+                }
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(BaseGlyphCache<Color>::MAX_SLOTS, glyphCache.getCachedGlyphCnt());
+
+    /* Release the cache */
+    glyphCache.release();
+    TEST_ASSERT_EQUAL_UINT8(0U, glyphCache.getCachedGlyphCnt());
+
+    /* A drawn cached glyph must look like the glyph bitmap. */
+    testGfxText.setFont(&TomThumb);
+    testGfxText.setTextColor(COLOR);
+    testGfxText.setTextWrap(false);
+
+    for(pass = 0U; pass < 2U; ++pass)
+    {
+        testGfx.fill(0U);
+        testGfxText.setTextCursorPos(CURSOR_X, CURSOR_Y);
+        testGfxText.drawChar(testGfx, 'W');
+
+        glyph = testGfxText.getFont().getGlyph('W');
+        TEST_ASSERT_NOT_NULL(glyph);
+
+        for(y = 0U; y < glyph->height; ++y)
+        {
+            for(x = 0U; x < glyph->width; ++x)
+            {
+                uint32_t expected = (true == isGlyphPixelSet(*glyph, x, y)) ? static_cast<uint32_t>(COLOR) : 0U;
+
+                TEST_ASSERT_EQUAL_UINT32(expected, static_cast<uint32_t>(testGfx.getColor(CURSOR_X + glyph->xOffset + x, CURSOR_Y + glyph->yOffset + y)));
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * Test that characters outside the canvas are skipped.
+ */
+static void testTextCulling()
+{
+    YAGfxTest       testGfx;
+    YAGfxText       testGfxText;
+    const Color     COLOR       = 0x1234;
+    const int16_t   BASELINE    = TomThumb.yAdvance;
+    const GFXglyph* glyph       = nullptr;
+    uint32_t        pixelCnt    = 0U;
+    uint8_t         x           = 0U;
+    uint8_t         y           = 0U;
+
+    testGfxText.setFont(&TomThumb);
+    testGfxText.setTextColor(COLOR);
+    testGfxText.setTextWrap(false);
+
+    glyph = testGfxText.getFont().getGlyph('W');
+    TEST_ASSERT_NOT_NULL(glyph);
+
+    for(y = 0U; y < glyph->height; ++y)
+    {
+        for(x = 0U; x < glyph->width; ++x)
+        {
+            if (true == isGlyphPixelSet(*glyph, x, y))
+            {
+                ++pixelCnt;
+            }
+        }
+    }
+
+    /* Character right of the canvas is skipped, but the cursor moves on. */
+    testGfx.setCallCounterDrawPixel(0U);
+    testGfxText.setTextCursorPos(YAGfxTest::WIDTH, BASELINE);
+    testGfxText.drawChar(testGfx, 'W');
+    TEST_ASSERT_EQUAL_UINT32(0U, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_EQUAL_INT16(YAGfxTest::WIDTH + glyph->xAdvance, testGfxText.getTextCursorPosX());
+
+    /* Character left of the canvas is skipped, but the cursor moves on. */
+    testGfxText.setTextCursorPos(-glyph->xAdvance, BASELINE);
+    testGfxText.drawChar(testGfx, 'W');
+    TEST_ASSERT_EQUAL_UINT32(0U, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_EQUAL_INT16(0, testGfxText.getTextCursorPosX());
+
+    /* Character below the canvas is skipped. */
+    testGfxText.setTextCursorPos(0, YAGfxTest::HEIGHT + BASELINE);
+    testGfxText.drawChar(testGfx, 'W');
+    TEST_ASSERT_EQUAL_UINT32(0U, testGfx.getCallCounterDrawPixel());
+
+    /* The rest of a line right of the canvas is skipped, the next line is drawn. */
+    testGfxText.setTextCursorPos(YAGfxTest::WIDTH - glyph->xAdvance, 0);
+    testGfxText.drawText(testGfx, "WWWW\nW");
+    TEST_ASSERT_EQUAL_UINT32(pixelCnt, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_EQUAL_INT16(glyph->xAdvance, testGfxText.getTextCursorPosX());
+    TEST_ASSERT_EQUAL_INT16(BASELINE, testGfxText.getTextCursorPosY());
+
+    /* Lines below the canvas are not drawn at all. */
+    testGfx.setCallCounterDrawPixel(0U);
+    testGfxText.setTextCursorPos(0, BASELINE);
+    testGfxText.drawText(testGfx, "W\nW");
+    pixelCnt = testGfx.getCallCounterDrawPixel();
+
+    testGfx.setCallCounterDrawPixel(0U);
+    testGfxText.setTextCursorPos(0, BASELINE);
+    testGfxText.drawText(testGfx, "W\nW\nW\nW");
+    TEST_ASSERT_EQUAL_UINT32(pixelCnt, testGfx.getCallCounterDrawPixel());
+
+    return;
+}
+
+/**
+ * Test UTF-8 decoding and the glyph lookup by codepoint.
+ */
+static void testUtf8()
+{
+    YAFont          font(&TomThumb, TomThumbCodepoints);
+    YAGfxText       testGfxText;
+    const char*     text        = nullptr;
+    size_t          idx         = 0U;
+    uint16_t        width       = 0U;
+    uint16_t        height      = 0U;
+    uint16_t        charWidth   = 0U;
+    uint16_t        charHeight  = 0U;
+
+    /* ASCII */
+    text = "A";
+    idx  = 0U;
+    TEST_ASSERT_EQUAL_UINT32(0x41U, Utf8::decode(text, idx));
+    TEST_ASSERT_EQUAL(1U, idx);
+
+    /* 2 byte sequence: a umlaut */
+    text = "\xC3\xA4";
+    idx  = 0U;
+    TEST_ASSERT_EQUAL_UINT32(0xE4U, Utf8::decode(text, idx));
+    TEST_ASSERT_EQUAL(2U, idx);
+
+    /* 3 byte sequence: euro sign */
+    text = "\xE2\x82\xAC";
+    idx  = 0U;
+    TEST_ASSERT_EQUAL_UINT32(0x20ACU, Utf8::decode(text, idx));
+    TEST_ASSERT_EQUAL(3U, idx);
+
+    /* Invalid and overlong sequences are taken as single raw bytes. */
+    text = "\x8E";
+    idx  = 0U;
+    TEST_ASSERT_EQUAL_UINT32(Utf8::RAW_BYTE_BASE + 0x8EU, Utf8::decode(text, idx));
+    TEST_ASSERT_EQUAL(1U, idx);
+
+    text = "\xC0\xAF";
+    idx  = 0U;
+    TEST_ASSERT_TRUE(Utf8::isRawByte(Utf8::decode(text, idx)));
+    TEST_ASSERT_EQUAL(1U, idx);
+
+    /* Truncated sequence */
+    text = "\xE2\x82";
+    idx  = 0U;
+    TEST_ASSERT_TRUE(Utf8::isRawByte(Utf8::decode(text, idx)));
+    TEST_ASSERT_EQUAL(1U, idx);
+
+    /* Glyph lookup in the sparse table */
+    TEST_ASSERT_EQUAL_PTR(font.getGlyph('A'), font.getGlyphByCodepoint(0x41U));
+    TEST_ASSERT_EQUAL_PTR(&TomThumbGlyphs[0xE4U - 0xA1U + 95U], font.getGlyphByCodepoint(0xE4U));
+    TEST_ASSERT_EQUAL_PTR(&TomThumbGlyphs[TomThumb.last - TomThumb.first - 1U], font.getGlyphByCodepoint(0x20ACU));
+    TEST_ASSERT_NULL(font.getGlyphByCodepoint(0xA0U));
+    TEST_ASSERT_NULL(font.getGlyphByCodepoint(0x20ADU));
+
+    /* Legacy raw bytes still address the glyph by its index, e.g. the degree sign. */
+    TEST_ASSERT_EQUAL_PTR(font.getGlyphByCodepoint(0xB0U), font.getGlyphByCodepoint(Utf8::fromChar('\x8E')));
+
+    /* Without table, the codepoint is the glyph index. */
+    font.setGfxFont(&TomThumb);
+    TEST_ASSERT_EQUAL_PTR(font.getGlyph('A'), font.getGlyphByCodepoint(0x41U));
+    TEST_ASSERT_NULL(font.getGlyphByCodepoint(0x20ACU));
+
+    /* A multi-byte character is measured as a single glyph. */
+    font.setGfxFont(&TomThumb, TomThumbCodepoints);
+    testGfxText.setFont(font);
+    TEST_ASSERT_TRUE(font.getCodepointBoundingBox(0xE4U, charWidth, charHeight));
+    TEST_ASSERT_TRUE(testGfxText.getTextBoundingBox(0U, "\xC3\xA4", width, height));
+    TEST_ASSERT_EQUAL_UINT16(charWidth, width);
+    TEST_ASSERT_EQUAL_UINT16(charHeight, height);
+
+    return;
+}
+
+/**
+ * Test a font with more glyphs than a single byte can address.
+ */
+static void testLargeFont()
+{
+    const uint16_t  GLYPH_CNT                   = 300U;
+    const uint16_t  GAP_INDEX                   = 200U;
+    const Color     COLOR                       = 0x1234;
+    const int16_t   CURSOR_Y                    = 1;
+    static uint8_t  bitmap[]                    = { 0x80U, 0x40U };   /* Left pixel, right pixel */
+    static GFXglyph glyphs[GLYPH_CNT];
+    static uint16_t codepoints[GLYPH_CNT];
+    GFXfont         gfxFont                     = { bitmap, glyphs, 0U, 0xFFU, 2U };
+    YAGfxTest       testGfx;
+    uint16_t        idx                         = 0U;
+    int16_t         cursorX                     = 0;
+    int16_t         cursorY                     = CURSOR_Y;
+
+    /* Every glyph shows the left pixel, only the last one the right pixel.
+     * The codepoints have a gap, which enforces the binary search.
+     */
+    for(idx = 0U; idx < GLYPH_CNT; ++idx)
+    {
+        glyphs[idx].bitmapOffset    = 0U;
+        glyphs[idx].width           = 2U;
+        glyphs[idx].height          = 1U;
+        glyphs[idx].xAdvance        = 3U;
+        glyphs[idx].xOffset         = 0;
+        glyphs[idx].yOffset         = -1;
+        codepoints[idx]             = (GAP_INDEX > idx) ? (0x0100U + idx) : (0x1000U + idx);
+    }
+
+    glyphs[GLYPH_CNT - 1U].bitmapOffset = 1U;
+
+    {
+        YAFont  font(&gfxFont, codepoints, GLYPH_CNT);
+        uint8_t mod256Idx   = static_cast<uint8_t>(GLYPH_CNT - 1U);
+
+        TEST_ASSERT_EQUAL_PTR(&glyphs[GLYPH_CNT - 1U], font.getGlyphByCodepoint(codepoints[GLYPH_CNT - 1U]));
+
+        /* The glyph at the 8 bit truncated index is cached first, it must not be drawn instead. */
+        testGfx.fill(0U);
+        font.drawCodepoint(testGfx, cursorX, cursorY, codepoints[mod256Idx], COLOR);
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR), static_cast<uint32_t>(testGfx.getColor(0, 0)));
+        TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(testGfx.getColor(1, 0)));
+
+        font.drawCodepoint(testGfx, cursorX, cursorY, codepoints[GLYPH_CNT - 1U], COLOR);
+        TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(testGfx.getColor(3, 0)));
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(COLOR), static_cast<uint32_t>(testGfx.getColor(4, 0)));
+        TEST_ASSERT_EQUAL_INT16(6, cursorX);
+    }
+
+    return;
+}
@@ -0,0 +1,311 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test GIF decoder.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <GifDecoder.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testGifDecoderAnimation();
+static void testGifDecoderPlayOnce();
+static void testGifDecoderInterlaced();
+static void testGifDecoderLarge();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Animation with 4x4 pixels and 4 frames, which is repeated infinite. */
+static const char*  FILE_NAME_ANIM          = "./test/test_GifDecoder/testAnim.gif";
+
+/** Animation with 2x2 pixels and 2 frames, which is played once. */
+static const char*  FILE_NAME_ONCE          = "./test/test_GifDecoder/testOnce.gif";
+
+/** Interlaced image with 2x10 pixels. */
+static const char*  FILE_NAME_INTERLACED    = "./test/test_GifDecoder/testInterlaced.gif";
+
+/** Image with 128x64 pixels of noise, which fills the LZW table. */
+static const char*  FILE_NAME_LARGE         = "./test/test_GifDecoder/testLarge.gif";
+
+/** Bitmap image file */
+static const char*  FILE_NAME_BMP           = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testGifDecoderAnimation);
+    RUN_TEST(testGifDecoderPlayOnce);
+    RUN_TEST(testGifDecoderInterlaced);
+    RUN_TEST(testGifDecoderLarge);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test frame disposal, transparency, delays and looping.
+ */
+static void testGifDecoderAnimation()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+    int16_t     x           = 0;
+    int16_t     y           = 0;
+
+    TEST_ASSERT_FALSE(decoder.isOpen());
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, decoder.next());
+
+    /* Not existing file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, decoder.open(localFileSystem, "./notExisting.gif"));
+    TEST_ASSERT_FALSE(decoder.isOpen());
+
+    /* Bitmap image file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, decoder.open(localFileSystem, FILE_NAME_BMP));
+    TEST_ASSERT_FALSE(decoder.isOpen());
+
+    /* Frame 1: Full canvas red */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.open(localFileSystem, FILE_NAME_ANIM));
+    TEST_ASSERT_TRUE(decoder.isOpen());
+    TEST_ASSERT_EQUAL_UINT16(4U, decoder.getFrame().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(4U, decoder.getFrame().getHeight());
+    TEST_ASSERT_EQUAL_UINT32(100U, decoder.getDelay());
+
+    for(y = 0; y < 4; ++y)
+    {
+        for(x = 0; x < 4; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(x, y));
+        }
+    }
+
+    /* Frame 2: Blue square with a transparent pixel in the middle. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_EQUAL_UINT32(200U, decoder.getDelay());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, decoder.getFrame().getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(2, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, decoder.getFrame().getColor(1, 2));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, decoder.getFrame().getColor(2, 2));
+
+    /* Frame 3: The square is restored to the background, without delay the default is used. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_EQUAL_UINT32(100U, decoder.getDelay());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, decoder.getFrame().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, decoder.getFrame().getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, decoder.getFrame().getColor(2, 2));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(3, 3));
+
+    /* Frame 4: The previous canvas is restored, the pixel uses a local color table. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_EQUAL_UINT32(50U, decoder.getDelay());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, decoder.getFrame().getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::WHITE, decoder.getFrame().getColor(3, 3));
+
+    /* Infinite loop, so it starts with frame 1 again. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_FALSE(decoder.isFinished());
+    TEST_ASSERT_EQUAL_UINT32(100U, decoder.getDelay());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(3, 3));
+
+    /* A copy continues with the current frame. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    {
+        GifDecoder copy(decoder);
+
+        TEST_ASSERT_TRUE(copy.isOpen());
+        TEST_ASSERT_EQUAL_UINT32(200U, copy.getDelay());
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, copy.getFrame().getColor(1, 1));
+
+        TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, copy.next());
+        TEST_ASSERT_EQUAL_UINT32(100U, copy.getDelay());
+        TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, copy.getFrame().getColor(0, 0));
+    }
+
+    /* A suspended animation continues with the next frame. */
+    decoder.suspend();
+    TEST_ASSERT_TRUE(decoder.isOpen());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, decoder.getFrame().getColor(1, 1));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, decoder.getFrame().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLACK, decoder.getFrame().getColor(1, 1));
+
+    decoder.close();
+    TEST_ASSERT_FALSE(decoder.isOpen());
+}
+
+/**
+ * Test that a animation without loop count is played once.
+ */
+static void testGifDecoderPlayOnce()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.open(localFileSystem, FILE_NAME_ONCE));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, decoder.getFrame().getColor(1, 1));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_FALSE(decoder.isFinished());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, decoder.getFrame().getColor(1, 1));
+
+    /* The last frame stays, it is not disposed. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_TRUE(decoder.isFinished());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, decoder.getFrame().getColor(1, 1));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.next());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::LIME, decoder.getFrame().getColor(1, 1));
+}
+
+/**
+ * Test a interlaced image.
+ */
+static void testGifDecoderInterlaced()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+    int16_t     y           = 0;
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.open(localFileSystem, FILE_NAME_INTERLACED));
+    TEST_ASSERT_EQUAL_UINT16(2U, decoder.getFrame().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(10U, decoder.getFrame().getHeight());
+
+    /* The red channel contains the row number. */
+    for(y = 0; y < 10; ++y)
+    {
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(y * 16) << 16U, decoder.getFrame().getColor(0, y));
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(y * 16) << 16U, decoder.getFrame().getColor(1, y));
+    }
+}
+
+/**
+ * Test a image, which fills the LZW table.
+ */
+static void testGifDecoderLarge()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+    uint32_t    seed        = 1U;
+    int16_t     x           = 0;
+    int16_t     y           = 0;
+    uint32_t    errCnt      = 0U;
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, decoder.open(localFileSystem, FILE_NAME_LARGE));
+    TEST_ASSERT_EQUAL_UINT16(128U, decoder.getFrame().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(64U, decoder.getFrame().getHeight());
+
+    /* The color indices are pseudo random and the color table is (i, 255 - i, i ^ 0x55). */
+    for(y = 0; y < 64; ++y)
+    {
+        for(x = 0; x < 128; ++x)
+        {
+            uint32_t    idx     = 0U;
+            uint32_t    color   = 0U;
+
+            seed    = (seed * 1103515245U + 12345U) & 0x7FFFFFFFU;
+            idx     = (seed >> 16U) & 0xFFU;
+            color   = (idx << 16U) | ((255U - idx) << 8U) | (idx ^ 0x55U);
+
+            if (color != decoder.getFrame().getColor(x, y))
+            {
+                ++errCnt;
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0U, errCnt);
+}
@@ -0,0 +1,302 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Goertzel filter bank tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <math.h>
+#include <Util.h>
+#include <GoertzelBank.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void generateTones(int32_t* samples, const float* freqs, const float* amplitudes, uint8_t count);
+static float calculateReference(const int32_t* samples, float freq);
+static void testSingleTone();
+static void testMultipleTones();
+static void testDisabledTone();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of samples per block. */
+static const uint32_t   SAMPLES     = 512U;
+
+/** Sample rate in Hz. */
+static const uint32_t   SAMPLE_RATE = 14080U;
+
+/** Max. number of tones. */
+static const uint8_t    MAX_TONES   = 4U;
+
+/** Filter bank under test. */
+typedef GoertzelBank<SAMPLES, MAX_TONES> TestBank;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testSingleTone);
+    RUN_TEST(testMultipleTones);
+    RUN_TEST(testDisabledTone);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Generate a sample block with the sum of several sinusoidal tones.
+ *
+ * @param[out]  samples     Sample block, SAMPLES values.
+ * @param[in]   freqs       Frequency of every tone in Hz
+ * @param[in]   amplitudes  Amplitude of every tone
+ * @param[in]   count       Number of tones
+ */
+static void generateTones(int32_t* samples, const float* freqs, const float* amplitudes, uint8_t count)
+{
+    uint32_t idx = 0U;
+
+    for(idx = 0U; idx < SAMPLES; ++idx)
+    {
+        double  value   = 0.0;
+        uint8_t tone    = 0U;
+
+        for(tone = 0U; tone < count; ++tone)
+        {
+            value += amplitudes[tone] * sin((2.0 * M_PI * freqs[tone] * idx) / SAMPLE_RATE);
+        }
+
+        samples[idx] = static_cast<int32_t>(lround(value));
+    }
+}
+
+/**
+ * Calculate the magnitude of a single tone like the audio tone detector did
+ * before, with the window calculated for every sample.
+ *
+ * @param[in] samples   Sample block, SAMPLES values.
+ * @param[in] freq      Target frequency in Hz
+ *
+ * @return Magnitude
+ */
+static float calculateReference(const int32_t* samples, float freq)
+{
+    uint32_t    bin     = static_cast<uint32_t>(0.5F + ((SAMPLES * freq) / SAMPLE_RATE));
+    double      omega   = (2.0 * M_PI * bin) / SAMPLES;
+    double      coeff   = 2.0 * cos(omega);
+    double      q1      = 0.0;
+    double      q2      = 0.0;
+    double      realValue;
+    double      imagValue;
+    uint32_t    idx;
+
+    for(idx = 0U; idx < SAMPLES; ++idx)
+    {
+        double window   = 0.54 - 0.46 * cos((2.0 * M_PI * idx) / SAMPLES);
+        double q0       = coeff * q1 - q2 + samples[idx] * window;
+
+        q2 = q1;
+        q1 = q0;
+    }
+
+    realValue = (q1 - q2 * cos(omega)) / (SAMPLES / 2.0);
+    imagValue = (q2 * sin(omega)) / (SAMPLES / 2.0);
+
+    return static_cast<float>(2.0 * sqrt(realValue * realValue + imagValue * imagValue));
+}
+
+/**
+ * Test the magnitude of a single tone.
+ */
+static void testSingleTone()
+{
+    TestBank    bank;
+    int32_t     samples[SAMPLES];
+    float       magnitudes[MAX_TONES];
+    float       freq        = 1000.0F;
+    float       amplitude   = 100000.0F;
+    float       reference   = 0.0F;
+
+    generateTones(samples, &freq, &amplitude, 1U);
+    reference = calculateReference(samples, freq);
+
+    bank.setTargetFreq(0U, freq, SAMPLE_RATE);
+    TEST_ASSERT_TRUE(bank.isEnabled(0U));
+    TEST_ASSERT_FALSE(bank.isEnabled(1U));
+
+    bank.calculate(samples, magnitudes);
+
+    /* Same result like the single tone calculation. */
+    TEST_ASSERT_FLOAT_WITHIN(reference * 0.0001F, reference, magnitudes[0]);
+
+    /* The target frequency is near the bin, therefore the windowed
+     * magnitude is close to the amplitude.
+     */
+    TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.15F, amplitude, magnitudes[0]);
+
+    /* Disabled tones are 0. */
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, magnitudes[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, magnitudes[2]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, magnitudes[3]);
+}
+
+/**
+ * Test several tones in a single pass.
+ */
+static void testMultipleTones()
+{
+    TestBank    bank;
+    int32_t     samples[SAMPLES];
+    float       magnitudes[MAX_TONES];
+    const float freqs[]         = { 697.0F, 1209.0F };
+    const float amplitudes[]    = { 50000.0F, 80000.0F };
+    const float targetFreqs[]   = { 697.0F, 1209.0F, 3000.0F, 5000.0F };
+    uint8_t     idx             = 0U;
+
+    generateTones(samples, freqs, amplitudes, UTIL_ARRAY_NUM(freqs));
+
+    /* Configure in different order, the tone id shall be kept. */
+    for(idx = MAX_TONES; idx > 0U; --idx)
+    {
+        bank.setTargetFreq(idx - 1U, targetFreqs[idx - 1U], SAMPLE_RATE);
+    }
+
+    bank.calculate(samples, magnitudes);
+
+    for(idx = 0U; idx < MAX_TONES; ++idx)
+    {
+        float reference = calculateReference(samples, targetFreqs[idx]);
+
+        TEST_ASSERT_TRUE(bank.isEnabled(idx));
+        TEST_ASSERT_FLOAT_WITHIN(amplitudes[0] * 0.0001F, reference, magnitudes[idx]);
+    }
+
+    /* The present tones are clearly above the absent ones. */
+    TEST_ASSERT_GREATER_THAN(static_cast<int32_t>(amplitudes[0] / 2.0F), static_cast<int32_t>(magnitudes[0]));
+    TEST_ASSERT_GREATER_THAN(static_cast<int32_t>(amplitudes[1] / 2.0F), static_cast<int32_t>(magnitudes[1]));
+    TEST_ASSERT_LESS_THAN(static_cast<int32_t>(amplitudes[0] / 20.0F), static_cast<int32_t>(magnitudes[2]));
+    TEST_ASSERT_LESS_THAN(static_cast<int32_t>(amplitudes[0] / 20.0F), static_cast<int32_t>(magnitudes[3]));
+}
+
+/**
+ * Test enabling and disabling of tones.
+ */
+static void testDisabledTone()
+{
+    TestBank    bank;
+    int32_t     samples[SAMPLES];
+    float       magnitudes[MAX_TONES];
+    float       freq        = 2000.0F;
+    float       amplitude   = 10000.0F;
+
+    generateTones(samples, &freq, &amplitude, 1U);
+
+    /* Initially all tones are disabled. */
+    bank.calculate(samples, magnitudes);
+    TEST_ASSERT_FALSE(bank.isEnabled(0U));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, magnitudes[0]);
+
+    /* Setting the same frequency twice keeps a single tone. */
+    bank.setTargetFreq(2U, freq, SAMPLE_RATE);
+    bank.setTargetFreq(2U, freq, SAMPLE_RATE);
+    bank.calculate(samples, magnitudes);
+    TEST_ASSERT_TRUE(bank.isEnabled(2U));
+    TEST_ASSERT_FLOAT_WITHIN(amplitude * 0.0001F, calculateReference(samples, freq), magnitudes[2]);
+
+    /* 0 Hz disables the tone. */
+    bank.setTargetFreq(2U, 0.0F, SAMPLE_RATE);
+    bank.calculate(samples, magnitudes);
+    TEST_ASSERT_FALSE(bank.isEnabled(2U));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, magnitudes[2]);
+
+    /* Invalid tone ids are ignored. */
+    bank.setTargetFreq(MAX_TONES, freq, SAMPLE_RATE);
+    TEST_ASSERT_FALSE(bank.isEnabled(MAX_TONES));
+}
@@ -0,0 +1,359 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test image cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <FS.h>
+#include <ImageCache.h>
+#include <Util.h>
+
+#include "../common/BmpFile.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t getWhite(uint16_t x, uint16_t y);
+static bool clearBmpPixels(const char* fileName);
+static void testImageCache();
+static void testImageCacheLru();
+static void testImageCacheFileChange();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Image file with 2x2 pixels. */
+static const char*  FILE_NAME_A     = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/** Image file with 2x2 pixels. */
+static const char*  FILE_NAME_B     = "./test/test_BmpImgLoader/test8bpp.bmp";
+
+/** Image file with 2x2 pixels. */
+static const char*  FILE_NAME_C     = "./test/test_BmpImgLoader/test4bpp.bmp";
+
+/** Name of the temporary generated bitmap file. */
+static const char*  TMP_FILE_NAME   = "./testImageCache.bmp";
+
+/** Memory in bytes of a 2x2 pixel image. */
+static const size_t IMAGE_SIZE      = 2U * 2U * sizeof(Color);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testImageCache);
+    RUN_TEST(testImageCacheLru);
+    RUN_TEST(testImageCacheFileChange);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    ImageCache::getInstance().setBudget(ImageCache::DEFAULT_BUDGET);
+    ImageCache::getInstance().clear();
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(TMP_FILE_NAME);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the color of a white image.
+ *
+ * @param[in] x x-coordinate
+ * @param[in] y y-coordinate
+ *
+ * @return Color in RGB24 format
+ */
+static uint32_t getWhite(uint16_t x, uint16_t y)
+{
+    UTIL_NOT_USED(x);
+    UTIL_NOT_USED(y);
+
+    return 0xFFFFFFU;
+}
+
+/**
+ * Overwrite the pixels of a bitmap file, created by BmpFile::create(), with
+ * black. The file size and its last write time are kept.
+ *
+ * @param[in] fileName  Name of the bitmap file
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool clearBmpPixels(const char* fileName)
+{
+    bool            isSuccessful    = false;
+    struct stat     fileStat;
+    struct utimbuf  times;
+
+    if (0 == stat(fileName, &fileStat))
+    {
+        FILE* fd = fopen(fileName, "r+b");
+
+        if (nullptr != fd)
+        {
+            long idx = 0;
+
+            if (0 == fseek(fd, 14L + 40L, SEEK_SET))
+            {
+                for(idx = 14L + 40L; idx < static_cast<long>(fileStat.st_size); ++idx)
+                {
+                    (void)fputc(0x00, fd);
+                }
+            }
+
+            fclose(fd);
+
+            times.actime    = fileStat.st_atime;
+            times.modtime   = fileStat.st_mtime;
+
+            isSuccessful = (0 == utime(fileName, &times));
+        }
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Test sharing of cached images.
+ */
+static void testImageCache()
+{
+    ImageCache&         cache   = ImageCache::getInstance();
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+    ImageCache::Handle  handle1;
+    ImageCache::Handle  handle2;
+
+    /* Not existing file */
+    handle1 = cache.load(localFileSystem, "./notExisting.bmp", ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, ret);
+    TEST_ASSERT_FALSE(handle1.isValid());
+    TEST_ASSERT_NULL(handle1.get());
+    TEST_ASSERT_EQUAL_UINT32(0U, cache.getEntryCnt());
+
+    /* The image is decoded once and shared. */
+    handle1 = cache.load(localFileSystem, FILE_NAME_A, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_TRUE(handle1.isValid());
+    TEST_ASSERT_EQUAL_UINT16(2U, handle1.get()->getWidth());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, handle1.get()->getColor(0, 0));
+
+    handle2 = cache.load(localFileSystem, FILE_NAME_A, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_PTR(handle1.get(), handle2.get());
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+    TEST_ASSERT_EQUAL(IMAGE_SIZE, cache.getSize());
+
+    /* A copied handle refers to the same image. */
+    {
+        ImageCache::Handle handle3(handle1);
+
+        TEST_ASSERT_EQUAL_PTR(handle1.get(), handle3.get());
+    }
+
+    /* A referenced image is not evicted. */
+    handle1.release();
+    TEST_ASSERT_FALSE(handle1.isValid());
+    cache.clear();
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, handle2.get()->getColor(0, 0));
+
+    /* A not referenced image stays in the cache as long as the budget allows it. */
+    handle2.release();
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+
+    cache.setBudget(0U);
+    TEST_ASSERT_EQUAL_UINT32(0U, cache.getEntryCnt());
+    TEST_ASSERT_EQUAL(0U, cache.getSize());
+
+    /* Without budget, an image is evicted with its last reference. */
+    handle1 = cache.load(localFileSystem, FILE_NAME_A, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+    handle1.release();
+    TEST_ASSERT_EQUAL_UINT32(0U, cache.getEntryCnt());
+}
+
+/**
+ * Test that the least recently used image is evicted.
+ */
+static void testImageCacheLru()
+{
+    ImageCache&         cache   = ImageCache::getInstance();
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+    ImageCache::Handle  handle;
+
+    cache.setBudget(2U * IMAGE_SIZE);
+
+    /* Load A and B, then use A again. */
+    handle = cache.load(localFileSystem, FILE_NAME_A, ret);
+    handle = cache.load(localFileSystem, FILE_NAME_B, ret);
+    handle = cache.load(localFileSystem, FILE_NAME_A, ret);
+    handle.release();
+    TEST_ASSERT_EQUAL_UINT32(2U, cache.getEntryCnt());
+
+    /* Loading C evicts B, which is the least recently used one. */
+    handle = cache.load(localFileSystem, FILE_NAME_C, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT32(2U, cache.getEntryCnt());
+    TEST_ASSERT_EQUAL(2U * IMAGE_SIZE, cache.getSize());
+
+    /* C is referenced, therefore A is evicted, if B is loaded again. */
+    handle = cache.load(localFileSystem, FILE_NAME_B, ret);
+    handle = cache.load(localFileSystem, FILE_NAME_C, ret);
+    TEST_ASSERT_EQUAL_UINT32(2U, cache.getEntryCnt());
+
+    handle.release();
+    cache.setBudget(IMAGE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+
+    /* C was used last, so it must be still available without decoding. */
+    handle = cache.load(localFileSystem, FILE_NAME_C, ret);
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+    TEST_ASSERT_EQUAL(IMAGE_SIZE, cache.getSize());
+}
+
+/**
+ * Test that a changed image file is decoded again.
+ */
+static void testImageCacheFileChange()
+{
+    ImageCache&         cache   = ImageCache::getInstance();
+    FS                  localFileSystem;
+    BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+    ImageCache::Handle  handle1;
+    ImageCache::Handle  handle2;
+
+    TEST_ASSERT_TRUE(BmpFile::create(TMP_FILE_NAME, 2U, 2U, getWhite));
+    handle1 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT16(2U, handle1.get()->getWidth());
+
+    /* The file changes, the old image stays valid as long as it is referenced. */
+    TEST_ASSERT_TRUE(BmpFile::create(TMP_FILE_NAME, 4U, 4U, getWhite));
+    handle2 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT16(4U, handle2.get()->getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2U, handle1.get()->getWidth());
+    TEST_ASSERT_EQUAL_UINT32(2U, cache.getEntryCnt());
+
+    /* The stale image is evicted with its last reference. */
+    handle1.release();
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+
+    handle1 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL_PTR(handle2.get(), handle1.get());
+
+    handle1.release();
+    handle2.release();
+
+    /* The file is rewritten with the same size and within the resolution of
+     * the last write time. The change is only detected by invalidation.
+     */
+    TEST_ASSERT_TRUE(BmpFile::create(TMP_FILE_NAME, 2U, 2U, getWhite));
+    handle1 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFU, static_cast<uint32_t>(handle1.get()->getColor(0, 0)));
+    TEST_ASSERT_TRUE(clearBmpPixels(TMP_FILE_NAME));
+
+    handle2 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL_PTR(handle1.get(), handle2.get());
+    handle2.release();
+
+    cache.invalidate(TMP_FILE_NAME);
+    handle2 = cache.load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_NOT_EQUAL(handle1.get(), handle2.get());
+    TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(handle2.get()->getColor(0, 0)));
+
+    /* The invalidated image stays valid as long as it is referenced. */
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFU, static_cast<uint32_t>(handle1.get()->getColor(0, 0)));
+    handle1.release();
+    TEST_ASSERT_EQUAL_UINT32(1U, cache.getEntryCnt());
+}
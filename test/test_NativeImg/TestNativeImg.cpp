@@ -0,0 +1,335 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test native image file.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <FS.h>
+#include <NativeImg.h>
+#include <ImageCache.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool copyFile(const char* srcFileName, const char* dstFileName);
+static long getFileSize(const char* fileName);
+static void testNativeImgRaw();
+static void testNativeImgRle();
+static void testNativeImgTranscode();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Bitmap image file with 2x2 pixels. */
+static const char*  BMP_FILE_NAME   = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/** Name of the temporary native image file. */
+static const char*  TMP_FILE_NAME   = "./testNativeImg.bmp";
+
+/** Size of the native image file header in bytes. */
+static const long   HEADER_SIZE     = 20;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testNativeImgRaw);
+    RUN_TEST(testNativeImgRle);
+    RUN_TEST(testNativeImgTranscode);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(TMP_FILE_NAME);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Copy a file.
+ *
+ * @param[in] srcFileName   Name of the source file
+ * @param[in] dstFileName   Name of the destination file
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool copyFile(const char* srcFileName, const char* dstFileName)
+{
+    FILE*   src = fopen(srcFileName, "rb");
+    FILE*   dst = fopen(dstFileName, "wb");
+    int     ch  = 0;
+
+    if ((nullptr == src) ||
+        (nullptr == dst))
+    {
+        if (nullptr != src)
+        {
+            fclose(src);
+        }
+
+        if (nullptr != dst)
+        {
+            fclose(dst);
+        }
+
+        return false;
+    }
+
+    while(EOF != (ch = fgetc(src)))
+    {
+        (void)fputc(ch, dst);
+    }
+
+    fclose(src);
+    fclose(dst);
+
+    return true;
+}
+
+/**
+ * Get the size of a file.
+ *
+ * @param[in] fileName  Name of the file
+ *
+ * @return File size in bytes or -1 in case of an error.
+ */
+static long getFileSize(const char* fileName)
+{
+    long    size    = -1;
+    FILE*   fd      = fopen(fileName, "rb");
+
+    if (nullptr != fd)
+    {
+        if (0 == fseek(fd, 0, SEEK_END))
+        {
+            size = ftell(fd);
+        }
+
+        fclose(fd);
+    }
+
+    return size;
+}
+
+/**
+ * Test native image with raw pixels.
+ */
+static void testNativeImgRaw()
+{
+    NativeImg           nativeImg;
+    FS                  localFileSystem;
+    YAGfxDynamicBitmap  bitmap;
+    YAGfxDynamicBitmap  loadedBitmap;
+    NativeImg::Meta     meta;
+    int16_t             x           = 0;
+    int16_t             y           = 0;
+
+    /* Every pixel is different, so there is no benefit of the run-length encoding. */
+    TEST_ASSERT_TRUE(bitmap.create(3U, 2U));
+
+    for(y = 0; y < 2; ++y)
+    {
+        for(x = 0; x < 3; ++x)
+        {
+            bitmap.drawPixel(x, y, Color(x * 16U, y * 16U, 0xAAU));
+        }
+    }
+
+    /* Invalid image */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_INVALID, nativeImg.save(localFileSystem, TMP_FILE_NAME, loadedBitmap));
+
+    /* Not existing file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, nativeImg.load(localFileSystem, "./notExisting.bmp", loadedBitmap));
+
+    /* Bitmap image file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, nativeImg.load(localFileSystem, BMP_FILE_NAME, loadedBitmap));
+    TEST_ASSERT_FALSE(loadedBitmap.isAllocated());
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.save(localFileSystem, TMP_FILE_NAME, bitmap));
+    TEST_ASSERT_EQUAL(HEADER_SIZE + 3 * 2 * sizeof(Color), getFileSize(TMP_FILE_NAME));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TMP_FILE_NAME, loadedBitmap, &meta));
+    TEST_ASSERT_EQUAL_UINT16(3U, loadedBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2U, loadedBitmap.getHeight());
+
+    for(y = 0; y < 2; ++y)
+    {
+        for(x = 0; x < 3; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(bitmap.getColor(x, y)), static_cast<uint32_t>(loadedBitmap.getColor(x, y)));
+        }
+    }
+
+    /* Without metadata, the whole image is a single frame. */
+    TEST_ASSERT_EQUAL_UINT16(3U, meta.frameWidth);
+    TEST_ASSERT_EQUAL_UINT16(2U, meta.frameHeight);
+    TEST_ASSERT_EQUAL_UINT8(1U, meta.frameCnt);
+    TEST_ASSERT_TRUE(meta.isRepeat);
+}
+
+/**
+ * Test native image with run-length encoded pixels.
+ */
+static void testNativeImgRle()
+{
+    NativeImg           nativeImg;
+    FS                  localFileSystem;
+    YAGfxDynamicBitmap  bitmap;
+    YAGfxDynamicBitmap  loadedBitmap;
+    NativeImg::Meta     meta        = { 10U, 20U, 2U, 5U, false };
+    NativeImg::Meta     loadedMeta;
+
+    /* 400 pixels with the same color need more than one packet. */
+    TEST_ASSERT_TRUE(bitmap.create(10U, 40U));
+    bitmap.fillScreen(ColorDef::RED);
+    bitmap.drawPixel(9, 39, ColorDef::BLUE);
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.save(localFileSystem, TMP_FILE_NAME, bitmap, &meta));
+    TEST_ASSERT_EQUAL(HEADER_SIZE + 3 * (1 + sizeof(Color)), getFileSize(TMP_FILE_NAME));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TMP_FILE_NAME, loadedBitmap, &loadedMeta));
+    TEST_ASSERT_EQUAL_UINT16(10U, loadedBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(40U, loadedBitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, static_cast<uint32_t>(loadedBitmap.getColor(0, 0)));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, static_cast<uint32_t>(loadedBitmap.getColor(5, 25)));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::RED, static_cast<uint32_t>(loadedBitmap.getColor(8, 39)));
+    TEST_ASSERT_EQUAL_UINT32(ColorDef::BLUE, static_cast<uint32_t>(loadedBitmap.getColor(9, 39)));
+
+    TEST_ASSERT_EQUAL_UINT16(meta.frameWidth, loadedMeta.frameWidth);
+    TEST_ASSERT_EQUAL_UINT16(meta.frameHeight, loadedMeta.frameHeight);
+    TEST_ASSERT_EQUAL_UINT8(meta.frameCnt, loadedMeta.frameCnt);
+    TEST_ASSERT_EQUAL_UINT8(meta.fps, loadedMeta.fps);
+    TEST_ASSERT_FALSE(loadedMeta.isRepeat);
+}
+
+/**
+ * Test transcoding of a bitmap image file.
+ */
+static void testNativeImgTranscode()
+{
+    NativeImg           nativeImg;
+    BmpImgLoader        loader;
+    FS                  localFileSystem;
+    YAGfxDynamicBitmap  bmpBitmap;
+    YAGfxDynamicBitmap  nativeBitmap;
+    BmpImgLoader::Ret   ret         = BmpImgLoader::RET_OK;
+    ImageCache::Handle  handle;
+    long                fileSize    = 0;
+    int16_t             x           = 0;
+    int16_t             y           = 0;
+
+    /* Not existing file */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, nativeImg.transcode(localFileSystem, "./notExisting.bmp"));
+
+    TEST_ASSERT_TRUE(copyFile(BMP_FILE_NAME, TMP_FILE_NAME));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, TMP_FILE_NAME, bmpBitmap));
+
+    /* The file keeps its name. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.transcode(localFileSystem, TMP_FILE_NAME));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, loader.load(localFileSystem, TMP_FILE_NAME, nativeBitmap));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.load(localFileSystem, TMP_FILE_NAME, nativeBitmap));
+
+    for(y = 0; y < 2; ++y)
+    {
+        for(x = 0; x < 2; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(bmpBitmap.getColor(x, y)), static_cast<uint32_t>(nativeBitmap.getColor(x, y)));
+        }
+    }
+
+    /* A native image is not transcoded again. */
+    fileSize = getFileSize(TMP_FILE_NAME);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.transcode(localFileSystem, TMP_FILE_NAME));
+    TEST_ASSERT_EQUAL(fileSize, getFileSize(TMP_FILE_NAME));
+
+    /* The image cache detects the native image by its signature. */
+    handle = ImageCache::getInstance().load(localFileSystem, TMP_FILE_NAME, ret);
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, ret);
+    TEST_ASSERT_TRUE(handle.isValid());
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(bmpBitmap.getColor(1, 1)), static_cast<uint32_t>(handle.get()->getColor(1, 1)));
+}
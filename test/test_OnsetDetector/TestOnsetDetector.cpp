@@ -0,0 +1,276 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Onset detector tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <OnsetDetector.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Number of frequency bins, like the spectrum analyzer. */
+static const uint32_t   BINS        = 256U;
+
+/** Onset detector under test. */
+typedef OnsetDetector<BINS> TestDetector;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void generateSpectrum(float* bins, float level, uint32_t frame);
+static uint32_t runBeats(TestDetector& detector, uint32_t beatInterval, uint32_t duration, uint32_t& falseOnsets);
+static void testSensitivity();
+static void testSilence();
+static void testBeats();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Time between two spectra in ms. */
+static const uint32_t   FRAME_PERIOD    = 18U;
+
+/** Frequency bins, which are too large for the stack. */
+static float            gBins[BINS];
+
+/** The detector is too large for the stack. */
+static TestDetector     gDetector;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testSensitivity);
+    RUN_TEST(testSilence);
+    RUN_TEST(testBeats);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    gDetector.reset();
+    gDetector.setSensitivity(TestDetector::SENSITIVITY_DEFAULT);
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Generate a spectrum with a noisy background.
+ *
+ * @param[out]  bins    Frequency bins
+ * @param[in]   level   Level of the spectrum
+ * @param[in]   frame   Frame number, used to vary the background.
+ */
+static void generateSpectrum(float* bins, float level, uint32_t frame)
+{
+    uint32_t idx = 0U;
+
+    for(idx = 0U; idx < BINS; ++idx)
+    {
+        /* Deterministic variation of +-10%. */
+        uint32_t    hash    = (idx * 2654435761U) ^ (frame * 40503U);
+        float       noise   = static_cast<float>((hash >> 8U) % 21U) / 100.0F - 0.1F;
+
+        bins[idx] = level * (1.0F + noise);
+    }
+}
+
+/**
+ * Feed the detector with a beat, which decays over some frames.
+ *
+ * @param[in]   detector        Onset detector
+ * @param[in]   beatInterval    Interval between two beats in ms
+ * @param[in]   duration        Duration in ms
+ * @param[out]  falseOnsets     Number of onsets, which are not at a beat.
+ *
+ * @return Number of detected onsets
+ */
+static uint32_t runBeats(TestDetector& detector, uint32_t beatInterval, uint32_t duration, uint32_t& falseOnsets)
+{
+    const float BACKGROUND  = 1000.0F;
+    const float BEAT        = 30000.0F;
+    uint32_t    onsets      = 0U;
+    uint32_t    frame       = 0U;
+    uint32_t    nextBeat    = beatInterval;
+    float       level       = BACKGROUND;
+
+    falseOnsets = 0U;
+
+    for(frame = 0U; (frame * FRAME_PERIOD) < duration; ++frame)
+    {
+        uint32_t    timestamp   = frame * FRAME_PERIOD;
+        bool        isBeat      = false;
+
+        if (nextBeat <= timestamp)
+        {
+            level       = BEAT;
+            isBeat      = true;
+            nextBeat   += beatInterval;
+        }
+        else
+        {
+            /* Decay to the background. */
+            level = BACKGROUND + (level - BACKGROUND) * 0.6F;
+        }
+
+        generateSpectrum(gBins, level, frame);
+
+        if (true == detector.process(gBins, timestamp))
+        {
+            ++onsets;
+
+            if (false == isBeat)
+            {
+                ++falseOnsets;
+            }
+        }
+    }
+
+    return onsets;
+}
+
+/**
+ * Check the sensitivity parameter.
+ */
+static void testSensitivity()
+{
+    TEST_ASSERT_EQUAL_FLOAT(TestDetector::SENSITIVITY_DEFAULT, gDetector.getSensitivity());
+
+    gDetector.setSensitivity(2.5F);
+    TEST_ASSERT_EQUAL_FLOAT(2.5F, gDetector.getSensitivity());
+
+    gDetector.setSensitivity(0.0F);
+    TEST_ASSERT_EQUAL_FLOAT(2.5F, gDetector.getSensitivity());
+
+    TEST_ASSERT_FALSE(gDetector.process(nullptr, 0U));
+}
+
+/**
+ * Silence and a constant noisy background shall not result in any onset.
+ */
+static void testSilence()
+{
+    uint32_t frame = 0U;
+
+    for(frame = 0U; frame < 200U; ++frame)
+    {
+        generateSpectrum(gBins, 0.0F, frame);
+        TEST_ASSERT_FALSE(gDetector.process(gBins, frame * FRAME_PERIOD));
+    }
+
+    /* The step from silence to the background is an onset itself. */
+    gDetector.reset();
+
+    for(frame = 0U; frame < 200U; ++frame)
+    {
+        generateSpectrum(gBins, 1000.0F, frame);
+        TEST_ASSERT_FALSE(gDetector.process(gBins, frame * FRAME_PERIOD));
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, gDetector.getTempo());
+}
+
+/**
+ * Every beat shall be detected in the spectrum it appears and the tempo
+ * shall be estimated.
+ */
+static void testBeats()
+{
+    uint32_t falseOnsets    = 0U;
+    uint32_t onsets         = 0U;
+
+    /* 120 BPM for 10 s */
+    onsets = runBeats(gDetector, 500U, 10000U, falseOnsets);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, falseOnsets);
+    TEST_ASSERT_EQUAL_UINT32(19U, onsets);
+    TEST_ASSERT_TRUE(0.0F < gDetector.getThreshold());
+    TEST_ASSERT_FLOAT_WITHIN(3.0F, 120.0F, gDetector.getTempo());
+
+    /* The tempo shall follow the music, here 90 BPM for 20 s. */
+    onsets = runBeats(gDetector, 667U, 20000U, falseOnsets);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, falseOnsets);
+    TEST_ASSERT_EQUAL_UINT32(29U, onsets);
+    TEST_ASSERT_FLOAT_WITHIN(3.0F, 90.0F, gDetector.getTempo());
+}
@@ -0,0 +1,272 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free sample ring buffer tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <SampleRingBuffer.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testWriteRead();
+static void testOverflow();
+static void testOverlappingWindows();
+static void testResync();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testWriteRead);
+    RUN_TEST(testOverflow);
+    RUN_TEST(testOverlappingWindows);
+    RUN_TEST(testResync);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test writing and reading, including the wrap around.
+ */
+static void testWriteRead()
+{
+    SampleRingBuffer<8U>    ringBuffer;
+    const int32_t           input[]     = { 1, -2, 3, -4, 5, -6 };
+    int32_t                 output[8U];
+    uint8_t                 round       = 0U;
+    uint8_t                 idx         = 0U;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.available());
+    TEST_ASSERT_FALSE(ringBuffer.peek(output, 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.skip(1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.write(nullptr, 1U));
+
+    /* Several rounds to pass the end of the buffer. */
+    for(round = 0U; round < 5U; ++round)
+    {
+        TEST_ASSERT_EQUAL_UINT32(UTIL_ARRAY_NUM(input), ringBuffer.write(input, UTIL_ARRAY_NUM(input)));
+        TEST_ASSERT_EQUAL_UINT32(UTIL_ARRAY_NUM(input), ringBuffer.available());
+
+        /* Peek doesn't remove samples. */
+        TEST_ASSERT_TRUE(ringBuffer.peek(output, UTIL_ARRAY_NUM(input)));
+        TEST_ASSERT_EQUAL_UINT32(UTIL_ARRAY_NUM(input), ringBuffer.available());
+        TEST_ASSERT_FALSE(ringBuffer.peek(output, UTIL_ARRAY_NUM(input) + 1U));
+
+        for(idx = 0U; idx < UTIL_ARRAY_NUM(input); ++idx)
+        {
+            TEST_ASSERT_EQUAL_INT32(input[idx], output[idx]);
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(UTIL_ARRAY_NUM(input), ringBuffer.skip(UTIL_ARRAY_NUM(input)));
+        TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.available());
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.getDroppedSamples());
+}
+
+/**
+ * Test a full buffer, which drops the new samples.
+ */
+static void testOverflow()
+{
+    SampleRingBuffer<8U>    ringBuffer;
+    const int32_t           input[]     = { 10, 11, 12, 13, 14, 15 };
+    int32_t                 output[8U];
+
+    TEST_ASSERT_EQUAL_UINT32(6U, ringBuffer.write(input, 6U));
+    TEST_ASSERT_EQUAL_UINT32(2U, ringBuffer.write(input, 6U));
+    TEST_ASSERT_EQUAL_UINT32(8U, ringBuffer.available());
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.write(input, 1U));
+
+    /* The dropped samples are counted and reset after reading. */
+    TEST_ASSERT_EQUAL_UINT32(5U, ringBuffer.getDroppedSamples());
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.getDroppedSamples());
+
+    /* The oldest samples are kept. */
+    TEST_ASSERT_TRUE(ringBuffer.peek(output, 8U));
+    TEST_ASSERT_EQUAL_INT32(10, output[0]);
+    TEST_ASSERT_EQUAL_INT32(15, output[5]);
+    TEST_ASSERT_EQUAL_INT32(10, output[6]);
+    TEST_ASSERT_EQUAL_INT32(11, output[7]);
+
+    ringBuffer.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.available());
+}
+
+/**
+ * Test overlapping windows, like the audio driver provides them to its
+ * observers.
+ */
+static void testOverlappingWindows()
+{
+    const uint32_t          WINDOW      = 8U;
+    const uint32_t          HOP         = 2U;
+    SampleRingBuffer<16U>   ringBuffer;
+    int32_t                 window[WINDOW];
+    int32_t                 sample      = 0;
+    uint32_t                windowCnt   = 0U;
+    uint32_t                idx         = 0U;
+
+    /* Feed the samples in blocks and consume every available window. */
+    while(64 > sample)
+    {
+        int32_t block[4U];
+
+        for(idx = 0U; idx < UTIL_ARRAY_NUM(block); ++idx)
+        {
+            block[idx] = sample;
+            ++sample;
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(UTIL_ARRAY_NUM(block), ringBuffer.write(block, UTIL_ARRAY_NUM(block)));
+
+        while(true == ringBuffer.peek(window, WINDOW))
+        {
+            /* Every window starts one hop after the previous one. */
+            for(idx = 0U; idx < WINDOW; ++idx)
+            {
+                TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(windowCnt * HOP + idx), window[idx]);
+            }
+
+            TEST_ASSERT_EQUAL_UINT32(HOP, ringBuffer.skip(HOP));
+            ++windowCnt;
+        }
+    }
+
+    /* 64 samples result in (64 - 8) / 2 + 1 windows. */
+    TEST_ASSERT_EQUAL_UINT32(29U, windowCnt);
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.getDroppedSamples());
+}
+
+/**
+ * Test the resynchronization after an overflow. No window shall span the
+ * dropped samples.
+ */
+static void testResync()
+{
+    SampleRingBuffer<8U>    ringBuffer;
+    const int32_t           before[]        = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const int32_t           after[]         = { 20, 21, 22, 23 };
+    int32_t                 window[4U];
+    uint32_t                removedSamples  = 0U;
+
+    /* Nothing dropped, nothing removed. */
+    TEST_ASSERT_EQUAL_UINT32(4U, ringBuffer.write(before, 4U));
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.resync(removedSamples));
+    TEST_ASSERT_EQUAL_UINT32(0U, removedSamples);
+    TEST_ASSERT_EQUAL_UINT32(4U, ringBuffer.available());
+    ringBuffer.clear();
+
+    /* Overflow: 8, 9 are dropped. */
+    TEST_ASSERT_EQUAL_UINT32(8U, ringBuffer.write(before, UTIL_ARRAY_NUM(before)));
+
+    /* The consumer frees some space, the producer continues after the gap. */
+    TEST_ASSERT_EQUAL_UINT32(4U, ringBuffer.skip(4U));
+    TEST_ASSERT_EQUAL_UINT32(4U, ringBuffer.write(after, UTIL_ARRAY_NUM(after)));
+
+    /* Without resync the window would be 4, 5, 6, 7 and then 6, 7, 20, 21. */
+    TEST_ASSERT_EQUAL_UINT32(2U, ringBuffer.resync(removedSamples));
+    TEST_ASSERT_EQUAL_UINT32(8U, removedSamples);
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.available());
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.getDroppedSamples());
+
+    /* The next window is continuous again. */
+    TEST_ASSERT_EQUAL_UINT32(4U, ringBuffer.write(after, UTIL_ARRAY_NUM(after)));
+    TEST_ASSERT_EQUAL_UINT32(0U, ringBuffer.resync(removedSamples));
+    TEST_ASSERT_TRUE(ringBuffer.peek(window, UTIL_ARRAY_NUM(window)));
+    TEST_ASSERT_EQUAL_INT32(20, window[0]);
+    TEST_ASSERT_EQUAL_INT32(23, window[3]);
+}
@@ -0,0 +1,270 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free double buffer with sequence counter tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <SeqLockBuffer.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Test data, which is published.
+ */
+struct TestData
+{
+    uint32_t    values[4U]; /**< Values */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeData(SeqLockBuffer<TestData>& buffer, uint32_t value);
+static void testPublish();
+static void testDirectRead();
+static void testReader();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testPublish);
+    RUN_TEST(testDirectRead);
+    RUN_TEST(testReader);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write and publish data, where all values are the same.
+ *
+ * @param[in] buffer    Buffer
+ * @param[in] value     Value
+ */
+static void writeData(SeqLockBuffer<TestData>& buffer, uint32_t value)
+{
+    TestData&   data    = buffer.beginWrite();
+    uint8_t     idx     = 0U;
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(data.values); ++idx)
+    {
+        data.values[idx] = value;
+    }
+
+    buffer.publish();
+}
+
+/**
+ * Test publishing and reading by copy.
+ */
+static void testPublish()
+{
+    SeqLockBuffer<TestData> buffer;
+    TestData                data        = { { 0U } };
+    uint32_t                sequence    = 0U;
+    uint32_t                value       = 0U;
+
+    /* Nothing published yet. */
+    TEST_ASSERT_EQUAL_UINT32(0U, buffer.getSequence());
+    TEST_ASSERT_FALSE(buffer.read(data, sequence));
+
+    for(value = 1U; value <= 5U; ++value)
+    {
+        writeData(buffer, value * 10U);
+
+        TEST_ASSERT_EQUAL_UINT32(value, buffer.getSequence());
+        TEST_ASSERT_TRUE(buffer.read(data, sequence));
+        TEST_ASSERT_EQUAL_UINT32(value, sequence);
+        TEST_ASSERT_EQUAL_UINT32(value * 10U, data.values[0]);
+        TEST_ASSERT_EQUAL_UINT32(value * 10U, data.values[3]);
+    }
+}
+
+/**
+ * Test the direct access and the detection of overwritten data.
+ */
+static void testDirectRead()
+{
+    SeqLockBuffer<TestData> buffer;
+    const TestData*         data        = nullptr;
+    uint32_t                sequence    = 0U;
+
+    data = buffer.beginRead(sequence);
+    TEST_ASSERT_NULL(data);
+
+    writeData(buffer, 1U);
+
+    data = buffer.beginRead(sequence);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL_UINT32(1U, data->values[0]);
+
+    /* The writer fills the other buffer, the read data stays consistent. */
+    writeData(buffer, 2U);
+    TEST_ASSERT_EQUAL_UINT32(1U, data->values[0]);
+    TEST_ASSERT_TRUE(buffer.endRead(sequence));
+
+    /* The next write overwrites the read data, even if it is not yet published. */
+    (void)buffer.beginWrite();
+    TEST_ASSERT_FALSE(buffer.endRead(sequence));
+    buffer.publish();
+
+    /* A new read gets the latest data. */
+    data = buffer.beginRead(sequence);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL_UINT32(3U, sequence);
+    TEST_ASSERT_TRUE(buffer.endRead(sequence));
+}
+
+/**
+ * Test reading with a reader, which copies only a part of the data.
+ */
+static void testReader()
+{
+    SeqLockBuffer<TestData> buffer;
+    uint32_t                value       = 0U;
+    uint32_t                sequence    = 0U;
+    uint8_t                 calls       = 0U;
+
+    /* Nothing published yet, the reader is not called. */
+    TEST_ASSERT_FALSE(buffer.read(
+        [&calls](const TestData& data) -> bool
+        {
+            UTIL_NOT_USED(data);
+            ++calls;
+            return true;
+        },
+        sequence));
+    TEST_ASSERT_EQUAL_UINT8(0U, calls);
+
+    writeData(buffer, 1U);
+
+    TEST_ASSERT_TRUE(buffer.read(
+        [&value](const TestData& data) -> bool
+        {
+            value = data.values[1];
+            return true;
+        },
+        sequence));
+    TEST_ASSERT_EQUAL_UINT32(1U, value);
+    TEST_ASSERT_EQUAL_UINT32(1U, sequence);
+
+    /* A reader, which can not use the data, fails the read. */
+    TEST_ASSERT_FALSE(buffer.read(
+        [](const TestData& data) -> bool
+        {
+            UTIL_NOT_USED(data);
+            return false;
+        },
+        sequence));
+
+    /* The writer overwrites the data during the first read, which is repeated. */
+    calls = 0U;
+    TEST_ASSERT_TRUE(buffer.read(
+        [&buffer, &value, &calls](const TestData& data) -> bool
+        {
+            if (0U == calls)
+            {
+                writeData(buffer, 2U);
+                writeData(buffer, 3U);
+            }
+
+            value = data.values[1];
+            ++calls;
+
+            return true;
+        },
+        sequence));
+    TEST_ASSERT_EQUAL_UINT8(2U, calls);
+    TEST_ASSERT_EQUAL_UINT32(3U, value);
+    TEST_ASSERT_EQUAL_UINT32(3U, sequence);
+}
@@ -34,6 +34,7 @@
  *****************************************************************************/
 #include <unity.h>
 #include <SimpleTimer.hpp>
+#include <VirtualClock.hpp>
 #include <Util.h>
 
 /******************************************************************************
@@ -53,6 +54,7 @@
  *****************************************************************************/
 
 static void testSimpleTimer();
+static void testSimpleTimerVirtualClock();
 
 /******************************************************************************
  * Local Variables
@@ -88,6 +90,7 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testSimpleTimer);
+    RUN_TEST(testSimpleTimerVirtualClock);
 
     return UNITY_END();
 }
@@ -105,7 +108,8 @@ extern void setUp(void)
  */
 extern void tearDown(void)
 {
-    /* Not used. */
+    /* Use system clock again, in case a test injected another one. */
+    setClock(nullptr);
 }
 
 /******************************************************************************
@@ -148,3 +152,53 @@ static void testSimpleTimer()
 
     return;
 }
+
+/**
+ * Test simple timer with a virtual clock.
+ */
+static void testSimpleTimerVirtualClock()
+{
+    VirtualClock    clock(1000UL);
+    SimpleTimer     testTimer;
+    uint32_t        step        = 0U;
+
+    setClock(&clock);
+    TEST_ASSERT_EQUAL_PTR(&clock, &getClock());
+    TEST_ASSERT_EQUAL_UINT32(1000UL, millis());
+
+    /* Clock must only advance if stepped. */
+    clock.step(500UL);
+    TEST_ASSERT_EQUAL_UINT32(1500UL, millis());
+
+    /* A delay steps the clock immediately. */
+    delay(500UL);
+    TEST_ASSERT_EQUAL_UINT32(2000UL, millis());
+
+    /* A 10 minute timer must timeout exactly after 10 minutes. */
+    testTimer.start(SIMPLE_TIMER_MINUTES(10U));
+
+    for(step = 0U; step < 599U; ++step)
+    {
+        clock.step(SIMPLE_TIMER_SECONDS(1U));
+        TEST_ASSERT_FALSE(testTimer.isTimeout());
+    }
+
+    clock.step(SIMPLE_TIMER_SECONDS(1U) - 1U);
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    clock.step(1U);
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+
+    /* Timer must handle the timestamp overflow. */
+    clock.set(UINT32_MAX - 10U);
+    testTimer.start(100U);
+    clock.step(50U);
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    clock.step(50U);
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+
+    /* Restore system clock. */
+    setClock(nullptr);
+    TEST_ASSERT_NOT_EQUAL(&clock, &getClock());
+
+    return;
+}
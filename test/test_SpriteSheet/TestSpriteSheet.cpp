@@ -0,0 +1,352 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test sprite sheet and its compressed texture.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <FS.h>
+#include <SpriteSheet.h>
+#include <SpriteTexture.h>
+#include <ImageCache.h>
+#include <NativeImg.h>
+#include <Util.h>
+
+#include "../common/BmpFile.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t getFrameColor(uint16_t x, uint16_t y);
+static void testSpriteTexturePalette();
+static void testSpriteTextureNoPalette();
+static void testSpriteSheet();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Name of the temporary texture image file. */
+static const char*      TMP_FILE_NAME   = "./testSpriteSheet.bmp";
+
+/** Frame width in pixels. */
+static const uint16_t   FRAME_WIDTH     = 4U;
+
+/** Frame height in pixels. */
+static const uint16_t   FRAME_HEIGHT    = 2U;
+
+/** Frame colors, in the order of the frames in the texture. */
+static const uint32_t   FRAME_COLORS[]  =
+{
+    0xFF0000U, 0x00FF00U, 0x0000FFU, 0xFFFFFFU
+};
+
+/** Color of the first pixel in every frame. */
+static const uint32_t   MARKER_COLOR    = 0x123456U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testSpriteTexturePalette);
+    RUN_TEST(testSpriteTextureNoPalette);
+    RUN_TEST(testSpriteSheet);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    (void)remove(TMP_FILE_NAME);
+    ImageCache::getInstance().clear();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the color of a texture pixel. Every frame is filled with its own color,
+ * except the first pixel, which is a marker.
+ *
+ * @param[in] x X-coordinate in the texture
+ * @param[in] y Y-coordinate in the texture
+ *
+ * @return Color
+ */
+static uint32_t getFrameColor(uint16_t x, uint16_t y)
+{
+    uint32_t color = MARKER_COLOR;
+
+    if ((0U != (x % FRAME_WIDTH)) ||
+        (0U != (y % FRAME_HEIGHT)))
+    {
+        uint16_t frameIdx = (y / FRAME_HEIGHT) * 2U + (x / FRAME_WIDTH);
+
+        color = FRAME_COLORS[frameIdx];
+    }
+
+    return color;
+}
+
+/**
+ * Test the compression of a texture with only a few colors.
+ */
+static void testSpriteTexturePalette()
+{
+    YAGfxDynamicBitmap  texture;
+    YAGfxDynamicBitmap  frame;
+    SpriteTexture       spriteTexture;
+    NativeImg           nativeImg;
+    FS                  localFileSystem;
+    uint16_t            x               = 0U;
+    uint16_t            y               = 0U;
+    uint16_t            frameIdx        = 0U;
+
+    /* 10 frames with 8x8 pixels. */
+    TEST_ASSERT_TRUE(texture.create(80U, 8U));
+    TEST_ASSERT_TRUE(frame.create(8U, 8U));
+
+    for(y = 0U; y < texture.getHeight(); ++y)
+    {
+        for(x = 0U; x < texture.getWidth(); ++x)
+        {
+            texture.drawPixel(x, y, (y == (x / 8U)) ? ColorDef::RED : ColorDef::BLUE);
+        }
+    }
+
+    TEST_ASSERT_FALSE(spriteTexture.isValid());
+    TEST_ASSERT_FALSE(spriteTexture.decode(0U, frame));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.save(localFileSystem, TMP_FILE_NAME, texture));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, spriteTexture.load(localFileSystem, TMP_FILE_NAME, 8U, 8U));
+    TEST_ASSERT_TRUE(spriteTexture.isValid());
+    TEST_ASSERT_EQUAL_UINT16(10U, spriteTexture.getFrameCnt());
+    TEST_ASSERT_EQUAL_UINT16(10U, spriteTexture.getFramesX());
+    TEST_ASSERT_EQUAL_UINT16(1U, spriteTexture.getFramesY());
+
+    /* The compressed texture shall be much smaller than the raw one. */
+    TEST_ASSERT_LESS_THAN(80U * 8U * sizeof(Color) / 4U, spriteTexture.getSize());
+
+    for(frameIdx = 0U; frameIdx < spriteTexture.getFrameCnt(); ++frameIdx)
+    {
+        TEST_ASSERT_TRUE(spriteTexture.decode(frameIdx, frame));
+
+        for(y = 0U; y < frame.getHeight(); ++y)
+        {
+            for(x = 0U; x < frame.getWidth(); ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT32(texture.getColor(frameIdx * 8U + x, y), frame.getColor(x, y));
+            }
+        }
+    }
+
+    /* Frame index out of range */
+    TEST_ASSERT_FALSE(spriteTexture.decode(10U, frame));
+
+    /* Frame size mismatch */
+    frame.release();
+    TEST_ASSERT_TRUE(frame.create(4U, 4U));
+    TEST_ASSERT_FALSE(spriteTexture.decode(0U, frame));
+
+    /* Frame size bigger than texture */
+    TEST_ASSERT_NOT_EQUAL(BmpImgLoader::RET_OK, spriteTexture.load(localFileSystem, TMP_FILE_NAME, 8U, 9U));
+    TEST_ASSERT_FALSE(spriteTexture.isValid());
+    TEST_ASSERT_EQUAL_UINT32(0U, spriteTexture.getSize());
+}
+
+/**
+ * Test the compression of a texture with more colors than a palette can hold.
+ */
+static void testSpriteTextureNoPalette()
+{
+    YAGfxDynamicBitmap  texture;
+    YAGfxDynamicBitmap  frame;
+    SpriteTexture       spriteTexture;
+    NativeImg           nativeImg;
+    FS                  localFileSystem;
+    uint16_t            x               = 0U;
+    uint16_t            y               = 0U;
+    uint16_t            frameIdx        = 0U;
+
+    /* 4 frames with 16x16 pixels, every pixel has its own color. */
+    TEST_ASSERT_TRUE(texture.create(32U, 32U));
+    TEST_ASSERT_TRUE(frame.create(16U, 16U));
+
+    for(y = 0U; y < texture.getHeight(); ++y)
+    {
+        for(x = 0U; x < texture.getWidth(); ++x)
+        {
+            texture.drawPixel(x, y, Color(x, y, 0U));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, nativeImg.save(localFileSystem, TMP_FILE_NAME, texture));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, spriteTexture.load(localFileSystem, TMP_FILE_NAME, 16U, 16U));
+    TEST_ASSERT_EQUAL_UINT16(4U, spriteTexture.getFrameCnt());
+
+    /* Without any runs, the raw colors are kept. */
+    TEST_ASSERT_EQUAL_UINT32(32U * 32U * sizeof(Color) + 4U * sizeof(uint32_t), spriteTexture.getSize());
+
+    {
+        /* The copy shall decode the same frames. */
+        SpriteTexture copy = spriteTexture;
+
+        spriteTexture.release();
+        TEST_ASSERT_FALSE(spriteTexture.isValid());
+        TEST_ASSERT_TRUE(copy.isValid());
+
+        for(frameIdx = 0U; frameIdx < copy.getFrameCnt(); ++frameIdx)
+        {
+            uint16_t offsetX = (frameIdx % 2U) * 16U;
+            uint16_t offsetY = (frameIdx / 2U) * 16U;
+
+            TEST_ASSERT_TRUE(copy.decode(frameIdx, frame));
+
+            for(y = 0U; y < frame.getHeight(); ++y)
+            {
+                for(x = 0U; x < frame.getWidth(); ++x)
+                {
+                    TEST_ASSERT_EQUAL_UINT32(texture.getColor(offsetX + x, offsetY + y), frame.getColor(x, y));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Test the sprite sheet animation, which decodes only the current frame.
+ */
+static void testSpriteSheet()
+{
+    FS          localFileSystem;
+    SpriteSheet spriteSheet;
+    uint8_t     idx             = 0U;
+
+    TEST_ASSERT_TRUE(spriteSheet.isEmpty());
+    TEST_ASSERT_TRUE(BmpFile::create(TMP_FILE_NAME, 2U * FRAME_WIDTH, 2U * FRAME_HEIGHT, getFrameColor));
+
+    /* Frame size bigger than texture */
+    TEST_ASSERT_FALSE(spriteSheet.loadTexture(localFileSystem, TMP_FILE_NAME, 3U * FRAME_WIDTH, FRAME_HEIGHT));
+    TEST_ASSERT_TRUE(spriteSheet.isEmpty());
+
+    /* Load twice, the second one replaces the first one. */
+    TEST_ASSERT_TRUE(spriteSheet.loadTexture(localFileSystem, TMP_FILE_NAME, 2U * FRAME_WIDTH, FRAME_HEIGHT));
+    TEST_ASSERT_TRUE(spriteSheet.loadTexture(localFileSystem, TMP_FILE_NAME, FRAME_WIDTH, FRAME_HEIGHT));
+    TEST_ASSERT_FALSE(spriteSheet.isEmpty());
+
+    /* The texture is compressed while loading, without the image cache. */
+    TEST_ASSERT_EQUAL_UINT32(0U, ImageCache::getInstance().getSize());
+    TEST_ASSERT_EQUAL_UINT16(FRAME_WIDTH, spriteSheet.getFrameWidth());
+    TEST_ASSERT_EQUAL_UINT16(FRAME_HEIGHT, spriteSheet.getFrameHeight());
+
+    /* The animation starts with the first frame. */
+    for(idx = 0U; idx < (2U * UTIL_ARRAY_NUM(FRAME_COLORS)); ++idx)
+    {
+        const YAGfxBitmap& frame = spriteSheet.getFrame();
+
+        spriteSheet.next();
+
+        TEST_ASSERT_EQUAL_UINT32(MARKER_COLOR, frame.getColor(0, 0));
+        TEST_ASSERT_EQUAL_UINT32(FRAME_COLORS[idx % UTIL_ARRAY_NUM(FRAME_COLORS)], frame.getColor(FRAME_WIDTH - 1U, FRAME_HEIGHT - 1U));
+    }
+
+    /* Backwards */
+    spriteSheet.setForward(false);
+    spriteSheet.reset();
+    spriteSheet.next();
+    TEST_ASSERT_EQUAL_UINT32(FRAME_COLORS[UTIL_ARRAY_NUM(FRAME_COLORS) - 1U], spriteSheet.getFrame().getColor(1, 0));
+
+    /* Once, the animation stops at the last frame. */
+    spriteSheet.setForward(true);
+    spriteSheet.repeatInfinite(false);
+    spriteSheet.reset();
+
+    for(idx = 0U; idx < (2U * UTIL_ARRAY_NUM(FRAME_COLORS)); ++idx)
+    {
+        spriteSheet.next();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(FRAME_COLORS[UTIL_ARRAY_NUM(FRAME_COLORS) - 1U], spriteSheet.getFrame().getColor(1, 0));
+
+    spriteSheet.release();
+    TEST_ASSERT_TRUE(spriteSheet.isEmpty());
+}
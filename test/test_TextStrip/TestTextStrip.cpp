@@ -0,0 +1,349 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test text strip.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <TextStrip.h>
+#include <YAGfxBitmap.h>
+#include <YAGfxText.h>
+#include <TomThumb.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void createLayout(TextLayout& layout);
+static void drawLayout(YAGfx& gfx, YAGfxText& gfxText, const TextLayout& layout, int16_t cursorX, int16_t cursorY);
+static bool isEqual(const YAGfx& gfx1, const YAGfx& gfx2);
+static void testTextStrip();
+static void testTextStripFallback();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Canvas width in pixels */
+static const uint16_t   WIDTH   = 32U;
+
+/** Canvas height in pixels */
+static const uint16_t   HEIGHT  = 8U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testTextStrip);
+    RUN_TEST(testTextStripFallback);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Create a single line text layout with two colors.
+ * The first run uses the default text color.
+ *
+ * @param[out] layout   Text layout
+ */
+static void createLayout(TextLayout& layout)
+{
+    TextLayout::Run* run = nullptr;
+
+    TEST_ASSERT_TRUE(layout.reset(2U));
+    layout.setText("Hello World!");
+
+    run = layout.appendRun(0U);
+    TEST_ASSERT_NOT_NULL(run);
+    run->length = 6U;
+
+    run = layout.appendRun(6U);
+    TEST_ASSERT_NOT_NULL(run);
+    run->length     = 6U;
+    run->isColorSet = true;
+    run->color      = 0xFF0000;
+}
+
+/**
+ * Draw the layout character by character.
+ *
+ * @param[in] gfx       Graphics interface
+ * @param[in] gfxText   Text graphics, which provides the font and the default color.
+ * @param[in] layout    Text layout
+ * @param[in] cursorX   Cursor x-coordinate
+ * @param[in] cursorY   Cursor y-coordinate
+ */
+static void drawLayout(YAGfx& gfx, YAGfxText& gfxText, const TextLayout& layout, int16_t cursorX, int16_t cursorY)
+{
+    const Color defaultColor    = gfxText.getTextColor();
+    uint16_t    runIndex        = 0U;
+    uint16_t    charIndex       = 0U;
+
+    gfxText.setTextCursorPos(cursorX, cursorY);
+
+    for(runIndex = 0U; runIndex < layout.getRunCnt(); ++runIndex)
+    {
+        const TextLayout::Run& run = layout.getRun(runIndex);
+
+        gfxText.setTextColor((true == run.isColorSet) ? run.color : defaultColor);
+
+        for(charIndex = 0U; charIndex < run.length; ++charIndex)
+        {
+            gfxText.drawChar(gfx, layout.getText()[run.begin + charIndex]);
+        }
+    }
+
+    gfxText.setTextColor(defaultColor);
+}
+
+/**
+ * Compare two canvas pixel by pixel.
+ *
+ * @param[in] gfx1  Graphics interface 1
+ * @param[in] gfx2  Graphics interface 2
+ *
+ * @return If both are equal, it will return true otherwise false.
+ */
+static bool isEqual(const YAGfx& gfx1, const YAGfx& gfx2)
+{
+    bool    isEqual = true;
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    for(y = 0; (y < HEIGHT) && (true == isEqual); ++y)
+    {
+        for(x = 0; (x < WIDTH) && (true == isEqual); ++x)
+        {
+            if (static_cast<uint32_t>(gfx1.getColor(x, y)) != static_cast<uint32_t>(gfx2.getColor(x, y)))
+            {
+                isEqual = false;
+            }
+        }
+    }
+
+    return isEqual;
+}
+
+/**
+ * Test that the pre-rendered text looks like the text, which is drawn
+ * character by character.
+ */
+static void testTextStrip()
+{
+    YAGfxDynamicBitmap  expected(WIDTH, HEIGHT);
+    YAGfxDynamicBitmap  actual(WIDTH, HEIGHT);
+    YAGfxText           gfxText(&TomThumb, ColorDef::WHITE);
+    TextLayout          layout;
+    TextStrip           strip;
+    TextStrip           stripCopy;
+    uint16_t            textWidth   = 0U;
+    uint16_t            textHeight  = 0U;
+    int16_t             cursorX     = 0;
+    int16_t             cursorY     = TomThumb.yAdvance - 1;
+
+    TEST_ASSERT_TRUE(expected.isAllocated());
+    TEST_ASSERT_TRUE(actual.isAllocated());
+
+    createLayout(layout);
+    TEST_ASSERT_FALSE(strip.isAvailable());
+    TEST_ASSERT_TRUE(strip.create(layout, gfxText.getFont()));
+    TEST_ASSERT_TRUE(strip.isAvailable());
+
+    /* The cursor moves like drawing character by character. */
+    TEST_ASSERT_TRUE(gfxText.getTextBoundingBox(UINT16_MAX, layout.getText().c_str(), textWidth, textHeight));
+    TEST_ASSERT_EQUAL_UINT16(textWidth, strip.getAdvance());
+
+    /* Scroll the text through the canvas. */
+    for(cursorX = -static_cast<int16_t>(textWidth) - 1; cursorX <= WIDTH; ++cursorX)
+    {
+        expected.fillScreen(ColorDef::BLACK);
+        actual.fillScreen(ColorDef::BLACK);
+
+        drawLayout(expected, gfxText, layout, cursorX, cursorY);
+        strip.draw(actual, cursorX, cursorY, gfxText.getTextColor());
+
+        TEST_ASSERT_TRUE(isEqual(expected, actual));
+    }
+
+    /* Partly above and below the canvas. */
+    for(cursorY = -1; cursorY <= (HEIGHT + TomThumb.yAdvance); ++cursorY)
+    {
+        expected.fillScreen(ColorDef::BLACK);
+        actual.fillScreen(ColorDef::BLACK);
+
+        drawLayout(expected, gfxText, layout, 1, cursorY);
+        strip.draw(actual, 1, cursorY, gfxText.getTextColor());
+
+        TEST_ASSERT_TRUE(isEqual(expected, actual));
+    }
+
+    /* A copy draws the same. */
+    stripCopy = strip;
+    TEST_ASSERT_TRUE(stripCopy.isAvailable());
+
+    expected.fillScreen(ColorDef::BLACK);
+    actual.fillScreen(ColorDef::BLACK);
+    strip.draw(expected, 3, TomThumb.yAdvance - 1, ColorDef::GREEN);
+    stripCopy.draw(actual, 3, TomThumb.yAdvance - 1, ColorDef::GREEN);
+    TEST_ASSERT_TRUE(isEqual(expected, actual));
+
+    strip.release();
+    TEST_ASSERT_FALSE(strip.isAvailable());
+
+    return;
+}
+
+/**
+ * Test the texts, which can not be pre-rendered.
+ */
+static void testTextStripFallback()
+{
+    YAGfxText           gfxText(&TomThumb, ColorDef::WHITE);
+    TextLayout          layout;
+    TextStrip           strip;
+    TextLayout::Run*    run     = nullptr;
+    String              text;
+
+    /* Several lines */
+    TEST_ASSERT_TRUE(layout.reset(2U));
+    layout.setText("A\nB");
+
+    run = layout.appendRun(0U);
+    TEST_ASSERT_NOT_NULL(run);
+    run->length = 1U;
+
+    run = layout.appendRun(2U);
+    TEST_ASSERT_NOT_NULL(run);
+    run->length     = 1U;
+    run->isNewLine  = true;
+
+    TEST_ASSERT_FALSE(strip.create(layout, gfxText.getFont()));
+    TEST_ASSERT_FALSE(strip.isAvailable());
+
+    /* Too long text */
+    while((TextStrip::MAX_MASK_SIZE * 8U / TomThumb.yAdvance) > text.length())
+    {
+        text += "WWWWWWWWWW";
+    }
+
+    TEST_ASSERT_TRUE(layout.reset(1U));
+    layout.setText(text.c_str());
+
+    run = layout.appendRun(0U);
+    TEST_ASSERT_NOT_NULL(run);
+    run->length = text.length();
+
+    TEST_ASSERT_FALSE(strip.create(layout, gfxText.getFont()));
+    TEST_ASSERT_FALSE(strip.isAvailable());
+
+    /* No text */
+    TEST_ASSERT_TRUE(layout.reset(1U));
+    TEST_ASSERT_NOT_NULL(layout.appendRun(0U));
+    TEST_ASSERT_FALSE(strip.create(layout, gfxText.getFont()));
+
+    /* Font with a glyph, which is too wide for the glyph cache. */
+    {
+        static uint8_t  bitmap[]    = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+        static GFXglyph glyphs[]    = { { 0U, 40U, 1U, 41U, 0, -1 } };
+        GFXfont         gfxFont     = { bitmap, glyphs, 'A', 'A', 2U };
+        YAGfxText       wideGfxText(&gfxFont, ColorDef::WHITE);
+
+        TEST_ASSERT_TRUE(layout.reset(1U));
+        layout.setText("A");
+
+        run = layout.appendRun(0U);
+        TEST_ASSERT_NOT_NULL(run);
+        run->length = 1U;
+
+        TEST_ASSERT_FALSE(strip.create(layout, wideGfxText.getFont()));
+        TEST_ASSERT_FALSE(strip.isAvailable());
+    }
+
+    return;
+}
@@ -35,6 +35,7 @@
 #include <unity.h>
 #include <TextWidget.h>
 #include <Util.h>
+#include <VirtualClock.hpp>
 
 #include "../common/YAGfxTest.hpp"
 
@@ -55,6 +56,10 @@
  *****************************************************************************/
 
 static void testTextWidget();
+static void testTextWidgetLayout();
+static void testTextWidgetScroll();
+static uint32_t countPixels(const YAGfxTest& gfx, int16_t posX, uint16_t width, const Color& color);
+static int16_t getFirstColumn(const YAGfxBitmap& bitmap, const Color& color);
 
 /******************************************************************************
  * Local Variables
@@ -90,6 +95,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testTextWidget);
+    RUN_TEST(testTextWidgetLayout);
+    RUN_TEST(testTextWidgetScroll);
 
     return UNITY_END();
 }
@@ -187,3 +194,160 @@ static void testTextWidget()
 
     return;
 }
+
+/**
+ * Test the text layout, which is created from the format tags.
+ */
+static void testTextWidgetLayout()
+{
+    YAGfxTest   testGfx;
+    TextWidget  textWidget;
+    const Color RED         = 0xFF0000;
+    const Color GREEN       = 0x00FF00;
+    const Color BLACK       = 0x000000;
+    uint16_t    charWidth   = 0U;
+    uint16_t    charHeight  = 0U;
+    int16_t     centerX     = 0;
+
+    TEST_ASSERT_TRUE(textWidget.getFont().getCharBoundingBox('A', charWidth, charHeight));
+
+    /* Two runs with different colors, left aligned. */
+    textWidget.setFormatStr("\\#FF0000A\\#00FF00A");
+    textWidget.update(testGfx);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, countPixels(testGfx, 0, charWidth, RED));
+    TEST_ASSERT_EQUAL_UINT32(0U, countPixels(testGfx, 0, charWidth, GREEN));
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, countPixels(testGfx, charWidth, charWidth, GREEN));
+    TEST_ASSERT_EQUAL_UINT32(0U, countPixels(testGfx, charWidth, charWidth, RED));
+    TEST_ASSERT_TRUE(testGfx.verify(2 * charWidth, 0, YAGfxTest::WIDTH - 2 * charWidth, YAGfxTest::HEIGHT, BLACK));
+
+    /* Centered text. */
+    testGfx.fill(BLACK);
+    textWidget.setFormatStr("\\calign\\#FF0000A");
+    textWidget.update(testGfx);
+    centerX = (YAGfxTest::WIDTH - charWidth) / 2;
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, centerX, YAGfxTest::HEIGHT, BLACK));
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, countPixels(testGfx, centerX, charWidth, RED));
+    TEST_ASSERT_TRUE(testGfx.verify(centerX + charWidth, 0, YAGfxTest::WIDTH - centerX - charWidth, YAGfxTest::HEIGHT, BLACK));
+
+    /* Right aligned text. */
+    testGfx.fill(BLACK);
+    textWidget.setFormatStr("\\ralign\\#00FF00A");
+    textWidget.update(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH - charWidth, YAGfxTest::HEIGHT, BLACK));
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, countPixels(testGfx, YAGfxTest::WIDTH - charWidth, charWidth, GREEN));
+
+    return;
+}
+
+/**
+ * Test that a scrolling text is moved before it is shown, so every scroll
+ * step is painted only once.
+ */
+static void testTextWidgetScroll()
+{
+    YAGfxDynamicBitmap  canvas(YAGfxTest::WIDTH, YAGfxTest::HEIGHT);
+    TextWidget          textWidget;
+    VirtualClock        clock;
+    const Color         RED         = 0xFF0000;
+    const Color         BLACK       = 0x000000;
+    const uint8_t       STEPS       = YAGfxTest::WIDTH / 2U;
+    uint8_t             step        = 0U;
+    int16_t             posX        = 0;
+    int16_t             prevPosX    = -1;
+
+    TEST_ASSERT_TRUE(canvas.isAllocated());
+
+    /* The canvas is used, because it clips the text outside the display. */
+    setClock(&clock);
+
+    /* The text is wider than the display, therefore it scrolls in from the right. */
+    textWidget.setFormatStr("\\#FF0000AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA");
+
+    for(step = 0U; step < STEPS; ++step)
+    {
+        TEST_ASSERT_TRUE(textWidget.isDirty());
+
+        canvas.fillScreen(BLACK);
+        textWidget.update(canvas);
+        TEST_ASSERT_FALSE(textWidget.isDirty());
+
+        /* The shown text is already moved by one pixel. */
+        posX = getFirstColumn(canvas, RED);
+
+        if ((0 <= prevPosX) &&
+            (0 <= posX))
+        {
+            TEST_ASSERT_EQUAL_INT16(prevPosX - 1, posX);
+        }
+
+        prevPosX = posX;
+
+        clock.step(TextWidget::DEFAULT_SCROLL_PAUSE);
+    }
+
+    TEST_ASSERT_GREATER_OR_EQUAL_INT16(0, prevPosX);
+
+    setClock(nullptr);
+
+    return;
+}
+
+/**
+ * Count the pixels with the given color in a range of columns.
+ *
+ * @param[in] gfx   Graphics
+ * @param[in] posX  x-coordinate of the first column
+ * @param[in] width Number of columns
+ * @param[in] color Pixel color
+ *
+ * @return Number of pixels
+ */
+static uint32_t countPixels(const YAGfxTest& gfx, int16_t posX, uint16_t width, const Color& color)
+{
+    uint32_t    cnt = 0U;
+    int16_t     x   = 0;
+    int16_t     y   = 0;
+
+    for(y = 0; y < YAGfxTest::HEIGHT; ++y)
+    {
+        for(x = posX; x < (posX + width); ++x)
+        {
+            if (color == gfx.getColor(x, y))
+            {
+                ++cnt;
+            }
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Get the first column, which contains a pixel with the given color.
+ *
+ * @param[in] bitmap    Bitmap
+ * @param[in] color     Pixel color
+ *
+ * @return Column or -1 if there is no pixel with the given color.
+ */
+static int16_t getFirstColumn(const YAGfxBitmap& bitmap, const Color& color)
+{
+    int16_t column  = -1;
+    int16_t x       = 0;
+    int16_t y       = 0;
+
+    while((0 > column) && (bitmap.getWidth() > x))
+    {
+        for(y = 0; y < bitmap.getHeight(); ++y)
+        {
+            if (color == bitmap.getColor(x, y))
+            {
+                column = x;
+            }
+        }
+
+        ++x;
+    }
+
+    return column;
+}
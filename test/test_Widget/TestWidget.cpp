@@ -213,5 +213,31 @@ static void testWidget()
                                     getMin<uint16_t>(YAGfxTest::HEIGHT - posY, TestWidget::HEIGHT),
                                     COLOR));
 
+    /* After the widget was painted, it is not dirty anymore. */
+    TEST_ASSERT_FALSE(testWidget.isDirty());
+
+    /* Moving the widget to the same position doesn't change it. */
+    testWidget.move(posX, posY);
+    TEST_ASSERT_FALSE(testWidget.isDirty());
+
+    /* Moving the widget to another position needs a repaint. */
+    testWidget.move(posX + 1, posY);
+    TEST_ASSERT_TRUE(testWidget.isDirty());
+    testWidget.update(testGfx);
+    TEST_ASSERT_FALSE(testWidget.isDirty());
+
+    /* Disable and enable the widget, both need a repaint. */
+    testWidget.disable();
+    TEST_ASSERT_TRUE(testWidget.isDirty());
+    testWidget.update(testGfx);
+    TEST_ASSERT_FALSE(testWidget.isDirty());
+    testWidget.enable();
+    TEST_ASSERT_TRUE(testWidget.isDirty());
+    testWidget.update(testGfx);
+
+    /* Explicit invalidation */
+    testWidget.invalidate();
+    TEST_ASSERT_TRUE(testWidget.isDirty());
+
     return;
 }
@@ -58,6 +58,7 @@
 template < typename T >
 static T getMin(const T value1, const T value2);
 static void testWidgetGroup();
+static void testWidgetGroupRefresh();
 
 /******************************************************************************
  * Local Variables
@@ -93,6 +94,7 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testWidgetGroup);
+    RUN_TEST(testWidgetGroupRefresh);
 
     return UNITY_END();
 }
@@ -241,3 +243,58 @@ static void testWidgetGroup()
 
     return;
 }
+
+/**
+ * Widget group tests in retained mode.
+ */
+static void testWidgetGroupRefresh()
+{
+    const uint16_t  CANVAS_WIDTH        = 8;
+    const uint16_t  CANVAS_HEIGHT       = 8;
+    const Color     WIDGET_COLOR        = 0x123456;
+    const Color     BACKGROUND_COLOR    = 0x000010;
+
+    YAGfxTest   testGfx;
+    WidgetGroup testWGroup(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0);
+    TestWidget  testWidget;
+
+    /* A new group was never painted, therefore it is dirty. */
+    TEST_ASSERT_TRUE(testWGroup.isDirty());
+
+    /* Refresh clears the whole group with the background color. */
+    testGfx.fill(0);
+    testWGroup.setBackgroundColor(BACKGROUND_COLOR);
+    TEST_ASSERT_TRUE(testWGroup.refresh(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, CANVAS_HEIGHT, BACKGROUND_COLOR));
+    TEST_ASSERT_FALSE(testWGroup.isDirty());
+
+    /* Nothing changed, so nothing shall be drawn. */
+    testGfx.fill(0);
+    testGfx.setCallCounterDrawPixel(0);
+    TEST_ASSERT_FALSE(testWGroup.refresh(testGfx));
+    TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+    /* Adding a widget makes the group dirty. */
+    TEST_ASSERT_TRUE(testWGroup.addWidget(testWidget));
+    TEST_ASSERT_TRUE(testWGroup.isDirty());
+    TEST_ASSERT_TRUE(testWGroup.refresh(testGfx));
+    TEST_ASSERT_FALSE(testWGroup.isDirty());
+    TEST_ASSERT_FALSE(testWidget.isDirty());
+
+    /* A changed widget makes the group dirty. */
+    testWidget.setPenColor(WIDGET_COLOR);
+    TEST_ASSERT_TRUE(testWGroup.isDirty());
+    testGfx.fill(0);
+    TEST_ASSERT_TRUE(testWGroup.refresh(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, TestWidget::HEIGHT, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, TestWidget::HEIGHT, CANVAS_WIDTH, CANVAS_HEIGHT - TestWidget::HEIGHT, BACKGROUND_COLOR));
+    TEST_ASSERT_FALSE(testWGroup.refresh(testGfx));
+
+    /* Moving a widget clears its old area with the background color. */
+    testWidget.move(CANVAS_WIDTH / 2, 0);
+    TEST_ASSERT_TRUE(testWGroup.refresh(testGfx));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH / 2, CANVAS_HEIGHT, BACKGROUND_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(CANVAS_WIDTH / 2, 0, CANVAS_WIDTH / 2, TestWidget::HEIGHT, WIDGET_COLOR));
+
+    return;
+}